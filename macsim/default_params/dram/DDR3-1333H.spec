@@ -0,0 +1,18 @@
+# DDR3-1333H (9-9-9), x8 devices, 4Gb, tCK 1.5ns
+# suggested: clock_mc 0.667, dram_bus_width 16 (64-bit channel), dram_num_banks 8 per channel
+tBL     4
+tCL     9
+tCWL    7
+tRCD    9
+tRP     9
+tRAS    24
+tRC     33
+tWR     10
+tRTP    5
+tWTR_S  5
+tRRD_S  4
+tCCD_S  4
+tFAW    20
+tRTRS   2
+tREFI   5200
+tRFC    174
@@ -0,0 +1,18 @@
+# DDR3-1600K (11-11-11), x8 devices, 4Gb, tCK 1.25ns
+# suggested: clock_mc 0.8, dram_bus_width 16 (64-bit channel), dram_num_banks 8 per channel
+tBL     4
+tCL     11
+tCWL    8
+tRCD    11
+tRP     11
+tRAS    28
+tRC     39
+tWR     12
+tRTP    6
+tWTR_S  6
+tRRD_S  5
+tCCD_S  4
+tFAW    24
+tRTRS   2
+tREFI   6240
+tRFC    208
@@ -0,0 +1,22 @@
+# DDR4-2400R (16-16-16), x8 devices, 8Gb, tCK 0.833ns
+# suggested: clock_mc 1.2, dram_bus_width 16 (64-bit channel), dram_num_banks 16 per channel,
+#            dram_num_bank_groups 4
+tBL     4
+tCL     16
+tCWL    12
+tRCD    16
+tRP     16
+tRAS    39
+tRC     55
+tWR     18
+tRTP    9
+tWTR_S  3
+tWTR_L  9
+tRRD_S  4
+tRRD_L  6
+tCCD_S  4
+tCCD_L  6
+tFAW    26
+tRTRS   2
+tREFI   9364
+tRFC    420
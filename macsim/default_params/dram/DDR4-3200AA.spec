@@ -0,0 +1,22 @@
+# DDR4-3200AA (22-22-22), x8 devices, 8Gb, tCK 0.625ns
+# suggested: clock_mc 1.6, dram_bus_width 16 (64-bit channel), dram_num_banks 16 per channel,
+#            dram_num_bank_groups 4
+tBL     4
+tCL     22
+tCWL    16
+tRCD    22
+tRP     22
+tRAS    52
+tRC     74
+tWR     24
+tRTP    12
+tWTR_S  4
+tWTR_L  12
+tRRD_S  4
+tRRD_L  8
+tCCD_S  4
+tCCD_L  8
+tFAW    34
+tRTRS   2
+tREFI   12480
+tRFC    560
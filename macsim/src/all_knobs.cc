@@ -357,6 +357,7 @@ all_knobs_c::all_knobs_c() {
 	KNOB_PREF_STREAM_ON_LARGE_CORE = new KnobTemplate< bool > ("pref_stream_on_large_core", false);
 	KNOB_PREF_THROTTLE_ON = new KnobTemplate< bool > ("pref_throttle_on", false);
 	KNOB_PREF_THROTTLEFB_ON = new KnobTemplate< bool > ("pref_throttlefb_on", false);
+	KNOB_PREF_THROTTLE_BW_THRESH = new KnobTemplate< float > ("pref_throttle_bw_thresh", 0.5);
 	KNOB_PREF_ACC_THRESH_4 = new KnobTemplate< float > ("pref_acc_thresh_4", 0.40);
 	KNOB_PREF_ACCRATIOTHROTTLE = new KnobTemplate< bool > ("pref_accratiothrottle", false);
 	KNOB_PREF_ACCRATIO_1 = new KnobTemplate< float > ("pref_accratio_1", 0.70);
@@ -470,6 +471,23 @@ all_knobs_c::all_knobs_c() {
 	KNOB_DRAM_NUM_MC = new KnobTemplate< int > ("dram_num_mc", 1);
 	KNOB_DRAM_INTERLEAVE_FACTOR = new KnobTemplate< int > ("dram_interleave_factor", 128);
 	KNOB_DRAM_ADDITIONAL_LATENCY = new KnobTemplate< int > ("dram_additional_latency", 0);
+	KNOB_DRAM_TIMING_SPEC = new KnobTemplate< string > ("dram_timing_spec", "none");
+	KNOB_DRAM_NUM_RANKS = new KnobTemplate< int > ("dram_num_ranks", 1);
+	KNOB_DRAM_NUM_BANK_GROUPS = new KnobTemplate< int > ("dram_num_bank_groups", 1);
+	KNOB_DRAM_PAGE_POLICY = new KnobTemplate< string > ("dram_page_policy", "open");
+	KNOB_DRAM_NUM_APPLICATION = new KnobTemplate< int > ("dram_num_application", 8);
+	KNOB_DRAM_SCHED_QUANTUM = new KnobTemplate< int > ("dram_sched_quantum", 1000000);
+	KNOB_DRAM_PARBS_MARKING_CAP = new KnobTemplate< int > ("dram_parbs_marking_cap", 5);
+	KNOB_DRAM_ATLAS_THRESHOLD = new KnobTemplate< int > ("dram_atlas_threshold", 100000);
+	KNOB_DRAM_ATLAS_ALPHA = new KnobTemplate< float > ("dram_atlas_alpha", 0.875);
+	KNOB_DRAM_TCM_CLUSTER_THRESHOLD = new KnobTemplate< float > ("dram_tcm_cluster_threshold", 0.1);
+	KNOB_DRAM_TCM_SHUFFLE_INTERVAL = new KnobTemplate< int > ("dram_tcm_shuffle_interval", 800);
+	KNOB_DRAM_BLISS_THRESHOLD = new KnobTemplate< int > ("dram_bliss_threshold", 4);
+	KNOB_DRAM_BLISS_CLEAR_INTERVAL = new KnobTemplate< int > ("dram_bliss_clear_interval", 10000);
+	KNOB_DRAM_WRITE_QUEUE_SIZE = new KnobTemplate< int > ("dram_write_queue_size", 0);
+	KNOB_DRAM_WRITE_HIGH_WATERMARK = new KnobTemplate< int > ("dram_write_high_watermark", 48);
+	KNOB_DRAM_WRITE_LOW_WATERMARK = new KnobTemplate< int > ("dram_write_low_watermark", 16);
+	KNOB_DRAM_TWTR = new KnobTemplate< int > ("dram_twtr", 0);
 	KNOB_MEMORY_TYPE = new KnobTemplate< string > ("memory_type", "l3_cn");
 	KNOB_MEM_MSHR_SIZE = new KnobTemplate< int > ("mem_mshr_size", 128);
 	KNOB_MEM_QUEUE_SIZE = new KnobTemplate< int > ("mem_queue_size", 128);
@@ -501,6 +519,17 @@ all_knobs_c::all_knobs_c() {
 	KNOB_SHARED_MEM_PORTS = new KnobTemplate< uns > ("shared_mem_ports", 2);
 	KNOB_ENABLE_CACHE_COHERENCE = new KnobTemplate< bool > ("enable_cache_coherence", false);
 	KNOB_LLC_TYPE = new KnobTemplate< string > ("llc_type", "default");
+	KNOB_L2_INCLUSION = new KnobTemplate< string > ("l2_inclusion", "non_inclusive");
+	KNOB_L3_INCLUSION = new KnobTemplate< string > ("l3_inclusion", "non_inclusive");
+	KNOB_L3_INCLUSION_QBS = new KnobTemplate< uns > ("l3_inclusion_qbs", 0);
+	KNOB_INCLUSION_SAMPLE_INTERVAL = new KnobTemplate< uns > ("inclusion_sample_interval", 0);
+	KNOB_LLC_BDI_TAG_RATIO = new KnobTemplate< uns > ("llc_bdi_tag_ratio", 2);
+	KNOB_LLC_BDI_SEGMENT_SIZE = new KnobTemplate< uns > ("llc_bdi_segment_size", 8);
+	KNOB_LLC_BDI_DECOMP_LATENCY = new KnobTemplate< uns > ("llc_bdi_decomp_latency", 1);
+	KNOB_LLC_BDI_VICTIM_WINDOW = new KnobTemplate< uns > ("llc_bdi_victim_window", 4);
+	KNOB_LLC_BDI_DIST = new KnobTemplate< string > ("llc_bdi_dist", "20,5,10,10,10,5,10,5,25");
+	KNOB_LLC_BDI_PROFILE = new KnobTemplate< string > ("llc_bdi_profile", "none");
+	KNOB_LLC_BDI_PAGE_SIZE = new KnobTemplate< uns > ("llc_bdi_page_size", 4096);
 	KNOB_COLLECT_CACHE_INFO = new KnobTemplate< int > ("collect_cache_info", 0);
 	KNOB_HETERO_STATIC_CACHE_PARTITION = new KnobTemplate< bool > ("hetero_static_cache_partition", false);
 	KNOB_HETERO_STATIC_CPU_PARTITION = new KnobTemplate< int > ("hetero_static_cpu_partition", 1);
@@ -521,6 +550,7 @@ all_knobs_c::all_knobs_c() {
 	KNOB_PAGE_SIZE = new KnobTemplate< int > ("page_size", 4096);
 	KNOB_REGION_SIZE = new KnobTemplate< int > ("region_size", 1048576);
 	KNOB_PAGE_MAPPING_POLICY = new KnobTemplate< string > ("page_mapping_policy", "REGION_FCFS");
+	KNOB_LLC_TAP_THRESHOLD = new KnobTemplate< int > ("llc_tap_threshold", 10);
 	
 
 	// =========== ../def/network.param.def ===========
@@ -671,6 +701,16 @@ all_knobs_c::all_knobs_c() {
 	KNOB_BUG_DETECTOR_ENABLE = new KnobTemplate< bool > ("bug_detector_enable", false);
 	KNOB_COLLECT_CPI_INFO = new KnobTemplate< int > ("collect_cpi_info", 0);
 	KNOB_COLLECT_CPI_INFO_FOR_MULTI_GPU = new KnobTemplate< int > ("collect_cpi_info_for_multi_gpu", 0);
+	KNOB_STAT_SAMPLE_CYCLES = new KnobTemplate< uns64 > ("stat_sample_cycles", 0);
+	KNOB_STAT_SAMPLE_INSTS = new KnobTemplate< uns64 > ("stat_sample_insts", 0);
+	KNOB_STAT_SAMPLE_FILTER = new KnobTemplate< string > ("stat_sample_filter", "*");
+	KNOB_STAT_SAMPLE_FILE = new KnobTemplate< string > ("stat_sample_file", "stat_samples.bin");
+	KNOB_STAT_OUTPUT_FORMAT = new KnobTemplate< string > ("stat_output_format", "text");
+	KNOB_MEM_LATENCY_HIST = new KnobTemplate< bool > ("mem_latency_hist", false);
+	KNOB_PC_PROFILER_ENABLE = new KnobTemplate< bool > ("pc_profiler_enable", false);
+	KNOB_PC_PROFILER_SIZE = new KnobTemplate< uns > ("pc_profiler_size", 256);
+	KNOB_PC_PROFILER_INTERVAL = new KnobTemplate< uns64 > ("pc_profiler_interval", 0);
+	KNOB_CPI_STACK_INTERVAL = new KnobTemplate< uns64 > ("cpi_stack_interval", 0);
 }
 
 all_knobs_c::~all_knobs_c() {
@@ -1010,6 +1050,7 @@ all_knobs_c::~all_knobs_c() {
 	delete KNOB_PREF_STREAM_ON_LARGE_CORE;
 	delete KNOB_PREF_THROTTLE_ON;
 	delete KNOB_PREF_THROTTLEFB_ON;
+	delete KNOB_PREF_THROTTLE_BW_THRESH;
 	delete KNOB_PREF_ACC_THRESH_4;
 	delete KNOB_PREF_ACCRATIOTHROTTLE;
 	delete KNOB_PREF_ACCRATIO_1;
@@ -1120,6 +1161,23 @@ all_knobs_c::~all_knobs_c() {
 	delete KNOB_DRAM_NUM_MC;
 	delete KNOB_DRAM_INTERLEAVE_FACTOR;
 	delete KNOB_DRAM_ADDITIONAL_LATENCY;
+	delete KNOB_DRAM_TIMING_SPEC;
+	delete KNOB_DRAM_NUM_RANKS;
+	delete KNOB_DRAM_NUM_BANK_GROUPS;
+	delete KNOB_DRAM_PAGE_POLICY;
+	delete KNOB_DRAM_NUM_APPLICATION;
+	delete KNOB_DRAM_SCHED_QUANTUM;
+	delete KNOB_DRAM_PARBS_MARKING_CAP;
+	delete KNOB_DRAM_ATLAS_THRESHOLD;
+	delete KNOB_DRAM_ATLAS_ALPHA;
+	delete KNOB_DRAM_TCM_CLUSTER_THRESHOLD;
+	delete KNOB_DRAM_TCM_SHUFFLE_INTERVAL;
+	delete KNOB_DRAM_BLISS_THRESHOLD;
+	delete KNOB_DRAM_BLISS_CLEAR_INTERVAL;
+	delete KNOB_DRAM_WRITE_QUEUE_SIZE;
+	delete KNOB_DRAM_WRITE_HIGH_WATERMARK;
+	delete KNOB_DRAM_WRITE_LOW_WATERMARK;
+	delete KNOB_DRAM_TWTR;
 	delete KNOB_MEMORY_TYPE;
 	delete KNOB_MEM_MSHR_SIZE;
 	delete KNOB_MEM_QUEUE_SIZE;
@@ -1151,6 +1209,17 @@ all_knobs_c::~all_knobs_c() {
 	delete KNOB_SHARED_MEM_PORTS;
 	delete KNOB_ENABLE_CACHE_COHERENCE;
 	delete KNOB_LLC_TYPE;
+	delete KNOB_L2_INCLUSION;
+	delete KNOB_L3_INCLUSION;
+	delete KNOB_L3_INCLUSION_QBS;
+	delete KNOB_INCLUSION_SAMPLE_INTERVAL;
+	delete KNOB_LLC_BDI_TAG_RATIO;
+	delete KNOB_LLC_BDI_SEGMENT_SIZE;
+	delete KNOB_LLC_BDI_DECOMP_LATENCY;
+	delete KNOB_LLC_BDI_VICTIM_WINDOW;
+	delete KNOB_LLC_BDI_DIST;
+	delete KNOB_LLC_BDI_PROFILE;
+	delete KNOB_LLC_BDI_PAGE_SIZE;
 	delete KNOB_COLLECT_CACHE_INFO;
 	delete KNOB_HETERO_STATIC_CACHE_PARTITION;
 	delete KNOB_HETERO_STATIC_CPU_PARTITION;
@@ -1309,6 +1378,17 @@ all_knobs_c::~all_knobs_c() {
 	delete KNOB_BUG_DETECTOR_ENABLE;
 	delete KNOB_COLLECT_CPI_INFO;
 	delete KNOB_COLLECT_CPI_INFO_FOR_MULTI_GPU;
+	delete KNOB_STAT_SAMPLE_CYCLES;
+	delete KNOB_STAT_SAMPLE_INSTS;
+	delete KNOB_STAT_SAMPLE_FILTER;
+	delete KNOB_STAT_SAMPLE_FILE;
+	delete KNOB_STAT_OUTPUT_FORMAT;
+	delete KNOB_MEM_LATENCY_HIST;
+	delete KNOB_PC_PROFILER_ENABLE;
+	delete KNOB_PC_PROFILER_SIZE;
+	delete KNOB_PC_PROFILER_INTERVAL;
+	delete KNOB_CPI_STACK_INTERVAL;
+	delete KNOB_LLC_TAP_THRESHOLD;
 }
 
 void all_knobs_c::registerKnobs(KnobsContainer *container) {
@@ -1666,6 +1746,7 @@ void all_knobs_c::registerKnobs(KnobsContainer *container) {
 	container->insertKnob( KNOB_PREF_STREAM_ON_LARGE_CORE );
 	container->insertKnob( KNOB_PREF_THROTTLE_ON );
 	container->insertKnob( KNOB_PREF_THROTTLEFB_ON );
+	container->insertKnob( KNOB_PREF_THROTTLE_BW_THRESH );
 	container->insertKnob( KNOB_PREF_ACC_THRESH_4 );
 	container->insertKnob( KNOB_PREF_ACCRATIOTHROTTLE );
 	container->insertKnob( KNOB_PREF_ACCRATIO_1 );
@@ -1779,6 +1860,23 @@ void all_knobs_c::registerKnobs(KnobsContainer *container) {
 	container->insertKnob( KNOB_DRAM_NUM_MC );
 	container->insertKnob( KNOB_DRAM_INTERLEAVE_FACTOR );
 	container->insertKnob( KNOB_DRAM_ADDITIONAL_LATENCY );
+	container->insertKnob( KNOB_DRAM_TIMING_SPEC );
+	container->insertKnob( KNOB_DRAM_NUM_RANKS );
+	container->insertKnob( KNOB_DRAM_NUM_BANK_GROUPS );
+	container->insertKnob( KNOB_DRAM_PAGE_POLICY );
+	container->insertKnob( KNOB_DRAM_NUM_APPLICATION );
+	container->insertKnob( KNOB_DRAM_SCHED_QUANTUM );
+	container->insertKnob( KNOB_DRAM_PARBS_MARKING_CAP );
+	container->insertKnob( KNOB_DRAM_ATLAS_THRESHOLD );
+	container->insertKnob( KNOB_DRAM_ATLAS_ALPHA );
+	container->insertKnob( KNOB_DRAM_TCM_CLUSTER_THRESHOLD );
+	container->insertKnob( KNOB_DRAM_TCM_SHUFFLE_INTERVAL );
+	container->insertKnob( KNOB_DRAM_BLISS_THRESHOLD );
+	container->insertKnob( KNOB_DRAM_BLISS_CLEAR_INTERVAL );
+	container->insertKnob( KNOB_DRAM_WRITE_QUEUE_SIZE );
+	container->insertKnob( KNOB_DRAM_WRITE_HIGH_WATERMARK );
+	container->insertKnob( KNOB_DRAM_WRITE_LOW_WATERMARK );
+	container->insertKnob( KNOB_DRAM_TWTR );
 	container->insertKnob( KNOB_MEMORY_TYPE );
 	container->insertKnob( KNOB_MEM_MSHR_SIZE );
 	container->insertKnob( KNOB_MEM_QUEUE_SIZE );
@@ -1810,6 +1908,17 @@ void all_knobs_c::registerKnobs(KnobsContainer *container) {
 	container->insertKnob( KNOB_SHARED_MEM_PORTS );
 	container->insertKnob( KNOB_ENABLE_CACHE_COHERENCE );
 	container->insertKnob( KNOB_LLC_TYPE );
+	container->insertKnob( KNOB_L2_INCLUSION );
+	container->insertKnob( KNOB_L3_INCLUSION );
+	container->insertKnob( KNOB_L3_INCLUSION_QBS );
+	container->insertKnob( KNOB_INCLUSION_SAMPLE_INTERVAL );
+	container->insertKnob( KNOB_LLC_BDI_TAG_RATIO );
+	container->insertKnob( KNOB_LLC_BDI_SEGMENT_SIZE );
+	container->insertKnob( KNOB_LLC_BDI_DECOMP_LATENCY );
+	container->insertKnob( KNOB_LLC_BDI_VICTIM_WINDOW );
+	container->insertKnob( KNOB_LLC_BDI_DIST );
+	container->insertKnob( KNOB_LLC_BDI_PROFILE );
+	container->insertKnob( KNOB_LLC_BDI_PAGE_SIZE );
 	container->insertKnob( KNOB_COLLECT_CACHE_INFO );
 	container->insertKnob( KNOB_HETERO_STATIC_CACHE_PARTITION );
 	container->insertKnob( KNOB_HETERO_STATIC_CPU_PARTITION );
@@ -1830,6 +1939,7 @@ void all_knobs_c::registerKnobs(KnobsContainer *container) {
 	container->insertKnob( KNOB_PAGE_SIZE );
 	container->insertKnob( KNOB_REGION_SIZE );
 	container->insertKnob( KNOB_PAGE_MAPPING_POLICY );
+	container->insertKnob( KNOB_LLC_TAP_THRESHOLD );
 	
 
 	// =========== ../def/network.param.def ===========
@@ -1980,5 +2090,27 @@ void all_knobs_c::registerKnobs(KnobsContainer *container) {
 	container->insertKnob( KNOB_BUG_DETECTOR_ENABLE );
 	container->insertKnob( KNOB_COLLECT_CPI_INFO );
 	container->insertKnob( KNOB_COLLECT_CPI_INFO_FOR_MULTI_GPU );
+	container->insertKnob( KNOB_STAT_SAMPLE_CYCLES );
+	container->insertKnob( KNOB_STAT_SAMPLE_INSTS );
+	container->insertKnob( KNOB_STAT_SAMPLE_FILTER );
+	container->insertKnob( KNOB_STAT_SAMPLE_FILE );
+	container->insertKnob( KNOB_STAT_OUTPUT_FORMAT );
+	container->insertKnob( KNOB_MEM_LATENCY_HIST );
+	container->insertKnob( KNOB_PC_PROFILER_ENABLE );
+	container->insertKnob( KNOB_PC_PROFILER_SIZE );
+	container->insertKnob( KNOB_PC_PROFILER_INTERVAL );
+	container->insertKnob( KNOB_CPI_STACK_INTERVAL );
 }
 
+void all_knobs_c::freeze(sim_config_s *config) {
+	config->m_max_insts = KNOB_MAX_INSTS->getValue();
+	config->m_max_insts1 = KNOB_MAX_INSTS1->getValue();
+	config->m_sim_cycle_count = KNOB_SIM_CYCLE_COUNT->getValue();
+	config->m_compute_capability = KNOB_COMPUTE_CAPABILITY->getValue();
+	config->m_fermi = (KNOB_COMPUTE_CAPABILITY->getValue() == 2.0f);
+	config->m_ideal_noc = KNOB_IDEAL_NOC->getValue();
+	config->m_ideal_noc_latency = KNOB_IDEAL_NOC_LATENCY->getValue();
+	config->m_cache_use_pseudo_lru = KNOB_CACHE_USE_PSEUDO_LRU->getValue();
+	config->m_hetero_mem_priority_cpu = KNOB_HETERO_MEM_PRIORITY_CPU->getValue();
+	config->m_hetero_mem_priority_gpu = KNOB_HETERO_MEM_PRIORITY_GPU->getValue();
+}
@@ -6,6 +6,8 @@
 
 #define KNOB(var) m_simBase->m_knobs->var
 
+struct sim_config_s;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief knob variables holder
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -26,6 +28,11 @@ class all_knobs_c {
 		 */
 		void registerKnobs(KnobsContainer *container);
 
+		/**
+		 * Take a frozen snapshot of the knobs read in per-cycle code
+		 */
+		void freeze(sim_config_s *config);
+
 	public:
 		
 
@@ -381,6 +388,7 @@ class all_knobs_c {
 		KnobTemplate< bool >* KNOB_PREF_STREAM_ON_LARGE_CORE;
 		KnobTemplate< bool >* KNOB_PREF_THROTTLE_ON;
 		KnobTemplate< bool >* KNOB_PREF_THROTTLEFB_ON;
+		KnobTemplate< float >* KNOB_PREF_THROTTLE_BW_THRESH;
 		KnobTemplate< float >* KNOB_PREF_ACC_THRESH_4;
 		KnobTemplate< bool >* KNOB_PREF_ACCRATIOTHROTTLE;
 		KnobTemplate< float >* KNOB_PREF_ACCRATIO_1;
@@ -494,6 +502,23 @@ class all_knobs_c {
 		KnobTemplate< int >* KNOB_DRAM_NUM_MC;
 		KnobTemplate< int >* KNOB_DRAM_INTERLEAVE_FACTOR;
 		KnobTemplate< int >* KNOB_DRAM_ADDITIONAL_LATENCY;
+		KnobTemplate< string >* KNOB_DRAM_TIMING_SPEC;
+		KnobTemplate< int >* KNOB_DRAM_NUM_RANKS;
+		KnobTemplate< int >* KNOB_DRAM_NUM_BANK_GROUPS;
+		KnobTemplate< string >* KNOB_DRAM_PAGE_POLICY;
+		KnobTemplate< int >* KNOB_DRAM_NUM_APPLICATION;
+		KnobTemplate< int >* KNOB_DRAM_SCHED_QUANTUM;
+		KnobTemplate< int >* KNOB_DRAM_PARBS_MARKING_CAP;
+		KnobTemplate< int >* KNOB_DRAM_ATLAS_THRESHOLD;
+		KnobTemplate< float >* KNOB_DRAM_ATLAS_ALPHA;
+		KnobTemplate< float >* KNOB_DRAM_TCM_CLUSTER_THRESHOLD;
+		KnobTemplate< int >* KNOB_DRAM_TCM_SHUFFLE_INTERVAL;
+		KnobTemplate< int >* KNOB_DRAM_BLISS_THRESHOLD;
+		KnobTemplate< int >* KNOB_DRAM_BLISS_CLEAR_INTERVAL;
+		KnobTemplate< int >* KNOB_DRAM_WRITE_QUEUE_SIZE;
+		KnobTemplate< int >* KNOB_DRAM_WRITE_HIGH_WATERMARK;
+		KnobTemplate< int >* KNOB_DRAM_WRITE_LOW_WATERMARK;
+		KnobTemplate< int >* KNOB_DRAM_TWTR;
 		KnobTemplate< string >* KNOB_MEMORY_TYPE;
 		KnobTemplate< int >* KNOB_MEM_MSHR_SIZE;
 		KnobTemplate< int >* KNOB_MEM_QUEUE_SIZE;
@@ -525,6 +550,17 @@ class all_knobs_c {
 		KnobTemplate< uns >* KNOB_SHARED_MEM_PORTS;
 		KnobTemplate< bool >* KNOB_ENABLE_CACHE_COHERENCE;
 		KnobTemplate< string >* KNOB_LLC_TYPE;
+		KnobTemplate< string >* KNOB_L2_INCLUSION;
+		KnobTemplate< string >* KNOB_L3_INCLUSION;
+		KnobTemplate< uns >* KNOB_L3_INCLUSION_QBS;
+		KnobTemplate< uns >* KNOB_INCLUSION_SAMPLE_INTERVAL;
+		KnobTemplate< uns >* KNOB_LLC_BDI_TAG_RATIO;
+		KnobTemplate< uns >* KNOB_LLC_BDI_SEGMENT_SIZE;
+		KnobTemplate< uns >* KNOB_LLC_BDI_DECOMP_LATENCY;
+		KnobTemplate< uns >* KNOB_LLC_BDI_VICTIM_WINDOW;
+		KnobTemplate< string >* KNOB_LLC_BDI_DIST;
+		KnobTemplate< string >* KNOB_LLC_BDI_PROFILE;
+		KnobTemplate< uns >* KNOB_LLC_BDI_PAGE_SIZE;
 		KnobTemplate< int >* KNOB_COLLECT_CACHE_INFO;
 		KnobTemplate< bool >* KNOB_HETERO_STATIC_CACHE_PARTITION;
 		KnobTemplate< int >* KNOB_HETERO_STATIC_CPU_PARTITION;
@@ -545,6 +581,7 @@ class all_knobs_c {
 		KnobTemplate< int >* KNOB_PAGE_SIZE;
 		KnobTemplate< int >* KNOB_REGION_SIZE;
 		KnobTemplate< string >* KNOB_PAGE_MAPPING_POLICY;
+		KnobTemplate< int >* KNOB_LLC_TAP_THRESHOLD;
 		
 
 	// =========== ../def/network.param.def ===========
@@ -695,6 +732,37 @@ class all_knobs_c {
 		KnobTemplate< bool >* KNOB_BUG_DETECTOR_ENABLE;
 		KnobTemplate< int >* KNOB_COLLECT_CPI_INFO;
 		KnobTemplate< int >* KNOB_COLLECT_CPI_INFO_FOR_MULTI_GPU;
+		KnobTemplate< uns64 >* KNOB_STAT_SAMPLE_CYCLES;
+		KnobTemplate< uns64 >* KNOB_STAT_SAMPLE_INSTS;
+		KnobTemplate< string >* KNOB_STAT_SAMPLE_FILTER;
+		KnobTemplate< string >* KNOB_STAT_SAMPLE_FILE;
+		KnobTemplate< string >* KNOB_STAT_OUTPUT_FORMAT;
+		KnobTemplate< bool >* KNOB_MEM_LATENCY_HIST;
+		KnobTemplate< bool >* KNOB_PC_PROFILER_ENABLE;
+		KnobTemplate< uns >* KNOB_PC_PROFILER_SIZE;
+		KnobTemplate< uns64 >* KNOB_PC_PROFILER_INTERVAL;
+		KnobTemplate< uns64 >* KNOB_CPI_STACK_INTERVAL;
 
 };
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief frozen knob snapshot
+///
+/// Filled once by all_knobs_c::freeze() after the parameter file and the command line
+/// switches are applied. Per-cycle code reads plain fields from here (or caches them at
+/// construction) instead of going through the KnobTemplate objects.
+///////////////////////////////////////////////////////////////////////////////////////////////
+struct sim_config_s {
+	uns32 m_max_insts; /**< KNOB_MAX_INSTS */
+	uns64 m_max_insts1; /**< KNOB_MAX_INSTS1 */
+	uns32 m_sim_cycle_count; /**< KNOB_SIM_CYCLE_COUNT */
+	float m_compute_capability; /**< KNOB_COMPUTE_CAPABILITY */
+	bool  m_fermi; /**< KNOB_COMPUTE_CAPABILITY == 2.0 */
+	bool  m_ideal_noc; /**< KNOB_IDEAL_NOC */
+	int   m_ideal_noc_latency; /**< KNOB_IDEAL_NOC_LATENCY */
+	bool  m_cache_use_pseudo_lru; /**< KNOB_CACHE_USE_PSEUDO_LRU */
+	bool  m_hetero_mem_priority_cpu; /**< KNOB_HETERO_MEM_PRIORITY_CPU */
+	bool  m_hetero_mem_priority_gpu; /**< KNOB_HETERO_MEM_PRIORITY_GPU */
+};
 #endif //__ALL_KNOBS_H_INCLUDED__
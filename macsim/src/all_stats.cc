@@ -51,6 +51,45 @@ all_stats_c::all_stats_c(ProcessorStatistics* procStat) {
 	m_DRAM_PRECHARGE = new COUNT_Stat("DRAM_PRECHARGE", "dram.stat.out", DRAM_PRECHARGE);
 	m_DRAM_ACTIVATE = new COUNT_Stat("DRAM_ACTIVATE", "dram.stat.out", DRAM_ACTIVATE);
 	m_DRAM_COLUMN = new COUNT_Stat("DRAM_COLUMN", "dram.stat.out", DRAM_COLUMN);
+	m_DRAM_AUTO_PRECHARGE = new COUNT_Stat("DRAM_AUTO_PRECHARGE", "dram.stat.out", DRAM_AUTO_PRECHARGE);
+	m_DRAM_REFRESH = new COUNT_Stat("DRAM_REFRESH", "dram.stat.out", DRAM_REFRESH);
+	m_DRAM_TIMING_STALL = new COUNT_Stat("DRAM_TIMING_STALL", "dram.stat.out", DRAM_TIMING_STALL);
+	m_DRAM_WQ_INSERT = new COUNT_Stat("DRAM_WQ_INSERT", "dram.stat.out", DRAM_WQ_INSERT);
+	m_DRAM_WQ_COALESCED = new COUNT_Stat("DRAM_WQ_COALESCED", "dram.stat.out", DRAM_WQ_COALESCED);
+	m_DRAM_WQ_FULL = new COUNT_Stat("DRAM_WQ_FULL", "dram.stat.out", DRAM_WQ_FULL);
+	m_DRAM_WQ_DRAIN = new COUNT_Stat("DRAM_WQ_DRAIN", "dram.stat.out", DRAM_WQ_DRAIN);
+	m_DRAM_WQ_DRAIN_CYCLE = new COUNT_Stat("DRAM_WQ_DRAIN_CYCLE", "dram.stat.out", DRAM_WQ_DRAIN_CYCLE);
+	m_DRAM_WQ_DRAIN_WRITE = new COUNT_Stat("DRAM_WQ_DRAIN_WRITE", "dram.stat.out", DRAM_WQ_DRAIN_WRITE);
+	m_DRAM_WQ_IDLE_WRITE = new COUNT_Stat("DRAM_WQ_IDLE_WRITE", "dram.stat.out", DRAM_WQ_IDLE_WRITE);
+	m_DRAM_TURNAROUND_RD_TO_WR = new COUNT_Stat("DRAM_TURNAROUND_RD_TO_WR", "dram.stat.out", DRAM_TURNAROUND_RD_TO_WR);
+	m_DRAM_TURNAROUND_WR_TO_RD = new COUNT_Stat("DRAM_TURNAROUND_WR_TO_RD", "dram.stat.out", DRAM_TURNAROUND_WR_TO_RD);
+	m_DRAM_WTR_STALL = new COUNT_Stat("DRAM_WTR_STALL", "dram.stat.out", DRAM_WTR_STALL);
+	m_DRAM_READ_LATENCY_BASE = new COUNT_Stat("DRAM_READ_LATENCY_BASE", "dram.stat.out", DRAM_READ_LATENCY_BASE);
+	m_DRAM_READ_LATENCY = new RATIO_Stat("DRAM_READ_LATENCY",  "dram.stat.out", DRAM_READ_LATENCY, DRAM_READ_LATENCY_BASE, procStat);
+	m_DRAM_APP0_BANDWIDTH = new COUNT_Stat("DRAM_APP0_BANDWIDTH", "dram.stat.out", DRAM_APP0_BANDWIDTH);
+	m_DRAM_APP1_BANDWIDTH = new COUNT_Stat("DRAM_APP1_BANDWIDTH", "dram.stat.out", DRAM_APP1_BANDWIDTH);
+	m_DRAM_APP2_BANDWIDTH = new COUNT_Stat("DRAM_APP2_BANDWIDTH", "dram.stat.out", DRAM_APP2_BANDWIDTH);
+	m_DRAM_APP3_BANDWIDTH = new COUNT_Stat("DRAM_APP3_BANDWIDTH", "dram.stat.out", DRAM_APP3_BANDWIDTH);
+	m_DRAM_APP4_BANDWIDTH = new COUNT_Stat("DRAM_APP4_BANDWIDTH", "dram.stat.out", DRAM_APP4_BANDWIDTH);
+	m_DRAM_APP5_BANDWIDTH = new COUNT_Stat("DRAM_APP5_BANDWIDTH", "dram.stat.out", DRAM_APP5_BANDWIDTH);
+	m_DRAM_APP6_BANDWIDTH = new COUNT_Stat("DRAM_APP6_BANDWIDTH", "dram.stat.out", DRAM_APP6_BANDWIDTH);
+	m_DRAM_APP7_BANDWIDTH = new COUNT_Stat("DRAM_APP7_BANDWIDTH", "dram.stat.out", DRAM_APP7_BANDWIDTH);
+	m_DRAM_APP0_ALONE_LATENCY = new COUNT_Stat("DRAM_APP0_ALONE_LATENCY", "dram.stat.out", DRAM_APP0_ALONE_LATENCY);
+	m_DRAM_APP1_ALONE_LATENCY = new COUNT_Stat("DRAM_APP1_ALONE_LATENCY", "dram.stat.out", DRAM_APP1_ALONE_LATENCY);
+	m_DRAM_APP2_ALONE_LATENCY = new COUNT_Stat("DRAM_APP2_ALONE_LATENCY", "dram.stat.out", DRAM_APP2_ALONE_LATENCY);
+	m_DRAM_APP3_ALONE_LATENCY = new COUNT_Stat("DRAM_APP3_ALONE_LATENCY", "dram.stat.out", DRAM_APP3_ALONE_LATENCY);
+	m_DRAM_APP4_ALONE_LATENCY = new COUNT_Stat("DRAM_APP4_ALONE_LATENCY", "dram.stat.out", DRAM_APP4_ALONE_LATENCY);
+	m_DRAM_APP5_ALONE_LATENCY = new COUNT_Stat("DRAM_APP5_ALONE_LATENCY", "dram.stat.out", DRAM_APP5_ALONE_LATENCY);
+	m_DRAM_APP6_ALONE_LATENCY = new COUNT_Stat("DRAM_APP6_ALONE_LATENCY", "dram.stat.out", DRAM_APP6_ALONE_LATENCY);
+	m_DRAM_APP7_ALONE_LATENCY = new COUNT_Stat("DRAM_APP7_ALONE_LATENCY", "dram.stat.out", DRAM_APP7_ALONE_LATENCY);
+	m_DRAM_APP0_SLOWDOWN = new RATIO_Stat("DRAM_APP0_SLOWDOWN",  "dram.stat.out", DRAM_APP0_SLOWDOWN, DRAM_APP0_ALONE_LATENCY, procStat);
+	m_DRAM_APP1_SLOWDOWN = new RATIO_Stat("DRAM_APP1_SLOWDOWN",  "dram.stat.out", DRAM_APP1_SLOWDOWN, DRAM_APP1_ALONE_LATENCY, procStat);
+	m_DRAM_APP2_SLOWDOWN = new RATIO_Stat("DRAM_APP2_SLOWDOWN",  "dram.stat.out", DRAM_APP2_SLOWDOWN, DRAM_APP2_ALONE_LATENCY, procStat);
+	m_DRAM_APP3_SLOWDOWN = new RATIO_Stat("DRAM_APP3_SLOWDOWN",  "dram.stat.out", DRAM_APP3_SLOWDOWN, DRAM_APP3_ALONE_LATENCY, procStat);
+	m_DRAM_APP4_SLOWDOWN = new RATIO_Stat("DRAM_APP4_SLOWDOWN",  "dram.stat.out", DRAM_APP4_SLOWDOWN, DRAM_APP4_ALONE_LATENCY, procStat);
+	m_DRAM_APP5_SLOWDOWN = new RATIO_Stat("DRAM_APP5_SLOWDOWN",  "dram.stat.out", DRAM_APP5_SLOWDOWN, DRAM_APP5_ALONE_LATENCY, procStat);
+	m_DRAM_APP6_SLOWDOWN = new RATIO_Stat("DRAM_APP6_SLOWDOWN",  "dram.stat.out", DRAM_APP6_SLOWDOWN, DRAM_APP6_ALONE_LATENCY, procStat);
+	m_DRAM_APP7_SLOWDOWN = new RATIO_Stat("DRAM_APP7_SLOWDOWN",  "dram.stat.out", DRAM_APP7_SLOWDOWN, DRAM_APP7_ALONE_LATENCY, procStat);
 	m_DRAM_AVG_LATENCY_BASE = new COUNT_Stat("DRAM_AVG_LATENCY_BASE", "dram.stat.out", DRAM_AVG_LATENCY_BASE);
 	m_DRAM_AVG_LATENCY = new RATIO_Stat("DRAM_AVG_LATENCY",  "dram.stat.out", DRAM_AVG_LATENCY, DRAM_AVG_LATENCY_BASE, procStat);
 	m_BANDWIDTH_TOT = new COUNT_Stat("BANDWIDTH_TOT", "dram.stat.out", BANDWIDTH_TOT);
@@ -423,6 +462,42 @@ all_stats_c::all_stats_c(ProcessorStatistics* procStat) {
 	m_TOTAL_WRITE_ACKS = new COUNT_Stat("TOTAL_WRITE_ACKS", "memory.stat.out", TOTAL_WRITE_ACKS);
 	m_TOTAL_WRITES = new COUNT_Stat("TOTAL_WRITES", "memory.stat.out", TOTAL_WRITES);
 	m_NUM_PHYSICAL_PAGES = new COUNT_Stat("NUM_PHYSICAL_PAGES", "memory.stat.out", NUM_PHYSICAL_PAGES);
+	m_COH_INV_MSG = new COUNT_Stat("COH_INV_MSG", "memory.stat.out", COH_INV_MSG);
+	m_COH_FWD_MSG = new COUNT_Stat("COH_FWD_MSG", "memory.stat.out", COH_FWD_MSG);
+	m_COH_BACK_INV_MSG = new COUNT_Stat("COH_BACK_INV_MSG", "memory.stat.out", COH_BACK_INV_MSG);
+	m_COH_ACK_MSG = new COUNT_Stat("COH_ACK_MSG", "memory.stat.out", COH_ACK_MSG);
+	m_COH_DATA_MSG = new COUNT_Stat("COH_DATA_MSG", "memory.stat.out", COH_DATA_MSG);
+	m_COH_UPGRADE = new COUNT_Stat("COH_UPGRADE", "memory.stat.out", COH_UPGRADE);
+	m_COH_BLOCKED_REQ = new COUNT_Stat("COH_BLOCKED_REQ", "memory.stat.out", COH_BLOCKED_REQ);
+	m_COH_TXN_LATENCY_BASE = new COUNT_Stat("COH_TXN_LATENCY_BASE", "memory.stat.out", COH_TXN_LATENCY_BASE);
+	m_COH_TXN_LATENCY = new RATIO_Stat("COH_TXN_LATENCY",  "memory.stat.out", COH_TXN_LATENCY, COH_TXN_LATENCY_BASE, procStat);
+	m_L2_INCLUSION_VICTIM = new COUNT_Stat("L2_INCLUSION_VICTIM", "memory.stat.out", L2_INCLUSION_VICTIM);
+	m_L3_INCLUSION_VICTIM = new COUNT_Stat("L3_INCLUSION_VICTIM", "memory.stat.out", L3_INCLUSION_VICTIM);
+	m_L3_INCLUSION_QBS_QUERY = new COUNT_Stat("L3_INCLUSION_QBS_QUERY", "memory.stat.out", L3_INCLUSION_QBS_QUERY);
+	m_L3_INCLUSION_QBS_SKIP = new COUNT_Stat("L3_INCLUSION_QBS_SKIP", "memory.stat.out", L3_INCLUSION_QBS_SKIP);
+	m_L3_EXCLUSIVE_MOVE = new COUNT_Stat("L3_EXCLUSIVE_MOVE", "memory.stat.out", L3_EXCLUSIVE_MOVE);
+	m_L3_EXCLUSIVE_CLEAN_VICTIM = new COUNT_Stat("L3_EXCLUSIVE_CLEAN_VICTIM", "memory.stat.out", L3_EXCLUSIVE_CLEAN_VICTIM);
+	m_CACHE_CAPACITY_SAMPLE = new COUNT_Stat("CACHE_CAPACITY_SAMPLE", "memory.stat.out", CACHE_CAPACITY_SAMPLE);
+	m_CACHE_PRIVATE_LINES = new RATIO_Stat("CACHE_PRIVATE_LINES",  "memory.stat.out", CACHE_PRIVATE_LINES, CACHE_CAPACITY_SAMPLE, procStat);
+	m_CACHE_LLC_LINES = new RATIO_Stat("CACHE_LLC_LINES",  "memory.stat.out", CACHE_LLC_LINES, CACHE_CAPACITY_SAMPLE, procStat);
+	m_CACHE_DUPLICATE_LINES = new RATIO_Stat("CACHE_DUPLICATE_LINES",  "memory.stat.out", CACHE_DUPLICATE_LINES, CACHE_CAPACITY_SAMPLE, procStat);
+	m_CACHE_EFFECTIVE_LINES = new RATIO_Stat("CACHE_EFFECTIVE_LINES",  "memory.stat.out", CACHE_EFFECTIVE_LINES, CACHE_CAPACITY_SAMPLE, procStat);
+	m_LLC_BDI_INSERT = new COUNT_Stat("LLC_BDI_INSERT", "memory.stat.out", LLC_BDI_INSERT);
+	m_LLC_BDI_ENC_ZEROS = new COUNT_Stat("LLC_BDI_ENC_ZEROS", "memory.stat.out", LLC_BDI_ENC_ZEROS);
+	m_LLC_BDI_ENC_REPEAT = new COUNT_Stat("LLC_BDI_ENC_REPEAT", "memory.stat.out", LLC_BDI_ENC_REPEAT);
+	m_LLC_BDI_ENC_B8D1 = new COUNT_Stat("LLC_BDI_ENC_B8D1", "memory.stat.out", LLC_BDI_ENC_B8D1);
+	m_LLC_BDI_ENC_B8D2 = new COUNT_Stat("LLC_BDI_ENC_B8D2", "memory.stat.out", LLC_BDI_ENC_B8D2);
+	m_LLC_BDI_ENC_B8D4 = new COUNT_Stat("LLC_BDI_ENC_B8D4", "memory.stat.out", LLC_BDI_ENC_B8D4);
+	m_LLC_BDI_ENC_B4D1 = new COUNT_Stat("LLC_BDI_ENC_B4D1", "memory.stat.out", LLC_BDI_ENC_B4D1);
+	m_LLC_BDI_ENC_B4D2 = new COUNT_Stat("LLC_BDI_ENC_B4D2", "memory.stat.out", LLC_BDI_ENC_B4D2);
+	m_LLC_BDI_ENC_B2D1 = new COUNT_Stat("LLC_BDI_ENC_B2D1", "memory.stat.out", LLC_BDI_ENC_B2D1);
+	m_LLC_BDI_ENC_NONE = new COUNT_Stat("LLC_BDI_ENC_NONE", "memory.stat.out", LLC_BDI_ENC_NONE);
+	m_LLC_BDI_SEGMENTS = new COUNT_Stat("LLC_BDI_SEGMENTS", "memory.stat.out", LLC_BDI_SEGMENTS);
+	m_LLC_BDI_COMPRESSION_RATIO = new RATIO_Stat("LLC_BDI_COMPRESSION_RATIO",  "memory.stat.out", LLC_BDI_COMPRESSION_RATIO, LLC_BDI_SEGMENTS, procStat);
+	m_LLC_BDI_SET_LINES = new RATIO_Stat("LLC_BDI_SET_LINES",  "memory.stat.out", LLC_BDI_SET_LINES, LLC_BDI_INSERT, procStat);
+	m_LLC_BDI_MULTI_EVICT = new COUNT_Stat("LLC_BDI_MULTI_EVICT", "memory.stat.out", LLC_BDI_MULTI_EVICT);
+	m_LLC_BDI_COMPACT_VICTIM = new COUNT_Stat("LLC_BDI_COMPACT_VICTIM", "memory.stat.out", LLC_BDI_COMPACT_VICTIM);
+	m_LLC_BDI_DECOMPRESS = new COUNT_Stat("LLC_BDI_DECOMPRESS", "memory.stat.out", LLC_BDI_DECOMPRESS);
 	
 	// ============= ../def/network.stat.def =============
 	m_TOTAL_PACKET_CPU = new COUNT_Stat("TOTAL_PACKET_CPU", "network.stat.out", TOTAL_PACKET_CPU);
@@ -656,6 +731,7 @@ all_stats_c::all_stats_c(ProcessorStatistics* procStat) {
 	m_PREF_REGION_EVICT = new COUNT_Stat("PREF_REGION_EVICT", "pref.stat.out", PREF_REGION_EVICT);
 	m_PREF_PHASE_OVERWRITE_PAGE = new COUNT_Stat("PREF_PHASE_OVERWRITE_PAGE", "pref.stat.out", PREF_PHASE_OVERWRITE_PAGE);
 	m_PREF_UPDATE_COUNT = new COUNT_Stat("PREF_UPDATE_COUNT", "pref.stat.out", PREF_UPDATE_COUNT);
+	m_PREF_GLOBAL_THROTTLE = new COUNT_Stat("PREF_GLOBAL_THROTTLE", "pref.stat.out", PREF_GLOBAL_THROTTLE);
 	m_DIST_PREF_HYBRID_SEL_0 = new DIST_Stat("PREF_HYBRID_SEL_0", "pref.stat.out", PREF_HYBRID_SEL_0, procStat);
 	m_PREF_HYBRID_SEL_0 = (COUNT_Stat*) new DISTMember_Stat("PREF_HYBRID_SEL_0", "pref.stat.out", PREF_HYBRID_SEL_0, PREF_HYBRID_SEL_0);
 	m_PREF_HYBRID_SEL_1 = (COUNT_Stat*) new DISTMember_Stat("PREF_HYBRID_SEL_1", "pref.stat.out", PREF_HYBRID_SEL_1, PREF_HYBRID_SEL_0);
@@ -664,6 +740,43 @@ all_stats_c::all_stats_c(ProcessorStatistics* procStat) {
 	m_PREF_HYBRID_SEL_4 = (COUNT_Stat*) new DISTMember_Stat("PREF_HYBRID_SEL_4", "pref.stat.out", PREF_HYBRID_SEL_4, PREF_HYBRID_SEL_0);
 	m_PREF_HYBRID_SEL_5 = (COUNT_Stat*) new DISTMember_Stat("PREF_HYBRID_SEL_5", "pref.stat.out", PREF_HYBRID_SEL_5, PREF_HYBRID_SEL_0);
 	m_PREF_HYBRID_SEL_6 = (COUNT_Stat*) new DISTMember_Stat("PREF_HYBRID_SEL_6", "pref.stat.out", PREF_HYBRID_SEL_6, PREF_HYBRID_SEL_0);
+	m_PREF_POTENTIAL_MISS = new COUNT_Stat("PREF_POTENTIAL_MISS", "pref.stat.out", PREF_POTENTIAL_MISS);
+	m_PREF_STRIDE_SENT = new COUNT_Stat("PREF_STRIDE_SENT", "pref.stat.out", PREF_STRIDE_SENT);
+	m_PREF_STRIDEPC_SENT = new COUNT_Stat("PREF_STRIDEPC_SENT", "pref.stat.out", PREF_STRIDEPC_SENT);
+	m_PREF_STREAM_SENT = new COUNT_Stat("PREF_STREAM_SENT", "pref.stat.out", PREF_STREAM_SENT);
+	m_PREF_GHB_SENT = new COUNT_Stat("PREF_GHB_SENT", "pref.stat.out", PREF_GHB_SENT);
+	m_PREF_2DC_SENT = new COUNT_Stat("PREF_2DC_SENT", "pref.stat.out", PREF_2DC_SENT);
+	m_PREF_PHASE_SENT = new COUNT_Stat("PREF_PHASE_SENT", "pref.stat.out", PREF_PHASE_SENT);
+	m_PREF_STRIDE_USEFUL = new COUNT_Stat("PREF_STRIDE_USEFUL", "pref.stat.out", PREF_STRIDE_USEFUL);
+	m_PREF_STRIDEPC_USEFUL = new COUNT_Stat("PREF_STRIDEPC_USEFUL", "pref.stat.out", PREF_STRIDEPC_USEFUL);
+	m_PREF_STREAM_USEFUL = new COUNT_Stat("PREF_STREAM_USEFUL", "pref.stat.out", PREF_STREAM_USEFUL);
+	m_PREF_GHB_USEFUL = new COUNT_Stat("PREF_GHB_USEFUL", "pref.stat.out", PREF_GHB_USEFUL);
+	m_PREF_2DC_USEFUL = new COUNT_Stat("PREF_2DC_USEFUL", "pref.stat.out", PREF_2DC_USEFUL);
+	m_PREF_PHASE_USEFUL = new COUNT_Stat("PREF_PHASE_USEFUL", "pref.stat.out", PREF_PHASE_USEFUL);
+	m_PREF_STRIDE_LATE = new COUNT_Stat("PREF_STRIDE_LATE", "pref.stat.out", PREF_STRIDE_LATE);
+	m_PREF_STRIDEPC_LATE = new COUNT_Stat("PREF_STRIDEPC_LATE", "pref.stat.out", PREF_STRIDEPC_LATE);
+	m_PREF_STREAM_LATE = new COUNT_Stat("PREF_STREAM_LATE", "pref.stat.out", PREF_STREAM_LATE);
+	m_PREF_GHB_LATE = new COUNT_Stat("PREF_GHB_LATE", "pref.stat.out", PREF_GHB_LATE);
+	m_PREF_2DC_LATE = new COUNT_Stat("PREF_2DC_LATE", "pref.stat.out", PREF_2DC_LATE);
+	m_PREF_PHASE_LATE = new COUNT_Stat("PREF_PHASE_LATE", "pref.stat.out", PREF_PHASE_LATE);
+	m_PREF_STRIDE_ACCURACY = new RATIO_Stat("PREF_STRIDE_ACCURACY",  "pref.stat.out", PREF_STRIDE_ACCURACY, PREF_STRIDE_SENT, procStat);
+	m_PREF_STRIDEPC_ACCURACY = new RATIO_Stat("PREF_STRIDEPC_ACCURACY",  "pref.stat.out", PREF_STRIDEPC_ACCURACY, PREF_STRIDEPC_SENT, procStat);
+	m_PREF_STREAM_ACCURACY = new RATIO_Stat("PREF_STREAM_ACCURACY",  "pref.stat.out", PREF_STREAM_ACCURACY, PREF_STREAM_SENT, procStat);
+	m_PREF_GHB_ACCURACY = new RATIO_Stat("PREF_GHB_ACCURACY",  "pref.stat.out", PREF_GHB_ACCURACY, PREF_GHB_SENT, procStat);
+	m_PREF_2DC_ACCURACY = new RATIO_Stat("PREF_2DC_ACCURACY",  "pref.stat.out", PREF_2DC_ACCURACY, PREF_2DC_SENT, procStat);
+	m_PREF_PHASE_ACCURACY = new RATIO_Stat("PREF_PHASE_ACCURACY",  "pref.stat.out", PREF_PHASE_ACCURACY, PREF_PHASE_SENT, procStat);
+	m_PREF_STRIDE_COVERAGE = new RATIO_Stat("PREF_STRIDE_COVERAGE",  "pref.stat.out", PREF_STRIDE_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_STRIDEPC_COVERAGE = new RATIO_Stat("PREF_STRIDEPC_COVERAGE",  "pref.stat.out", PREF_STRIDEPC_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_STREAM_COVERAGE = new RATIO_Stat("PREF_STREAM_COVERAGE",  "pref.stat.out", PREF_STREAM_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_GHB_COVERAGE = new RATIO_Stat("PREF_GHB_COVERAGE",  "pref.stat.out", PREF_GHB_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_2DC_COVERAGE = new RATIO_Stat("PREF_2DC_COVERAGE",  "pref.stat.out", PREF_2DC_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_PHASE_COVERAGE = new RATIO_Stat("PREF_PHASE_COVERAGE",  "pref.stat.out", PREF_PHASE_COVERAGE, PREF_POTENTIAL_MISS, procStat);
+	m_PREF_STRIDE_TIMELINESS = new RATIO_Stat("PREF_STRIDE_TIMELINESS",  "pref.stat.out", PREF_STRIDE_TIMELINESS, PREF_STRIDE_USEFUL, procStat);
+	m_PREF_STRIDEPC_TIMELINESS = new RATIO_Stat("PREF_STRIDEPC_TIMELINESS",  "pref.stat.out", PREF_STRIDEPC_TIMELINESS, PREF_STRIDEPC_USEFUL, procStat);
+	m_PREF_STREAM_TIMELINESS = new RATIO_Stat("PREF_STREAM_TIMELINESS",  "pref.stat.out", PREF_STREAM_TIMELINESS, PREF_STREAM_USEFUL, procStat);
+	m_PREF_GHB_TIMELINESS = new RATIO_Stat("PREF_GHB_TIMELINESS",  "pref.stat.out", PREF_GHB_TIMELINESS, PREF_GHB_USEFUL, procStat);
+	m_PREF_2DC_TIMELINESS = new RATIO_Stat("PREF_2DC_TIMELINESS",  "pref.stat.out", PREF_2DC_TIMELINESS, PREF_2DC_USEFUL, procStat);
+	m_PREF_PHASE_TIMELINESS = new RATIO_Stat("PREF_PHASE_TIMELINESS",  "pref.stat.out", PREF_PHASE_TIMELINESS, PREF_PHASE_USEFUL, procStat);
 	
 	// ============= ../def/stream.stat.def =============
 	m_DCACHE_PREF_HIT = new COUNT_Stat("DCACHE_PREF_HIT", "stream.stat.out", DCACHE_PREF_HIT);
@@ -795,6 +908,45 @@ all_stats_c::~all_stats_c() {
 	delete m_DRAM_PRECHARGE;
 	delete m_DRAM_ACTIVATE;
 	delete m_DRAM_COLUMN;
+	delete m_DRAM_AUTO_PRECHARGE;
+	delete m_DRAM_REFRESH;
+	delete m_DRAM_TIMING_STALL;
+	delete m_DRAM_WQ_INSERT;
+	delete m_DRAM_WQ_COALESCED;
+	delete m_DRAM_WQ_FULL;
+	delete m_DRAM_WQ_DRAIN;
+	delete m_DRAM_WQ_DRAIN_CYCLE;
+	delete m_DRAM_WQ_DRAIN_WRITE;
+	delete m_DRAM_WQ_IDLE_WRITE;
+	delete m_DRAM_TURNAROUND_RD_TO_WR;
+	delete m_DRAM_TURNAROUND_WR_TO_RD;
+	delete m_DRAM_WTR_STALL;
+	delete m_DRAM_READ_LATENCY_BASE;
+	delete m_DRAM_READ_LATENCY;
+	delete m_DRAM_APP0_BANDWIDTH;
+	delete m_DRAM_APP1_BANDWIDTH;
+	delete m_DRAM_APP2_BANDWIDTH;
+	delete m_DRAM_APP3_BANDWIDTH;
+	delete m_DRAM_APP4_BANDWIDTH;
+	delete m_DRAM_APP5_BANDWIDTH;
+	delete m_DRAM_APP6_BANDWIDTH;
+	delete m_DRAM_APP7_BANDWIDTH;
+	delete m_DRAM_APP0_ALONE_LATENCY;
+	delete m_DRAM_APP1_ALONE_LATENCY;
+	delete m_DRAM_APP2_ALONE_LATENCY;
+	delete m_DRAM_APP3_ALONE_LATENCY;
+	delete m_DRAM_APP4_ALONE_LATENCY;
+	delete m_DRAM_APP5_ALONE_LATENCY;
+	delete m_DRAM_APP6_ALONE_LATENCY;
+	delete m_DRAM_APP7_ALONE_LATENCY;
+	delete m_DRAM_APP0_SLOWDOWN;
+	delete m_DRAM_APP1_SLOWDOWN;
+	delete m_DRAM_APP2_SLOWDOWN;
+	delete m_DRAM_APP3_SLOWDOWN;
+	delete m_DRAM_APP4_SLOWDOWN;
+	delete m_DRAM_APP5_SLOWDOWN;
+	delete m_DRAM_APP6_SLOWDOWN;
+	delete m_DRAM_APP7_SLOWDOWN;
 	delete m_DRAM_AVG_LATENCY_BASE;
 	delete m_DRAM_AVG_LATENCY;
 	delete m_BANDWIDTH_TOT;
@@ -1159,6 +1311,42 @@ all_stats_c::~all_stats_c() {
 	delete m_TOTAL_WRITE_ACKS;
 	delete m_TOTAL_WRITES;
 	delete m_NUM_PHYSICAL_PAGES;
+	delete m_COH_INV_MSG;
+	delete m_COH_FWD_MSG;
+	delete m_COH_BACK_INV_MSG;
+	delete m_COH_ACK_MSG;
+	delete m_COH_DATA_MSG;
+	delete m_COH_UPGRADE;
+	delete m_COH_BLOCKED_REQ;
+	delete m_COH_TXN_LATENCY_BASE;
+	delete m_COH_TXN_LATENCY;
+	delete m_L2_INCLUSION_VICTIM;
+	delete m_L3_INCLUSION_VICTIM;
+	delete m_L3_INCLUSION_QBS_QUERY;
+	delete m_L3_INCLUSION_QBS_SKIP;
+	delete m_L3_EXCLUSIVE_MOVE;
+	delete m_L3_EXCLUSIVE_CLEAN_VICTIM;
+	delete m_CACHE_CAPACITY_SAMPLE;
+	delete m_CACHE_PRIVATE_LINES;
+	delete m_CACHE_LLC_LINES;
+	delete m_CACHE_DUPLICATE_LINES;
+	delete m_CACHE_EFFECTIVE_LINES;
+	delete m_LLC_BDI_INSERT;
+	delete m_LLC_BDI_ENC_ZEROS;
+	delete m_LLC_BDI_ENC_REPEAT;
+	delete m_LLC_BDI_ENC_B8D1;
+	delete m_LLC_BDI_ENC_B8D2;
+	delete m_LLC_BDI_ENC_B8D4;
+	delete m_LLC_BDI_ENC_B4D1;
+	delete m_LLC_BDI_ENC_B4D2;
+	delete m_LLC_BDI_ENC_B2D1;
+	delete m_LLC_BDI_ENC_NONE;
+	delete m_LLC_BDI_SEGMENTS;
+	delete m_LLC_BDI_COMPRESSION_RATIO;
+	delete m_LLC_BDI_SET_LINES;
+	delete m_LLC_BDI_MULTI_EVICT;
+	delete m_LLC_BDI_COMPACT_VICTIM;
+	delete m_LLC_BDI_DECOMPRESS;
 	delete m_TOTAL_PACKET_CPU;
 	delete m_TOTAL_PACKET_GPU;
 	delete m_NOC_AVG_LATENCY_BASE;
@@ -1386,6 +1574,7 @@ all_stats_c::~all_stats_c() {
 	delete m_PREF_REGION_EVICT;
 	delete m_PREF_PHASE_OVERWRITE_PAGE;
 	delete m_PREF_UPDATE_COUNT;
+	delete m_PREF_GLOBAL_THROTTLE;
 	delete m_DIST_PREF_HYBRID_SEL_0;
 	delete m_PREF_HYBRID_SEL_0;
 	delete m_PREF_HYBRID_SEL_1;
@@ -1394,6 +1583,43 @@ all_stats_c::~all_stats_c() {
 	delete m_PREF_HYBRID_SEL_4;
 	delete m_PREF_HYBRID_SEL_5;
 	delete m_PREF_HYBRID_SEL_6;
+	delete m_PREF_POTENTIAL_MISS;
+	delete m_PREF_STRIDE_SENT;
+	delete m_PREF_STRIDEPC_SENT;
+	delete m_PREF_STREAM_SENT;
+	delete m_PREF_GHB_SENT;
+	delete m_PREF_2DC_SENT;
+	delete m_PREF_PHASE_SENT;
+	delete m_PREF_STRIDE_USEFUL;
+	delete m_PREF_STRIDEPC_USEFUL;
+	delete m_PREF_STREAM_USEFUL;
+	delete m_PREF_GHB_USEFUL;
+	delete m_PREF_2DC_USEFUL;
+	delete m_PREF_PHASE_USEFUL;
+	delete m_PREF_STRIDE_LATE;
+	delete m_PREF_STRIDEPC_LATE;
+	delete m_PREF_STREAM_LATE;
+	delete m_PREF_GHB_LATE;
+	delete m_PREF_2DC_LATE;
+	delete m_PREF_PHASE_LATE;
+	delete m_PREF_STRIDE_ACCURACY;
+	delete m_PREF_STRIDEPC_ACCURACY;
+	delete m_PREF_STREAM_ACCURACY;
+	delete m_PREF_GHB_ACCURACY;
+	delete m_PREF_2DC_ACCURACY;
+	delete m_PREF_PHASE_ACCURACY;
+	delete m_PREF_STRIDE_COVERAGE;
+	delete m_PREF_STRIDEPC_COVERAGE;
+	delete m_PREF_STREAM_COVERAGE;
+	delete m_PREF_GHB_COVERAGE;
+	delete m_PREF_2DC_COVERAGE;
+	delete m_PREF_PHASE_COVERAGE;
+	delete m_PREF_STRIDE_TIMELINESS;
+	delete m_PREF_STRIDEPC_TIMELINESS;
+	delete m_PREF_STREAM_TIMELINESS;
+	delete m_PREF_GHB_TIMELINESS;
+	delete m_PREF_2DC_TIMELINESS;
+	delete m_PREF_PHASE_TIMELINESS;
 	delete m_DCACHE_PREF_HIT;
 	delete m_DIST_IFETCH_WB_FIRST_SCHEDULE;
 	delete m_IFETCH_WB_FIRST_SCHEDULE;
@@ -1490,6 +1716,45 @@ void all_stats_c::initialize(ProcessorStatistics* m_ProcessorStats, CoreStatisti
 	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_PRECHARGE);
 	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_ACTIVATE);
 	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_COLUMN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_AUTO_PRECHARGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_REFRESH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_TIMING_STALL);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_INSERT);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_COALESCED);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_FULL);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_DRAIN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_DRAIN_CYCLE);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_DRAIN_WRITE);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WQ_IDLE_WRITE);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_TURNAROUND_RD_TO_WR);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_TURNAROUND_WR_TO_RD);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_WTR_STALL);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_READ_LATENCY_BASE);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_READ_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP0_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP1_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP2_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP3_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP4_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP5_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP6_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP7_BANDWIDTH);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP0_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP1_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP2_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP3_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP4_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP5_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP6_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP7_ALONE_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP0_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP1_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP2_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP3_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP4_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP5_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP6_SLOWDOWN);
+	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_APP7_SLOWDOWN);
 	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_AVG_LATENCY_BASE);
 	m_ProcessorStats->globalStats()->addStatistic(m_DRAM_AVG_LATENCY);
 	m_ProcessorStats->globalStats()->addStatistic(m_BANDWIDTH_TOT);
@@ -1620,6 +1885,42 @@ void all_stats_c::initialize(ProcessorStatistics* m_ProcessorStats, CoreStatisti
 	m_ProcessorStats->globalStats()->addStatistic(m_TOTAL_WRITE_ACKS);
 	m_ProcessorStats->globalStats()->addStatistic(m_TOTAL_WRITES);
 	m_ProcessorStats->globalStats()->addStatistic(m_NUM_PHYSICAL_PAGES);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_INV_MSG);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_FWD_MSG);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_BACK_INV_MSG);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_ACK_MSG);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_DATA_MSG);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_UPGRADE);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_BLOCKED_REQ);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_TXN_LATENCY_BASE);
+	m_ProcessorStats->globalStats()->addStatistic(m_COH_TXN_LATENCY);
+	m_ProcessorStats->globalStats()->addStatistic(m_L2_INCLUSION_VICTIM);
+	m_ProcessorStats->globalStats()->addStatistic(m_L3_INCLUSION_VICTIM);
+	m_ProcessorStats->globalStats()->addStatistic(m_L3_INCLUSION_QBS_QUERY);
+	m_ProcessorStats->globalStats()->addStatistic(m_L3_INCLUSION_QBS_SKIP);
+	m_ProcessorStats->globalStats()->addStatistic(m_L3_EXCLUSIVE_MOVE);
+	m_ProcessorStats->globalStats()->addStatistic(m_L3_EXCLUSIVE_CLEAN_VICTIM);
+	m_ProcessorStats->globalStats()->addStatistic(m_CACHE_CAPACITY_SAMPLE);
+	m_ProcessorStats->globalStats()->addStatistic(m_CACHE_PRIVATE_LINES);
+	m_ProcessorStats->globalStats()->addStatistic(m_CACHE_LLC_LINES);
+	m_ProcessorStats->globalStats()->addStatistic(m_CACHE_DUPLICATE_LINES);
+	m_ProcessorStats->globalStats()->addStatistic(m_CACHE_EFFECTIVE_LINES);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_INSERT);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_ZEROS);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_REPEAT);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B8D1);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B8D2);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B8D4);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B4D1);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B4D2);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_B2D1);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_ENC_NONE);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_SEGMENTS);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_COMPRESSION_RATIO);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_SET_LINES);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_MULTI_EVICT);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_COMPACT_VICTIM);
+	m_ProcessorStats->globalStats()->addStatistic(m_LLC_BDI_DECOMPRESS);
 	m_ProcessorStats->globalStats()->addStatistic(m_TOTAL_PACKET_CPU);
 	m_ProcessorStats->globalStats()->addStatistic(m_TOTAL_PACKET_GPU);
 	m_ProcessorStats->globalStats()->addStatistic(m_NOC_AVG_LATENCY_BASE);
@@ -1727,6 +2028,7 @@ void all_stats_c::initialize(ProcessorStatistics* m_ProcessorStats, CoreStatisti
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_REGION_EVICT);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_OVERWRITE_PAGE);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_UPDATE_COUNT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GLOBAL_THROTTLE);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_0);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_1);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_2);
@@ -1734,6 +2036,43 @@ void all_stats_c::initialize(ProcessorStatistics* m_ProcessorStats, CoreStatisti
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_4);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_5);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREF_HYBRID_SEL_6);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_POTENTIAL_MISS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_SENT);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_USEFUL);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_LATE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_ACCURACY);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_COVERAGE);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDE_TIMELINESS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STRIDEPC_TIMELINESS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_STREAM_TIMELINESS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_GHB_TIMELINESS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_2DC_TIMELINESS);
+	m_ProcessorStats->globalStats()->addStatistic(m_PREF_PHASE_TIMELINESS);
 	m_ProcessorStats->globalStats()->addStatistic(m_DCACHE_PREF_HIT);
 	m_ProcessorStats->globalStats()->addStatistic(m_IFETCH_WB_FIRST_SCHEDULE);
 	m_ProcessorStats->globalStats()->addStatistic(m_PREFETCH_LAST_SCHEDULE);
@@ -71,6 +71,45 @@ class all_stats_c {
 		COUNT_Stat* m_DRAM_PRECHARGE;
 		COUNT_Stat* m_DRAM_ACTIVATE;
 		COUNT_Stat* m_DRAM_COLUMN;
+		COUNT_Stat* m_DRAM_AUTO_PRECHARGE;
+		COUNT_Stat* m_DRAM_REFRESH;
+		COUNT_Stat* m_DRAM_TIMING_STALL;
+		COUNT_Stat* m_DRAM_WQ_INSERT;
+		COUNT_Stat* m_DRAM_WQ_COALESCED;
+		COUNT_Stat* m_DRAM_WQ_FULL;
+		COUNT_Stat* m_DRAM_WQ_DRAIN;
+		COUNT_Stat* m_DRAM_WQ_DRAIN_CYCLE;
+		COUNT_Stat* m_DRAM_WQ_DRAIN_WRITE;
+		COUNT_Stat* m_DRAM_WQ_IDLE_WRITE;
+		COUNT_Stat* m_DRAM_TURNAROUND_RD_TO_WR;
+		COUNT_Stat* m_DRAM_TURNAROUND_WR_TO_RD;
+		COUNT_Stat* m_DRAM_WTR_STALL;
+		COUNT_Stat* m_DRAM_READ_LATENCY_BASE;
+		RATIO_Stat* m_DRAM_READ_LATENCY;
+		COUNT_Stat* m_DRAM_APP0_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP1_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP2_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP3_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP4_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP5_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP6_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP7_BANDWIDTH;
+		COUNT_Stat* m_DRAM_APP0_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP1_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP2_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP3_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP4_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP5_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP6_ALONE_LATENCY;
+		COUNT_Stat* m_DRAM_APP7_ALONE_LATENCY;
+		RATIO_Stat* m_DRAM_APP0_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP1_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP2_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP3_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP4_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP5_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP6_SLOWDOWN;
+		RATIO_Stat* m_DRAM_APP7_SLOWDOWN;
 		COUNT_Stat* m_DRAM_AVG_LATENCY_BASE;
 		RATIO_Stat* m_DRAM_AVG_LATENCY;
 		COUNT_Stat* m_BANDWIDTH_TOT;
@@ -443,6 +482,42 @@ class all_stats_c {
 		COUNT_Stat* m_TOTAL_WRITE_ACKS;
 		COUNT_Stat* m_TOTAL_WRITES;
 		COUNT_Stat* m_NUM_PHYSICAL_PAGES;
+		COUNT_Stat* m_COH_INV_MSG;
+		COUNT_Stat* m_COH_FWD_MSG;
+		COUNT_Stat* m_COH_BACK_INV_MSG;
+		COUNT_Stat* m_COH_ACK_MSG;
+		COUNT_Stat* m_COH_DATA_MSG;
+		COUNT_Stat* m_COH_UPGRADE;
+		COUNT_Stat* m_COH_BLOCKED_REQ;
+		COUNT_Stat* m_COH_TXN_LATENCY_BASE;
+		RATIO_Stat* m_COH_TXN_LATENCY;
+		COUNT_Stat* m_L2_INCLUSION_VICTIM;
+		COUNT_Stat* m_L3_INCLUSION_VICTIM;
+		COUNT_Stat* m_L3_INCLUSION_QBS_QUERY;
+		COUNT_Stat* m_L3_INCLUSION_QBS_SKIP;
+		COUNT_Stat* m_L3_EXCLUSIVE_MOVE;
+		COUNT_Stat* m_L3_EXCLUSIVE_CLEAN_VICTIM;
+		COUNT_Stat* m_CACHE_CAPACITY_SAMPLE;
+		RATIO_Stat* m_CACHE_PRIVATE_LINES;
+		RATIO_Stat* m_CACHE_LLC_LINES;
+		RATIO_Stat* m_CACHE_DUPLICATE_LINES;
+		RATIO_Stat* m_CACHE_EFFECTIVE_LINES;
+		COUNT_Stat* m_LLC_BDI_INSERT;
+		COUNT_Stat* m_LLC_BDI_ENC_ZEROS;
+		COUNT_Stat* m_LLC_BDI_ENC_REPEAT;
+		COUNT_Stat* m_LLC_BDI_ENC_B8D1;
+		COUNT_Stat* m_LLC_BDI_ENC_B8D2;
+		COUNT_Stat* m_LLC_BDI_ENC_B8D4;
+		COUNT_Stat* m_LLC_BDI_ENC_B4D1;
+		COUNT_Stat* m_LLC_BDI_ENC_B4D2;
+		COUNT_Stat* m_LLC_BDI_ENC_B2D1;
+		COUNT_Stat* m_LLC_BDI_ENC_NONE;
+		COUNT_Stat* m_LLC_BDI_SEGMENTS;
+		RATIO_Stat* m_LLC_BDI_COMPRESSION_RATIO;
+		RATIO_Stat* m_LLC_BDI_SET_LINES;
+		COUNT_Stat* m_LLC_BDI_MULTI_EVICT;
+		COUNT_Stat* m_LLC_BDI_COMPACT_VICTIM;
+		COUNT_Stat* m_LLC_BDI_DECOMPRESS;
 		
 		// ============= ../def/network.stat.def =============
 		COUNT_Stat* m_TOTAL_PACKET_CPU;
@@ -676,6 +751,7 @@ class all_stats_c {
 		COUNT_Stat* m_PREF_REGION_EVICT;
 		COUNT_Stat* m_PREF_PHASE_OVERWRITE_PAGE;
 		COUNT_Stat* m_PREF_UPDATE_COUNT;
+		COUNT_Stat* m_PREF_GLOBAL_THROTTLE;
 		DIST_Stat* m_DIST_PREF_HYBRID_SEL_0;
 		COUNT_Stat* m_PREF_HYBRID_SEL_0;
 		COUNT_Stat* m_PREF_HYBRID_SEL_1;
@@ -684,6 +760,43 @@ class all_stats_c {
 		COUNT_Stat* m_PREF_HYBRID_SEL_4;
 		COUNT_Stat* m_PREF_HYBRID_SEL_5;
 		COUNT_Stat* m_PREF_HYBRID_SEL_6;
+		COUNT_Stat* m_PREF_POTENTIAL_MISS;
+		COUNT_Stat* m_PREF_STRIDE_SENT;
+		COUNT_Stat* m_PREF_STRIDEPC_SENT;
+		COUNT_Stat* m_PREF_STREAM_SENT;
+		COUNT_Stat* m_PREF_GHB_SENT;
+		COUNT_Stat* m_PREF_2DC_SENT;
+		COUNT_Stat* m_PREF_PHASE_SENT;
+		COUNT_Stat* m_PREF_STRIDE_USEFUL;
+		COUNT_Stat* m_PREF_STRIDEPC_USEFUL;
+		COUNT_Stat* m_PREF_STREAM_USEFUL;
+		COUNT_Stat* m_PREF_GHB_USEFUL;
+		COUNT_Stat* m_PREF_2DC_USEFUL;
+		COUNT_Stat* m_PREF_PHASE_USEFUL;
+		COUNT_Stat* m_PREF_STRIDE_LATE;
+		COUNT_Stat* m_PREF_STRIDEPC_LATE;
+		COUNT_Stat* m_PREF_STREAM_LATE;
+		COUNT_Stat* m_PREF_GHB_LATE;
+		COUNT_Stat* m_PREF_2DC_LATE;
+		COUNT_Stat* m_PREF_PHASE_LATE;
+		RATIO_Stat* m_PREF_STRIDE_ACCURACY;
+		RATIO_Stat* m_PREF_STRIDEPC_ACCURACY;
+		RATIO_Stat* m_PREF_STREAM_ACCURACY;
+		RATIO_Stat* m_PREF_GHB_ACCURACY;
+		RATIO_Stat* m_PREF_2DC_ACCURACY;
+		RATIO_Stat* m_PREF_PHASE_ACCURACY;
+		RATIO_Stat* m_PREF_STRIDE_COVERAGE;
+		RATIO_Stat* m_PREF_STRIDEPC_COVERAGE;
+		RATIO_Stat* m_PREF_STREAM_COVERAGE;
+		RATIO_Stat* m_PREF_GHB_COVERAGE;
+		RATIO_Stat* m_PREF_2DC_COVERAGE;
+		RATIO_Stat* m_PREF_PHASE_COVERAGE;
+		RATIO_Stat* m_PREF_STRIDE_TIMELINESS;
+		RATIO_Stat* m_PREF_STRIDEPC_TIMELINESS;
+		RATIO_Stat* m_PREF_STREAM_TIMELINESS;
+		RATIO_Stat* m_PREF_GHB_TIMELINESS;
+		RATIO_Stat* m_PREF_2DC_TIMELINESS;
+		RATIO_Stat* m_PREF_PHASE_TIMELINESS;
 		
 		// ============= ../def/stream.stat.def =============
 		COUNT_Stat* m_DCACHE_PREF_HIT;
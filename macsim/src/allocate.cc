@@ -76,6 +76,7 @@ allocate_c::allocate_c(int core_id, pqueue_c<int *> *q_frontend, pqueue_c<int> *
   m_rob              = rob;
   m_unit_type        = unit_type;
   m_allocate_running = true; 
+  m_resource_stall   = false;
   m_num_queues       = num_queues;
   m_simBase          = simBase;
   
@@ -101,6 +102,8 @@ void allocate_c::run_a_cycle(void)
   if (!m_allocate_running)
     return;
 
+  m_resource_stall = false;
+
   // check if the first element of frontend queue is ready i.e. 
   // has gone through all intermediate pipeline stages
   for (int cnt = 0; cnt < m_knob_width; ++cnt) {
@@ -159,29 +162,30 @@ void allocate_c::run_a_cycle(void)
         alloc_q->space() < 1 || 
         m_rob->get_num_int_regs () < req_int_reg || 
         m_rob->get_num_fp_regs() < req_fp_reg) {
+      m_resource_stall = true;
       break;
     }
 
     // no stall allocate resources 
-    uop->m_alloc_cycle = m_simBase->m_core_cycle[m_core_id];
+    uop->m_warm->m_alloc_cycle = m_simBase->m_core_cycle[m_core_id];
 
 
     // allocate physical resources
     if (req_sb) {
       m_rob->alloc_sb(); 
-      uop->m_req_sb = true; 
+      uop->m_warm->m_req_sb = true; 
     }
     else if (req_lb) {
       m_rob->alloc_lb(); 
-      uop->m_req_lb = true;
+      uop->m_warm->m_req_lb = true;
     }
     else if (req_int_reg) {
       m_rob->alloc_int_reg();
-      uop->m_req_int_reg = true;
+      uop->m_warm->m_req_int_reg = true;
     }
     else if (req_fp_reg) {
       m_rob->alloc_fp_reg();
-      uop->m_req_fp_reg = true;
+      uop->m_warm->m_req_fp_reg = true;
     }
 
     // -------------------------------------
@@ -212,26 +216,28 @@ void allocate_c::run_a_cycle(void)
 
     DEBUG("cycle_count:%lld core_id:%d uop_num:%lld inst_num:%lld uop.va:0x%s "
         "alloc_q:%d mem_type:%d\n", 
-        m_simBase->m_core_cycle[m_core_id], m_core_id, uop->m_uop_num, uop->m_inst_num, 
+        m_simBase->m_core_cycle[m_core_id], m_core_id, uop->m_uop_num, uop->m_warm->m_inst_num, 
         hexstr64s(uop->m_vaddr), uop->m_allocq_num, uop->m_mem_type); 
 
     DEBUG("core_id:%d thread_id:%d id:%lld uop is pushed. inst_count:%lld\n", 
-        m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_inst_num);
+        m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_warm->m_inst_num);
   
 
     // BTB miss is resolved 
-    if (uop->m_uop_info.m_btb_miss && !(uop->m_uop_info.m_btb_miss_resolved)) {
+    if (uop->m_cold->m_uop_info.m_btb_miss && !(uop->m_cold->m_uop_info.m_btb_miss_resolved)) {
       // indirect branch and indirect call cannot resolve the target address in the decode stage 
-      if ((uop->m_cf_type < CF_IBR) && (uop->m_cf_type > CF_ICO)) {
+      if ((uop->m_warm->m_cf_type < CF_IBR) && (uop->m_warm->m_cf_type > CF_ICO)) {
+        int thread_slot = 
+          m_simBase->m_core_pointers[m_core_id]->get_thread_slot(uop->m_thread_id);
         m_bp_data->m_bp_targ_pred->update(uop); 
-        m_bp_data->m_bp_redirect_cycle[uop->m_thread_id] = 
+        m_bp_data->m_bp_redirect_cycle[thread_slot] = 
           m_cur_core_cycle + 1 + *m_simBase->m_knobs->KNOB_EXTRA_RECOVERY_CYCLES; // redirect cycle 
-        uop->m_uop_info.m_btb_miss_resolved = true; 
+        uop->m_cold->m_uop_info.m_btb_miss_resolved = true; 
 
         DEBUG("cycle_count:%lld core_id:%d uop_num:%lld inst_num:%lld btb_miss "
             "resolved redirect_cycle:%lld\n", 
-            m_simBase->m_core_cycle[m_core_id], m_core_id, uop->m_uop_num, uop->m_inst_num, 
-            m_bp_data->m_bp_redirect_cycle[uop->m_thread_id]); 
+            m_simBase->m_core_cycle[m_core_id], m_core_id, uop->m_uop_num, uop->m_warm->m_inst_num, 
+            m_bp_data->m_bp_redirect_cycle[thread_slot]); 
 
         STAT_CORE_EVENT(m_core_id, BP_REDIRECT_RESOLVED); 
       }
@@ -175,6 +175,15 @@ class allocate_c
       return m_allocate_running; 
     }
 
+    /*! \fn resource_stalled()
+     *  \brief Check if the last allocation cycle stalled on rob/lsq/register resources
+     *  \return bool - True if stalled
+     */
+    bool resource_stalled() 
+    { 
+      return m_resource_stall; 
+    }
+
   private:
     int             m_core_id; /**< core id */
     pqueue_c<int*>* m_frontend_q; /**< frontend queue */
@@ -184,6 +193,7 @@ class allocate_c
     Unit_Type       m_unit_type; /**< core type */
     uns16           m_knob_width; /**< width */
     bool            m_allocate_running; /**< Enable allocation stage */
+    bool            m_resource_stall; /**< last cycle stalled on resources */
     Counter         m_cur_core_cycle; /**< current core cycle */
     int             m_num_queues; /**< number of allocation queue types */
     bp_data_c*      m_bp_data;  /**< branch predictor data structure */ 
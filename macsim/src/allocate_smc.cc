@@ -109,7 +109,7 @@ void smc_allocate_c::run_a_cycle(void)
     // fetch an uop from frontend queue
     uop_c *uop = (uop_c *) m_frontend_q->peek(0);
     DEBUG("core_id:%d thread_id:%d inst_num:%s uop_num:%s is peeked\n", 
-        m_core_id, uop->m_thread_id, unsstr64(uop->m_inst_num),
+        m_core_id, uop->m_thread_id, unsstr64(uop->m_warm->m_inst_num),
         unsstr64(uop->m_uop_num));
     ASSERT(uop);
     
@@ -171,24 +171,24 @@ void smc_allocate_c::run_a_cycle(void)
     }
 
     // no stall allocate resources 
-    uop->m_alloc_cycle = m_simBase->m_core_cycle[m_core_id];
+    uop->m_warm->m_alloc_cycle = m_simBase->m_core_cycle[m_core_id];
 
     // allocate physical resources
     if (req_sb) {
       thread_rob->alloc_sb(); 
-      uop->m_req_sb = true; 
+      uop->m_warm->m_req_sb = true; 
     }
     else if (req_lb) {
       thread_rob->alloc_lb(); 
-      uop->m_req_lb = true;
+      uop->m_warm->m_req_lb = true;
     }
     else if (req_int_reg) {
       thread_rob->alloc_int_reg();
-      uop->m_req_int_reg = true;
+      uop->m_warm->m_req_int_reg = true;
     }
     else if (req_fp_reg) {
       thread_rob->alloc_fp_reg();
-      uop->m_req_fp_reg = true;
+      uop->m_warm->m_req_fp_reg = true;
     }
     
     // enqueue an entry in allocate queue
@@ -213,7 +213,7 @@ void smc_allocate_c::run_a_cycle(void)
 
     DEBUG("cycle_count:%lld core_id:%d uop_num:%lld inst_num:%lld uop.va:0x%s "
           "gpu_alloc_q:%d mem_type:%d thread_id:%d uop is pushed.\n", 
-          m_cur_core_cycle, m_core_id, uop->m_uop_num, uop->m_inst_num, 
+          m_cur_core_cycle, m_core_id, uop->m_uop_num, uop->m_warm->m_inst_num, 
           hexstr64s(uop->m_vaddr), uop->m_allocq_num, uop->m_mem_type, uop->m_thread_id);
   }
 }
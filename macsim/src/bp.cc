@@ -83,18 +83,30 @@ bp_recovery_info_c::~bp_recovery_info_c()
 
 
 // bp_data_c constructor
-bp_data_c::bp_data_c(int core_id, macsim_c* simBase) 
+bp_data_c::bp_data_c(int core_id, int num_thread_slot, macsim_c* simBase) 
 {
   m_core_id = core_id;
   string bp_type = simBase->m_knobs->KNOB_BP_DIR_MECH->getValue();
   m_bp      = bp_factory_c::get()->allocate(bp_type, simBase);
   m_bp_targ_pred = new bp_targ_c(m_core_id, simBase); 
+
+  m_bp_recovery_cycle = new Counter[num_thread_slot];
+  m_bp_redirect_cycle = new Counter[num_thread_slot];
+  m_bp_cause_op       = new Counter[num_thread_slot];
+  for (int ii = 0; ii < num_thread_slot; ++ii) {
+    m_bp_recovery_cycle[ii] = 0;
+    m_bp_redirect_cycle[ii] = 0;
+    m_bp_cause_op[ii]       = 0;
+  }
 }
 
 
 // bp_data_c destructor
 bp_data_c::~bp_data_c()
 {
+  delete[] m_bp_recovery_cycle;
+  delete[] m_bp_redirect_cycle;
+  delete[] m_bp_cause_op;
 }
 
 
@@ -146,8 +146,9 @@ class bp_data_c
   public:
     /**
      * Branch predictor class constructor
+     * \param num_thread_slot - number of per-thread state slots in the core
      */
-    bp_data_c(int core_id, macsim_c* simBase);
+    bp_data_c(int core_id, int num_thread_slot, macsim_c* simBase);
 
     /**
      * Branch predictor class destructor
@@ -158,9 +159,10 @@ class bp_data_c
     bp_dir_base_c     *m_bp; /**< branch predictor */
     bp_targ_c         *m_bp_targ_pred;   /**< BTB */ 
     
-    unordered_map<int, Counter>  m_bp_recovery_cycle; /**< bp recovery cycle per thread */
-    unordered_map<int, Counter>  m_bp_redirect_cycle; /**< bp recovery cycle per thread */
-    unordered_map<int, Counter>  m_bp_cause_op; /**< misprediction caused uop per thread */
+    // indexed by core_c::get_thread_slot()
+    Counter*           m_bp_recovery_cycle; /**< bp recovery cycle per thread */
+    Counter*           m_bp_redirect_cycle; /**< bp recovery cycle per thread */
+    Counter*           m_bp_cause_op; /**< misprediction caused uop per thread */
 
     
     // FIXME : implement BTB
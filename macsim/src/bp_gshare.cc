@@ -72,7 +72,7 @@ bp_gshare_c::bp_gshare_c(macsim_c* simBase) : bp_dir_base_c(simBase)
 // branch prediction
 uns8 bp_gshare_c::pred (uop_c *uop)
 {
-  Addr  addr        = uop->m_pc; 
+  Addr  addr        = uop->m_warm->m_pc; 
   uns32 hist        = m_global_hist;
   uns32 cooked_hist = COOK_HIST_BITS(hist, *m_simBase->m_knobs->KNOB_BP_HIST_LENGTH, 0);
   uns32 cooked_addr = COOK_ADDR_BITS(addr, *m_simBase->m_knobs->KNOB_BP_HIST_LENGTH, 2);
@@ -81,14 +81,14 @@ uns8 bp_gshare_c::pred (uop_c *uop)
   uns8  pred        = ((pht_entry >> (*KNOB(KNOB_PHT_CTR_BITS)) - 1)) & 0x1;
   
 
-  uop->m_uop_info.m_pred_global_hist = m_global_hist;
+  uop->m_cold->m_uop_info.m_pred_global_hist = m_global_hist;
   m_global_hist >>= 1;
-  uop->m_recovery_info.m_global_hist = this->m_global_hist | uop->m_dir << 31; 
+  uop->m_cold->m_recovery_info.m_global_hist = this->m_global_hist | uop->m_warm->m_dir << 31; 
   m_global_hist |= pred << 31;
 
   DEBUG("Predicting core:%d thread_id:%d uop_num:%s addr:%s  index:%d  ent:%u pred:%d  dir:%d\n", 
         uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), hexstr64s(addr), 
-        pht_index, pht_entry, pred, uop->m_dir);
+        pht_index, pht_entry, pred, uop->m_warm->m_dir);
 
   return pred;
 }
@@ -97,19 +97,19 @@ uns8 bp_gshare_c::pred (uop_c *uop)
 // update branch predictor
 void bp_gshare_c::update (uop_c *uop)
 {
-  Addr  addr        = uop->m_pc;
-  uns32 hist        = uop->m_uop_info.m_pred_global_hist;
+  Addr  addr        = uop->m_warm->m_pc;
+  uns32 hist        = uop->m_cold->m_uop_info.m_pred_global_hist;
   uns32 cooked_hist = COOK_HIST_BITS(hist, *m_simBase->m_knobs->KNOB_BP_HIST_LENGTH, 0);
   uns32 cooked_addr = COOK_ADDR_BITS(addr, *m_simBase->m_knobs->KNOB_BP_HIST_LENGTH, 2);
   uns32 pht_index   = cooked_hist ^ cooked_addr;
   uns8  pht_entry   = m_pht[pht_index];
 
   DEBUG("Writing gshare PHT for  op_num:%s  index:%d  dir:%d ent:%u max value is :%lld \n", 
-      unsstr64(uop->m_uop_num), pht_index, uop->m_dir, m_pht[pht_index],  
+      unsstr64(uop->m_uop_num), pht_index, uop->m_warm->m_dir, m_pht[pht_index],  
       N_BIT_MASK(*m_simBase->m_knobs->KNOB_PHT_CTR_BITS));
 
 
-  if (uop->m_dir) {
+  if (uop->m_warm->m_dir) {
     m_pht[pht_index] = SAT_INC(pht_entry, N_BIT_MASK(*m_simBase->m_knobs->KNOB_PHT_CTR_BITS));
   }
   else {
@@ -118,7 +118,7 @@ void bp_gshare_c::update (uop_c *uop)
 
 
   DEBUG("Updating addr:%s  index:%u  ent:%u  dir:%d\n", 
-        hexstr64s(addr), pht_index, m_pht[pht_index], uop->m_dir);
+        hexstr64s(addr), pht_index, m_pht[pht_index], uop->m_warm->m_dir);
 }
 
 
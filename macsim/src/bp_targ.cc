@@ -73,19 +73,19 @@ Addr bp_targ_c::pred (uop_c *uop)
   perfect_pred = (m_simBase->m_knobs->KNOB_PERFECT_BTB); 
 
   if (perfect_pred) { 
-    return_addr = uop->m_npc; 
+    return_addr = uop->m_cold->m_npc; 
     STAT_CORE_EVENT(m_core_id, PERFECT_TARGET_PRED); 
   }
   else { 
     int appl_id = m_simBase->m_core_pointers[uop->m_core_id]->get_appl_id(uop->m_thread_id);
-    return_addr_ptr = (Addr *) btb->access_cache (uop->m_pc, &line_addr, true, appl_id);
+    return_addr_ptr = (Addr *) btb->access_cache (uop->m_warm->m_pc, &line_addr, true, appl_id);
     return_addr = return_addr_ptr ? *return_addr_ptr : 0; 
   }
   
   Addr tag; 
   int set; 
-  btb->find_tag_and_set(uop->m_pc, &tag, &set);
-  uop->m_uop_info.m_btb_set = set; 
+  btb->find_tag_and_set(uop->m_warm->m_pc, &tag, &set);
+  uop->m_cold->m_uop_info.m_btb_set = set; 
 
   return return_addr; 
 }
@@ -93,17 +93,17 @@ Addr bp_targ_c::pred (uop_c *uop)
 
 void bp_targ_c::update (uop_c *uop)
 {
-  Addr fetch_addr = uop->m_pc; 
+  Addr fetch_addr = uop->m_warm->m_pc; 
   Addr *btb_line = NULL;
   Addr btb_line_addr, repl_line_addr; 
   bool insert_btb = false; 
 
-  if (uop->m_off_path) 
+  if (uop->m_warm->m_off_path) 
     return; 
   
   Addr tag; 
   int set; 
-  btb->find_tag_and_set(uop->m_pc, &tag, &set);
+  btb->find_tag_and_set(uop->m_warm->m_pc, &tag, &set);
 
   int appl_id = m_simBase->m_core_pointers[uop->m_core_id]->get_appl_id(uop->m_thread_id);
   btb_line = (Addr *)btb->access_cache(fetch_addr, &btb_line_addr, false, appl_id);
@@ -114,11 +114,11 @@ void bp_targ_c::update (uop_c *uop)
     insert_btb = true; 
   }
 
-  *btb_line = uop->m_target_addr; 
+  *btb_line = uop->m_cold->m_target_addr; 
 
   DEBUG("Writing BTB pc:0x%s target:0x%s m_uop_num:%s core_id:%d thread_id:%d cf_type:%d "
       "btb_line:%s set:%d tag:0x%s insert_btb:%d\n",
-      hexstr64s(uop->m_pc), hexstr64s(uop->m_target_addr), unsstr64(uop->m_uop_num),
-      m_core_id, uop->m_thread_id, uop->m_cf_type, (btb_line) ? hexstr64s(*btb_line) : "-1", 
+      hexstr64s(uop->m_warm->m_pc), hexstr64s(uop->m_cold->m_target_addr), unsstr64(uop->m_uop_num),
+      m_core_id, uop->m_thread_id, uop->m_warm->m_cf_type, (btb_line) ? hexstr64s(*btb_line) : "-1", 
       set, hexstr64s(tag), insert_btb);
 }
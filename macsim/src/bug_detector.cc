@@ -187,19 +187,19 @@ void bug_detector_c::print(int core_id, int thread_id)
       uop_c *uop = (*I);
       ASSERT(uop);
       out
-        << setw(10) << left << uop->m_inst_num
+        << setw(10) << left << uop->m_warm->m_inst_num
         << setw(10) << left << uop->m_uop_num
         << setw(10) << left << uop->m_thread_id
         << setw(15) << left << (*m_uop_table[ii])[(*I)]
         << setw(15) << left << CYCLE - (*m_uop_table[ii])[(*I)]
         << setw(25) << left << uop_c::g_uop_state_name[uop->m_state] 
-        << setw(25) << left << trace_read_c::g_tr_opcode_names[uop->m_opcode] 
+        << setw(25) << left << trace_read_c::g_tr_opcode_names[uop->m_warm->m_opcode] 
         << setw(20) << left << uop_c::g_uop_type_name[uop->m_uop_type]
         << setw(20) << left << uop_c::g_mem_type_name[uop->m_mem_type]
-        << setw(20) << left << uop_c::g_cf_type_name[uop->m_cf_type]
-        << setw(20) << left << uop_c::g_dep_type_name[uop->m_bar_type]
-        << setw(6)  << left << uop->m_num_child_uops
-        << setw(10) << left << (uop->m_parent_uop == NULL ? 0 : uop->m_parent_uop->m_uop_num)
+        << setw(20) << left << uop_c::g_cf_type_name[uop->m_warm->m_cf_type]
+        << setw(20) << left << uop_c::g_dep_type_name[uop->m_warm->m_bar_type]
+        << setw(6)  << left << uop->m_warm->m_num_child_uops
+        << setw(10) << left << (uop->m_warm->m_parent_uop == NULL ? 0 : uop->m_warm->m_parent_uop->m_uop_num)
         << endl;
     }
     out << "\n\n";
@@ -41,6 +41,12 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "assert_macros.h"
 #include "cache.h"
 #include "utils.h"
@@ -52,33 +58,69 @@ POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG(args...) _DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_CACHE_LIB, ## args)
 #define DEBUG_MEM(args...) _DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_MEM_TRACE, ## args)
 
-/*
- * (SE/AR) Epsilon values used by the TAP-BIP policy. TODO: Take these values as an input from
- * the params.in file.
- */
-
-#define CPU_EPSILON 32
-#define GPU_EPSILON 32
-
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
 cache_entry_c::cache_entry_c()
-  : m_valid(false), m_last_access_time(0)
 {
 }
 
 
 cache_set_c::cache_set_c(int assoc)
 {
-  m_entry = new cache_entry_c[assoc];
-  m_assoc = assoc;
+  m_tag              = new Addr[assoc];
+  m_last_access_time = new Counter[assoc];
+  m_entry            = new cache_entry_c[assoc];
+  m_assoc            = assoc;
+
+  for (int ii = 0; ii < assoc; ++ii) {
+    m_tag[ii]              = 0;
+    m_last_access_time[ii] = 0;
+  }
 }
 
 cache_set_c::~cache_set_c()
 {
-  delete m_entry;
+  delete[] m_tag;
+  delete[] m_last_access_time;
+  delete[] m_entry;
+}
+
+
+// compare the packed tag against all ways; the lowest matching way is returned
+int cache_set_c::find_way(Addr tag)
+{
+  Addr key = tag | CACHE_TAG_VALID;
+  int ii = 0;
+
+#if defined(__AVX2__)
+  __m256i vkey = _mm256_set1_epi64x(key);
+  for (; ii + 4 <= m_assoc; ii += 4) {
+    __m256i vtag = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_tag + ii));
+    int match = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(vtag, vkey)));
+    if (match)
+      return ii + __builtin_ctz(match);
+  }
+#elif defined(__SSE2__)
+  // no 64-bit compare in SSE2 : both 32-bit halves should match
+  __m128i vkey = _mm_set1_epi64x(key);
+  for (; ii + 2 <= m_assoc; ii += 2) {
+    __m128i vtag = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_tag + ii));
+    __m128i eq32 = _mm_cmpeq_epi32(vtag, vkey);
+    __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+    int match = _mm_movemask_pd(_mm_castsi128_pd(eq64));
+    if (match)
+      return ii + __builtin_ctz(match);
+  }
+#endif
+
+  for (; ii < m_assoc; ++ii) {
+    if (m_tag[ii] == key)
+      return ii;
+  }
+
+  return -1;
 }
 
 
@@ -90,10 +132,6 @@ cache_c::cache_c(string name, int num_set, int assoc, int line_size,
     int data_size, int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info,
     bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase) 
 {
-  // (SE) initialize BIP counters
-  m_bip_cpu_count = 0;
-  m_bip_gpu_count = 0;
-
   m_simBase = simBase;
 
   DEBUG("Initializing cache called '%s'.\n", name.c_str());
@@ -132,6 +170,12 @@ cache_c::cache_c(string name, int num_set, int assoc, int line_size,
   m_interleave_bits = log2_int(m_interleave_factor);
   m_interleave_mask = N_BIT_MASK(m_interleave_bits);
 
+  // replacement policy
+  if (CONFIG(m_cache_use_pseudo_lru))
+    m_find_victim = &cache_c::find_replacement_line_plru;
+  else
+    m_find_victim = &cache_c::find_replacement_line_lru;
+
   // Allocating memory for all the sets (pointers to line arrays)
   m_core_id = core_id; 
 
@@ -143,7 +187,6 @@ cache_c::cache_c(string name, int num_set, int assoc, int line_size,
 
     // Allocating memory for all of the data elements in each line
     for (int jj = 0; jj < assoc; ++jj) {
-      m_set[ii]->m_entry[jj].m_valid          = false;
       m_set[ii]->m_entry[jj].m_access_counter = false;
       if (data_size > 0) {
         m_set[ii]->m_entry[jj].m_data = (void *)malloc(data_size);
@@ -222,26 +265,23 @@ void* cache_c::access_cache(Addr addr, Addr *line_addr, bool update_repl, int ap
   if (update_repl)
     update_cache_on_access(*line_addr, set, appl_id);
 
-  // Walk through the set
-  for (int ii = 0; ii < m_assoc; ++ii) {
-    // For each line in based on associativity
-    cache_entry_c * line = &(m_set[set]->m_entry[ii]);
-
-    // Check for matching tag and validity
-    if (line->m_valid && line->m_tag == tag) {
-      // If hit, then return  
-      assert(line->m_data);
-
-      if (update_repl) {
-        // If prefetch is set mark it as used  
-        if (line->m_pref) {
-          line->m_pref = false;
-        }
-        update_line_on_hit(line, set, appl_id);
-      }   
-
-      return line->m_data;
-    }
+  // Check all ways for matching tag and validity
+  int way = m_set[set]->find_way(tag);
+  if (way != -1) {
+    cache_entry_c * line = &(m_set[set]->m_entry[way]);
+
+    // If hit, then return  
+    assert(line->m_data);
+
+    if (update_repl) {
+      // If prefetch is set mark it as used  
+      if (line->m_pref) {
+        line->m_pref = false;
+      }
+      update_line_on_hit(set, way, appl_id);
+    }   
+
+    return line->m_data;
   }
 
   if (update_repl)
@@ -255,9 +295,9 @@ void cache_c::update_cache_on_access(Addr line_addr, int set, int appl_id)
 }
 
 
-void cache_c::update_line_on_hit(cache_entry_c* line, int set, int appl_id)
+void cache_c::update_line_on_hit(int set, int way, int appl_id)
 {
-  line->m_last_access_time = CYCLE;
+  m_set[set]->m_last_access_time[way] = CYCLE;
 }
 
 
@@ -268,50 +308,71 @@ void cache_c::update_cache_on_miss(int set_id, int appl_id)
 
 
 // find an entry to be replaced based on the policy
-cache_entry_c* cache_c::find_replacement_line(int set, int appl_id) 
-{
-  if (*m_simBase->m_knobs->KNOB_CACHE_USE_PSEUDO_LRU) {
-    while (1) {
-      for (int ii = 0; ii < m_assoc; ++ii) {
-        cache_entry_c* line = &(m_set[set]->m_entry[ii]);
-        if (!line->m_valid || line->m_last_access_time == 0) {
-          return &(m_set[set]->m_entry[ii]);
-        }
-      }
+int cache_c::find_replacement_line(int set, int appl_id) 
+{
+  return (this->*m_find_victim)(m_set[set]);
+}
 
-      for (int ii = 0; ii < m_assoc; ++ii) {
-        cache_entry_c* line = &(m_set[set]->m_entry[ii]);
-        line->m_last_access_time = 0;
-      }
+
+// same selection as find_replacement_line; pseudo-LRU picks the first way when it would
+// clear all bits
+int cache_c::peek_replacement_line(int set, int appl_id)
+{
+  if (m_find_victim != &cache_c::find_replacement_line_plru)
+    return find_replacement_line(set, appl_id);
+
+  cache_set_c* set_ptr = m_set[set];
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    if (!set_ptr->is_valid(ii) || set_ptr->m_last_access_time[ii] == 0) {
+      return ii;
     }
   }
-  else {
-    int i = 0;
-    int lru_ind = 0;
-    Counter lru_time = MAX_INT;
-    while (i < m_assoc) {
-      cache_entry_c* line = &(m_set[set]->m_entry[i]);
-      // If free entry found, return it
-      if (!line->m_valid) {
-        lru_ind = i;
-        break;
-      }
+  return 0;
+}
+
 
-      // Check if this is the LRU entry encountered
-      if (line->m_last_access_time < lru_time) {
-        lru_ind  = i;
-        lru_time = line->m_last_access_time;
+int cache_c::find_replacement_line_plru(cache_set_c* set_ptr)
+{
+  while (1) {
+    for (int ii = 0; ii < m_assoc; ++ii) {
+      if (!set_ptr->is_valid(ii) || set_ptr->m_last_access_time[ii] == 0) {
+        return ii;
       }
-      ++i;
     }
-    return &(m_set[set]->m_entry[lru_ind]);
+
+    for (int ii = 0; ii < m_assoc; ++ii) {
+      set_ptr->m_last_access_time[ii] = 0;
+    }
   }
 }
 
 
-cache_entry_c* cache_c::find_replacement_line_from_same_type(int set, int appl_id, 
-    bool gpuline) 
+int cache_c::find_replacement_line_lru(cache_set_c* set_ptr)
+{
+  int i = 0;
+  int lru_ind = 0;
+  Counter lru_time = MAX_INT;
+  while (i < m_assoc) {
+    // If free entry found, return it
+    if (!set_ptr->is_valid(i)) {
+      lru_ind = i;
+      break;
+    }
+
+    // Check if this is the LRU entry encountered
+    if (set_ptr->m_last_access_time[i] < lru_time) {
+      lru_ind  = i;
+      lru_time = set_ptr->m_last_access_time[i];
+    }
+    ++i;
+  }
+  return lru_ind;
+}
+
+
+int cache_c::find_replacement_line_from_same_type(int set, int appl_id, bool gpuline) 
 {
+  cache_set_c* set_ptr = m_set[set];
   int current_type_count; 
   int current_type_max;
 
@@ -327,79 +388,56 @@ cache_entry_c* cache_c::find_replacement_line_from_same_type(int set, int appl_i
   int lru_index = -1;
   Counter lru_time = ULLONG_MAX;
   for (int ii = 0; ii < m_assoc; ++ii) {
-    cache_entry_c* line = &(m_set[set]->m_entry[ii]);
-    if (!line->m_valid && current_type_count < current_type_max) {
+    bool valid = set_ptr->is_valid(ii);
+    if (!valid && current_type_count < current_type_max) {
       lru_index = ii;
       break;
     }
 
-    if (line->m_valid && line->m_gpuline == gpuline && line->m_last_access_time < lru_time) {
+    if (valid && set_ptr->m_entry[ii].m_gpuline == gpuline && 
+        set_ptr->m_last_access_time[ii] < lru_time) {
       lru_index = ii;
-      lru_time = line->m_last_access_time;
+      lru_time = set_ptr->m_last_access_time[ii];
     }
   }
 
   if (lru_index == -1) {
     for (int ii = 0; ii < m_assoc; ++ii) {
-      cache_entry_c* line = &(m_set[set]->m_entry[ii]);
-      report("valid:" << line->m_valid << " gpu:" << line->m_gpuline << " lru:" << line->m_last_access_time); 
+      report("valid:" << set_ptr->is_valid(ii) << " gpu:" << set_ptr->m_entry[ii].m_gpuline 
+          << " lru:" << set_ptr->m_last_access_time[ii]); 
     }
     ASSERTM(lru_index != -1, "assoc:%d count:%d max:%d gpu:%d\n", 
             m_assoc, current_type_count, current_type_max, gpuline);
   }
-  return &(m_set[set]->m_entry[lru_index]);
+  return lru_index;
 }
 
 
 // initialize a cache line
-void cache_c::initialize_cache_line(cache_entry_c *ins_line, Addr tag, Addr addr, int appl_id,
+void cache_c::initialize_cache_line(int way, Addr tag, Addr addr, int appl_id,
     bool gpuline, int set_id, bool skip) 
 {
-  /*
-   * (SE/AR) Quick hack to disable the default pseudo-LRU insertion policy.
-   * TODO: Decide whether to use pseudo LRU/TAP-BIP based on a parameter set
-   * in the params.in file.
-   */
-
-  if(0){  
-    ins_line->m_valid            = true;
-    ins_line->m_tag              = tag;
-    ins_line->m_base             = (addr & ~m_offset_mask);
-    ins_line->m_access_counter   = 0;
-    ins_line->m_last_access_time = CYCLE;
-    ins_line->m_pref             = false;
-    ins_line->m_skip             = skip;
-
-    // for heterogeneous simulation
-    ins_line->m_appl_id          = appl_id;
-    ins_line->m_gpuline          = gpuline;
-    if (ins_line->m_gpuline) { 
-      ++m_num_gpu_line;
-      ++m_set[set_id]->m_num_gpu_line;
-    }
-    else {
-      ++m_num_cpu_line;
-      ++m_set[set_id]->m_num_cpu_line;
-    }
-  } else{  // (SE/AR) BEGIN implement BIP for GPU and CPU    
-    if(gpuline){  
-      if(m_bip_gpu_count < GPU_EPSILON){    // Insert at LRU    
-        m_bip_gpu_count++;      
-        ins_line->m_last_access_time = 0;     
-      }else{
-        ins_line->m_last_access_time = CYCLE; // Insert at MRU
-        m_bip_gpu_count = 0;
-      }
-    }else{
-      if(m_bip_cpu_count < CPU_EPSILON){    // Insert at LRU 
-        m_bip_cpu_count++;
-        ins_line->m_last_access_time = 0;     
-      }else{
-        ins_line->m_last_access_time = CYCLE; // Insert at MRU
-        m_bip_cpu_count = 0;      
-      }
-    }
-  } // (SE/AR) END implement BIP for GPU and CPU
+  cache_set_c* set_ptr    = m_set[set_id];
+  cache_entry_c* ins_line = &(set_ptr->m_entry[way]);
+
+  set_ptr->m_tag[way]              = tag | CACHE_TAG_VALID;
+  set_ptr->m_last_access_time[way] = CYCLE;
+  ins_line->m_base                 = (addr & ~m_offset_mask);
+  ins_line->m_access_counter       = 0;
+  ins_line->m_pref                 = false;
+  ins_line->m_skip                 = skip;
+
+  // for heterogeneous simulation
+  ins_line->m_appl_id              = appl_id;
+  ins_line->m_gpuline              = gpuline;
+  if (ins_line->m_gpuline) { 
+    ++m_num_gpu_line;
+    ++m_set[set_id]->m_num_gpu_line;
+  }
+  else {
+    ++m_num_cpu_line;
+    ++m_set[set_id]->m_num_cpu_line;
+  }
 }
 
 
@@ -416,7 +454,7 @@ void *cache_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line, int
 {
   Addr tag;
   int set;
-  cache_entry_c *ins_line;
+  int way;
   *line_addr = base_cache_line (addr);
 
   // Get the set where the addr maps and tag to asssociate 
@@ -425,14 +463,15 @@ void *cache_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line, int
 
   // Get the pointer to a line that should be replaced as per policy
   if (*m_simBase->m_knobs->KNOB_HETERO_STATIC_CACHE_PARTITION && m_enable_partition) {
-    ins_line = find_replacement_line_from_same_type(set, appl_id, gpuline);
+    way = find_replacement_line_from_same_type(set, appl_id, gpuline);
   }
   else {
-    ins_line = find_replacement_line(set, appl_id);
+    way = find_replacement_line(set, appl_id);
   }
+  cache_entry_c* ins_line = &(m_set[set]->m_entry[way]);
 
   // Populate the update_line variable if the present line was in use
-  if (ins_line->m_valid) {
+  if (m_set[set]->is_valid(way)) {
     *updated_line = ins_line->m_base;
     update_set_on_replacement(tag, ins_line->m_appl_id, set, ins_line->m_gpuline);
   }
@@ -442,11 +481,11 @@ void *cache_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line, int
   
   DEBUG("Replacing (set %u, tag 0x%s, base 0x%s, up:0x%s) in cache '%s' "
         "core_id:%d with base 0x%s\n",
-        set, hexstr64s(ins_line->m_tag), hexstr64s(ins_line->m_base), 
+        set, hexstr64s(m_set[set]->get_tag(way)), hexstr64s(ins_line->m_base), 
         hexstr64s(*updated_line), m_name.c_str(), m_core_id, hexstr64s(*line_addr));
   
   // Initialize the other fileds of the cache line
-  initialize_cache_line(ins_line, tag, addr, appl_id, gpuline, set, skip);
+  initialize_cache_line(way, tag, addr, appl_id, gpuline, set, skip);
 
   // Check if prefetch flag was set and update the field accordingly
   ++m_insert_count;
@@ -455,6 +494,64 @@ void *cache_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line, int
 }
 
 
+// find the line to be replaced by an insertion (same selection as insert_cache)
+Addr cache_c::find_victim_line(Addr addr, int appl_id, bool gpuline, int* set, int* way)
+{
+  Addr tag;
+
+  find_tag_and_set(addr, &tag, set);
+  if (*m_simBase->m_knobs->KNOB_HETERO_STATIC_CACHE_PARTITION && m_enable_partition) {
+    *way = find_replacement_line_from_same_type(*set, appl_id, gpuline);
+  }
+  else {
+    *way = peek_replacement_line(*set, appl_id);
+  }
+
+  if (!m_set[*set]->is_valid(*way))
+    return 0;
+
+  return m_set[*set]->m_entry[*way].m_base;
+}
+
+
+// promote a line as on a hit
+void cache_c::promote_line(int set, int way, int appl_id)
+{
+  update_line_on_hit(set, way, appl_id);
+}
+
+
+// collect the base addresses of all valid lines
+void cache_c::get_line_addrs(vector<Addr>& addrs)
+{
+  for (int ii = 0; ii < m_num_sets; ++ii) {
+    for (int jj = 0; jj < m_assoc; ++jj) {
+      if (m_set[ii]->is_valid(jj))
+        addrs.push_back(m_set[ii]->m_entry[jj].m_base);
+    }
+  }
+}
+
+
+// a regular cache replaces at most one line per insertion
+bool cache_c::pop_victim(Addr *line_addr, void **data)
+{
+  return false;
+}
+
+
+int cache_c::max_victims(void)
+{
+  return 1;
+}
+
+
+int cache_c::extra_hit_latency(Addr addr)
+{
+  return 0;
+}
+
+
 void cache_c::update_set_on_replacement(Addr tag, int appl_id, int set, bool gpuline)
 {
   if (gpuline) {
@@ -469,10 +566,10 @@ void cache_c::update_set_on_replacement(Addr tag, int appl_id, int set, bool gpu
 
 
 // initialize (nullify) a cache line
-bool cache_c::null_cache_line_fields(cache_entry_c *line)
+bool cache_c::null_cache_line_fields(int set, int way)
 {
-  line->m_tag   = 0;
-  line->m_valid = false;
+  cache_entry_c* line = &(m_set[set]->m_entry[way]);
+  m_set[set]->m_tag[way] = 0;
   line->m_base  = 0;
   memset(line->m_data, 0, m_data_size);
   if (line->m_dirty) {
@@ -494,15 +591,11 @@ bool cache_c::invalidate_cache_line(Addr addr)
   // to the new cache line being returned
   find_tag_and_set(addr, &tag, &set);
 
-  for (int ii = 0; ii < m_assoc; ++ii) {
-    // For each line in based on associativity
-    cache_entry_c *line = &(m_set[set]->m_entry[ii]);
-
-    // Check for matching tag and validity
-    if (line->m_valid && line->m_tag == tag) {
-      // If hit, then erase the current line data and return 
-      return null_cache_line_fields(line);
-    }
+  // Check all ways for matching tag and validity
+  int way = m_set[set]->find_way(tag);
+  if (way != -1) {
+    // If hit, then erase the current line data and return 
+    return null_cache_line_fields(set, way);
   }
 
   return false;
@@ -522,8 +615,7 @@ void cache_c::invalidate_cache(void)
   for (int ii = 0; ii < m_num_sets; ++ii) {
     for (int jj = 0; jj < m_assoc; ++jj) {
       cache_entry_c* line = &(m_set[ii]->m_entry[jj]);
-      line->m_valid = false;
-      line->m_tag   = 0;
+      m_set[ii]->m_tag[jj] = 0;
       memset(line->m_data, 0, m_data_size);
     }
   }
@@ -556,10 +648,10 @@ int cache_c::get_bank_num(Addr addr)
 Counter cache_c::find_min_lru(int set) 
 {
   Counter lru_time = MAX_INT;
+  cache_set_c* set_ptr = m_set[set];
   for (int ii = 0; ii < m_assoc; ++ii) {
-    cache_entry_c *entry = &(m_set[set]->m_entry[ii]);
-    if (entry->m_valid && entry->m_last_access_time < lru_time) {
-      lru_time = m_set[set]->m_entry[ii].m_last_access_time;
+    if (set_ptr->is_valid(ii) && set_ptr->m_last_access_time[ii] < lru_time) {
+      lru_time = set_ptr->m_last_access_time[ii];
     }   
   }
 
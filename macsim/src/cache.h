@@ -40,6 +40,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <string>
+#include <vector>
 
 #include "macsim.h"
 #include "global_types.h" 
@@ -61,17 +62,17 @@ typedef enum Cache_Type_enum
 /* set data pointers to this initially */
 #define INIT_CACHE_DATA_VALUE ((void *)0x8badbeef) 
 
+/* valid bit folded into a packed tag (tags are address >> line bits, so the MSB is free) */
+#define CACHE_TAG_VALID (((Addr)1) << 63)
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief Cache entry class
+/// \brief Cache entry class (line payload; tag and replacement data are kept in the set)
 ///////////////////////////////////////////////////////////////////////////////////////////////
 class cache_entry_c 
 {
   public:
-    bool          m_valid;        //!< valid bit for the line 
-    Addr          m_tag;          //!< tag for the line 
     Addr          m_base;         //!< address of first element 
-    Counter       m_last_access_time; //!< for replacement policy 
     Counter       m_access_counter; //!< access counter 
     void         *m_data;         //!< poiter to arbitrary data 
     bool          m_pref;         //!< data is brought by a prefetcher 
@@ -87,6 +88,9 @@ class cache_entry_c
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Cache set class
+///
+/// Ways of a set are stored as a structure of arrays: packed tags (with the valid bit)
+/// for the lookup, replacement data, and line payload. Lookups only touch the tag array.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 class cache_set_c
 {
@@ -103,7 +107,25 @@ class cache_set_c
      */
     ~cache_set_c();
 
+    /**
+     * Find the way holding a valid line with the tag
+     * \return way index, -1 if not found
+     */
+    int find_way(Addr tag);
+
+    /**
+     * Check whether a way holds a valid line
+     */
+    bool is_valid(int way) { return (m_tag[way] & CACHE_TAG_VALID) != 0; }
+
+    /**
+     * Get the tag of a way
+     */
+    Addr get_tag(int way) { return m_tag[way] & ~CACHE_TAG_VALID; }
+
   public:
+    Addr*          m_tag; /**< packed tags (CACHE_TAG_VALID | tag) */
+    Counter*       m_last_access_time; /**< replacement data (last access time) */
     cache_entry_c* m_entry; /**< cache entries */
     int m_assoc; /**< associativity */
     int m_num_cpu_line; /**< number of cpu cache line */
@@ -181,7 +203,7 @@ class cache_c
     /**
      * Update LRU value on cache hit
      */
-    virtual void update_line_on_hit(cache_entry_c* line, int set, int appl_id);
+    virtual void update_line_on_hit(int set, int way, int appl_id);
 
     /**
      * Update cache on misses - set dueling
@@ -197,9 +219,18 @@ class cache_c
      * \brief Funtion to find line where a new insert could be performed.
      * \param set - Cache set under consideration
      * \param appl_id - application id
-     * \return cache_entry_c - find replaceable entry in set 
+     * \return int - replaceable way in set 
+     */
+    virtual int find_replacement_line(int set, int appl_id);
+
+    /**
+     * \brief Function to find the way find_replacement_line would pick, without updating
+     * the replacement state. Policies whose selection changes the state override this.
+     * \param set - Cache set under consideration
+     * \param appl_id - application id
+     * \return int - replaceable way in set
      */
-    virtual cache_entry_c* find_replacement_line(int set, int appl_id);
+    virtual int peek_replacement_line(int set, int appl_id);
 
     /**
      * Find replace-line from the same type
@@ -207,11 +238,51 @@ class cache_c
      * @param appl_id - application id
      * @param gpuline - gpu cache line
      */
-    cache_entry_c* find_replacement_line_from_same_type(int set, int appl_id, bool gpuline);
+    int find_replacement_line_from_same_type(int set, int appl_id, bool gpuline);
+
+    /**
+     * Find the first line whose pseudo-LRU bit is clear (clears all bits when none is)
+     */
+    int find_replacement_line_plru(cache_set_c* set_ptr);
+
+    /**
+     * Find the least recently used line (or the first invalid one)
+     */
+    int find_replacement_line_lru(cache_set_c* set_ptr);
+
+    /**
+     * \brief Function to find the line an insertion of addr would replace. Neither the set
+     * nor the replacement state is changed.
+     * \param addr - Address to be inserted
+     * \param appl_id - application id
+     * \param gpuline - gpu cache line
+     * \param set - set of the victim line (output)
+     * \param way - way of the victim line (output)
+     * \return Addr - Base address of the victim line (0 : a free way would be used)
+     */
+    Addr find_victim_line(Addr addr, int appl_id, bool gpuline, int* set, int* way);
+
+    /**
+     * \brief Function to promote a line as on a hit. Only the replacement state of the line
+     * is updated; unlike access_cache, no access is recorded.
+     * \param set - set id
+     * \param way - way id
+     * \param appl_id - application id
+     * \return void
+     */
+    void promote_line(int set, int way, int appl_id);
+
+    /**
+     * \brief Function to collect the base addresses of all valid lines.
+     * \param addrs - Addresses are appended to this vector
+     * \return void
+     */
+    void get_line_addrs(vector<Addr>& addrs);
 
     /**
-     * \brief Funtion to initialize a new cache line.
-     * \param ins_line - Line to be inserted
+     * \brief Funtion to initialize a new cache line (inserted at the MRU position).
+     * LLC policies override this to pick the insertion position.
+     * \param way - way to be inserted
      * \param tag - Tag based on the address
      * \param addr - Address
      * \param appl_id - application id
@@ -220,7 +291,7 @@ class cache_c
      * \param skip - skip LLC
      * \return void 
      */
-    virtual void initialize_cache_line(cache_entry_c *ins_line, Addr tag, Addr addr, 
+    virtual void initialize_cache_line(int way, Addr tag, Addr addr, 
         int appl_id, bool gpuline, int set_id, bool skip);
 
     /**
@@ -249,16 +320,39 @@ class cache_c
      * \param skip 
      * \return void* - Pointer to the data of the new cache line
      */
-    void * insert_cache (Addr addr, Addr *line_addr, Addr *repl_line, int appl_id, 
+    virtual void * insert_cache (Addr addr, Addr *line_addr, Addr *repl_line, int appl_id, 
         bool gpuline, bool skip);
 
+    /**
+     * \brief Function to get a line replaced by the last insertion besides the one returned
+     * by insert_cache (a compressed cache may replace several lines). The line data stays
+     * valid until the next insertion.
+     * \param line_addr - Base address of the replaced line (updated by the function)
+     * \param data - Data of the replaced line (updated by the function)
+     * \return bool - false if there is no more replaced line
+     */
+    virtual bool pop_victim(Addr *line_addr, void **data);
+
+    /**
+     * \brief Function to get the maximum number of lines an insertion can replace
+     */
+    virtual int max_victims(void);
+
+    /**
+     * \brief Function to get the additional latency of a hit (e.g. decompression)
+     * \param addr - Address
+     * \return int - additional cycles
+     */
+    virtual int extra_hit_latency(Addr addr);
+
     /**
      * \brief Function to null out all fields in the caache line 
         being invalidated 
-     * \param line - Cache line being invalidated
+     * \param set - set of the line being invalidated
+     * \param way - way of the line being invalidated
      * \return bool - Dirty flag
      */
-    bool null_cache_line_fields(cache_entry_c *line);
+    bool null_cache_line_fields(int set, int way);
 
     /**
      * \brief Function to invalidate cache line. 
@@ -327,16 +421,8 @@ class cache_c
     int     m_interleave_factor; /**< granularity of interleaving across tiles */
     int     m_interleave_bits;   /**< number of bits taken by interleaving factor */
     Addr    m_interleave_mask;   /**< interleave factor mask */
+    int     (cache_c::*m_find_victim)(cache_set_c*); /**< replacement policy, picked at construction */
 
-    /*
-     * (SE/AR) Counters which keep track of the number of cache lines that are currently
-     * in the LRU position. Whenever these counters reach CPU_EPSILON or GPU_EPISLON
-     * respectively, they will be reset.
-     */
-
-	int		m_bip_cpu_count;	 /**< counter for BIP for CPU lines */
-	int 	m_bip_gpu_count;	 /**< counter for BIP for GPU lines */
-  
     cache_set_c** m_set;       /**< cache data structure */
 
     macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
@@ -110,6 +110,165 @@ POSSIBILITY OF SUCH DAMAGE.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// thread_state_c constructor
+thread_state_c::thread_state_c(int num_slot, macsim_c* simBase)
+{
+  m_simBase   = simBase;
+  m_num_slot  = num_slot;
+  m_dead_slot = num_slot;
+
+  int total_slot         = num_slot + 1;
+  m_tid                  = new int[total_slot];
+  m_fetch_ended          = new bool[total_slot];
+  m_thread_reach_end     = new bool[total_slot];
+  m_thread_finished      = new bool[total_slot];
+  m_inst_fetched         = new Counter[total_slot];
+  m_ops_to_be_dispatched = new Counter[total_slot];
+  m_last_fetch_cycle     = new Counter[total_slot];
+  m_heartbeat            = new heartbeat_s[total_slot];
+  m_trace_info           = new thread_s*[total_slot];
+  m_process              = new process_s*[total_slot];
+  m_free_slot            = new int[num_slot];
+
+  // tid to slot table : at least twice the number of slots to reduce collisions
+  int map_size = 1;
+  while (map_size < 2 * num_slot)
+    map_size <<= 1;
+  m_slot_map      = new int[map_size];
+  m_slot_map_mask = map_size - 1;
+
+  init();
+}
+
+
+// thread_state_c destructor
+thread_state_c::~thread_state_c()
+{
+  delete[] m_tid;
+  delete[] m_fetch_ended;
+  delete[] m_thread_reach_end;
+  delete[] m_thread_finished;
+  delete[] m_inst_fetched;
+  delete[] m_ops_to_be_dispatched;
+  delete[] m_last_fetch_cycle;
+  delete[] m_heartbeat;
+  delete[] m_trace_info;
+  delete[] m_process;
+  delete[] m_free_slot;
+  delete[] m_slot_map;
+}
+
+
+// release all slots
+void thread_state_c::init(void)
+{
+  for (int ii = 0; ii <= m_num_slot; ++ii) {
+    m_tid[ii]                  = -1;
+    m_fetch_ended[ii]          = true;
+    m_thread_reach_end[ii]     = true;
+    m_thread_finished[ii]      = true;
+    m_inst_fetched[ii]         = 0;
+    m_ops_to_be_dispatched[ii] = 0;
+    m_last_fetch_cycle[ii]     = 0;
+    m_trace_info[ii]           = NULL;
+    m_process[ii]              = NULL;
+  }
+
+  // pop in ascending slot order
+  m_num_free_slot = m_num_slot;
+  for (int ii = 0; ii < m_num_slot; ++ii) {
+    m_free_slot[ii] = m_num_slot - 1 - ii;
+  }
+
+  for (int ii = 0; ii <= m_slot_map_mask; ++ii) {
+    m_slot_map[ii] = m_dead_slot;
+  }
+}
+
+
+// assign a free slot to a new thread
+int thread_state_c::allocate_slot(int tid)
+{
+  ASSERT(tid >= 0);
+  ASSERTM(m_num_free_slot > 0, "tid:%d no free thread slot\n", tid);
+  ASSERT(get_slot(tid) == m_dead_slot);
+
+  int slot = m_free_slot[--m_num_free_slot];
+  m_tid[slot] = tid;
+
+  // another running thread holds the table entry
+  int occupant = m_slot_map[tid & m_slot_map_mask];
+  if (occupant != m_dead_slot) 
+    rehash();
+  else
+    m_slot_map[tid & m_slot_map_mask] = slot;
+
+  m_fetch_ended[slot]          = false;
+  m_thread_reach_end[slot]     = false;
+  m_thread_finished[slot]      = false;
+  m_inst_fetched[slot]         = 0;
+  m_ops_to_be_dispatched[slot] = 0;
+  m_last_fetch_cycle[slot]     = 0;
+  m_trace_info[slot]           = NULL;
+  m_process[slot]              = NULL;
+
+  heartbeat_s* heartbeat         = &m_heartbeat[slot];
+  heartbeat->m_check_done        = false;
+  heartbeat->m_last_time         = 0;
+  heartbeat->m_last_cycle_count  = 0;
+  heartbeat->m_last_inst_count   = 0;
+  heartbeat->m_printed_inst_count = 0;
+
+  return slot;
+}
+
+
+// release the slot of a terminated thread
+void thread_state_c::deallocate_slot(int tid)
+{
+  int slot = get_slot(tid);
+  ASSERTM(slot != m_dead_slot, "tid:%d is not running\n", tid);
+
+  m_tid[slot]        = -1;
+  m_trace_info[slot] = NULL;
+  m_process[slot]    = NULL;
+  m_slot_map[tid & m_slot_map_mask] = m_dead_slot;
+  m_free_slot[m_num_free_slot++]    = slot;
+}
+
+
+// grow the tid to slot table until running threads map to distinct entries
+void thread_state_c::rehash(void)
+{
+  int map_size = m_slot_map_mask + 1;
+  bool collision = true;
+  while (collision) {
+    map_size <<= 1;
+    delete[] m_slot_map;
+    m_slot_map      = new int[map_size];
+    m_slot_map_mask = map_size - 1;
+    for (int ii = 0; ii < map_size; ++ii) {
+      m_slot_map[ii] = m_dead_slot;
+    }
+
+    collision = false;
+    for (int ii = 0; ii < m_num_slot; ++ii) {
+      if (m_tid[ii] == -1)
+        continue;
+      int index = m_tid[ii] & m_slot_map_mask;
+      if (m_slot_map[index] != m_dead_slot) {
+        collision = true;
+        break;
+      }
+      m_slot_map[index] = ii;
+    }
+  }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
 void core_c::init(void)
 {
   m_unique_scheduled_thread_num       = 0; 
@@ -126,17 +285,8 @@ void core_c::init(void)
   m_last_inst_count                   = 0;
   m_appl_id                           = 0;
 
-  m_fetch_ended.clear();
-  m_thread_reach_end.clear();
-  m_thread_finished.clear();
-  m_inst_fetched.clear();
-  m_ops_to_be_dispatched.clear();
-  m_last_fetch_cycle.clear();
-  m_terminated_tid.clear();
-  m_heartbeat.clear();
+  m_thread_state->init();
   m_tid_to_appl_map.clear();
-  m_thread_trace_info.clear();
-  m_bp_recovery_info.clear();
 }
 
 
@@ -154,6 +304,21 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
 
   // configuration
   CORE_CONFIG();
+
+  // pipeline kind : picks the pipeline stage classes and the run_pipeline specialization
+  if (m_core_type == "ptx") 
+    m_core_kind = *KNOB(KNOB_GPU_SCHED) ? CORE_PTX_SM : CORE_PTX;
+  else if (m_knob_schedule == "io") 
+    m_core_kind = CORE_X86_IO;
+  else 
+    m_core_kind = CORE_X86_OOO;
+
+  switch (m_core_kind) {
+    case CORE_X86_OOO: m_run_pipeline = &core_c::run_pipeline<CORE_X86_OOO>; break;
+    case CORE_X86_IO:  m_run_pipeline = &core_c::run_pipeline<CORE_X86_IO>;  break;
+    case CORE_PTX:     m_run_pipeline = &core_c::run_pipeline<CORE_PTX>;     break;
+    case CORE_PTX_SM:  m_run_pipeline = &core_c::run_pipeline<CORE_PTX_SM>;  break;
+  }
   
 
   // memory allocation
@@ -171,7 +336,7 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   m_icache->set_core_id(m_core_id);
 
   // reorder buffer
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     m_rob     = NULL;
     m_gpu_rob = new smc_rob_c(m_unit_type, m_core_id, m_simBase);
   }
@@ -185,7 +350,7 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
       (m_knob_fetch_latency + m_knob_alloc_latency), "q_frontend", m_simBase); 
 
   // allocation queue
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     m_q_iaq     = NULL;
     m_gpu_q_iaq = new pqueue_c<gpu_allocq_entry_s>* [max_ALLOCQ]; 
   }
@@ -200,7 +365,7 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   q_iaq_size[fp_ALLOCQ]  = fq_size;
 
   sstr.clear();
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     for (int i = 0; i < max_ALLOCQ; ++i) {
       sstr << "q_iaq" << i;
       sstr >> name;
@@ -217,14 +382,18 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
     }
   }
 
+  // per-thread state : one more slot than max threads, since a new thread is scheduled
+  // before the terminated one is deallocated (see final_heartbeat)
+  m_thread_state = new thread_state_c(m_max_threads_per_core + 1, m_simBase);
+
   // branch predictor
-  m_bp_data = new bp_data_c(c_id, m_simBase); 
+  m_bp_data = new bp_data_c(c_id, m_thread_state->m_dead_slot + 1, m_simBase); 
 
   // frontend stage
   m_frontend = fetch_factory_c::get()->allocate_frontend(FRONTEND_INTERFACE_ARGS(), m_simBase);
   
   // allocation stage
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     m_allocate = NULL;
     m_gpu_allocate = new smc_allocate_c(m_core_id, m_q_frontend, m_gpu_q_iaq, m_uop_pool, 
         m_gpu_rob, m_unit_type, max_ALLOCQ, m_simBase);
@@ -239,7 +408,7 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   m_exec = new exec_c (EXEC_INTERFACE_ARGS(), m_simBase);
 
   // instruction scheduler
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     m_schedule = new schedule_smc_c (m_core_id, m_gpu_q_iaq, m_gpu_rob, m_exec, m_unit_type, 
         m_frontend, m_simBase);
   }
@@ -261,9 +430,11 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   // hardware prefetcher
   if (*m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON && m_knob_enable_pref) 
     m_hw_pref = new hwp_common_c(c_id, type, m_simBase);
+  else
+    m_hw_pref = NULL;
   
   // const / texture cache
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_USE_CONST_AND_TEX_CACHES) {
+  if (is_ptx() && *m_simBase->m_knobs->KNOB_USE_CONST_AND_TEX_CACHES) {
     m_const_cache = new readonly_cache_c("const_cache", m_core_id, 
         *KNOB(KNOB_CONST_CACHE_SIZE), *KNOB(KNOB_CONST_CACHE_ASSOC), 
         *KNOB(KNOB_CONST_CACHE_LINE_SIZE), *KNOB(KNOB_CONST_CACHE_BANKS), 
@@ -280,7 +451,7 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   }
 
   // shared memory
-  if (m_core_type == "ptx") {
+  if (is_ptx()) {
     m_shared_memory = new sw_managed_cache_c("shared_memory", m_core_id, 
         *KNOB(KNOB_SHARED_MEM_SIZE), *KNOB(KNOB_SHARED_MEM_ASSOC), 
         *KNOB(KNOB_SHARED_MEM_LINE_SIZE), *KNOB(KNOB_SHARED_MEM_BANKS), 
@@ -303,7 +474,7 @@ core_c::~core_c()
   delete m_q_frontend;
   delete m_frontend;
   delete m_uop_pool;
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     delete m_gpu_rob;
     delete m_gpu_allocate;
     for (int i = 0; i < max_ALLOCQ; ++i) {
@@ -321,6 +492,7 @@ core_c::~core_c()
   }
   delete m_map;
   delete m_bp_data;
+  delete m_thread_state;
   delete m_exec;
   delete m_schedule;
   delete m_retire;
@@ -372,11 +544,25 @@ void core_c::run_a_cycle(bool pll_lock)
     return ;
   }
 
+  (this->*m_run_pipeline)();
+
+  ++m_cycle;
+}
+
+
+// pipeline stages of one cycle. The core pipeline kind is a template parameter,
+// so x86/ptx choices are resolved at compile time.
+template <Core_Kind K>
+void core_c::run_pipeline(void)
+{
+  const bool ptx_sim   = (K == CORE_PTX || K == CORE_PTX_SM);
+  const bool gpu_sched = (K == CORE_PTX_SM);
+
   start();
 
   // to simulate kernel invocation from host code
-  if (*KNOB(KNOB_ENABLE_CONDITIONAL_EXECUTION)) {
-    if (m_core_type == "ptx" && m_simBase->m_gpu_paused) {
+  if (ptx_sim && *KNOB(KNOB_ENABLE_CONDITIONAL_EXECUTION)) {
+    if (m_simBase->m_gpu_paused) {
       m_frontend->stop();
     }
   }
@@ -398,15 +584,13 @@ void core_c::run_a_cycle(bool pll_lock)
   m_schedule->run_a_cycle();
 
   // allocate stage
-  if (m_allocate) 
-    m_allocate->run_a_cycle();
-  else 
+  if (gpu_sched) 
     m_gpu_allocate->run_a_cycle();
+  else 
+    m_allocate->run_a_cycle();
 
   // frontend stage
   m_frontend->run_a_cycle();
-
-  ++m_cycle;
 }
 
 
@@ -417,7 +601,7 @@ void core_c::advance_queues(void)
   m_q_frontend->advance();
 
   // advance allocation queue
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (m_core_kind == CORE_PTX_SM) {
     for (int i = 0; i < max_ALLOCQ; ++i) {
       m_gpu_q_iaq[i]->advance();
     }
@@ -437,7 +621,7 @@ void core_c::final_heartbeat(int thread_id)
   m_simBase->m_process_manager->sim_thread_schedule(false); 
 
   // check done
-  m_heartbeat[thread_id]->m_check_done = true; 
+  m_thread_state->m_heartbeat[get_thread_slot(thread_id)].m_check_done = true; 
   
   // thread final heart beat
   thread_heartbeat(thread_id, true);
@@ -450,7 +634,8 @@ void core_c::check_heartbeat(bool final)
   core_heartbeat(final); 
 
   for (int ii = m_last_terminated_tid; ii < m_unique_scheduled_thread_num; ++ii) { 
-    if (m_heartbeat.find(ii) == m_heartbeat.end() || m_heartbeat[ii]->m_check_done) 
+    int slot = get_thread_slot(ii);
+    if (slot == m_thread_state->m_dead_slot || m_thread_state->m_heartbeat[slot].m_check_done) 
       continue; 
 
     // print thread heartbeat
@@ -465,20 +650,22 @@ void core_c::thread_heartbeat(int tid, bool final)
   if (!*m_simBase->m_knobs->KNOB_PRINT_HEARTBEAT)
     return ;
 
+  heartbeat_s* heartbeat = &m_thread_state->m_heartbeat[get_thread_slot(tid)];
+
   /* End Bookkeeping */
   m_inst_count = m_retire->get_instrs_retired(tid);
-  Counter inst_diff = ((m_inst_count > m_heartbeat[tid]->m_printed_inst_count)? 
-                        m_inst_count - m_heartbeat[tid]->m_printed_inst_count : 0);
+  Counter inst_diff = ((m_inst_count > heartbeat->m_printed_inst_count)? 
+                        m_inst_count - heartbeat->m_printed_inst_count : 0);
 
   /* print heartbeat message if necessary */
   if ((*KNOB(KNOB_HEARTBEAT_INTERVAL) && inst_diff >= *KNOB(KNOB_HEARTBEAT_INTERVAL)) || final) {
     time_t cur_time = time(NULL);
-    double int_ipc = (double)(m_inst_count - m_heartbeat[tid]->m_last_inst_count) / 
-                             (m_core_cycle_count - m_heartbeat[tid]->m_last_cycle_count);
+    double int_ipc = (double)(m_inst_count - heartbeat->m_last_inst_count) / 
+                             (m_core_cycle_count - heartbeat->m_last_cycle_count);
     double cum_ipc = (double)m_inst_count / m_core_cycle_count;
 
-    double int_khz = (double)(m_inst_count - m_heartbeat[tid]->m_last_inst_count) / 
-                             (cur_time - m_heartbeat[tid]->m_last_time) / 1000;
+    double int_khz = (double)(m_inst_count - heartbeat->m_last_inst_count) / 
+                             (cur_time - heartbeat->m_last_time) / 1000;
 
     double cum_khz = (double)m_inst_count / (cur_time - m_sim_start_time) / 1000;
     if (final) {
@@ -496,10 +683,10 @@ void core_c::thread_heartbeat(int tid, bool final)
     }
 
     // update thread heartbeat
-    m_heartbeat[tid]->m_last_time           = cur_time;
-    m_heartbeat[tid]->m_last_cycle_count    = m_core_cycle_count;
-    m_heartbeat[tid]->m_last_inst_count     = m_inst_count;
-    m_heartbeat[tid]->m_printed_inst_count += *m_simBase->m_knobs->KNOB_HEARTBEAT_INTERVAL;
+    heartbeat->m_last_time           = cur_time;
+    heartbeat->m_last_cycle_count    = m_core_cycle_count;
+    heartbeat->m_last_inst_count     = m_inst_count;
+    heartbeat->m_printed_inst_count += *m_simBase->m_knobs->KNOB_HEARTBEAT_INTERVAL;
   }
 }
 
@@ -593,44 +780,31 @@ void core_c::check_forward_progress()
 // deallocate those data on demand. Thus, we need to allocate thread-specific data when a 
 // new thread has been launched and deallocate when it is terminated.
 
-// Mostly, these data are maintained using hash structure. 'Allocation' adds new entry in the
-// hash table and 'Deallocation' deletes corresponding entry from the hash table.
+// Core-level thread data is kept in a struct of arrays (thread_state_c). 'Allocation' assigns
+// a dense slot to the thread and 'Deallocation' returns the slot to the free list.
 
 
 // allocate thread specific data
 void core_c::allocate_thread_data(int tid)
 {
   // add thread data
-  m_fetch_ended[tid]          = false;
-  m_thread_finished[tid]      = false;
-  m_thread_reach_end[tid]     = false;
-  m_inst_fetched[tid]         = 0;
-  m_last_fetch_cycle[tid]     = 0;
-  m_ops_to_be_dispatched[tid] = 0;
-
-  // allocate heartbeat
-  heartbeat_s* heartbeat = m_simBase->m_heartbeat_pool->acquire_entry();
-  heartbeat->m_check_done              = false;
-  heartbeat->m_last_time               = 0;
-  heartbeat->m_last_cycle_count        = 0;
-  heartbeat->m_last_inst_count         = 0;
-  heartbeat->m_printed_inst_count      = 0;
-  m_heartbeat[tid]                    = heartbeat; 
+  int slot = m_thread_state->allocate_slot(tid);
+
+  // application of the thread has been added by add_application
+  auto itr = m_tid_to_appl_map.find(tid);
+  if (itr != m_tid_to_appl_map.end())
+    m_thread_state->m_process[slot] = itr->second;
 
   // allocate bp recovery
-  bp_recovery_info_c* bp_recovery_info = m_simBase->m_bp_recovery_info_pool->acquire_entry();
-  bp_recovery_info->m_recovery_cycle   = MAX_CTR;
-  bp_recovery_info->m_redirect_cycle   = MAX_CTR;
-  m_bp_recovery_info[tid]              = bp_recovery_info;
-  m_bp_data->m_bp_recovery_cycle[tid]  = 0;
-  m_bp_data->m_bp_redirect_cycle[tid]  = 0; 
-  m_bp_data->m_bp_cause_op[tid]        = 0;
+  m_bp_data->m_bp_recovery_cycle[slot] = 0;
+  m_bp_data->m_bp_redirect_cycle[slot] = 0; 
+  m_bp_data->m_bp_cause_op[slot]       = 0;
 
   // allocate retire data
   m_retire->allocate_retire_data(tid);
 
   // allocate scheduler queue and rob for GPU simulation
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) 
+  if (m_core_kind == CORE_PTX_SM) 
     m_gpu_rob->reserve_rob(tid);
 }
 
@@ -638,34 +812,21 @@ void core_c::allocate_thread_data(int tid)
 // When a thread is terminated, deallocate all data used by this thread
 void core_c::deallocate_thread_data(int tid)
 {
-  if (tid != 0) {
-    // deallocate heartbeat info
-    heartbeat_s* heartbeat = m_heartbeat[tid];
-    m_heartbeat.erase(tid);
-    m_simBase->m_heartbeat_pool->release_entry(heartbeat);
-
-    // deallocate bp recovery info
-    bp_recovery_info_c* bp_recovery_info = m_bp_recovery_info[tid];
-    m_bp_recovery_info.erase(tid);
-    m_simBase->m_bp_recovery_info_pool->release_entry(bp_recovery_info);
-  }
+  // deallocate per-thread state : from now on, the thread reads the dead slot
+  m_thread_state->deallocate_slot(tid);
 
   // deallocate dependence map
   m_map->delete_map(tid);
 
-  // mark current thread as terminated
-  m_terminated_tid[tid] = true;
-
   // update last terminated thread id : all threads before last_terminted_tid are terminated.
-  // Since threads are terminated not in ascending order, in order to get correct
-  // last_terminated_tid, we need to hold all previous terminated thread ids.
-  int t_id = m_last_terminated_tid;
-  while (m_terminated_tid.find(t_id) != m_terminated_tid.end()) {
-    m_terminated_tid.erase(t_id);
-    m_last_terminated_tid = ++t_id;
+  // Since threads are terminated not in ascending order, skip every scheduled thread
+  // that no longer holds a slot.
+  while (m_last_terminated_tid < m_unique_scheduled_thread_num && 
+      get_thread_slot(m_last_terminated_tid) == m_thread_state->m_dead_slot) {
+    ++m_last_terminated_tid;
   }
 
-  if (m_core_type == "ptx" && *m_simBase->m_knobs->KNOB_GPU_SCHED) 
+  if (m_core_kind == CORE_PTX_SM) 
     m_gpu_rob->free_rob(tid);
 
   // check forward progress
@@ -696,7 +857,7 @@ void core_c::train_hw_pref(int level, int tid, Addr addr, Addr pc, uop_c* uop, b
 void core_c::pref_init(void) 
 {
   if (*m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON && m_knob_enable_pref) {
-    m_hw_pref->pref_init(m_core_type == "ptx" ? true : false);
+    m_hw_pref->pref_init(is_ptx());
   }
 }
 
@@ -712,6 +873,10 @@ void core_c::add_application(int tid, process_s *process)
 {
   m_tid_to_appl_map[tid] = process;
   m_appl_id              = process->m_orig_pid;
+
+  int slot = get_thread_slot(tid);
+  if (slot != m_thread_state->m_dead_slot)
+    m_thread_state->m_process[slot] = process;
 }
 
 
@@ -727,6 +892,11 @@ void core_c::delete_application(int appl_id)
     }
   }
 
+  for (int ii = 0; ii < m_thread_state->m_num_slot; ++ii) {
+    if (m_thread_state->m_process[ii] && m_thread_state->m_process[ii]->m_orig_pid == appl_id)
+      m_thread_state->m_process[ii] = NULL;
+  }
+
   m_appl_id = 0;
 }
 
@@ -734,10 +904,17 @@ void core_c::delete_application(int appl_id)
 // get the application id from the thread id
 int core_c::get_appl_id(int tid)
 {
-  if (m_tid_to_appl_map.find(tid) == m_tid_to_appl_map.end()) 
+  // running threads : read from the slot
+  process_s* process = m_thread_state->m_process[get_thread_slot(tid)];
+  if (process)
+    return process->m_orig_pid;
+
+  // terminated threads may still have outstanding requests
+  auto itr = m_tid_to_appl_map.find(tid);
+  if (itr == m_tid_to_appl_map.end()) 
     return 0;
   else 
-    return m_tid_to_appl_map[tid]->m_orig_pid;
+    return itr->second->m_orig_pid;
 }
 
 
@@ -754,19 +931,16 @@ int core_c::get_appl_id()
 // get the thread trace information
 thread_s* core_c::get_trace_info(int tid)
 {
-  if (m_thread_trace_info.find(tid) == m_thread_trace_info.end())
-    return NULL;
-
-  return m_thread_trace_info[tid];
+  return m_thread_state->m_trace_info[get_thread_slot(tid)];
 }
 
 
 // create a new thread trace information
 void core_c::create_trace_info(int tid, thread_s* thread)
 {
-  m_thread_trace_info[tid] = thread;
-
   allocate_thread_data(tid);
+
+  m_thread_state->m_trace_info[get_thread_slot(tid)] = thread;
   ++m_unique_scheduled_thread_num;
   ++m_running_thread_num;
   ++m_fetching_thread_num;
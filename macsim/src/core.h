@@ -60,6 +60,81 @@ class heartbeat_s {
 };
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief per-core thread state (struct of arrays)
+///
+/// Simulation thread ids grow monotonically in a core, but only a few threads are running
+/// at a time. Each running thread is given a dense slot and its per-thread data lives in
+/// flat arrays indexed by that slot. Threads that are not running share the last (dead)
+/// slot, which reads as fetch-ended and finished, so a lookup never fails.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class thread_state_c
+{
+  public:
+    /**
+     * Constructor
+     * \param num_slot - max number of concurrently running threads
+     * \param simBase - Pointer to base simulation class
+     */
+    thread_state_c(int num_slot, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~thread_state_c(void);
+
+    /**
+     * Release all slots
+     */
+    void init(void);
+
+    /**
+     * Assign a free slot to a newly scheduled thread and reset its state
+     */
+    int allocate_slot(int tid);
+
+    /**
+     * Release the slot of a terminated thread
+     */
+    void deallocate_slot(int tid);
+
+    /**
+     * Get the slot of a thread (dead slot if the thread is not running)
+     */
+    int get_slot(int tid) {
+      int slot = m_slot_map[tid & m_slot_map_mask];
+      return (m_tid[slot] == tid) ? slot : m_dead_slot;
+    }
+
+  private:
+    /**
+     * Double the tid-to-slot table until no two running threads collide
+     */
+    void rehash(void);
+
+  public:
+    int          m_num_slot; /**< number of slots for running threads */
+    int          m_dead_slot; /**< slot shared by all threads that are not running */
+    int*         m_tid; /**< thread id of each slot (-1 if free) */
+    bool*        m_fetch_ended; /**< fetch ended */
+    bool*        m_thread_reach_end; /**< thread reaches last instruction */
+    bool*        m_thread_finished; /**< thread finished */
+    Counter*     m_inst_fetched; /**< number of fetched instructions */
+    Counter*     m_ops_to_be_dispatched; /**< number of uops to be scheduled */
+    Counter*     m_last_fetch_cycle; /**< last fetched cycle */
+    heartbeat_s* m_heartbeat; /**< heartbeat */
+    thread_s**   m_trace_info; /**< thread trace information */
+    process_s**  m_process; /**< application of the thread */
+
+  private:
+    int*      m_free_slot; /**< stack of free slots */
+    int       m_num_free_slot; /**< number of free slots */
+    int*      m_slot_map; /**< direct-mapped tid to slot table */
+    int       m_slot_map_mask; /**< tid to slot table mask */
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Core (processor) class
 ///
@@ -117,6 +192,18 @@ class core_c
      */
     string get_core_type(void) { return m_core_type; }
 
+    /*! \fn Core_Kind get_core_kind(void)
+     *  \brief Function to return core pipeline kind
+     *  \return Core_Kind - Core pipeline kind
+     */
+    Core_Kind get_core_kind(void) { return m_core_kind; }
+
+    /*! \fn bool is_ptx(void)
+     *  \brief Function to check whether this is a ptx (GPU) core
+     *  \return bool - True if ptx core
+     */
+    bool is_ptx(void) { return m_core_kind == CORE_PTX || m_core_kind == CORE_PTX_SM; }
+
     /*! \fn void pref_init(void)
      *  \brief Hardware prefetcher initializer
      *  \return void
@@ -159,6 +246,18 @@ class core_c
      */
     frontend_c* get_frontend(void) { return m_frontend;}
 
+    /*! \fn allocate_c* get_allocate(void)
+     *  \brief Function to get pointer to allocate class (NULL for GPU cores)
+     *  \return allocate_c* - Pointer to allocate class
+     */
+    allocate_c* get_allocate(void) { return m_allocate; }
+
+    /*! \fn schedule_c* get_scheduler(void)
+     *  \brief Function to get pointer to scheduler class
+     *  \return schedule_c* - Pointer to scheduler class
+     */
+    schedule_c* get_scheduler(void) { return m_schedule; }
+
     /*! \fn Counter check_heartbeat(bool final)
      *  \brief Function to check if final heartbeat for cores
      *  \param final - TRUE or FALSE
@@ -272,6 +371,11 @@ class core_c
      */
     void train_hw_pref(int level, int tid, Addr addr, Addr pc, uop_c* uop, bool hit);
 
+    /**
+     * Get hardware prefetchers (NULL if disabled)
+     */
+    hwp_common_c* get_hw_pref(void) { return m_hw_pref; }
+
     /**
      * Get dependence map
      */
@@ -287,6 +391,11 @@ class core_c
      */
     void create_trace_info(int tid, thread_s* thread);
 
+    /**
+     * Get the per-thread state slot of a thread
+     */
+    int get_thread_slot(int tid) { return m_thread_state->get_slot(tid); }
+
     /**
      * Increase and return the unique uop number. Each uop will have unique uop number in a core.
      */
@@ -312,6 +421,11 @@ class core_c
      */
     void init(void);
 
+    /**
+     * Run all pipeline stages, specialized by the core pipeline kind
+     */
+    template <Core_Kind K> void run_pipeline(void);
+
   public:
     // stats to run the simulation (used for the simulation)
     int m_unique_scheduled_thread_num; /**< total number of scheduled threads */
@@ -321,23 +435,19 @@ class core_c
     int m_fetching_block_id;    /**< currently fetching block id */
     int m_running_thread_num;   /**< number of currently running threads */
 
-    // current core stats per thread
-    unordered_map<int, bool> m_fetch_ended; /**< fetch ended */
-    unordered_map<int, bool> m_thread_reach_end; /**< thread reaches last instruction */
-    unordered_map<int, bool> m_thread_finished; /**< thread finished */
-    
+    // current core stats per thread, indexed by get_thread_slot()
+    thread_state_c* m_thread_state; /**< per-thread state */
+
     // additional fetch policies
-    unordered_map<int, Counter> m_inst_fetched; /**< last fetched cycle for the thread */
-    unordered_map<int, Counter> m_ops_to_be_dispatched; /**< number of uops to be scheduled */
-    unordered_map<int, Counter> m_last_fetch_cycle; /**< last fetched cycle */
-    Counter                     m_max_inst_fetched; /**< maximum inst fetched */
+    Counter m_max_inst_fetched; /**< maximum inst fetched */
 
   private:
     int                      m_core_id; /**< core id */
     string                   m_core_type; /**< simulation core type (x86 or ptx) */
+    Core_Kind                m_core_kind; /**< core pipeline kind */
+    void                     (core_c::*m_run_pipeline)(void); /**< run_pipeline specialized for this core */
     Unit_Type                m_unit_type; /**< core type */
     int                      m_last_terminated_tid; /**< last terminated thread id */
-    unordered_map<int, bool> m_terminated_tid; /**< ids of terminated threads */
     Counter                  m_unique_uop_num; /**< unique uop number */
     time_t                   m_sim_start_time; /**< simulation start time */
     Counter                  m_core_cycle_count; /**< current core cycle */
@@ -369,7 +479,6 @@ class core_c
     bp_data_c*                      m_bp_data; /**< branch predictor */
     
     // heartbeat 
-    unordered_map<int, heartbeat_s*> m_heartbeat; /**< heartbeat per thread*/
     time_t  m_heartbeat_last_time_core; /**< last heartbeat time */
     Counter m_heartbeat_last_cycle_count_core; /**< last heartbeat cycle */
     Counter m_heartbeat_last_inst_count_core; /**< last heartbeat inst. count */
@@ -384,9 +493,7 @@ class core_c
     // application id mapping
     unordered_map<int, process_s *> m_tid_to_appl_map; /**< get application id with tid */
     int m_appl_id; /**< id of currently running application */
-    
-    unordered_map<int, thread_s*> m_thread_trace_info; /**< thread trace information */
-    unordered_map<int, bp_recovery_info_c*>  m_bp_recovery_info; /**< thread bp recovery info */
+
 
     // clock cycle
     Counter m_cycle; /**< clock cycle */
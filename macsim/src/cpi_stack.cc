@@ -0,0 +1,230 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/**********************************************************************************************
+ * File         : cpi_stack.cc
+ * Description  : online CPI stack accounting per core and per thread
+ *********************************************************************************************/
+
+
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <map>
+
+#include "cpi_stack.h"
+#include "memreq_info.h"
+#include "uop.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+
+#include "all_knobs.h"
+
+
+// component names, in Cpi_Component order
+static const char* cpi_component_name[CPI_MAX] = {
+  "base", "frontend", "icache", "br_mispred", "load_l1", "load_l2", "load_l3", "load_dram",
+  "structural", "exec", "gpu_no_warp", "gpu_mem", "gpu_barrier",
+};
+
+
+// constructor
+cpi_stack_c::cpi_stack_c(macsim_c* simBase)
+{
+  m_simBase       = simBase;
+  m_interval      = *KNOB(KNOB_CPI_STACK_INTERVAL);
+  m_next_interval = m_interval ? m_interval : MAX_CTR;
+
+  int num_cores = *KNOB(KNOB_NUM_SIM_CORES);
+  cpi_count_s zero;
+  memset(&zero, 0, sizeof(cpi_count_s));
+  m_core.resize(num_cores, zero);
+  m_core_prev.resize(num_cores, zero);
+  m_thread.resize(num_cores);
+  cpi_pending_s none;
+  memset(&none, 0, sizeof(cpi_pending_s));
+  m_pending.resize(num_cores, none);
+
+  string stat_dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(stat_dir.c_str(), S_IRWXU);
+  string path = stat_dir + "/cpi_stack.out";
+  m_file = fopen(path.c_str(), "w");
+  ASSERTM(m_file, "cannot open %s\n", path.c_str());
+
+  fprintf(m_file, "# %-10s %4s %6s %12s %12s %8s", "kind", "core", "thread", "cycles", "insts",
+      "cpi");
+  for (int ii = 0; ii < CPI_MAX; ++ii) {
+    fprintf(m_file, " %11s", cpi_component_name[ii]);
+  }
+  fprintf(m_file, "\n");
+}
+
+
+// destructor
+cpi_stack_c::~cpi_stack_c()
+{
+  // loads still at the rob head when the simulation ends
+  for (unsigned int core_id = 0; core_id < m_pending.size(); ++core_id) {
+    charge_pending(core_id);
+  }
+
+  if (m_interval && CYCLE > m_next_interval - m_interval)
+    write_interval(CYCLE);
+
+  for (unsigned int core_id = 0; core_id < m_core.size(); ++core_id) {
+    cpi_count_s& core = m_core[core_id];
+    if (core.m_cycles == 0)
+      continue;
+
+    Counter slots = 0;
+    for (int ii = 0; ii < CPI_MAX; ++ii) {
+      slots += core.m_slots[ii];
+    }
+    double width = static_cast<double>(slots) / core.m_cycles;
+
+    fprintf(m_file, "  %-10s %4d %6s", "core", core_id, "-");
+    write_stack(core, core.m_cycles, width);
+
+    // threads share the retire slots of the core; sorted by thread id
+    map<int, cpi_count_s> threads(m_thread[core_id].begin(), m_thread[core_id].end());
+    for (auto I = threads.begin(), E = threads.end(); I != E; ++I) {
+      Counter thread_slots = 0;
+      for (int ii = 0; ii < CPI_MAX; ++ii) {
+        thread_slots += I->second.m_slots[ii];
+      }
+      fprintf(m_file, "  %-10s %4d %6d", "thread", core_id, I->first);
+      write_stack(I->second, static_cast<Counter>(thread_slots / width), width);
+    }
+  }
+
+  fclose(m_file);
+}
+
+
+// retired uop
+void cpi_stack_c::retire_uop(uop_c* uop, bool slot)
+{
+  int core_id   = uop->m_core_id;
+  int thread_id = slot ? uop->m_thread_id : -1;
+
+  if (uop->m_warm->m_isitBOM) {
+    ++m_core[core_id].m_insts;
+    if (thread_id >= 0)
+      ++m_thread[core_id][thread_id].m_insts;
+  }
+
+  if (!slot)
+    return;
+
+  add(core_id, thread_id, CPI_BASE, 1);
+
+  cpi_pending_s& pending = m_pending[core_id];
+  if (pending.m_slots && pending.m_unique_num == uop->m_unique_num) {
+    pending.m_mem_level = uop->m_cold->m_uop_info.m_mem_level;
+    charge_pending(core_id);
+  }
+}
+
+
+// rob head load stall
+void cpi_stack_c::stall_load(uop_c* uop, Counter slots)
+{
+  cpi_pending_s& pending = m_pending[uop->m_core_id];
+
+  // the previous load left the head without retiring (flushed) : charge it now
+  if (pending.m_slots && pending.m_unique_num != uop->m_unique_num)
+    charge_pending(uop->m_core_id);
+
+  pending.m_unique_num = uop->m_unique_num;
+  pending.m_thread_id  = uop->m_thread_id;
+  pending.m_mem_level  = uop->m_cold->m_uop_info.m_mem_level;
+  pending.m_slots     += slots;
+}
+
+
+// charge pending rob head load slots
+void cpi_stack_c::charge_pending(int core_id)
+{
+  cpi_pending_s& pending = m_pending[core_id];
+  if (pending.m_slots == 0)
+    return;
+
+  add(core_id, pending.m_thread_id, load_component(pending.m_mem_level), pending.m_slots);
+  pending.m_slots = 0;
+}
+
+
+Cpi_Component cpi_stack_c::load_component(int level)
+{
+  switch (level) {
+    case MEM_L2: return CPI_LOAD_L2;
+    case MEM_L3: return CPI_LOAD_L3;
+    case MEM_MC: return CPI_LOAD_DRAM;
+    default:     return CPI_LOAD_L1;
+  }
+}
+
+
+// per-core deltas since the last interval
+void cpi_stack_c::write_interval(Counter cycle)
+{
+  fprintf(m_file, "# cycle %llu\n", cycle);
+  for (unsigned int core_id = 0; core_id < m_core.size(); ++core_id) {
+    cpi_count_s delta;
+    Counter slots = 0;
+    for (int ii = 0; ii < CPI_MAX; ++ii) {
+      delta.m_slots[ii] = m_core[core_id].m_slots[ii] - m_core_prev[core_id].m_slots[ii];
+      slots += delta.m_slots[ii];
+    }
+    delta.m_insts  = m_core[core_id].m_insts - m_core_prev[core_id].m_insts;
+    delta.m_cycles = m_core[core_id].m_cycles - m_core_prev[core_id].m_cycles;
+    m_core_prev[core_id] = m_core[core_id];
+
+    if (delta.m_cycles == 0)
+      continue;
+
+    fprintf(m_file, "  %-10s %4d %6s", "interval", core_id, "-");
+    write_stack(delta, delta.m_cycles, static_cast<double>(slots) / delta.m_cycles);
+  }
+
+  m_next_interval = cycle + m_interval;
+}
+
+
+void cpi_stack_c::write_stack(const cpi_count_s& count, Counter cycles, double width)
+{
+  double insts = count.m_insts ? count.m_insts : 1;
+
+  fprintf(m_file, " %12llu %12llu %8.4f", cycles, count.m_insts, cycles / insts);
+  for (int ii = 0; ii < CPI_MAX; ++ii) {
+    fprintf(m_file, " %11.4f", count.m_slots[ii] / width / insts);
+  }
+  fprintf(m_file, "\n");
+}
@@ -0,0 +1,196 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/**********************************************************************************************
+ * File         : cpi_stack.h
+ * Description  : online CPI stack accounting per core and per thread
+ *********************************************************************************************/
+
+#ifndef CPI_STACK_H_INCLUDED
+#define CPI_STACK_H_INCLUDED
+
+
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+
+#include "macsim.h"
+#include "global_types.h"
+#include "global_defs.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief CPI stack component (cause of an unused retire slot)
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum Cpi_Component_enum {
+  CPI_BASE = 0,      /**< slot used by a retired uop */
+  CPI_FRONTEND,      /**< empty rob, no fetch bubble cause known (fetch/decode bandwidth) */
+  CPI_ICACHE,        /**< empty rob after an instruction cache miss */
+  CPI_BR_MISPRED,    /**< empty rob after a branch misprediction */
+  CPI_LOAD_L1,       /**< load at the rob head, serviced by L1 */
+  CPI_LOAD_L2,       /**< load at the rob head, serviced by L2 */
+  CPI_LOAD_L3,       /**< load at the rob head, serviced by L3 */
+  CPI_LOAD_DRAM,     /**< load at the rob head, serviced by dram */
+  CPI_STRUCTURAL,    /**< rob/load/store buffer or register file full */
+  CPI_EXEC,          /**< non-load uop at the rob head still executing (dependences) */
+  CPI_GPU_NO_WARP,   /**< GPU : no warp ready to retire */
+  CPI_GPU_MEM,       /**< GPU : oldest uop of a warp waits for memory */
+  CPI_GPU_BARRIER,   /**< GPU : warps blocked on a barrier */
+  CPI_MAX
+} Cpi_Component;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief online CPI stack
+///
+/// Every cycle each retire slot of a core is attributed to exactly one component, so the
+/// components of a core add up to retire width x cycles. x86 slots are uops; an unused
+/// slot is charged to
+///   - the fetch bubble that emptied the rob (icache miss, branch misprediction, other),
+///   - the load at the rob head, by the level that serviced it (charged when it retires;
+///     if another uop reaches the head first or the simulation ends, by the level known
+///     at that point),
+///   - a structural stall when allocation was blocked on rob/lsq/register resources,
+///   - otherwise execution of the uop at the rob head.
+/// GPU cores retire from many warps at once, so a GPU slot is a whole cycle: it is base
+/// when any uop retired, otherwise memory (a warp's oldest uop is a pending load),
+/// barrier, or no ready warp, in that order. GPU cycles are only accounted per core.
+///
+/// cpi_stack.out (statistics directory) gets one line per core every cpi_stack_interval
+/// cycles and the final per-core and per-thread stacks. Each component is reported as its
+/// contribution to CPI; the contributions add up to the CPI of the core/thread.
+/// Enabled with collect_cpi_info.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class cpi_stack_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    cpi_stack_c(macsim_c* simBase);
+
+    /**
+     * Destructor. Write the final stacks.
+     */
+    ~cpi_stack_c();
+
+    /**
+     * Write an interval line per core when the interval has elapsed
+     */
+    inline void run_a_cycle(Counter cycle)
+    {
+      if (cycle >= m_next_interval)
+        write_interval(cycle);
+    }
+
+    /**
+     * Charge slots to a component
+     * @param thread_id thread id (-1: core only)
+     */
+    inline void add(int core_id, int thread_id, Cpi_Component component, Counter slots)
+    {
+      m_core[core_id].m_slots[component] += slots;
+      if (thread_id >= 0)
+        m_thread[core_id][thread_id].m_slots[component] += slots;
+    }
+
+    /**
+     * One more accounted cycle of a core
+     */
+    inline void cycle(int core_id)
+    {
+      ++m_core[core_id].m_cycles;
+    }
+
+    /**
+     * The load at the rob head held up slots this cycle. The slots stay pending until the
+     * load retires and its servicing level is known.
+     */
+    void stall_load(uop_c* uop, Counter slots);
+
+    /**
+     * A uop retired. Counts the instruction and, for slot (x86) accounting, the base slot
+     * and the stall slots pending while it was a load at the rob head.
+     */
+    void retire_uop(uop_c* uop, bool slot);
+
+    /**
+     * Rob head load component from the level that serviced the load (0: L1 hit)
+     */
+    static Cpi_Component load_component(int level);
+
+  private:
+    /**
+     * Per core/thread counters
+     */
+    typedef struct cpi_count_s {
+      Counter m_slots[CPI_MAX]; /**< slots per component */
+      Counter m_insts; /**< retired instructions */
+      Counter m_cycles; /**< accounted cycles (core only) */
+    } cpi_count_s;
+
+    /**
+     * Rob head load stall slots of a core that are not charged yet
+     */
+    typedef struct cpi_pending_s {
+      Counter m_unique_num; /**< unique number of the load */
+      int     m_thread_id; /**< thread id of the load */
+      int     m_mem_level; /**< level that serviced the load so far */
+      Counter m_slots; /**< pending slots */
+    } cpi_pending_s;
+
+    /**
+     * Charge the pending load slots of a core by the last known level
+     */
+    void charge_pending(int core_id);
+
+    /**
+     * Write one interval line per core
+     */
+    void write_interval(Counter cycle);
+
+    /**
+     * Write a stack line: cycles, instructions, cpi and the components
+     * @param width retire slots per cycle
+     */
+    void write_stack(const cpi_count_s& count, Counter cycles, double width);
+
+  private:
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+    FILE*     m_file; /**< output file */
+    Counter   m_interval; /**< interval in cycles (0: final stacks only) */
+    Counter   m_next_interval; /**< cycle of the next interval line */
+    vector<cpi_count_s> m_core; /**< per core counters */
+    vector<cpi_count_s> m_core_prev; /**< per core counters at the last interval */
+    vector<cpi_pending_s> m_pending; /**< per core pending rob head load slots */
+    vector<unordered_map<int, cpi_count_s> > m_thread; /**< per core, per thread counters */
+};
+
+#endif
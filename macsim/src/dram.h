@@ -98,6 +98,10 @@ class dram_c
 // wrapper function to allocate a dram scheduler
 dram_c* fcfs_controller(macsim_c* simBase);
 dram_c* frfcfs_controller(macsim_c* simBase);
+dram_c* parbs_controller(macsim_c* simBase);
+dram_c* atlas_controller(macsim_c* simBase);
+dram_c* tcm_controller(macsim_c* simBase);
+dram_c* bliss_controller(macsim_c* simBase);
 
 
 #endif
@@ -36,6 +36,9 @@ POSSIBILITY OF SUCH DAMAGE.
  *********************************************************************************************/
 
 
+#include <fstream>
+#include <sstream>
+
 #include "assert_macros.h"
 #include "debug_macros.h"
 #include "dram_ctrl.h"
@@ -43,6 +46,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "memreq_info.h"
 #include "utils.h"
 #include "bug_detector.h"
+#include "pc_profiler.h"
 #include "network.h"
 
 #include "all_knobs.h"
@@ -92,6 +96,7 @@ int dram_ctrl_c::dram_req_priority[DRAM_REQ_PRIORITY_COUNT] =
   0, // MRT_SW_DPRF_T0
   0, // MRT_SW_DPRF_T1
   0, // MRT_SW_DPRF_T2
+  0, // MRT_COH
   0  // MAX_MEM_REQ_TYPE
 };
 
@@ -137,6 +142,9 @@ void drb_entry_s::reset()
   m_size      = 0;
   m_timestamp = 0;
   m_scheduled = 0;
+  m_row_conflict = false;
+  m_interference = 0;
+  m_marked    = false;
 }
 
 
@@ -180,6 +188,10 @@ dram_ctrl_c::dram_ctrl_c(macsim_c* simBase)
   m_num_channel          = *KNOB(KNOB_DRAM_NUM_CHANNEL);
   m_num_bank_per_channel = m_num_bank / m_num_channel;
   m_bus_width            = *KNOB(KNOB_DRAM_BUS_WIDTH);
+  m_num_app              = *KNOB(KNOB_DRAM_NUM_APPLICATION);
+
+  // per-application stats are DRAM_APP0.. DRAM_APP7
+  ASSERTM(m_num_app >= 1 && m_num_app <= 8, "dram_num_application should be 1..8\n");
   
   // bank
   m_buffer           = new list<drb_entry_s*>[m_num_bank];
@@ -209,10 +221,45 @@ dram_ctrl_c::dram_ctrl_c(macsim_c* simBase)
   // channel
   m_byte_avail = new int[m_num_channel];
   m_dbus_ready = new Counter[m_num_channel];
+  m_bus_dir    = new int[m_num_channel];
+  m_wtr_ready  = new Counter[m_num_channel];
 
   for (int ii = 0; ii < m_num_channel; ++ii) {
     m_byte_avail[ii] = m_bus_width;
     m_dbus_ready[ii] = 0;
+    m_bus_dir[ii]    = -1;
+    m_wtr_ready[ii]  = 0;
+  }
+  m_twtr = *KNOB(KNOB_DRAM_TWTR);
+
+
+  // write queue
+  m_wq_size   = *KNOB(KNOB_DRAM_WRITE_QUEUE_SIZE);
+  m_wq_high   = *KNOB(KNOB_DRAM_WRITE_HIGH_WATERMARK);
+  m_wq_low    = *KNOB(KNOB_DRAM_WRITE_LOW_WATERMARK);
+  m_line_mask = *KNOB(KNOB_L3_LINE_SIZE) - 1;
+  if (m_wq_size) {
+    ASSERTM(m_wq_low < m_wq_high && m_wq_high <= m_wq_size, 
+        "dram write watermarks should be low < high <= dram_write_queue_size (%d %d %d)\n",
+        m_wq_low, m_wq_high, m_wq_size);
+
+    m_write_queue   = new list<drb_entry_s*>[m_num_channel];
+    m_wq_free_list  = new list<drb_entry_s*>[m_num_channel];
+    m_wq_drain      = new bool[m_num_channel];
+    m_channel_reads = new int[m_num_channel];
+    for (int ii = 0; ii < m_num_channel; ++ii) {
+      for (int jj = 0; jj < m_wq_size; ++jj) {
+        m_wq_free_list[ii].push_back(new drb_entry_s(m_simBase));
+      }
+      m_wq_drain[ii]      = false;
+      m_channel_reads[ii] = 0;
+    }
+  }
+  else {
+    m_write_queue   = NULL;
+    m_wq_free_list  = NULL;
+    m_wq_drain      = NULL;
+    m_channel_reads = NULL;
   }
 
   
@@ -250,6 +297,24 @@ dram_ctrl_c::dram_ctrl_c(macsim_c* simBase)
   m_activate_latency  = *KNOB(KNOB_DRAM_ACTIVATE);
   m_column_latency    = *KNOB(KNOB_DRAM_COLUMN);
 
+  // command timing
+  m_timing_model = static_cast<string>(*KNOB(KNOB_DRAM_TIMING_SPEC)) != "none";
+  if (m_timing_model) {
+    init_timing(*KNOB(KNOB_DRAM_TIMING_SPEC));
+  }
+  else {
+    m_bank_rank     = NULL;
+    m_bank_group    = NULL;
+    m_bank_timer    = NULL;
+    m_group_timer   = NULL;
+    m_rank_timer    = NULL;
+    m_channel_timer = NULL;
+    m_faw           = NULL;
+    m_faw_index     = NULL;
+    m_refresh_due   = NULL;
+    m_last_rank     = NULL;
+  }
+
   // output buffer
   m_output_buffer = new list<mem_req_s*>;
   if (*KNOB(KNOB_DRAM_ADDITIONAL_LATENCY)) {
@@ -271,6 +336,22 @@ dram_ctrl_c::~dram_ctrl_c()
   delete[] m_data_avail;
   delete[] m_bank_ready;
   delete[] m_bank_timestamp;
+  delete[] m_bank_rank;
+  delete[] m_bank_group;
+  delete[] m_bank_timer;
+  delete[] m_group_timer;
+  delete[] m_rank_timer;
+  delete[] m_channel_timer;
+  delete[] m_faw;
+  delete[] m_faw_index;
+  delete[] m_refresh_due;
+  delete[] m_last_rank;
+  delete[] m_bus_dir;
+  delete[] m_wtr_ready;
+  delete[] m_write_queue;
+  delete[] m_wq_free_list;
+  delete[] m_wq_drain;
+  delete[] m_channel_reads;
   delete m_output_buffer;
   delete m_tmp_output_buffer;
 }
@@ -319,8 +400,19 @@ bool dram_ctrl_c::insert_new_req(mem_req_s* mem_req)
     bid = bid ^ bid_xor;
   }
 
+  if (m_wq_size && mem_req->m_type == MRT_WB) {
+    // write queue : merge with a queued write to the line, or wait for a free entry
+    int channel_id = bid / m_num_bank_per_channel;
+    if (coalesce_write(channel_id, mem_req))
+      return true;
+
+    if (m_wq_free_list[channel_id].empty()) {
+      STAT_EVENT(DRAM_WQ_FULL);
+      return false;
+    }
+  }
   // check buffer full
-  if (m_buffer_free_list[bid].empty()) {
+  else if (m_buffer_free_list[bid].empty()) {
     flush_prefetch(bid);
   
     if (m_buffer_free_list[bid].empty()) {
@@ -337,6 +429,8 @@ bool dram_ctrl_c::insert_new_req(mem_req_s* mem_req)
 
   ++m_total_req;
   mem_req->m_state = MEM_DRAM_START;
+  mem_req->m_service_level = MEM_MC;
+  mem_req->set_stage(MEM_STAGE_DRAM_QUEUE, CYCLE);
 
   DEBUG("MC[%d] new_req:%d bid:%lu rid:%lu cid:%lu\n", m_id, mem_req->m_id, bid, rid, cid);
 
@@ -355,6 +449,7 @@ void dram_ctrl_c::flush_prefetch(int bid)
   }
 
   for (auto I = done_list.begin(), E  = done_list.end(); I != E; ++I) {
+    on_flush(*I);
     MEMORY->free_req((*I)->m_req->m_core_id, (*I)->m_req);
     m_buffer_free_list[bid].push_back((*I));
     m_buffer[bid].remove((*I));
@@ -366,15 +461,27 @@ void dram_ctrl_c::flush_prefetch(int bid)
 // insert a new request to dram request buffer (DRB)
 void dram_ctrl_c::insert_req_in_drb(mem_req_s* mem_req, uint64_t bid, uint64_t rid, uint64_t cid)
 {
-  drb_entry_s* new_entry = m_buffer_free_list[bid].front();
-  m_buffer_free_list[bid].pop_front();
+  // write-backs go to the write queue of the channel
+  bool write_queue = m_wq_size && mem_req->m_type == MRT_WB;
+  int channel_id   = bid / m_num_bank_per_channel;
+  list<drb_entry_s*>* free_list = write_queue ? &m_wq_free_list[channel_id] : 
+    &m_buffer_free_list[bid];
+
+  drb_entry_s* new_entry = free_list->front();
+  free_list->pop_front();
 
   // set drb_entry
   new_entry->set(mem_req, bid, rid, cid); 
   new_entry->m_timestamp = m_cycle;
 
   // insert new drb entry to drb 
-  m_buffer[bid].push_back(new_entry);
+  if (write_queue) {
+    m_write_queue[channel_id].push_back(new_entry);
+    STAT_EVENT(DRAM_WQ_INSERT);
+  }
+  else {
+    m_buffer[bid].push_back(new_entry);
+  }
 
   POWER_EVENT(POWER_MC_W);
 }
@@ -463,6 +570,16 @@ void dram_ctrl_c::print_req(void)
     }
   }
 
+  // print write queues
+  for (int ii = 0; m_wq_size && ii < m_num_channel; ++ii) {
+    fprintf(fp, "channel_id:%d write queue drain:%d\n", ii, m_wq_drain[ii]);
+    for (auto I = m_write_queue[ii].begin(), E = m_write_queue[ii].end(); I != E; ++I) {
+      fprintf(fp, "req_id:%-10d bank:%-3d time:%lld delta:%lld\n", 
+          (*I)->m_req->m_id, (int)(*I)->m_bid, (*I)->m_timestamp, 
+          m_cycle - (*I)->m_timestamp);
+    }
+  }
+
   fclose(fp);
 
 //  g_memory->print_mshr();
@@ -498,6 +615,7 @@ void dram_ctrl_c::bank_schedule_complete(void)
         for (auto I = m_buffer[ii].begin(), E  = m_buffer[ii].end(); I != E; ++I) {
           if ((*I)->m_addr == m_current_list[ii]->m_addr) {
             on_complete(*I);
+            app_account(*I);
             if ((*I)->m_req->m_type == MRT_WB) {
               DEBUG("MC[%d] merged_req:%d addr:%s type:%s done\n", \
                   m_id, (*I)->m_req->m_id, hexstr64s((*I)->m_req->m_addr), \
@@ -512,6 +630,7 @@ void dram_ctrl_c::bank_schedule_complete(void)
                 m_output_buffer->push_back((*I)->m_req);
               }
               (*I)->m_req->m_state = MEM_DRAM_DONE;
+              (*I)->m_req->set_stage(MEM_STAGE_NOC, CYCLE);
               DEBUG("MC[%d] merged_req:%d addr:%s typs:%s done\n", \
                   m_id, (*I)->m_req->m_id, hexstr64s((*I)->m_req->m_addr), \
                   mem_req_c::mem_req_type_name[(*I)->m_req->m_type]);
@@ -535,8 +654,22 @@ void dram_ctrl_c::bank_schedule_complete(void)
       
       STAT_EVENT(DRAM_AVG_LATENCY_BASE);
       STAT_EVENT_N(DRAM_AVG_LATENCY, m_cycle - m_current_list[ii]->m_timestamp);
+      if (m_current_list[ii]->m_read) {
+        STAT_EVENT(DRAM_READ_LATENCY_BASE);
+        STAT_EVENT_N(DRAM_READ_LATENCY, m_cycle - m_current_list[ii]->m_timestamp);
+      }
 
       on_complete(m_current_list[ii]);
+      app_account(m_current_list[ii]);
+
+      // requests of other applications waited for the whole service time
+      Counter service = m_cycle - m_current_list[ii]->m_scheduled;
+      int app = app_index(m_current_list[ii]->m_appl_id);
+      for (auto I = m_buffer[ii].begin(), E = m_buffer[ii].end(); I != E; ++I) {
+        if (app_index((*I)->m_appl_id) != app)
+          (*I)->m_interference += service;
+      }
+
       // wb request will be retired immediately
       if (m_current_list[ii]->m_req->m_type == MRT_WB) {
         DEBUG("MC[%d] req:%d addr:%s type:%s done\n", 
@@ -555,14 +688,14 @@ void dram_ctrl_c::bank_schedule_complete(void)
           m_output_buffer->push_back(m_current_list[ii]->m_req);
         }
         m_current_list[ii]->m_req->m_state = MEM_DRAM_DONE;
+        m_current_list[ii]->m_req->set_stage(MEM_STAGE_NOC, CYCLE);
         DEBUG("MC[%d] req:%d addr:%s type:%s bank:%d done\n", 
             m_id, m_current_list[ii]->m_req->m_id, \
             hexstr64s(m_current_list[ii]->m_req->m_addr), \
             mem_req_c::mem_req_type_name[m_current_list[ii]->m_req->m_type], ii);
       }
 
-      m_current_list[ii]->reset();
-      m_buffer_free_list[ii].push_back(m_current_list[ii]);
+      free_entry(ii, m_current_list[ii]);
       m_current_list[ii] = NULL;
       m_data_ready[ii]   = ULLONG_MAX;
       ++m_num_completed_in_last_cycle;
@@ -664,21 +797,39 @@ void dram_ctrl_c::receive(void)
 // otherwise, make it ready for next command.
 void dram_ctrl_c::bank_schedule_new(void)
 {
+  if (m_wq_size)
+    update_write_drain();
+
   for (int ii = 0; ii < m_num_bank; ++ii) {
-    if (m_buffer[ii].empty() && m_current_list[ii] == NULL)
+    // queued writes go in drain mode, or when the channel has no read
+    drb_entry_s* write = NULL;
+    if (m_wq_size && m_current_list[ii] == NULL)
+      write = schedule_write(ii);
+
+    if (m_buffer[ii].empty() && m_current_list[ii] == NULL && write == NULL)
       continue;
 
     // current list is empty. find a new one.
     if (m_current_list[ii] == NULL) {
-      drb_entry_s* entry = schedule(&m_buffer[ii]);
-      ASSERT(entry);
+      drb_entry_s* entry;
+      if (write) {
+        entry = write;
+        m_write_queue[ii / m_num_bank_per_channel].remove(entry);
+      }
+      else {
+        // reads wait until the write drain is over
+        if (m_wq_size && m_wq_drain[ii / m_num_bank_per_channel])
+          continue;
+
+        entry = schedule(&m_buffer[ii]);
+        ASSERT(entry);
+        m_buffer[ii].remove(entry);
+      }
 
       m_current_list[ii] = entry;
       m_current_list[ii]->m_state = DRAM_CMD;
       m_current_list[ii]->m_scheduled = m_cycle;
 
-      m_buffer[ii].remove(entry);
-
       m_bank_ready[ii]     = ULLONG_MAX;
       m_bank_timestamp[ii] = m_cycle;
 
@@ -725,6 +876,14 @@ void dram_ctrl_c::channel_schedule(void)
 // schedule command-ready bank.
 void dram_ctrl_c::channel_schedule_cmd(void)
 {
+  if (m_timing_model) {
+    for (int ii = 0; ii < m_num_channel; ++ii) {
+      if (!refresh(ii))
+        timed_schedule_cmd(ii);
+    }
+    return ;
+  }
+
   for (int ii = 0; ii < m_num_channel; ++ii) {
     Counter oldest = ULLONG_MAX;
     int bank = -1;
@@ -740,6 +899,8 @@ void dram_ctrl_c::channel_schedule_cmd(void)
     if (bank != -1) {
       ASSERT(m_current_list[bank]->m_state == DRAM_CMD);
       m_current_list[bank]->m_req->m_state = MEM_DRAM_CMD;
+      if (m_current_list[bank]->m_req->m_stage == MEM_STAGE_DRAM_QUEUE)
+        m_current_list[bank]->m_req->set_stage(MEM_STAGE_DRAM, CYCLE);
       // activate
       if (m_current_rid[bank] == ULLONG_MAX) {
         m_current_rid[bank] = m_current_list[bank]->m_rid;
@@ -763,6 +924,7 @@ void dram_ctrl_c::channel_schedule_cmd(void)
         m_bank_ready[bank]  = m_cycle + m_precharge_latency;
         m_data_avail[bank]   = ULLONG_MAX;
         m_current_list[bank]->m_state = DRAM_CMD_WAIT;
+        m_current_list[bank]->m_row_conflict = true;
         STAT_EVENT(DRAM_PRECHARGE);
         DEBUG("bank[%d] req:%d precharge\n", bank, m_current_list[bank]->m_req->m_id);
       }
@@ -774,6 +936,10 @@ void dram_ctrl_c::channel_schedule_cmd(void)
 // schedule data-ready bank.
 void dram_ctrl_c::channel_schedule_data(void)
 {
+  // the command timing model reserves the data bus with the column command
+  if (m_timing_model)
+    return ;
+
   for (int ii = 0; ii < m_num_channel; ++ii) {
     // check whether the dram bandwidth has been saturated
     if (!avail_data_bus(ii)) {
@@ -807,6 +973,12 @@ void dram_ctrl_c::channel_schedule_data(void)
       }
 
       if (bank != -1) {
+        // write to read turnaround
+        if (m_twtr && m_current_list[bank]->m_read && m_wtr_ready[ii] > m_cycle) {
+          STAT_EVENT(DRAM_WTR_STALL);
+          break;
+        }
+
         m_current_list[bank]->m_req->m_state = MEM_DRAM_DATA;
         DEBUG("bank[%d] req:%d has acquired data bus\n", \
             bank, m_current_list[bank]->m_req->m_id);
@@ -815,6 +987,10 @@ void dram_ctrl_c::channel_schedule_data(void)
             m_current_list[bank]->m_req->m_ptx);
         m_data_avail[bank] = ULLONG_MAX;
         m_current_list[bank]->m_state = DRAM_DATA_WAIT;
+
+        count_turnaround(ii, m_current_list[bank]->m_read);
+        if (!m_current_list[bank]->m_read)
+          m_wtr_ready[ii] = m_data_ready[bank] + m_twtr;
       }
       else
         break;
@@ -823,6 +999,365 @@ void dram_ctrl_c::channel_schedule_data(void)
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+// command timing model
+
+
+// load the speed grade and reset the command timing registers
+void dram_ctrl_c::init_timing(const string& spec)
+{
+  struct {
+    const char* m_name;
+    int*        m_value;
+  } params[] = {
+    {"tBL",    &m_timing.m_tBL},
+    {"tCL",    &m_timing.m_tCL},
+    {"tCWL",   &m_timing.m_tCWL},
+    {"tRCD",   &m_timing.m_tRCD},
+    {"tRP",    &m_timing.m_tRP},
+    {"tRAS",   &m_timing.m_tRAS},
+    {"tRC",    &m_timing.m_tRC},
+    {"tWR",    &m_timing.m_tWR},
+    {"tRTP",   &m_timing.m_tRTP},
+    {"tWTR_S", &m_timing.m_tWTR_S},
+    {"tWTR_L", &m_timing.m_tWTR_L},
+    {"tRRD_S", &m_timing.m_tRRD_S},
+    {"tRRD_L", &m_timing.m_tRRD_L},
+    {"tCCD_S", &m_timing.m_tCCD_S},
+    {"tCCD_L", &m_timing.m_tCCD_L},
+    {"tFAW",   &m_timing.m_tFAW},
+    {"tRTRS",  &m_timing.m_tRTRS},
+    {"tREFI",  &m_timing.m_tREFI},
+    {"tRFC",   &m_timing.m_tRFC},
+  };
+  int num_params = sizeof(params) / sizeof(params[0]);
+
+  for (int ii = 0; ii < num_params; ++ii) {
+    *params[ii].m_value = -1;
+  }
+
+  ifstream file(spec.c_str());
+  ASSERTM(file.is_open(), "cannot open dram timing spec %s\n", spec.c_str());
+
+  string line;
+  while (getline(file, line)) {
+    stringstream sstr(line.substr(0, line.find('#')));
+    string name;
+    int value = -1;
+    if (!(sstr >> name))
+      continue;
+    sstr >> value;
+
+    int ii;
+    for (ii = 0; ii < num_params; ++ii) {
+      if (name == params[ii].m_name)
+        break;
+    }
+    ASSERTM(ii < num_params, "%s: unknown timing parameter %s\n", spec.c_str(), name.c_str());
+    ASSERTM(value >= 0, "%s: bad value for %s\n", spec.c_str(), name.c_str());
+    *params[ii].m_value = value;
+  }
+
+  // no bank groups (DDR3)
+  if (m_timing.m_tWTR_L == -1) m_timing.m_tWTR_L = m_timing.m_tWTR_S;
+  if (m_timing.m_tRRD_L == -1) m_timing.m_tRRD_L = m_timing.m_tRRD_S;
+  if (m_timing.m_tCCD_L == -1) m_timing.m_tCCD_L = m_timing.m_tCCD_S;
+
+  for (int ii = 0; ii < num_params; ++ii) {
+    ASSERTM(*params[ii].m_value >= 0, "%s: %s is missing\n", spec.c_str(), params[ii].m_name);
+  }
+
+
+  // page policy
+  string policy = *KNOB(KNOB_DRAM_PAGE_POLICY);
+  if (policy == "open")
+    m_page_policy = DRAM_PAGE_OPEN;
+  else if (policy == "closed")
+    m_page_policy = DRAM_PAGE_CLOSED;
+  else if (policy == "adaptive")
+    m_page_policy = DRAM_PAGE_ADAPTIVE;
+  else
+    ASSERTM(0, "unknown dram_page_policy %s\n", policy.c_str());
+
+
+  // organization : channel - rank - bank group - bank
+  m_num_rank       = *KNOB(KNOB_DRAM_NUM_RANKS);
+  m_num_bank_group = *KNOB(KNOB_DRAM_NUM_BANK_GROUPS);
+  ASSERTM(m_num_bank_per_channel % m_num_rank == 0, "%d banks per channel, %d ranks\n",
+      m_num_bank_per_channel, m_num_rank);
+  m_num_bank_per_rank = m_num_bank_per_channel / m_num_rank;
+  ASSERTM(m_num_bank_per_rank % m_num_bank_group == 0, "%d banks per rank, %d bank groups\n",
+      m_num_bank_per_rank, m_num_bank_group);
+
+  int num_rank  = m_num_channel * m_num_rank;
+  int num_group = num_rank * m_num_bank_group;
+
+  // consecutive banks go to different bank groups
+  m_bank_rank  = new int[m_num_bank];
+  m_bank_group = new int[m_num_bank];
+  for (int ii = 0; ii < m_num_bank; ++ii) {
+    m_bank_rank[ii]  = ii / m_num_bank_per_rank;
+    m_bank_group[ii] = m_bank_rank[ii] * m_num_bank_group +
+      (ii % m_num_bank_per_rank) % m_num_bank_group;
+  }
+
+  m_bank_timer    = new dram_timer_s[m_num_bank];
+  m_group_timer   = new dram_timer_s[num_group];
+  m_rank_timer    = new dram_timer_s[num_rank];
+  m_channel_timer = new dram_timer_s[m_num_channel];
+  memset(m_bank_timer, 0, sizeof(dram_timer_s) * m_num_bank);
+  memset(m_group_timer, 0, sizeof(dram_timer_s) * num_group);
+  memset(m_rank_timer, 0, sizeof(dram_timer_s) * num_rank);
+  memset(m_channel_timer, 0, sizeof(dram_timer_s) * m_num_channel);
+
+  m_faw         = new Counter[num_rank * 4];
+  m_faw_index   = new int[num_rank];
+  m_refresh_due = new Counter[num_rank];
+  memset(m_faw, 0, sizeof(Counter) * num_rank * 4);
+  for (int ii = 0; ii < num_rank; ++ii) {
+    m_faw_index[ii] = 0;
+    // stagger refreshes of the ranks in a channel
+    if (m_timing.m_tREFI)
+      m_refresh_due[ii] = m_timing.m_tREFI + 
+        (Counter)(ii % m_num_rank) * m_timing.m_tREFI / m_num_rank;
+    else
+      m_refresh_due[ii] = ULLONG_MAX;
+  }
+
+  m_last_rank = new int[m_num_channel];
+  for (int ii = 0; ii < m_num_channel; ++ii) {
+    m_last_rank[ii] = -1;
+  }
+}
+
+
+// pick the oldest command-ready bank whose next command is legal in this cycle.
+void dram_ctrl_c::timed_schedule_cmd(int channel_id)
+{
+  Counter oldest = ULLONG_MAX;
+  int bank = -1;
+  bool stall = false;
+  for (int jj = channel_id * m_num_bank_per_channel; 
+      jj < (channel_id + 1) * m_num_bank_per_channel; ++jj) {
+    if (m_current_list[jj] != NULL && 
+        m_current_list[jj]->m_state == DRAM_CMD &&
+        m_bank_timestamp[jj] < oldest) {
+      if (m_refresh_due[m_bank_rank[jj]] > m_cycle && cmd_ready(jj)) {
+        oldest = m_bank_timestamp[jj];
+        bank   = jj;
+      }
+      else {
+        stall = true;
+      }
+    }
+  }
+
+  if (bank == -1) {
+    if (stall)
+      STAT_EVENT(DRAM_TIMING_STALL);
+    return ;
+  }
+
+  issue_cmd(bank);
+}
+
+
+// check the timing registers of every level that contains the bank.
+bool dram_ctrl_c::cmd_ready(int bank)
+{
+  drb_entry_s* entry = m_current_list[bank];
+  int rank           = m_bank_rank[bank];
+  int channel_id     = bank / m_num_bank_per_channel;
+
+  dram_timer_s* bank_timer    = &m_bank_timer[bank];
+  dram_timer_s* group_timer   = &m_group_timer[m_bank_group[bank]];
+  dram_timer_s* rank_timer    = &m_rank_timer[rank];
+  dram_timer_s* channel_timer = &m_channel_timer[channel_id];
+
+  // activate
+  if (m_current_rid[bank] == ULLONG_MAX) {
+    return bank_timer->m_act <= m_cycle && group_timer->m_act <= m_cycle &&
+      rank_timer->m_act <= m_cycle && m_faw[rank * 4 + m_faw_index[rank]] <= m_cycle;
+  }
+  // column access
+  else if (entry->m_rid == m_current_rid[bank]) {
+    Counter data_start;
+    if (entry->m_read) {
+      if (bank_timer->m_rd > m_cycle || group_timer->m_rd > m_cycle || 
+          rank_timer->m_rd > m_cycle || channel_timer->m_rd > m_cycle)
+        return false;
+      data_start = m_cycle + m_timing.m_tCL;
+    }
+    else {
+      if (bank_timer->m_wr > m_cycle || group_timer->m_wr > m_cycle || 
+          rank_timer->m_wr > m_cycle || channel_timer->m_wr > m_cycle)
+        return false;
+      data_start = m_cycle + m_timing.m_tCWL;
+    }
+
+    // data bus, including the rank switch bubble
+    Counter bus_free = m_dbus_ready[channel_id];
+    if (m_last_rank[channel_id] != -1 && m_last_rank[channel_id] != rank)
+      bus_free += m_timing.m_tRTRS;
+    return data_start >= bus_free;
+  }
+  // precharge
+  else {
+    return bank_timer->m_pre <= m_cycle;
+  }
+}
+
+
+// issue the next command of the bank and update the timing registers.
+void dram_ctrl_c::issue_cmd(int bank)
+{
+  drb_entry_s* entry = m_current_list[bank];
+  int rank           = m_bank_rank[bank];
+  int channel_id     = bank / m_num_bank_per_channel;
+
+  dram_timer_s* bank_timer    = &m_bank_timer[bank];
+  dram_timer_s* group_timer   = &m_group_timer[m_bank_group[bank]];
+  dram_timer_s* rank_timer    = &m_rank_timer[rank];
+  dram_timer_s* channel_timer = &m_channel_timer[channel_id];
+
+  ASSERT(entry->m_state == DRAM_CMD);
+  entry->m_req->m_state = MEM_DRAM_CMD;
+  if (entry->m_req->m_stage == MEM_STAGE_DRAM_QUEUE)
+    entry->m_req->set_stage(MEM_STAGE_DRAM, CYCLE);
+
+  // activate
+  if (m_current_rid[bank] == ULLONG_MAX) {
+    m_current_rid[bank] = entry->m_rid;
+
+    bank_timer->m_act  = MAX2(bank_timer->m_act, m_cycle + m_timing.m_tRC);
+    bank_timer->m_pre  = MAX2(bank_timer->m_pre, m_cycle + m_timing.m_tRAS);
+    bank_timer->m_rd   = MAX2(bank_timer->m_rd, m_cycle + m_timing.m_tRCD);
+    bank_timer->m_wr   = MAX2(bank_timer->m_wr, m_cycle + m_timing.m_tRCD);
+    group_timer->m_act = MAX2(group_timer->m_act, m_cycle + m_timing.m_tRRD_L);
+    rank_timer->m_act  = MAX2(rank_timer->m_act, m_cycle + m_timing.m_tRRD_S);
+
+    m_faw[rank * 4 + m_faw_index[rank]] = m_cycle + m_timing.m_tFAW;
+    m_faw_index[rank] = (m_faw_index[rank] + 1) % 4;
+
+    m_bank_ready[bank] = m_cycle + m_timing.m_tRCD;
+    m_data_avail[bank] = ULLONG_MAX;
+    entry->m_state     = DRAM_CMD_WAIT;
+    STAT_EVENT(DRAM_ACTIVATE);
+    DEBUG("bank[%d] req:%d activate\n", bank, entry->m_req->m_id);
+  }
+  // column access : the data bus is reserved from here
+  else if (entry->m_rid == m_current_rid[bank]) {
+    int burst = MAX2(m_timing.m_tBL, (int)((entry->m_size + m_bus_width - 1) / m_bus_width));
+    Counter data_end;
+    if (entry->m_read) {
+      data_end = m_cycle + m_timing.m_tCL + burst;
+
+      bank_timer->m_pre    = MAX2(bank_timer->m_pre, m_cycle + m_timing.m_tRTP);
+      group_timer->m_rd    = MAX2(group_timer->m_rd, m_cycle + m_timing.m_tCCD_L);
+      group_timer->m_wr    = MAX2(group_timer->m_wr, m_cycle + m_timing.m_tCCD_L);
+      channel_timer->m_rd  = MAX2(channel_timer->m_rd, m_cycle + m_timing.m_tCCD_S);
+      // read to write turnaround
+      channel_timer->m_wr  = MAX2(channel_timer->m_wr, 
+          MAX2(m_cycle + m_timing.m_tCCD_S, data_end + 2 - m_timing.m_tCWL));
+    }
+    else {
+      data_end = m_cycle + m_timing.m_tCWL + burst;
+
+      bank_timer->m_pre    = MAX2(bank_timer->m_pre, data_end + m_timing.m_tWR);
+      group_timer->m_rd    = MAX2(group_timer->m_rd, data_end + m_timing.m_tWTR_L);
+      group_timer->m_wr    = MAX2(group_timer->m_wr, m_cycle + m_timing.m_tCCD_L);
+      rank_timer->m_rd     = MAX2(rank_timer->m_rd, data_end + m_timing.m_tWTR_S);
+      channel_timer->m_rd  = MAX2(channel_timer->m_rd, m_cycle + m_timing.m_tCCD_S);
+      channel_timer->m_wr  = MAX2(channel_timer->m_wr, m_cycle + m_timing.m_tCCD_S);
+    }
+
+    m_dbus_ready[channel_id] = data_end;
+    m_last_rank[channel_id]  = rank;
+    count_turnaround(channel_id, entry->m_read);
+    total_dram_bandwidth += entry->m_size;
+    STAT_EVENT_N(BANDWIDTH_TOT, entry->m_size);
+
+    m_data_ready[bank]    = data_end;
+    m_data_avail[bank]    = ULLONG_MAX;
+    entry->m_state        = DRAM_DATA_WAIT;
+    entry->m_req->m_state = MEM_DRAM_DATA;
+    STAT_EVENT(DRAM_COLUMN);
+    DEBUG("bank[%d] req:%d column\n", bank, entry->m_req->m_id);
+
+    // auto-precharge
+    bool close = (m_page_policy == DRAM_PAGE_CLOSED);
+    if (m_page_policy == DRAM_PAGE_ADAPTIVE) {
+      close = true;
+      for (auto I = m_buffer[bank].begin(), E = m_buffer[bank].end(); I != E; ++I) {
+        if ((*I)->m_rid == m_current_rid[bank]) {
+          close = false;
+          break;
+        }
+      }
+    }
+
+    if (close) {
+      m_current_rid[bank] = ULLONG_MAX;
+      bank_timer->m_act   = MAX2(bank_timer->m_act, bank_timer->m_pre + m_timing.m_tRP);
+      STAT_EVENT(DRAM_AUTO_PRECHARGE);
+    }
+  }
+  // precharge
+  else {
+    m_current_rid[bank] = ULLONG_MAX;
+    bank_timer->m_act   = MAX2(bank_timer->m_act, m_cycle + m_timing.m_tRP);
+
+    m_bank_ready[bank]   = m_cycle + m_timing.m_tRP;
+    m_data_avail[bank]   = ULLONG_MAX;
+    entry->m_state       = DRAM_CMD_WAIT;
+    entry->m_row_conflict = true;
+    STAT_EVENT(DRAM_PRECHARGE);
+    DEBUG("bank[%d] req:%d precharge\n", bank, entry->m_req->m_id);
+  }
+}
+
+
+// When a refresh is due in a rank, no other command goes to the rank. Open rows are 
+// precharged first, then all banks of the rank are refreshed at once.
+bool dram_ctrl_c::refresh(int channel_id)
+{
+  for (int rank = channel_id * m_num_rank; rank < (channel_id + 1) * m_num_rank; ++rank) {
+    if (m_refresh_due[rank] > m_cycle)
+      continue;
+
+    bool idle = true;
+    for (int bank = rank * m_num_bank_per_rank; bank < (rank + 1) * m_num_bank_per_rank; 
+        ++bank) {
+      if (m_current_rid[bank] != ULLONG_MAX) {
+        if (m_bank_timer[bank].m_pre <= m_cycle) {
+          m_current_rid[bank]     = ULLONG_MAX;
+          m_bank_timer[bank].m_act = MAX2(m_bank_timer[bank].m_act, m_cycle + m_timing.m_tRP);
+          STAT_EVENT(DRAM_PRECHARGE);
+          return true;
+        }
+        idle = false;
+      }
+      else if (m_bank_timer[bank].m_act > m_cycle) {
+        idle = false;
+      }
+    }
+
+    if (idle) {
+      for (int bank = rank * m_num_bank_per_rank; bank < (rank + 1) * m_num_bank_per_rank; 
+          ++bank) {
+        m_bank_timer[bank].m_act = m_cycle + m_timing.m_tRFC;
+      }
+      m_refresh_due[rank] += m_timing.m_tREFI;
+      STAT_EVENT(DRAM_REFRESH);
+      DEBUG("MC[%d] rank:%d refresh\n", m_id, rank);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
 // check data bus availability.
 bool dram_ctrl_c::avail_data_bus(int channel_id)
 {
@@ -858,6 +1393,104 @@ Counter dram_ctrl_c::acquire_data_bus(int channel_id, int req_size, bool gpu_req
 }
 
 
+// a write-back to a line that is already in the write queue is retired
+bool dram_ctrl_c::coalesce_write(int channel_id, mem_req_s* req)
+{
+  Addr line_addr = req->m_addr & ~m_line_mask;
+  for (auto I = m_write_queue[channel_id].begin(), E = m_write_queue[channel_id].end(); 
+      I != E; ++I) {
+    if (((*I)->m_addr & ~m_line_mask) == line_addr) {
+      STAT_EVENT(DRAM_WQ_COALESCED);
+      DEBUG("MC[%d] wb:%d addr:%s merged into req:%d\n", 
+          m_id, req->m_id, hexstr64s(req->m_addr), (*I)->m_req->m_id);
+      MEMORY->free_req(req->m_core_id, req);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// drain mode starts at the high watermark and stops at the low watermark
+void dram_ctrl_c::update_write_drain(void)
+{
+  for (int ii = 0; ii < m_num_channel; ++ii) {
+    int size = m_write_queue[ii].size();
+    if (!m_wq_drain[ii] && size >= m_wq_high) {
+      m_wq_drain[ii] = true;
+      STAT_EVENT(DRAM_WQ_DRAIN);
+      DEBUG("MC[%d] channel:%d write drain start (%d writes)\n", m_id, ii, size);
+    }
+    else if (m_wq_drain[ii] && size <= m_wq_low) {
+      m_wq_drain[ii] = false;
+      DEBUG("MC[%d] channel:%d write drain end\n", m_id, ii);
+    }
+
+    if (m_wq_drain[ii])
+      STAT_EVENT(DRAM_WQ_DRAIN_CYCLE);
+
+    m_channel_reads[ii] = 0;
+    for (int jj = ii * m_num_bank_per_channel; jj < (ii + 1) * m_num_bank_per_channel; ++jj) {
+      m_channel_reads[ii] += m_buffer[jj].size();
+    }
+  }
+}
+
+
+// row-hit write first, then the oldest write of the bank
+drb_entry_s* dram_ctrl_c::schedule_write(int bank)
+{
+  int channel_id = bank / m_num_bank_per_channel;
+  if (!m_wq_drain[channel_id] && m_channel_reads[channel_id] > 0)
+    return NULL;
+
+  drb_entry_s* write = NULL;
+  for (auto I = m_write_queue[channel_id].begin(), E = m_write_queue[channel_id].end(); 
+      I != E; ++I) {
+    if ((*I)->m_bid != static_cast<uint64_t>(bank))
+      continue;
+
+    if ((*I)->m_rid == m_current_rid[bank]) {
+      write = (*I);
+      break;
+    }
+    if (write == NULL)
+      write = (*I);
+  }
+
+  if (write) {
+    STAT_EVENT(m_wq_drain[channel_id] ? DRAM_WQ_DRAIN_WRITE : DRAM_WQ_IDLE_WRITE);
+  }
+
+  return write;
+}
+
+
+// return a serviced entry to its free list
+void dram_ctrl_c::free_entry(int bank, drb_entry_s* entry)
+{
+  bool write_queue = m_wq_size && !entry->m_read;
+
+  entry->reset();
+  if (write_queue)
+    m_wq_free_list[bank / m_num_bank_per_channel].push_back(entry);
+  else
+    m_buffer_free_list[bank].push_back(entry);
+}
+
+
+// read/write switches of the data bus
+void dram_ctrl_c::count_turnaround(int channel_id, bool read)
+{
+  int dir = read ? 1 : 0;
+  if (m_bus_dir[channel_id] != -1 && m_bus_dir[channel_id] != dir) {
+    STAT_EVENT(read ? DRAM_TURNAROUND_WR_TO_RD : DRAM_TURNAROUND_RD_TO_WR);
+  }
+  m_bus_dir[channel_id] = dir;
+}
+
+
 void dram_ctrl_c::on_insert(mem_req_s* req, uint64_t bid, uint64_t rid, uint64_t cid)
 {
   // empty
@@ -866,7 +1499,8 @@ void dram_ctrl_c::on_insert(mem_req_s* req, uint64_t bid, uint64_t rid, uint64_t
 
 void dram_ctrl_c::on_complete(drb_entry_s* req)
 {
-  // empty
+  if (m_simBase->m_pc_profiler && req->m_row_conflict && req->m_req->m_type == MRT_DFETCH)
+    m_simBase->m_pc_profiler->row_conflict(req->m_req->m_pc);
 }
 
 
@@ -876,6 +1510,26 @@ void dram_ctrl_c::on_run_a_cycle()
 }
 
 
+void dram_ctrl_c::on_flush(drb_entry_s* req)
+{
+  // empty
+}
+
+
+// Slowdown estimate : the latency of a request over the latency it would have seen alone,
+// i.e. without the cycles its bank spent serving other applications (as in STFM).
+void dram_ctrl_c::app_account(drb_entry_s* req)
+{
+  int app = app_index(req->m_appl_id);
+  Counter latency = m_cycle - req->m_timestamp;
+  Counter alone   = latency - MIN2(req->m_interference, latency);
+
+  STAT_EVENT_N(DRAM_APP0_BANDWIDTH + app, req->m_size);
+  STAT_EVENT_N(DRAM_APP0_SLOWDOWN + app, latency);
+  STAT_EVENT_N(DRAM_APP0_ALONE_LATENCY + app, alone);
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -61,6 +61,60 @@ enum DRAM_STATE {
 }; 
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief row buffer management policy (command timing model only)
+///////////////////////////////////////////////////////////////////////////////////////////////
+enum DRAM_PAGE_POLICY {
+  DRAM_PAGE_OPEN, /**< keep the row open until a conflict */
+  DRAM_PAGE_CLOSED, /**< auto-precharge after every column access */
+  DRAM_PAGE_ADAPTIVE, /**< auto-precharge unless a queued request hits the open row */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief dram command timing parameters of a speed grade
+///
+/// Read from the dram_timing_spec file, one "<name> <value>" pair per line ('#' comments).
+/// All values are in memory controller cycles, so clock_mc should be the DRAM command clock.
+/// The _L (same bank group) values default to the _S ones when omitted (DDR3).
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct dram_timing_s {
+  int m_tBL; /**< data burst duration */
+  int m_tCL; /**< read to data */
+  int m_tCWL; /**< write to data */
+  int m_tRCD; /**< activate to column */
+  int m_tRP; /**< precharge to activate */
+  int m_tRAS; /**< activate to precharge */
+  int m_tRC; /**< activate to activate, same bank */
+  int m_tWR; /**< end of write data to precharge */
+  int m_tRTP; /**< read to precharge */
+  int m_tWTR_S; /**< end of write data to read, different bank group */
+  int m_tWTR_L; /**< end of write data to read, same bank group */
+  int m_tRRD_S; /**< activate to activate, different bank group */
+  int m_tRRD_L; /**< activate to activate, same bank group */
+  int m_tCCD_S; /**< column to column, different bank group */
+  int m_tCCD_L; /**< column to column, same bank group */
+  int m_tFAW; /**< four activate window */
+  int m_tRTRS; /**< rank to rank switch on the data bus */
+  int m_tREFI; /**< refresh interval (0 : no refresh) */
+  int m_tRFC; /**< refresh cycle time */
+} dram_timing_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief earliest cycle at which each command may be issued
+///
+/// One set per bank, bank group, rank and channel. A command is legal when the cycle has
+/// reached its register at every level that contains the target bank.
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct dram_timer_s {
+  Counter m_act; /**< activate */
+  Counter m_pre; /**< precharge */
+  Counter m_rd; /**< read */
+  Counter m_wr; /**< write */
+} dram_timer_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief dram request entry class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -81,6 +135,9 @@ typedef struct drb_entry_s {
   int         m_size;           /**< size */
   Counter     m_timestamp;      /**< last touched cycle */
   Counter     m_scheduled;      /**< scheduled cycle */
+  bool        m_row_conflict;   /**< needed a precharge (row conflict) */
+  Counter     m_interference;   /**< cycles the bank served other applications meanwhile */
+  bool        m_marked;         /**< in the current batch (PAR-BS) */
   macsim_c*   m_simBase;        /**< macsim_c base class for simulation globals */
   // m_type;
   // m_core_type;
@@ -105,6 +162,12 @@ typedef struct drb_entry_s {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Base dram scheduling class (FCFS)
+///
+/// With dram_write_queue_size, write-backs wait in a per-channel write queue (merged by line
+/// address) instead of the bank buffers. Reads go first; writes are scheduled when the
+/// channel has no pending read, or in drain mode, which starts when the queue reaches
+/// dram_write_high_watermark entries and holds reads until it is down to
+/// dram_write_low_watermark.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 class dram_ctrl_c : public dram_c
 {
@@ -147,7 +210,7 @@ class dram_ctrl_c : public dram_c
     void print_req(void);
 
   public:
-    #define DRAM_REQ_PRIORITY_COUNT 12
+    #define DRAM_REQ_PRIORITY_COUNT 13
     #define DRAM_STATE_COUNT 5
     static int dram_req_priority[DRAM_REQ_PRIORITY_COUNT]; /**< dram request priority */
     static const char* dram_state[DRAM_STATE_COUNT]; /**< dram state string */
@@ -189,6 +252,32 @@ class dram_ctrl_c : public dram_c
      */
     void channel_schedule_data();
 
+    /**
+     * Load the speed grade and set up the command timing registers
+     */
+    void init_timing(const string& spec);
+
+    /**
+     * Pick a command from banks, honoring the command timing of the speed grade
+     */
+    void timed_schedule_cmd(int channel_id);
+
+    /**
+     * Check whether the next command of a bank is legal in this cycle
+     */
+    bool cmd_ready(int bank);
+
+    /**
+     * Issue the next command of a bank
+     */
+    void issue_cmd(int bank);
+
+    /**
+     * Issue a refresh (or the precharge before it) when one is due in a rank of the channel.
+     * \return true if the command slot of the channel has been used
+     */
+    bool refresh(int channel_id);
+
     /**
      * Check whether data bus of a channel is available
      */
@@ -204,6 +293,34 @@ class dram_ctrl_c : public dram_c
      */
     void flush_prefetch(int bid);
 
+    /**
+     * Merge a write-back into a queued write to the same line
+     * @return true, if merged (the request is retired)
+     */
+    bool coalesce_write(int channel_id, mem_req_s* req);
+
+    /**
+     * Enter/leave write drain mode at the write queue watermarks
+     */
+    void update_write_drain(void);
+
+    /**
+     * Pick a queued write for an idle bank. Outside drain mode, writes only go when the 
+     * channel has no pending read.
+     * @return NULL, if no write can be scheduled
+     */
+    drb_entry_s* schedule_write(int bank);
+
+    /**
+     * Return a completed entry to its free list (bank buffer or write queue)
+     */
+    void free_entry(int bank, drb_entry_s* entry);
+
+    /**
+     * Count data bus read/write turnarounds
+     */
+    void count_turnaround(int channel_id, bool read);
+
     /**
      * Check the progress of dram controller.
      * Although there are requests, if no request has been serviced for certain cycles
@@ -241,6 +358,25 @@ class dram_ctrl_c : public dram_c
      */
     virtual void on_run_a_cycle();
 
+    /**
+     * Function to do any book-keeping that might be needed by scheduling policies
+     * (a prefetch is dropped from the buffer without being serviced)
+     */
+    virtual void on_flush(drb_entry_s* req);
+
+    /**
+     * Per-application bandwidth and slowdown of a completed request
+     */
+    void app_account(drb_entry_s* req);
+
+    /**
+     * Application slot of a request (appl_id modulo dram_num_application)
+     */
+    inline int app_index(int appl_id)
+    {
+      return (appl_id < 0 ? 0 : appl_id) % m_num_app;
+    }
+
   protected:
     list<drb_entry_s*> *m_buffer; /**< Dram request buffer (DRB) */
     list<drb_entry_s*> *m_buffer_free_list; /**< DRB free list */
@@ -265,12 +401,44 @@ class dram_ctrl_c : public dram_c
     int m_num_completed_in_last_cycle; /**< number of requests completed in last cycle */
     int m_starvation_cycle; /**< number of cycles without completed requests*/
     int m_total_req; /**< total pending requests */
+    int m_num_app; /**< number of application slots */
 
     // latency
     int m_activate_latency; /**< activate latency */
     int m_precharge_latency; /**< precharge latency */
     int m_column_latency; /**< column access latency */
 
+    // command timing (dram_timing_spec)
+    bool m_timing_model; /**< use the command timing model */
+    dram_timing_s m_timing; /**< speed grade */
+    int m_page_policy; /**< row buffer management policy */
+    int m_num_rank; /**< number of ranks per channel */
+    int m_num_bank_group; /**< number of bank groups per rank */
+    int m_num_bank_per_rank; /**< number of banks per rank */
+    int* m_bank_rank; /**< rank of each bank */
+    int* m_bank_group; /**< bank group of each bank */
+    dram_timer_s* m_bank_timer; /**< per-bank command timing */
+    dram_timer_s* m_group_timer; /**< per-bank group command timing */
+    dram_timer_s* m_rank_timer; /**< per-rank command timing */
+    dram_timer_s* m_channel_timer; /**< per-channel command timing */
+    Counter* m_faw; /**< end of the four activate window of the last four activates per rank */
+    int* m_faw_index; /**< oldest entry of m_faw per rank */
+    Counter* m_refresh_due; /**< next refresh cycle per rank */
+    int* m_last_rank; /**< rank of the last data transfer per channel */
+
+    // write queue
+    int m_wq_size; /**< write queue entries per channel (0 : writes share the bank buffers) */
+    int m_wq_high; /**< occupancy that starts write drain mode */
+    int m_wq_low; /**< occupancy that ends write drain mode */
+    list<drb_entry_s*>* m_write_queue; /**< per-channel write queue */
+    list<drb_entry_s*>* m_wq_free_list; /**< per-channel write queue free list */
+    bool* m_wq_drain; /**< channel is in write drain mode */
+    int* m_channel_reads; /**< pending reads per channel (in this cycle) */
+    Addr m_line_mask; /**< offset mask of a memory line (write coalescing) */
+    int m_twtr; /**< write to read turnaround of the latency model */
+    int* m_bus_dir; /**< last data transfer per channel (-1 : none, 0 : write, 1 : read) */
+    Counter* m_wtr_ready; /**< first cycle a read can take the data bus after a write */
+
     list<mem_req_s*>* m_output_buffer; /**< output buffer */
     list<mem_req_s*>* m_tmp_output_buffer; /**< buffer to simulate any additional dram latency */
 };
@@ -116,6 +116,7 @@ void dram_dramsim_c::read_callback(unsigned id, uint64_t address, uint64_t clock
     ++I;
 
     if (req->m_addr == address) {
+      req->set_stage(MEM_STAGE_NOC, CYCLE);
       m_output_buffer->push_back(req);
       m_pending_request->remove(req);
     }
@@ -150,6 +151,8 @@ void dram_dramsim_c::receive(void)
   if (m_dramsim->addTransaction(req->m_type == MRT_WB, static_cast<uint64_t>(req->m_addr))) {
     m_pending_request->push_back(req);
     NETWORK->receive_pop(MEM_MC, m_id);
+    req->m_service_level = MEM_MC;
+    req->set_stage(MEM_STAGE_DRAM, CYCLE);
     if (*KNOB(KNOB_BUG_DETECTOR_ENABLE)) {
       m_simBase->m_bug_detector->deallocate_noc(req);
     }
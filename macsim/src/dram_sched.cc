@@ -0,0 +1,524 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : dram_sched.cc
+ * Description  : application-aware dram schedulers (PAR-BS, ATLAS, TCM, BLISS)
+ *********************************************************************************************/
+
+
+#include <algorithm>
+
+#include "dram_sched.h"
+#include "memreq_info.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+#include "statistics.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// wrapper functions to allocate dram controller object
+
+dram_c* parbs_controller(macsim_c* simBase)
+{
+  dram_c* parbs = new dc_parbs_c(simBase);
+  return parbs;
+}
+
+
+dram_c* atlas_controller(macsim_c* simBase)
+{
+  dram_c* atlas = new dc_atlas_c(simBase);
+  return atlas;
+}
+
+
+dram_c* tcm_controller(macsim_c* simBase)
+{
+  dram_c* tcm = new dc_tcm_c(simBase);
+  return tcm;
+}
+
+
+dram_c* bliss_controller(macsim_c* simBase)
+{
+  dram_c* bliss = new dc_bliss_c(simBase);
+  return bliss;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+dc_app_aware_c::dc_app_aware_c(macsim_c* simBase) : dram_ctrl_c(simBase)
+{
+}
+
+
+dc_app_aware_c::~dc_app_aware_c()
+{
+}
+
+
+drb_entry_s* dc_app_aware_c::schedule(list<drb_entry_s*>* buffer)
+{
+  ASSERT(!buffer->empty());
+
+  drb_entry_s* entry = buffer->front();
+  for (auto I = buffer->begin(), E = buffer->end(); I != E; ++I) {
+    if (higher((*I), entry))
+      entry = (*I);
+  }
+
+  return entry;
+}
+
+
+void dc_app_aware_c::rank_by(const vector<double>& key, vector<int>& rank)
+{
+  vector<int> order(m_num_app);
+  for (int ii = 0; ii < m_num_app; ++ii) {
+    order[ii] = ii;
+  }
+  stable_sort(order.begin(), order.end(),
+      [&key](int a, int b) { return key[a] < key[b]; });
+
+  for (int ii = 0; ii < m_num_app; ++ii) {
+    rank[order[ii]] = ii;
+  }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// PAR-BS
+
+
+dc_parbs_c::dc_parbs_c(macsim_c* simBase) : dc_app_aware_c(simBase)
+{
+  m_marking_cap = *KNOB(KNOB_DRAM_PARBS_MARKING_CAP);
+  m_num_marked  = 0;
+  m_rank.resize(m_num_app, 0);
+  m_load.resize(m_num_app, 0);
+  m_key.resize(m_num_app, 0);
+}
+
+
+dc_parbs_c::~dc_parbs_c()
+{
+}
+
+
+drb_entry_s* dc_parbs_c::schedule(list<drb_entry_s*>* buffer)
+{
+  if (m_num_marked == 0)
+    form_batch();
+
+  return dc_app_aware_c::schedule(buffer);
+}
+
+
+// Buffers are kept in arrival order (entries are only appended and removed), so the first
+// entries of an application in a bank are its oldest.
+void dc_parbs_c::form_batch(void)
+{
+  vector<int> max_load(m_num_app, 0);
+  vector<int> total_load(m_num_app, 0);
+
+  for (int ii = 0; ii < m_num_bank; ++ii) {
+    if (m_buffer[ii].empty())
+      continue;
+
+    fill(m_load.begin(), m_load.end(), 0);
+    for (auto I = m_buffer[ii].begin(), E = m_buffer[ii].end(); I != E; ++I) {
+      int app = source(*I);
+      if (m_load[app] < m_marking_cap) {
+        (*I)->m_marked = true;
+        ++m_load[app];
+        ++m_num_marked;
+      }
+    }
+
+    for (int app = 0; app < m_num_app; ++app) {
+      max_load[app]    = MAX2(max_load[app], m_load[app]);
+      total_load[app] += m_load[app];
+    }
+  }
+
+  // shortest job first : max bank load, then total load
+  for (int app = 0; app < m_num_app; ++app) {
+    m_key[app] = (double)max_load[app] * (m_marking_cap * m_num_bank + 1) + total_load[app];
+  }
+  rank_by(m_key, m_rank);
+}
+
+
+bool dc_parbs_c::higher(const drb_entry_s* req_a, const drb_entry_s* req_b)
+{
+  if (req_a->m_marked != req_b->m_marked)
+    return req_a->m_marked;
+
+  bool hit_a = row_hit(req_a);
+  if (hit_a != row_hit(req_b))
+    return hit_a;
+
+  int rank_a = m_rank[source(req_a)];
+  int rank_b = m_rank[source(req_b)];
+  if (rank_a != rank_b)
+    return rank_a < rank_b;
+
+  return req_a->m_timestamp < req_b->m_timestamp;
+}
+
+
+void dc_parbs_c::unmark(drb_entry_s* req)
+{
+  if (req->m_marked) {
+    req->m_marked = false;
+    --m_num_marked;
+  }
+}
+
+
+void dc_parbs_c::on_complete(drb_entry_s* req)
+{
+  dram_ctrl_c::on_complete(req);
+  unmark(req);
+}
+
+
+void dc_parbs_c::on_flush(drb_entry_s* req)
+{
+  unmark(req);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// ATLAS
+
+
+dc_atlas_c::dc_atlas_c(macsim_c* simBase) : dc_app_aware_c(simBase)
+{
+  m_quantum      = *KNOB(KNOB_DRAM_SCHED_QUANTUM);
+  m_next_quantum = m_quantum;
+  m_threshold    = *KNOB(KNOB_DRAM_ATLAS_THRESHOLD);
+  m_alpha        = *KNOB(KNOB_DRAM_ATLAS_ALPHA);
+  m_service.resize(m_num_app, 0);
+  m_total_service.resize(m_num_app, 0);
+  m_rank.resize(m_num_app, 0);
+}
+
+
+dc_atlas_c::~dc_atlas_c()
+{
+}
+
+
+bool dc_atlas_c::higher(const drb_entry_s* req_a, const drb_entry_s* req_b)
+{
+  bool over_a = m_cycle - req_a->m_timestamp > m_threshold;
+  bool over_b = m_cycle - req_b->m_timestamp > m_threshold;
+  if (over_a != over_b)
+    return over_a;
+
+  int rank_a = m_rank[source(req_a)];
+  int rank_b = m_rank[source(req_b)];
+  if (rank_a != rank_b)
+    return rank_a < rank_b;
+
+  return frfcfs(req_a, req_b);
+}
+
+
+// bank cycles of a serviced request (merged requests ride along for free)
+void dc_atlas_c::on_complete(drb_entry_s* req)
+{
+  dram_ctrl_c::on_complete(req);
+
+  if (req->m_state == DRAM_DATA_WAIT)
+    m_service[source(req)] += m_cycle - req->m_scheduled;
+}
+
+
+void dc_atlas_c::on_run_a_cycle()
+{
+  if (m_cycle < m_next_quantum)
+    return ;
+
+  for (int app = 0; app < m_num_app; ++app) {
+    m_total_service[app] = m_alpha * m_total_service[app] + (1 - m_alpha) * m_service[app];
+    m_service[app] = 0;
+  }
+  rank_by(m_total_service, m_rank);
+
+  m_next_quantum += m_quantum;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// TCM
+
+
+dc_tcm_c::dc_tcm_c(macsim_c* simBase) : dc_app_aware_c(simBase)
+{
+  m_quantum           = *KNOB(KNOB_DRAM_SCHED_QUANTUM);
+  m_next_quantum      = m_quantum;
+  m_shuffle_interval  = *KNOB(KNOB_DRAM_TCM_SHUFFLE_INTERVAL);
+  m_next_shuffle      = m_shuffle_interval;
+  m_cluster_threshold = *KNOB(KNOB_DRAM_TCM_CLUSTER_THRESHOLD);
+  m_shuffle_offset    = 0;
+
+  m_bandwidth.resize(m_num_app, 0);
+  m_blp_sum.resize(m_num_app, 0);
+  m_blp_sample.resize(m_num_app, 0);
+  m_hit.resize(m_num_app, 0);
+  m_access.resize(m_num_app, 0);
+  m_outstanding.resize(m_num_app * m_num_bank, 0);
+  m_busy_bank.resize(m_num_app, 0);
+  m_rank.resize(m_num_app, 0);
+
+  // until the first quantum ends, everybody is in the bandwidth cluster
+  for (int app = 0; app < m_num_app; ++app) {
+    m_bandwidth_order.push_back(app);
+  }
+  shuffle();
+}
+
+
+dc_tcm_c::~dc_tcm_c()
+{
+}
+
+
+drb_entry_s* dc_tcm_c::schedule(list<drb_entry_s*>* buffer)
+{
+  drb_entry_s* entry = dc_app_aware_c::schedule(buffer);
+
+  int app = source(entry);
+  ++m_access[app];
+  if (row_hit(entry))
+    ++m_hit[app];
+
+  return entry;
+}
+
+
+bool dc_tcm_c::higher(const drb_entry_s* req_a, const drb_entry_s* req_b)
+{
+  int rank_a = m_rank[source(req_a)];
+  int rank_b = m_rank[source(req_b)];
+  if (rank_a != rank_b)
+    return rank_a < rank_b;
+
+  return frfcfs(req_a, req_b);
+}
+
+
+// bank-level parallelism : banks with pending requests of the application, sampled at
+// every new request
+void dc_tcm_c::on_insert(mem_req_s* req, uint64_t bid, uint64_t rid, uint64_t cid)
+{
+  int app = app_index(req->m_appl_id);
+  if (m_outstanding[app * m_num_bank + bid]++ == 0)
+    ++m_busy_bank[app];
+
+  m_blp_sum[app] += m_busy_bank[app];
+  ++m_blp_sample[app];
+}
+
+
+void dc_tcm_c::leave(drb_entry_s* req)
+{
+  int app = source(req);
+  if (--m_outstanding[app * m_num_bank + req->m_bid] == 0)
+    --m_busy_bank[app];
+}
+
+
+void dc_tcm_c::on_complete(drb_entry_s* req)
+{
+  dram_ctrl_c::on_complete(req);
+
+  m_bandwidth[source(req)] += req->m_size;
+  leave(req);
+}
+
+
+void dc_tcm_c::on_flush(drb_entry_s* req)
+{
+  leave(req);
+}
+
+
+void dc_tcm_c::on_run_a_cycle()
+{
+  if (m_cycle >= m_next_quantum) {
+    cluster();
+    m_next_quantum += m_quantum;
+  }
+
+  if (m_cycle >= m_next_shuffle) {
+    ++m_shuffle_offset;
+    shuffle();
+    m_next_shuffle += m_shuffle_interval;
+  }
+}
+
+
+void dc_tcm_c::cluster(void)
+{
+  vector<int> order(m_num_app);
+  Counter total = 0;
+  for (int app = 0; app < m_num_app; ++app) {
+    order[app] = app;
+    total += m_bandwidth[app];
+  }
+  stable_sort(order.begin(), order.end(),
+      [this](int a, int b) { return m_bandwidth[a] < m_bandwidth[b]; });
+
+  // lightest applications within the bandwidth budget
+  m_latency_order.clear();
+  m_bandwidth_order.clear();
+  Counter sum = 0;
+  for (int ii = 0; ii < m_num_app; ++ii) {
+    int app = order[ii];
+    sum += m_bandwidth[app];
+    if (m_bandwidth_order.empty() && sum <= m_cluster_threshold * total)
+      m_latency_order.push_back(app);
+    else
+      m_bandwidth_order.push_back(app);
+  }
+
+  // niceness : high bank-level parallelism is nice, high row-buffer locality is not
+  vector<double> blp(m_num_app, 0);
+  vector<double> rbl(m_num_app, 0);
+  for (int app = 0; app < m_num_app; ++app) {
+    if (m_blp_sample[app])
+      blp[app] = (double)m_blp_sum[app] / m_blp_sample[app];
+    if (m_access[app])
+      rbl[app] = (double)m_hit[app] / m_access[app];
+  }
+
+  vector<int> blp_rank(m_num_app);
+  vector<int> rbl_rank(m_num_app);
+  rank_by(blp, blp_rank);
+  rank_by(rbl, rbl_rank);
+
+  stable_sort(m_bandwidth_order.begin(), m_bandwidth_order.end(),
+      [&blp_rank, &rbl_rank](int a, int b) {
+        return blp_rank[a] - rbl_rank[a] > blp_rank[b] - rbl_rank[b];
+      });
+
+  for (int app = 0; app < m_num_app; ++app) {
+    m_bandwidth[app]  = 0;
+    m_blp_sum[app]    = 0;
+    m_blp_sample[app] = 0;
+    m_hit[app]        = 0;
+    m_access[app]     = 0;
+  }
+
+  m_shuffle_offset = 0;
+  shuffle();
+}
+
+
+void dc_tcm_c::shuffle(void)
+{
+  int num_latency   = m_latency_order.size();
+  int num_bandwidth = m_bandwidth_order.size();
+
+  for (int ii = 0; ii < num_latency; ++ii) {
+    m_rank[m_latency_order[ii]] = ii;
+  }
+
+  for (int ii = 0; ii < num_bandwidth; ++ii) {
+    m_rank[m_bandwidth_order[ii]] = num_latency +
+      (ii + m_shuffle_offset) % num_bandwidth;
+  }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// BLISS
+
+
+dc_bliss_c::dc_bliss_c(macsim_c* simBase) : dc_app_aware_c(simBase)
+{
+  m_threshold      = *KNOB(KNOB_DRAM_BLISS_THRESHOLD);
+  m_clear_interval = *KNOB(KNOB_DRAM_BLISS_CLEAR_INTERVAL);
+  m_next_clear     = m_clear_interval;
+  m_last_app       = -1;
+  m_streak         = 0;
+  m_blacklist.resize(m_num_app, false);
+}
+
+
+dc_bliss_c::~dc_bliss_c()
+{
+}
+
+
+drb_entry_s* dc_bliss_c::schedule(list<drb_entry_s*>* buffer)
+{
+  drb_entry_s* entry = dc_app_aware_c::schedule(buffer);
+
+  int app = source(entry);
+  if (app == m_last_app) {
+    if (++m_streak >= m_threshold)
+      m_blacklist[app] = true;
+  }
+  else {
+    m_last_app = app;
+    m_streak   = 1;
+  }
+
+  return entry;
+}
+
+
+bool dc_bliss_c::higher(const drb_entry_s* req_a, const drb_entry_s* req_b)
+{
+  bool black_a = m_blacklist[source(req_a)];
+  if (black_a != m_blacklist[source(req_b)])
+    return !black_a;
+
+  return frfcfs(req_a, req_b);
+}
+
+
+void dc_bliss_c::on_run_a_cycle()
+{
+  if (m_cycle < m_next_clear)
+    return ;
+
+  fill(m_blacklist.begin(), m_blacklist.end(), false);
+  m_next_clear += m_clear_interval;
+}
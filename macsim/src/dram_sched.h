@@ -0,0 +1,315 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : dram_sched.h
+ * Description  : application-aware dram schedulers (PAR-BS, ATLAS, TCM, BLISS)
+ *********************************************************************************************/
+
+#ifndef DRAM_SCHED_H_INCLUDED
+#define DRAM_SCHED_H_INCLUDED
+
+
+#include <vector>
+
+#include "dram_ctrl.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Base class of the application-aware schedulers
+///
+/// Requests are grouped by application (appl_id modulo dram_num_application), so a GPU
+/// kernel is one source no matter how many cores it runs on. Each controller ranks the
+/// applications from what it sees itself; there is no meta-controller between channels.
+/// A scheduler defines the priority order with higher(); the bank picks the highest
+/// priority request with one pass over its buffer.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class dc_app_aware_c : public dram_ctrl_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    dc_app_aware_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    virtual ~dc_app_aware_c();
+
+    /**
+     * Pick the highest priority request
+     */
+    drb_entry_s* schedule(list<drb_entry_s*>* buffer);
+
+  protected:
+    /**
+     * True if req_a has higher priority than req_b
+     */
+    virtual bool higher(const drb_entry_s* req_a, const drb_entry_s* req_b) = 0;
+
+    /**
+     * Application slot of a request
+     */
+    inline int source(const drb_entry_s* req)
+    {
+      return app_index(req->m_appl_id);
+    }
+
+    /**
+     * Request hits the open row of its bank
+     */
+    inline bool row_hit(const drb_entry_s* req)
+    {
+      return m_current_rid[req->m_bid] == req->m_rid;
+    }
+
+    /**
+     * FR-FCFS order : row hit first, then oldest first
+     */
+    inline bool frfcfs(const drb_entry_s* req_a, const drb_entry_s* req_b)
+    {
+      bool hit_a = row_hit(req_a);
+      if (hit_a != row_hit(req_b))
+        return hit_a;
+
+      return req_a->m_timestamp < req_b->m_timestamp;
+    }
+
+    /**
+     * Rank applications by ascending key (rank 0 : highest priority)
+     */
+    void rank_by(const vector<double>& key, vector<int>& rank);
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PAR-BS : parallelism-aware batch scheduling (Mutlu and Moscibroda, ISCA 2008)
+///
+/// When the previous batch has drained, the dram_parbs_marking_cap oldest requests of every
+/// application in every bank are marked as the new batch. Within the batch, applications
+/// are ranked shortest job first (fewest marked requests in their most loaded bank, then
+/// fewest in total) so that the requests of an application are serviced in parallel across
+/// banks. Order : marked, row hit, rank, oldest.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class dc_parbs_c : public dc_app_aware_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    dc_parbs_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~dc_parbs_c();
+
+    /**
+     * Form a new batch when the current one has drained, then pick
+     */
+    drb_entry_s* schedule(list<drb_entry_s*>* buffer);
+
+  protected:
+    bool higher(const drb_entry_s* req_a, const drb_entry_s* req_b);
+    void on_complete(drb_entry_s* req);
+    void on_flush(drb_entry_s* req);
+
+  private:
+    /**
+     * Mark a new batch and rank the applications
+     */
+    void form_batch(void);
+
+    /**
+     * A marked request leaves the buffer
+     */
+    void unmark(drb_entry_s* req);
+
+  private:
+    int            m_marking_cap; /**< marked requests per application per bank */
+    int            m_num_marked; /**< marked requests not completed yet */
+    vector<int>    m_rank; /**< rank of each application in the batch */
+    vector<int>    m_load; /**< marked requests per application in a bank */
+    vector<double> m_key; /**< ranking key per application */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief ATLAS : adaptive per-thread least-attained-service (Kim et al., HPCA 2010)
+///
+/// The attained service of an application is the bank cycles spent on its requests. At
+/// every dram_sched_quantum cycles the service of the quantum is folded into an exponential
+/// average (dram_atlas_alpha) and applications are ranked least attained service first.
+/// Order : waiting over dram_atlas_threshold cycles, rank, row hit, oldest.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class dc_atlas_c : public dc_app_aware_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    dc_atlas_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~dc_atlas_c();
+
+  protected:
+    bool higher(const drb_entry_s* req_a, const drb_entry_s* req_b);
+    void on_complete(drb_entry_s* req);
+    void on_run_a_cycle();
+
+  private:
+    Counter         m_quantum; /**< ranking quantum */
+    Counter         m_next_quantum; /**< end of the current quantum */
+    Counter         m_threshold; /**< starvation threshold */
+    float           m_alpha; /**< history weight */
+    vector<Counter> m_service; /**< attained service in the quantum */
+    vector<double>  m_total_service; /**< averaged attained service */
+    vector<int>     m_rank; /**< rank of each application */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief TCM : thread cluster memory scheduling (Kim et al., MICRO 2010)
+///
+/// At every dram_sched_quantum cycles, applications are sorted by memory intensity and the
+/// lightest ones, together using at most dram_tcm_cluster_threshold of the bandwidth, form
+/// the latency-sensitive cluster; it always has priority, lightest first. The rest form the
+/// bandwidth-sensitive cluster, ordered by niceness (bank-level parallelism rank minus
+/// row-buffer locality rank) and rotated every dram_tcm_shuffle_interval cycles.
+/// Order : rank, row hit, oldest.
+///
+/// Intensity is the bytes the application moved in the quantum (the controller does not
+/// see instruction counts, so MPKI is not available); the shuffle is a round-robin rotation
+/// of the niceness order.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class dc_tcm_c : public dc_app_aware_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    dc_tcm_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~dc_tcm_c();
+
+    /**
+     * Pick, and count row hits per application
+     */
+    drb_entry_s* schedule(list<drb_entry_s*>* buffer);
+
+  protected:
+    bool higher(const drb_entry_s* req_a, const drb_entry_s* req_b);
+    void on_insert(mem_req_s* req, uint64_t bid, uint64_t rid, uint64_t cid);
+    void on_complete(drb_entry_s* req);
+    void on_flush(drb_entry_s* req);
+    void on_run_a_cycle();
+
+  private:
+    /**
+     * A request leaves its bank
+     */
+    void leave(drb_entry_s* req);
+
+    /**
+     * Form the clusters at the end of a quantum
+     */
+    void cluster(void);
+
+    /**
+     * Assign ranks : latency cluster, then the rotated bandwidth cluster
+     */
+    void shuffle(void);
+
+  private:
+    Counter         m_quantum; /**< clustering quantum */
+    Counter         m_next_quantum; /**< end of the current quantum */
+    Counter         m_shuffle_interval; /**< shuffle interval */
+    Counter         m_next_shuffle; /**< next shuffle */
+    float           m_cluster_threshold; /**< bandwidth fraction of the latency cluster */
+    vector<Counter> m_bandwidth; /**< bytes in the quantum */
+    vector<Counter> m_blp_sum; /**< sum of busy banks sampled at each insert */
+    vector<Counter> m_blp_sample; /**< number of samples */
+    vector<Counter> m_hit; /**< row hits in the quantum */
+    vector<Counter> m_access; /**< scheduled requests in the quantum */
+    vector<int>     m_outstanding; /**< pending requests per application per bank */
+    vector<int>     m_busy_bank; /**< banks with pending requests per application */
+    vector<int>     m_latency_order; /**< latency cluster, lightest first */
+    vector<int>     m_bandwidth_order; /**< bandwidth cluster, nicest first */
+    int             m_shuffle_offset; /**< rotation of the bandwidth cluster */
+    vector<int>     m_rank; /**< rank of each application */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief BLISS : blacklisting memory scheduler (Subramanian et al., ICCD 2014)
+///
+/// An application that gets dram_bliss_threshold requests scheduled in a row is
+/// blacklisted; the blacklist is cleared every dram_bliss_clear_interval cycles.
+/// Order : not blacklisted, row hit, oldest.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class dc_bliss_c : public dc_app_aware_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    dc_bliss_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~dc_bliss_c();
+
+    /**
+     * Pick, and track consecutive requests of the same application
+     */
+    drb_entry_s* schedule(list<drb_entry_s*>* buffer);
+
+  protected:
+    bool higher(const drb_entry_s* req_a, const drb_entry_s* req_b);
+    void on_run_a_cycle();
+
+  private:
+    int          m_threshold; /**< consecutive requests to be blacklisted */
+    Counter      m_clear_interval; /**< blacklist clearing interval */
+    Counter      m_next_clear; /**< next clearing */
+    int          m_last_app; /**< application of the last scheduled request */
+    int          m_streak; /**< consecutive requests of m_last_app */
+    vector<bool> m_blacklist; /**< blacklisted applications */
+};
+
+
+#endif
@@ -210,12 +210,12 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
   DEBUG("m_core_id:%d thread_id:%d uop->iaq:%d uop_num:%lld inst_num:%lld mem_type:%d "
       "bogus:%d \n", 
       m_core_id, uop->m_thread_id, uop->m_allocq_num, uop->m_uop_num, 
-      uop->m_inst_num, uop->m_mem_type, uop->m_bogus);
+      uop->m_warm->m_inst_num, uop->m_mem_type, uop->m_bogus);
 
   DEBUG_CORE(m_core_id, "m_core_id:%d thread_id:%d uop->iaq:%d uop_num:%lld inst_num:%lld "
       " mem_type:%d bogus:%d \n", 
       m_core_id, uop->m_thread_id, uop->m_allocq_num, uop->m_uop_num, 
-      uop->m_inst_num, uop->m_mem_type, uop->m_bogus);
+      uop->m_warm->m_inst_num, uop->m_mem_type, uop->m_bogus);
 
   uop->m_state = OS_EXEC_BEGIN;
 
@@ -234,13 +234,13 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
       // -------------------------------------
       // single uop in an instruction
       // -------------------------------------
-      if (uop->m_num_child_uops == 0) {
+      if (uop->m_warm->m_num_child_uops == 0) {
         // shared memory access
         if (uop->m_mem_type == MEM_LD_SM || uop->m_mem_type == MEM_ST_SM) {
           // shared memory access
           uop_latency = core->get_shared_memory()->load(uop);
           if (uop_latency != 0) {
-            uop->m_mem_start_cycle = m_cur_core_cycle;
+            uop->m_cold->m_mem_start_cycle = m_cur_core_cycle;
           }
         }
         // other memory accesses
@@ -273,7 +273,7 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
           }
             
           if (uop_latency != 0) {
-            uop->m_mem_start_cycle = m_cur_core_cycle;
+            uop->m_cold->m_mem_start_cycle = m_cur_core_cycle;
           }
         }
 
@@ -316,7 +316,7 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
         // m_pending_child_uops is a bitmask that tracks which of the 
         // child uops have been sent to the memory hierarchy.
         // get the next child uop for the current parent uop
-        int next_set_bit = get_next_set_bit64(uop->m_pending_child_uops, 0);
+        int next_set_bit = get_next_set_bit64(uop->m_warm->m_pending_child_uops, 0);
 
         // executing children uops
         while (-1 != next_set_bit) {
@@ -324,9 +324,9 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
           // shared memory access
           // -------------------------------------
           if (uop->m_mem_type == MEM_LD_SM || uop->m_mem_type == MEM_ST_SM) {
-            latency = core->get_shared_memory()->load(uop->m_child_uops[next_set_bit]);
+            latency = core->get_shared_memory()->load(uop->m_warm->m_child_uops[next_set_bit]);
             if (latency != 0) {
-              uop->m_mem_start_cycle = m_cur_core_cycle;
+              uop->m_cold->m_mem_start_cycle = m_cur_core_cycle;
             }
           }
           // -------------------------------------
@@ -345,7 +345,7 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
             }
             else {
 #endif
-              latency = MEMORY->access(uop->m_child_uops[next_set_bit]);
+              latency = MEMORY->access(uop->m_warm->m_child_uops[next_set_bit]);
 #if PORT_FIXME
               if (latency == 0) {
                 if (m_bank_busy[uop->m_child_uops[next_set_bit]->m_dcache_bank_id] < 128)
@@ -356,21 +356,21 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
           }
 
           if (0 != latency) { // successful execution
-            if (!uop->m_mem_start_cycle) {
-            	uop->m_mem_start_cycle = m_cur_core_cycle;
+            if (!uop->m_cold->m_mem_start_cycle) {
+            	uop->m_cold->m_mem_start_cycle = m_cur_core_cycle;
             }
 
             // mark current uop as executed
-            uop->m_pending_child_uops = 
-              CLEAR_BIT(uop->m_pending_child_uops, next_set_bit);
+            uop->m_warm->m_pending_child_uops = 
+              CLEAR_BIT(uop->m_warm->m_pending_child_uops, next_set_bit);
 
             // cache hit
             if (latency > 0) {
-              ++uop->m_num_child_uops_done;
+              ++uop->m_warm->m_num_child_uops_done;
               DEBUG("m_core_id:%d thread_id:%d uop_num:%lld inst_num:%lld child_uop_num:%lld "
                   "m_dcu hit\n", 
-                  m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_inst_num,
-                  uop->m_child_uops[next_set_bit]->m_uop_num);
+                  m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_warm->m_inst_num,
+                  uop->m_warm->m_child_uops[next_set_bit]->m_uop_num);
 
               if (latency > max_latency) {
                 max_latency = latency;
@@ -381,13 +381,13 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
               uop_latency = -1;
               DEBUG("m_core_id:%d thread_id:%d uop_num:%lld inst_num:%lld child_uop_num:%lld "
                   "m_dcu miss\n", 
-                  m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_inst_num, 
-                  uop->m_child_uops[next_set_bit]->m_uop_num);
+                  m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_warm->m_inst_num, 
+                  uop->m_warm->m_child_uops[next_set_bit]->m_uop_num);
             }
           }
 
           // find next uop to execute
-          next_set_bit = get_next_set_bit64(uop->m_pending_child_uops, next_set_bit + 1);
+          next_set_bit = get_next_set_bit64(uop->m_warm->m_pending_child_uops, next_set_bit + 1);
         }
 
         // uop_latency can be
@@ -395,12 +395,12 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
         //  0 - some child uops are yet to be issued
         //  x > 0 - all child uops have been issued and all children will complete 
         // in x cycles
-        if (uop->m_pending_child_uops) {
+        if (uop->m_warm->m_pending_child_uops) {
           uop_latency = 0;
         }
         else {
           // all children uops have been executed
-          if (uop->m_num_child_uops == uop->m_num_child_uops_done) {
+          if (uop->m_warm->m_num_child_uops == uop->m_warm->m_num_child_uops_done) {
             uop_latency = max_latency;
           }
           // some uops have in-flight memory accesses
@@ -428,13 +428,13 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
         m_frontend->set_load_wait(uop->m_thread_id, uop->m_uop_num); 
 
         DEBUG("set_load_wait m_core_id:%d thread_id:%d uop_num:%lld inst_num:%lld\n",
-            uop->m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_inst_num);
+            uop->m_core_id, uop->m_thread_id, uop->m_uop_num, uop->m_warm->m_inst_num);
       }
 
       DEBUG("m_core_id:%d thread_id:%d vaddr:%s uop_num:%lld inst_num:%lld "
           "uop->m_uop_info.dcmiss:%d latency:%d done_cycle:%lld\n",
           m_core_id, uop->m_thread_id, hexstr64s(uop->m_vaddr), uop->m_uop_num, 
-          uop->m_inst_num, uop->m_uop_info.m_dcmiss, uop_latency, uop->m_done_cycle);
+          uop->m_warm->m_inst_num, uop->m_cold->m_uop_info.m_dcmiss, uop_latency, uop->m_done_cycle);
     }
     POWER_CORE_EVENT(m_core_id, POWER_SEGMENT_REGISTER_R);
     POWER_CORE_EVENT(m_core_id, POWER_SEGMENT_REGISTER_W);
@@ -498,7 +498,7 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
   POWER_CORE_EVENT(m_core_id, POWER_EXEC_BYPASS);
 
   // set scheduling cycle
-  uop->m_sched_cycle = m_cur_core_cycle;
+  uop->m_warm->m_sched_cycle = m_cur_core_cycle;
 
   ASSERTM(uop_latency != 0, "type=%d uop_type:%d\n", type, uop_type);
 
@@ -511,16 +511,16 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
   DEBUG("done_exec m_core_id:%d thread_id:%d core_cycle_count:%lld uop_num:%lld"
       " inst_num:%lld sched_cycle:%lld exec_cycle:%lld uop->done_cycle:%lld "
       "inst_count:%lld uop->dcmiss:%d uop_latency:%d done_cycle:%lld pc:0x%s\n",
-      m_core_id, uop->m_thread_id, m_cur_core_cycle, uop->m_uop_num, uop->m_inst_num, 
-      uop->m_sched_cycle, uop->m_exec_cycle, uop->m_done_cycle, uop->m_inst_num, 
-      uop->m_uop_info.m_dcmiss, uop_latency, uop->m_done_cycle, hexstr64s(uop->m_pc));
+      m_core_id, uop->m_thread_id, m_cur_core_cycle, uop->m_uop_num, uop->m_warm->m_inst_num, 
+      uop->m_warm->m_sched_cycle, uop->m_warm->m_exec_cycle, uop->m_done_cycle, uop->m_warm->m_inst_num, 
+      uop->m_cold->m_uop_info.m_dcmiss, uop_latency, uop->m_done_cycle, hexstr64s(uop->m_warm->m_pc));
 
   // branch execution
-  if (uop->m_cf_type) {
+  if (uop->m_warm->m_cf_type) {
     br_exec(uop);
   }
 
-  uop->m_exec_cycle = m_cur_core_cycle;
+  uop->m_warm->m_exec_cycle = m_cur_core_cycle;
 
   return true;
 }
@@ -529,7 +529,7 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
 // branch execution
 void exec_c::br_exec(uop_c *uop)
 {
-  switch (uop->m_cf_type) {
+  switch (uop->m_warm->m_cf_type) {
     case CF_BR:
       break;
     case CF_CBR:
@@ -550,12 +550,14 @@ void exec_c::br_exec(uop_c *uop)
   }
 
 
+  int thread_slot = m_simBase->m_core_pointers[m_core_id]->get_thread_slot(uop->m_thread_id);
+
   // handle mispredicted branches 
-  if (uop->m_mispredicted) {
-    (m_bp_data->m_bp)->recover(&(uop->m_recovery_info)); 
-    m_bp_data->m_bp_recovery_cycle[uop->m_thread_id] = 
+  if (uop->m_cold->m_mispredicted) {
+    (m_bp_data->m_bp)->recover(&(uop->m_cold->m_recovery_info)); 
+    m_bp_data->m_bp_recovery_cycle[thread_slot] = 
       m_cur_core_cycle + 1 + *m_simBase->m_knobs->KNOB_EXTRA_RECOVERY_CYCLES;
-    m_bp_data->m_bp_cause_op[uop->m_thread_id] = 0;
+    m_bp_data->m_bp_cause_op[thread_slot] = 0;
 
 
     STAT_CORE_EVENT(m_core_id, BP_RESOLVED); 
@@ -563,27 +565,27 @@ void exec_c::br_exec(uop_c *uop)
     DEBUG("m_core_id:%d thread_id:%d cur_core_cycle:%s branch is resolved: "
           "recovery_cycle:%lld uop_num:%lld\n", 
           m_core_id, uop->m_thread_id, unsstr64(m_cur_core_cycle), 
-          m_bp_data->m_bp_recovery_cycle[uop->m_thread_id], uop->m_uop_num);
+          m_bp_data->m_bp_recovery_cycle[thread_slot], uop->m_uop_num);
   }
 
   // handle misfetched branch  (miss target prediction: indirect branches) 
-  if (uop->m_uop_info.m_btb_miss) { 
+  if (uop->m_cold->m_uop_info.m_btb_miss) { 
     
-    if (uop->m_uop_info.m_btb_miss && !(uop->m_uop_info.m_btb_miss_resolved)) { 
+    if (uop->m_cold->m_uop_info.m_btb_miss && !(uop->m_cold->m_uop_info.m_btb_miss_resolved)) { 
       
       STAT_CORE_EVENT(m_core_id, BP_REDIRECT_RESOLVED); 
       
       m_bp_data->m_bp_targ_pred->update (uop);  // update 
 
       // redirect cycle
-      m_bp_data->m_bp_redirect_cycle[uop->m_thread_id] = 
+      m_bp_data->m_bp_redirect_cycle[thread_slot] = 
         m_cur_core_cycle + 1 + *m_simBase->m_knobs->KNOB_EXTRA_RECOVERY_CYCLES;
 
-      uop->m_uop_info.m_btb_miss_resolved = true; 
+      uop->m_cold->m_uop_info.m_btb_miss_resolved = true; 
       DEBUG("_core_id:%d thread_id:%d cur_core_cycle:%s branch misprediction is resolved: "
           "redirect_cycle:%lld uop_num:%lld\n", 
           m_core_id, uop->m_thread_id, unsstr64(m_cur_core_cycle), 
-          m_bp_data->m_bp_recovery_cycle[uop->m_thread_id], uop->m_uop_num);
+          m_bp_data->m_bp_recovery_cycle[thread_slot], uop->m_uop_num);
     }
   }
   
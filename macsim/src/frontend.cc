@@ -79,6 +79,7 @@ bool icache_fill_line_wrapper(mem_req_s *req)
   // serve merged request
   list<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E  = req->m_merge.end(); I != E; ++I) {
+    (*I)->m_service_level = req->m_service_level;
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
       continue;
@@ -166,6 +167,10 @@ frontend_c::frontend_c(FRONTEND_INTERFACE_PARAMS(), macsim_c* simBase)
   m_fetch_arbiter          = 0;
   m_mem_access_thread_num  = 0;
   m_last_fetch_tid_failed  = false;
+  m_cpi_bubble             = CPI_FRONTEND;
+  m_cpi_bubble_tid         = -1;
+  m_cpi_bubble_cycle       = 0;
+  m_barrier_blocked_thread_num = 0;
 
   FRONTEND_CONFIG();
     
@@ -232,6 +237,7 @@ void frontend_c::run_a_cycle(void)
       if (m_ready_thread_available == true) {
         STAT_CORE_EVENT(m_core_id, CORE_NUM_NO_FETCH_CYCLES_WITH_READY_THREADS);
       }
+      set_cpi_bubble(CPI_FRONTEND, -1);
       break;
     }
 
@@ -267,6 +273,7 @@ void frontend_c::run_a_cycle(void)
           }
           else {
             DEBUG("fetch stalled m_core_id:%d tid:%d\n", m_core_id, fetch_thread);
+            set_cpi_bubble(CPI_ICACHE, fetch_thread);
           }
           break;
 
@@ -297,17 +304,22 @@ void frontend_c::run_a_cycle(void)
         m_sync_done.pop_front();
         min = ~0;
 
+        thread_state_c* thread_state = m_core->m_thread_state;
         for (int tid = m_last_terminated_tid; tid < m_unique_scheduled_thread_num; ++tid) {
           /* this condition is not needed */
-          if (m_core->m_fetch_ended[tid] || m_core->m_thread_reach_end[tid]) {
+          int slot = m_core->get_thread_slot(tid);
+          if (thread_state->m_fetch_ended[slot] || thread_state->m_thread_reach_end[slot]) {
             continue;
           }
 
-          if (m_core->get_trace_info(tid)->m_block_id == block_id) {
-            frontend_s* fetch_data = m_core->get_trace_info(tid)->m_fetch_data;
+          if (thread_state->m_trace_info[slot]->m_block_id == block_id) {
+            frontend_s* fetch_data = thread_state->m_trace_info[slot]->m_fetch_data;
             if (!fetch_data->m_fetch_blocked) {
               printf("[FE] fetch not blocked!!! %d %d\n", m_core_id, tid);
             }
+            else {
+              --m_barrier_blocked_thread_num;
+            }
 
             fetch_data->m_fetch_blocked = false;
             fetch_data->m_sync_wait_count += 
@@ -325,24 +337,38 @@ void frontend_c::run_a_cycle(void)
 }
 
 
+// CPI stack : a bubble reaches the rob after the frontend queue latency and lasts as long
+// as it was; once it is older than that, an empty rob is a plain frontend bubble
+Cpi_Component frontend_c::cpi_bubble(Counter cycle, int* thread_id)
+{
+  *thread_id = m_cpi_bubble_tid;
+  if (cycle > m_cpi_bubble_cycle + m_q_frontend->latency())
+    return CPI_FRONTEND;
+
+  return m_cpi_bubble;
+}
+
+
 // fetch instructions from a thread
 FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_data)
 {
   int fetched_uops = 0;
   Break_Reason break_fetch = BREAK_DONT;
+  thread_state_c* thread_state = m_core->m_thread_state;
+  int slot = m_core->get_thread_slot(tid);
 
   // First time : set up traces for current thread 
   if (fetch_data->m_first_time) {
     m_simBase->m_trace_reader->setup_trace(m_core_id, tid, m_knob_ptx_sim);
     fetch_data->m_first_time = false;
 
-    ++m_core->m_inst_fetched[tid]; /*! initial increase */
-    if (m_core->m_inst_fetched[tid] > m_core->m_max_inst_fetched) {
-      m_core->m_max_inst_fetched = m_core->m_inst_fetched[tid];
+    ++thread_state->m_inst_fetched[slot]; /*! initial increase */
+    if (thread_state->m_inst_fetched[slot] > m_core->m_max_inst_fetched) {
+      m_core->m_max_inst_fetched = thread_state->m_inst_fetched[slot];
     }
 
     // set up initial fetch address
-    thread_s *thread = m_core->get_trace_info(tid);
+    thread_s *thread = thread_state->m_trace_info[slot];
     if (thread->m_ptx) {
       trace_info_gpu_s *prev_trace_info = static_cast<trace_info_gpu_s *>(thread->m_prev_trace_info);
       fetch_data->m_MT_scheduler.m_next_fetch_addr = prev_trace_info->m_inst_addr;
@@ -357,9 +383,10 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
   // -------------------------------------
   // check whether previous branch misprediction has been resolved
   // -------------------------------------
-  if ((m_bp_data->m_bp_recovery_cycle[tid] > m_cur_core_cycle) || 
-      (m_bp_data->m_bp_redirect_cycle[tid] > m_cur_core_cycle) ) {
+  if ((m_bp_data->m_bp_recovery_cycle[slot] > m_cur_core_cycle) || 
+      (m_bp_data->m_bp_redirect_cycle[slot] > m_cur_core_cycle) ) {
     STAT_CORE_EVENT(m_core_id, BP_MISPRED_STALL);
+    set_cpi_bubble(CPI_BR_MISPRED, tid);
 
     return FRONTEND_MODE_IFETCH;
   }
@@ -374,7 +401,7 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
     // get new fetch address (+ each application has own memory space)
     fetch_addr = fetch_data->m_MT_scheduler.m_next_fetch_addr;
     fetch_addr = fetch_addr + m_icache->base_cache_line((unsigned long)UINT_MAX *
-        (m_core->get_trace_info(tid)->m_process->m_process_id) * 10ul);
+        (thread_state->m_trace_info[slot]->m_process->m_process_id) * 10ul);
 
     // -------------------------------------
     // instruction cache access
@@ -384,6 +411,7 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
     // instruction cache miss
     if (icache_miss) {
       DEBUG_CORE(m_core_id, "set frontend[%d] is FRONTEND_MODE_WAIT_FOR_MISS\n", tid);
+      set_cpi_bubble(CPI_ICACHE, tid);
       return FRONTEND_MODE_WAIT_FOR_MISS;
     } 
     // instruction cache hit
@@ -413,7 +441,7 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
         }
         
         new_uop->m_state = OS_FETCHED; 
-        new_uop->m_fetched_cycle = m_core->get_cycle_count();
+        new_uop->m_cold->m_fetched_cycle = m_core->get_cycle_count();
 
 
         // FIXME (jaekyu, 10-4-2011)
@@ -421,20 +449,20 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
         // debugging purpose
 				if (*m_simBase->m_knobs->KNOB_BUG_DETECTOR_ENABLE) {
 	        m_simBase->m_bug_detector->allocate(new_uop);
-	        for (int ii = 0; ii < new_uop->m_num_child_uops; ++ii) {
-	          m_simBase->m_bug_detector->allocate(new_uop->m_child_uops[ii]);
+	        for (int ii = 0; ii < new_uop->m_warm->m_num_child_uops; ++ii) {
+	          m_simBase->m_bug_detector->allocate(new_uop->m_warm->m_child_uops[ii]);
 	        }
 				}
 
-        ++m_core->m_ops_to_be_dispatched[tid];
-        m_core->m_last_fetch_cycle[tid] = m_core->get_cycle_count();
+        ++thread_state->m_ops_to_be_dispatched[slot];
+        thread_state->m_last_fetch_cycle[slot] = m_core->get_cycle_count();
 
         DEBUG_CORE(m_core_id, "cycle_count:%lld m_core_id:%d tid:%d uop_num:%lld  "
             "inst_num:%lld uop.va:%s iaq:%d mem_type:%d dest:%d num_dests:%d\n",
             m_cur_core_cycle, m_core_id, new_uop->m_thread_id,
-            new_uop->m_uop_num, new_uop->m_inst_num, hexstr64s(new_uop->m_vaddr),
-            new_uop->m_allocq_num, new_uop->m_mem_type, new_uop->m_dest_info[0],
-            new_uop->m_num_dests);
+            new_uop->m_uop_num, new_uop->m_warm->m_inst_num, hexstr64s(new_uop->m_vaddr),
+            new_uop->m_allocq_num, new_uop->m_mem_type, new_uop->m_cold->m_dest_info[0],
+            new_uop->m_warm->m_num_dests);
 
 
         // -------------------------------------
@@ -452,14 +480,14 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
         // access branch predictors
         // -------------------------------------
         int br_mispred = false;
-        if (new_uop->m_cf_type) {
+        if (new_uop->m_warm->m_cf_type) {
           // btb prediction 
           bool btb_miss = btb_access(new_uop); 
 
           // branch prediction 
           br_mispred = predict_bpu(new_uop);
-          if (new_uop->m_cf_type == CF_CBR) {
-            STAT_CORE_EVENT(m_core_id, BP_ON_PATH_CORRECT+br_mispred+(new_uop->m_off_path)*3);
+          if (new_uop->m_warm->m_cf_type == CF_CBR) {
+            STAT_CORE_EVENT(m_core_id, BP_ON_PATH_CORRECT+br_mispred+(new_uop->m_warm->m_off_path)*3);
           }
 
           // BTB miss is MISFETCH. In theory, processor should access the bp only if btb hits 
@@ -467,31 +495,31 @@ FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_dat
           // This might be changed in future 
 
           if (btb_miss & !br_mispred)
-            STAT_CORE_EVENT(m_core_id, BP_ON_PATH_MISFETCH+(new_uop->m_off_path)*3);
+            STAT_CORE_EVENT(m_core_id, BP_ON_PATH_MISFETCH+(new_uop->m_warm->m_off_path)*3);
 
 
           // set frontend misprediction */
           if (br_mispred) {
             /*! should be per core */
-            m_bp_data->m_bp_recovery_cycle[new_uop->m_thread_id] = MAX_CTR;
-            m_bp_data->m_bp_cause_op[new_uop->m_thread_id] = new_uop->m_uop_num;
+            m_bp_data->m_bp_recovery_cycle[slot] = MAX_CTR;
+            m_bp_data->m_bp_cause_op[slot] = new_uop->m_uop_num;
 
             DEBUG_CORE(m_core_id, "m_core_id:%d tid:%d branch is mispredicted inst_num:%lld "
-                "uop_num:%lld\n", m_core_id, new_uop->m_thread_id, new_uop->m_inst_num, 
+                "uop_num:%lld\n", m_core_id, new_uop->m_thread_id, new_uop->m_warm->m_inst_num, 
                 new_uop->m_uop_num);
           } 
           else if (btb_miss) { 
-            m_bp_data->m_bp_redirect_cycle[new_uop->m_thread_id] = MAX_CTR; 
-            m_bp_data->m_bp_cause_op[new_uop->m_thread_id] = new_uop->m_uop_num;
+            m_bp_data->m_bp_redirect_cycle[slot] = MAX_CTR; 
+            m_bp_data->m_bp_cause_op[slot] = new_uop->m_uop_num;
 
             DEBUG_CORE(m_core_id, "m_core_id:%d tid:%d branch is misfetched(btb_miss) "
                 "inst_num:%lld uop_num:%lld\n", m_core_id, new_uop->m_thread_id, 
-                new_uop->m_inst_num, new_uop->m_uop_num);
+                new_uop->m_warm->m_inst_num, new_uop->m_uop_num);
           }
           else {
-            fetch_data->m_MT_scheduler.m_next_fetch_addr = new_uop->m_npc;
+            fetch_data->m_MT_scheduler.m_next_fetch_addr = new_uop->m_cold->m_npc;
             DEBUG_CORE(m_core_id, "m_core_id:%d tid:%d MT_scheduler[%d]->0x%s \n",
-                m_core_id, new_uop->m_thread_id, tid, hexstr64s(new_uop->m_npc));
+                m_core_id, new_uop->m_thread_id, tid, hexstr64s(new_uop->m_cold->m_npc));
           }
         }
 
@@ -643,8 +671,8 @@ inline void frontend_c::send_uop_to_qfe(uop_c *uop)
   // Since one line of ICache has ~4 insts, W Counter is #insts/4
   POWER_CORE_EVENT(m_core_id, POWER_FETCH_QUEUE_W);	
   DEBUG("m_core_id:%d tid:%d inst_num:%s uop_num:%s opcode:%d isitEOM:%d sent to qfe \n", 
-      m_core_id, uop->m_thread_id, unsstr64(uop->m_inst_num), unsstr64(uop->m_uop_num), 
-      (int)uop->m_opcode, uop->m_isitEOM);
+      m_core_id, uop->m_thread_id, unsstr64(uop->m_warm->m_inst_num), unsstr64(uop->m_uop_num), 
+      (int)uop->m_warm->m_opcode, uop->m_warm->m_isitEOM);
 
   ASSERT(success);
 }
@@ -657,7 +685,7 @@ int frontend_c::predict_bpu(uop_c *uop)
 {
   uns8 pred_dir = 0; // initialized to dummy value
   bool mispredicted = false;
-  switch (uop->m_cf_type) {
+  switch (uop->m_warm->m_cf_type) {
     case CF_BR:
       // 100 % accurate
     case CF_CBR:
@@ -665,7 +693,7 @@ int frontend_c::predict_bpu(uop_c *uop)
         pred_dir = (m_bp_data->m_bp_targ_pred)->pred(uop);
       else
         pred_dir = (m_bp_data->m_bp)->pred(uop);
-      mispredicted = (pred_dir != uop->m_dir);
+      mispredicted = (pred_dir != uop->m_warm->m_dir);
       POWER_CORE_EVENT(m_core_id, POWER_BR_PRED_R);
       break;
     case CF_CALL:
@@ -709,13 +737,13 @@ int frontend_c::predict_bpu(uop_c *uop)
   if (*m_simBase->m_knobs->KNOB_PERFECT_BP) 
     mispredicted = false;
 
-  uop->m_mispredicted = mispredicted;
+  uop->m_cold->m_mispredicted = mispredicted;
 
   DEBUG("m_core_id:%d tid:%d uop_num:%s pc:0x%s cf_type:%d dir:%d pred:%d mispredicted:%d \n", 
-      uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), hexstr64s(uop->m_pc), 
-      uop->m_cf_type, uop->m_dir, pred_dir, mispredicted);
+      uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), hexstr64s(uop->m_warm->m_pc), 
+      uop->m_warm->m_cf_type, uop->m_warm->m_dir, pred_dir, mispredicted);
 
-  return uop->m_mispredicted;
+  return uop->m_cold->m_mispredicted;
 }
 
 // btb accesses 
@@ -726,19 +754,19 @@ bool frontend_c::btb_access(uop_c *uop)
 
   bool btb_miss = false; 
   Addr pred_targ_addr = m_bp_data->m_bp_targ_pred->pred(uop);
-  if (pred_targ_addr != uop->m_npc) 
+  if (pred_targ_addr != uop->m_cold->m_npc) 
     btb_miss = true; 
 
-  uop->m_uop_info.m_btb_miss = btb_miss; 
+  uop->m_cold->m_uop_info.m_btb_miss = btb_miss; 
 
   DEBUG("m_core_id:%d tid:%d uop_num:%s pc:0x%s cf_type:%d dir:%d oracle_npc:%s pred_targ:%s "
       "btb_miss:%d \n", 
-      uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), hexstr64s(uop->m_pc), 
-      uop->m_cf_type, uop->m_dir, hexstr64s(uop->m_npc), hexstr64s(pred_targ_addr), btb_miss);
+      uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), hexstr64s(uop->m_warm->m_pc), 
+      uop->m_warm->m_cf_type, uop->m_warm->m_dir, hexstr64s(uop->m_cold->m_npc), hexstr64s(pred_targ_addr), btb_miss);
 
   // need to set up redirect 
 
-  return uop->m_uop_info.m_btb_miss; 
+  return uop->m_cold->m_uop_info.m_btb_miss; 
 
 }
 
@@ -780,14 +808,16 @@ int frontend_c::fetch_rr(void)
       m_fetch_arbiter = m_last_terminated_tid;
 
     // already terminated or fetch not ready
-    if (m_core->m_fetch_ended[fetch_id] || m_core->m_thread_reach_end[fetch_id] || 
+    int slot = m_core->get_thread_slot(fetch_id);
+    if (m_core->m_thread_state->m_fetch_ended[slot] || 
+        m_core->m_thread_state->m_thread_reach_end[slot] || 
         (*m_simBase->m_knobs->KNOB_NO_FETCH_ON_ICACHE_MISS && !check_fetch_ready(fetch_id))) {
       ++try_again;
       continue;
     }
 
     // fetch blocked, try next thread
-    frontend_s* fetch_data = m_core->get_trace_info(fetch_id)->m_fetch_data;
+    frontend_s* fetch_data = m_core->m_thread_state->m_trace_info[slot]->m_fetch_data;
     if (fetch_data!= NULL && fetch_data->m_fetch_blocked) {
       DEBUG("m_core_id:%d tid:%d fetch_blocked\n", m_core_id, fetch_id);
       ++try_again;
@@ -859,7 +889,12 @@ void frontend_c::set_br_wait(int fetch_id)
 // set previous load ready
 void frontend_c::set_load_ready(int fetch_id, Counter uop_num) 
 {
-  frontend_s* fetch_data = m_core->get_trace_info(fetch_id)->m_fetch_data;
+  // the thread has already been terminated
+  thread_s* thread = m_core->get_trace_info(fetch_id);
+  if (thread == NULL)
+    return ;
+
+  frontend_s* fetch_data = thread->m_fetch_data;
 
   if (fetch_data->m_load_waiting.find(uop_num) != fetch_data->m_load_waiting.end()) {
     --fetch_data->m_MT_load_waiting; 
@@ -875,7 +910,12 @@ void frontend_c::set_load_ready(int fetch_id, Counter uop_num)
 // set previous branch ready 
 void frontend_c::set_br_ready(int fetch_id) 
 {
-  frontend_s* fetch_data = m_core->get_trace_info(fetch_id)->m_fetch_data;
+  // the thread has already been terminated
+  thread_s* thread = m_core->get_trace_info(fetch_id);
+  if (thread == NULL)
+    return ;
+
+  frontend_s* fetch_data = thread->m_fetch_data;
   fetch_data->m_MT_br_waiting = false;
 }
 
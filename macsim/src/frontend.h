@@ -44,6 +44,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "macsim.h"
 #include "global_types.h"
+#include "cpi_stack.h"
 
 
 // FIXME
@@ -392,6 +393,28 @@ class frontend_c
      */
     pool_c<uop_c>* get_uop_pool() { return m_uop_pool; }
 
+    /**
+     * CPI stack : cause of the fetch bubble that can reach the rob at cycle; a bubble older
+     * than the fetch-to-allocate latency has drained and counts as CPI_FRONTEND
+     * @param thread_id - thread of the bubble (-1: none)
+     */
+    Cpi_Component cpi_bubble(Counter cycle, int* thread_id);
+
+    /**
+     * GPU : number of threads whose fetch is blocked on a barrier
+     */
+    int barrier_blocked_thread_num(void) { return m_barrier_blocked_thread_num; }
+
+    /**
+     * GPU : a thread's fetch got blocked on a barrier
+     */
+    void inc_barrier_blocked_thread_num(void) { ++m_barrier_blocked_thread_num; }
+
+    /**
+     * GPU : a thread's fetch got released from a barrier
+     */
+    void dec_barrier_blocked_thread_num(void) { --m_barrier_blocked_thread_num; }
+
   public:
     hash_c<sync_thread_s>* m_sync_info; /**< synchronization information */
 
@@ -427,6 +450,16 @@ class frontend_c
      */
     void send_uop_to_qfe(uop_c *);
 
+    /**
+     * CPI stack : record the cause of a fetch bubble
+     */
+    inline void set_cpi_bubble(Cpi_Component reason, int tid)
+    {
+      m_cpi_bubble       = reason;
+      m_cpi_bubble_tid   = tid;
+      m_cpi_bubble_cycle = m_cur_core_cycle;
+    }
+
   protected:
     FRONTEND_INTERFACE_DECL(); /**< declaration macro */
 
@@ -444,6 +477,10 @@ class frontend_c
     bool          m_ready_thread_available; /**< ready thread available */
     int           m_mem_access_thread_num; /**< number of threads that access memory */
     int           m_fetch_ratio; /**< how often fetch an instruction (GPU only) */
+    Cpi_Component m_cpi_bubble; /**< cause of the last fetch bubble */
+    int           m_cpi_bubble_tid; /**< thread of the last fetch bubble */
+    Counter       m_cpi_bubble_cycle; /**< cycle of the last fetch bubble */
+    int           m_barrier_blocked_thread_num; /**< number of threads blocked on a barrier */
 
     bool          m_dcache_bank_busy[129]; /**< dcache bank busy status */
 
@@ -95,6 +95,10 @@ class thread_s;
 class throttler_c;
 class fbstream_c;
 class bug_detector_c;
+class stat_sampler_c;
+class mem_latency_c;
+class pc_profiler_c;
+class cpi_stack_c;
 class queue_c;
 class multi_key_map_c;
 class inst_info_s;
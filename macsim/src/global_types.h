@@ -76,4 +76,16 @@ typedef enum _Unit_Type_enum
   UNIT_LARGE /**< large core */
 } Unit_Type;
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Core pipeline kind, fixed when a core is constructed
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _Core_Kind_enum
+{
+  CORE_X86_OOO = 0, /**< x86 core with the out-of-order scheduler */
+  CORE_X86_IO, /**< x86 core with the in-order scheduler */
+  CORE_PTX, /**< ptx core on the x86 pipeline stages (gpu_sched off) */
+  CORE_PTX_SM /**< ptx streaming multiprocessor (gpu_sched on) */
+} Core_Kind;
+
 #endif 
@@ -0,0 +1,706 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/**********************************************************************************************
+ * File         : llc_policy.cc
+ * Description  : last-level cache replacement/insertion policies
+ *********************************************************************************************/
+
+
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "llc_policy.h"
+#include "assert_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+#include "statistics.h"
+#include "all_stats.h"
+
+
+// leader sets of each policy per owner (Qureshi et al. use 32)
+#define LLC_DUELING_LEADERS 32
+
+// TADIP : applications beyond this share leader sets and PSEL (appl_id modulo)
+#define LLC_TADIP_MAX_OWNERS 8
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+set_dueling_c::set_dueling_c(int num_sets, int num_owners, int psel_bits)
+{
+  // fewer leaders when the cache is too small for 32 constituencies
+  m_constituency = num_sets / LLC_DUELING_LEADERS;
+  if (m_constituency < 2 * num_owners)
+    m_constituency = 2 * num_owners;
+  assert(m_constituency <= num_sets);
+
+  m_psel_max = (1 << psel_bits) - 1;
+  m_psel.resize(num_owners, m_psel_max / 2);
+}
+
+
+Llc_Policy llc_policy_from_name(const string& name)
+{
+  static const char* names[LLC_POLICY_MAX] = {
+    "lru", "plru", "bip", "dip", "tadip", "srrip", "brrip", "drrip", "tap", "ucp", "bdi",
+  };
+
+  if (name == "default")
+    return LLC_LRU;
+
+  for (int ii = 0; ii < LLC_POLICY_MAX; ++ii) {
+    if (name == names[ii])
+      return static_cast<Llc_Policy>(ii);
+  }
+
+  return LLC_POLICY_MAX;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+llc_plru_c::llc_plru_c(string name, int num_set, int assoc, int line_size, int data_size, 
+    int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+    bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase)
+  : cache_c(name, num_set, assoc, line_size, data_size, bank_num, cache_by_pass, core_id,
+      cache_type_info, enable_partition, num_tiles, interleave_factor, simBase)
+{
+  m_find_victim = &cache_c::find_replacement_line_plru;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+llc_dip_c::llc_dip_c(string name, int num_set, int assoc, int line_size, int data_size, 
+    int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+    bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase,
+    Llc_Policy policy)
+  : cache_c(name, num_set, assoc, line_size, data_size, bank_num, cache_by_pass, core_id,
+      cache_type_info, enable_partition, num_tiles, interleave_factor, simBase)
+{
+  m_policy    = policy;
+  m_bip_mask  = (1ull << *KNOB(KNOB_TADIP_CACHE_BIP_EPSILON)) - 1;
+  m_bip_count = 0;
+
+  m_dueling    = NULL;
+  m_num_owners = (policy == LLC_TADIP) ? LLC_TADIP_MAX_OWNERS : 1;
+  if (policy != LLC_BIP) {
+    m_dueling = new set_dueling_c(num_set, m_num_owners, 
+        *KNOB(KNOB_TADIP_CACHE_NUM_COUNTER_BIT));
+  }
+}
+
+
+llc_dip_c::~llc_dip_c()
+{
+  delete m_dueling;
+}
+
+
+// a fill follows a miss : train the dueling monitor and pick the insertion position
+void llc_dip_c::initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, 
+    bool gpuline, int set_id, bool skip)
+{
+  cache_c::initialize_cache_line(way, tag, addr, appl_id, gpuline, set_id, skip);
+
+  bool bip = true;
+  if (m_dueling) {
+    int owner = (appl_id < 0 ? 0 : appl_id) % m_num_owners;
+    m_dueling->miss(set_id, owner);
+    bip = m_dueling->use_b(set_id, owner);
+  }
+
+  // BIP : LRU position, except every 2^epsilon-th fill
+  if (bip && (m_bip_count++ & m_bip_mask) != 0)
+    m_set[set_id]->m_last_access_time[way] = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+llc_rrip_c::llc_rrip_c(string name, int num_set, int assoc, int line_size, int data_size, 
+    int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+    bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase,
+    Llc_Policy policy)
+  : cache_c(name, num_set, assoc, line_size, data_size, bank_num, cache_by_pass, core_id,
+      cache_type_info, enable_partition, num_tiles, interleave_factor, simBase)
+{
+  int num_bit = *KNOB(KNOB_RRIP_CACHE_NUM_BIT);
+  ASSERTM(num_bit > 0 && num_bit <= 8, "rrip_cache_num_bit should be 1..8\n");
+
+  m_policy      = policy;
+  m_max_rrpv    = (1 << num_bit) - 1;
+  m_insert_rrpv = MIN2(*KNOB(KNOB_RRIP_CACHE_INSERT_AT), m_max_rrpv);
+  m_rrpv.resize(num_set * assoc, m_max_rrpv);
+  m_bip_mask    = (1ull << *KNOB(KNOB_RRIP_CACHE_BIP_EPSILON)) - 1;
+  m_bip_count   = 0;
+
+  m_dueling = NULL;
+  if (policy == LLC_DRRIP || policy == LLC_TAP) {
+    m_dueling = new set_dueling_c(num_set, policy == LLC_TAP ? 2 : 1, 
+        *KNOB(KNOB_RRIP_CACHE_NUM_COUNTER_BIT));
+  }
+
+  m_tap_period          = *KNOB(KNOB_ABIP_CACHE_PERIOD);
+  m_tap_next_period     = m_tap_period;
+  m_tap_gpu_miss[0]     = 0;
+  m_tap_gpu_miss[1]     = 0;
+  m_tap_gpu_insensitive = false;
+}
+
+
+llc_rrip_c::~llc_rrip_c()
+{
+  delete m_dueling;
+}
+
+
+void llc_rrip_c::update_line_on_hit(int set, int way, int appl_id)
+{
+  cache_c::update_line_on_hit(set, way, appl_id);
+  m_rrpv[set * m_assoc + way] = 0;
+}
+
+
+// a line with the distant RRPV; age the whole set when there is none
+int llc_rrip_c::find_replacement_line(int set, int appl_id)
+{
+  cache_set_c* set_ptr = m_set[set];
+  uns8* rrpv = &m_rrpv[set * m_assoc];
+
+  int victim = 0;
+  uns8 oldest = 0;
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    if (!set_ptr->is_valid(ii))
+      return ii;
+
+    if (rrpv[ii] > oldest) {
+      oldest = rrpv[ii];
+      victim = ii;
+    }
+  }
+
+  if (oldest < m_max_rrpv) {
+    uns8 age = m_max_rrpv - oldest;
+    for (int ii = 0; ii < m_assoc; ++ii) {
+      rrpv[ii] += age;
+    }
+  }
+
+  return victim;
+}
+
+
+// aging raises every RRPV by the same amount, so the victim is the first oldest line
+int llc_rrip_c::peek_replacement_line(int set, int appl_id)
+{
+  cache_set_c* set_ptr = m_set[set];
+  uns8* rrpv = &m_rrpv[set * m_assoc];
+
+  int victim = 0;
+  uns8 oldest = 0;
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    if (!set_ptr->is_valid(ii))
+      return ii;
+
+    if (rrpv[ii] > oldest) {
+      oldest = rrpv[ii];
+      victim = ii;
+    }
+  }
+
+  return victim;
+}
+
+
+// a fill follows a miss : train the dueling monitor and pick the insertion RRPV
+void llc_rrip_c::initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, 
+    bool gpuline, int set_id, bool skip)
+{
+  cache_c::initialize_cache_line(way, tag, addr, appl_id, gpuline, set_id, skip);
+
+  bool brrip = (m_policy == LLC_BRRIP);
+  bool distant = false;
+  if (m_dueling) {
+    int owner = (m_policy == LLC_TAP && gpuline) ? 1 : 0;
+    m_dueling->miss(set_id, owner);
+    brrip = m_dueling->use_b(set_id, owner);
+
+    if (m_policy == LLC_TAP && gpuline) {
+      int kind = m_dueling->leader(set_id, 1);
+      if (kind != -1)
+        ++m_tap_gpu_miss[kind];
+      else
+        distant = m_tap_gpu_insensitive;
+
+      if (CYCLE >= m_tap_next_period)
+        tap_update_period();
+    }
+  }
+
+  uns8 insert = m_insert_rrpv;
+  if (distant || (brrip && (m_bip_count++ & m_bip_mask) != 0))
+    insert = m_max_rrpv;
+
+  m_rrpv[set_id * m_assoc + way] = insert;
+}
+
+
+// GPU misses barely depend on the insertion policy : the GPU is cache-insensitive
+void llc_rrip_c::tap_update_period(void)
+{
+  Counter miss_max = MAX2(m_tap_gpu_miss[0], m_tap_gpu_miss[1]);
+  Counter miss_min = MIN2(m_tap_gpu_miss[0], m_tap_gpu_miss[1]);
+  if (miss_max > 0) {
+    m_tap_gpu_insensitive = 
+      (miss_max - miss_min) * 100 < miss_max * *KNOB(KNOB_LLC_TAP_THRESHOLD);
+  }
+
+  m_tap_gpu_miss[0] = 0;
+  m_tap_gpu_miss[1] = 0;
+  m_tap_next_period = CYCLE + m_tap_period;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+llc_ucp_c::llc_ucp_c(string name, int num_set, int assoc, int line_size, int data_size, 
+    int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+    bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase)
+  : cache_c(name, num_set, assoc, line_size, data_size, bank_num, cache_by_pass, core_id,
+      cache_type_info, enable_partition, num_tiles, interleave_factor, simBase)
+{
+  m_num_app = *KNOB(KNOB_UCP_CACHE_NUM_APPLICATION);
+  ASSERTM(m_num_app > 0 && m_num_app <= assoc, 
+      "ucp_cache_num_application should be 1..%d\n", assoc);
+
+  m_sample_stride  = MAX2(num_set / LLC_DUELING_LEADERS, 1);
+  m_period         = *KNOB(KNOB_UCP_CACHE_PARTITION_PERIOD);
+  m_next_partition = m_period;
+  m_for_gpu        = *KNOB(KNOB_UCP_CACHE_FOR_GPU);
+  m_gpu_lookup     = MAX2(*KNOB(KNOB_UCP_CACHE_GPU_MAX_PARTITION_LOOKUP), 1);
+  m_gpu_drop       = *KNOB(KNOB_UCP_CACHE_GPU_DROP_PROBABILITY);
+  m_gpu_access     = 0;
+
+  int num_sampled = (num_set + m_sample_stride - 1) / m_sample_stride;
+  m_alloc.resize(m_num_app, assoc / m_num_app);
+  m_gpu_app.resize(m_num_app, false);
+  m_atd.resize(m_num_app * num_sampled * assoc, 0);
+  m_hit.resize(m_num_app * assoc, 0);
+  m_access.resize(m_num_app, 0);
+  m_count.resize(m_num_app, 0);
+
+  string stat_dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(stat_dir.c_str(), S_IRWXU);
+  string path = stat_dir + "/ucp.out";
+  m_file = fopen(path.c_str(), "w");
+  ASSERTM(m_file, "cannot open %s\n", path.c_str());
+  fprintf(m_file, "# cycle, then ways / umon hits / umon accesses per application\n");
+}
+
+
+llc_ucp_c::~llc_ucp_c()
+{
+  fclose(m_file);
+}
+
+
+// UMON : LRU stack of the sampled set in the application's auxiliary tag directory
+void llc_ucp_c::update_cache_on_access(Addr tag, int set, int appl_id)
+{
+  if (CYCLE >= m_next_partition)
+    repartition();
+
+  if (set % m_sample_stride)
+    return;
+
+  int app = app_index(appl_id);
+  if (m_for_gpu && m_gpu_app[app] && static_cast<int>(m_gpu_access++ % 100) < m_gpu_drop)
+    return;
+
+  ++m_access[app];
+
+  Addr* stack = &m_atd[(app * (m_atd.size() / m_num_app / m_assoc) + set / m_sample_stride) * 
+    m_assoc];
+  int pos = 0;
+  while (pos < m_assoc - 1 && stack[pos] != tag) 
+    ++pos;
+
+  if (stack[pos] == tag) 
+    ++m_hit[app * m_assoc + pos];
+
+  memmove(stack + 1, stack, pos * sizeof(Addr));
+  stack[0] = tag;
+}
+
+
+// enforce the allocation : LRU line of an application over its allocation, or own LRU line
+int llc_ucp_c::find_replacement_line(int set, int appl_id)
+{
+  cache_set_c* set_ptr = m_set[set];
+  int app = app_index(appl_id);
+
+  fill(m_count.begin(), m_count.end(), 0);
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    if (!set_ptr->is_valid(ii))
+      return ii;
+    ++m_count[app_index(set_ptr->m_entry[ii].m_appl_id)];
+  }
+
+  bool own = m_count[app] >= m_alloc[app];
+  int lru_index = -1;
+  Counter lru_time = ULLONG_MAX;
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    int owner = app_index(set_ptr->m_entry[ii].m_appl_id);
+    bool candidate = own ? (owner == app) : (owner != app && m_count[owner] > m_alloc[owner]);
+    if (candidate && set_ptr->m_last_access_time[ii] < lru_time) {
+      lru_index = ii;
+      lru_time  = set_ptr->m_last_access_time[ii];
+    }
+  }
+
+  // nobody over its allocation (just repartitioned) : plain LRU
+  if (lru_index == -1)
+    lru_index = find_replacement_line_lru(set_ptr);
+
+  return lru_index;
+}
+
+
+void llc_ucp_c::initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, 
+    bool gpuline, int set_id, bool skip)
+{
+  cache_c::initialize_cache_line(way, tag, addr, appl_id, gpuline, set_id, skip);
+
+  if (gpuline)
+    m_gpu_app[app_index(appl_id)] = true;
+}
+
+
+// lookahead : repeatedly give the ways with the highest marginal utility per way
+void llc_ucp_c::repartition(void)
+{
+  vector<Counter> utility((m_assoc + 1) * m_num_app, 0); // hits with n ways
+  for (int app = 0; app < m_num_app; ++app) {
+    for (int ii = 0; ii < m_assoc; ++ii) {
+      utility[app * (m_assoc + 1) + ii + 1] = 
+        utility[app * (m_assoc + 1) + ii] + m_hit[app * m_assoc + ii];
+    }
+  }
+
+  fill(m_alloc.begin(), m_alloc.end(), 1);
+  int balance = m_assoc - m_num_app;
+  while (balance > 0) {
+    double best_mu = -1.0;
+    int best_app = 0;
+    int best_ways = 1;
+    for (int app = 0; app < m_num_app; ++app) {
+      int lookup = (m_for_gpu && m_gpu_app[app]) ? MIN2(balance, m_gpu_lookup) : balance;
+      Counter base = utility[app * (m_assoc + 1) + m_alloc[app]];
+      for (int ways = 1; ways <= lookup; ++ways) {
+        double mu = 
+          static_cast<double>(utility[app * (m_assoc + 1) + m_alloc[app] + ways] - base) / ways;
+        if (mu > best_mu) {
+          best_mu   = mu;
+          best_app  = app;
+          best_ways = ways;
+        }
+      }
+    }
+
+    m_alloc[best_app] += best_ways;
+    balance -= best_ways;
+  }
+
+  fprintf(m_file, "%llu", CYCLE);
+  for (int app = 0; app < m_num_app; ++app) {
+    fprintf(m_file, " %d/%llu/%llu", m_alloc[app], utility[app * (m_assoc + 1) + m_assoc], 
+        m_access[app]);
+  }
+  fprintf(m_file, "\n");
+  fflush(m_file);
+
+  // age the monitors
+  for (unsigned int ii = 0; ii < m_hit.size(); ++ii) {
+    m_hit[ii] /= 2;
+  }
+  for (int app = 0; app < m_num_app; ++app) {
+    m_access[app] /= 2;
+  }
+
+  m_next_partition = CYCLE + m_period;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// BDI encodings (LLC_BDI_ENC_* order)
+#define LLC_BDI_NUM_ENC 9
+
+
+llc_bdi_c::llc_bdi_c(string name, int num_set, int assoc, int line_size, int data_size, 
+    int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+    bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase)
+  : cache_c(name, num_set, assoc * *simBase->m_knobs->KNOB_LLC_BDI_TAG_RATIO, line_size, 
+      data_size, bank_num, cache_by_pass, core_id, cache_type_info, enable_partition, 
+      num_tiles, interleave_factor, simBase)
+{
+  int segment_size = *KNOB(KNOB_LLC_BDI_SEGMENT_SIZE);
+  ASSERTM(*KNOB(KNOB_LLC_BDI_TAG_RATIO) >= 1, "llc_bdi_tag_ratio should be at least 1\n");
+  ASSERTM(segment_size > 0 && line_size % segment_size == 0, 
+      "llc_bdi_segment_size %d should divide the line size %d\n", segment_size, line_size);
+
+  m_line_segs      = line_size / segment_size;
+  m_data_segs      = assoc * m_line_segs;
+  m_decomp_latency = *KNOB(KNOB_LLC_BDI_DECOMP_LATENCY);
+  m_window         = MAX2(static_cast<int>(*KNOB(KNOB_LLC_BDI_VICTIM_WINDOW)), 1);
+  m_page_bits      = log2_int(*KNOB(KNOB_LLC_BDI_PAGE_SIZE));
+  m_segs.resize(num_set * m_assoc, 0);
+  m_victim_data.resize(m_line_segs * data_size);
+
+  // compressed bytes : zeros, repeated 8-byte value, base (8/4/2 bytes) + one delta per value
+  int bytes[LLC_BDI_NUM_ENC] = {
+    1, 8, 
+    8 + line_size / 8, 8 + line_size / 8 * 2, 8 + line_size / 8 * 4, 
+    4 + line_size / 4, 4 + line_size / 4 * 2, 
+    2 + line_size / 2, 
+    line_size
+  };
+  for (int ii = 0; ii < LLC_BDI_NUM_ENC; ++ii) {
+    m_enc_segs.push_back(MIN2((bytes[ii] + segment_size - 1) / segment_size, m_line_segs));
+  }
+
+  string dist = KNOB(KNOB_LLC_BDI_DIST)->getValue();
+  ASSERTM(parse_weights(dist, &m_dist), "llc_bdi_dist %s : nine weights expected\n", 
+      dist.c_str());
+
+  string profile = KNOB(KNOB_LLC_BDI_PROFILE)->getValue();
+  if (profile != "none")
+    load_profile(profile);
+}
+
+
+bool llc_bdi_c::parse_weights(const string& weights, vector<uns>* cumulative)
+{
+  string line = weights;
+  replace(line.begin(), line.end(), ',', ' ');
+  stringstream sstr(line);
+
+  uns total = 0;
+  uns weight;
+  cumulative->clear();
+  while (sstr >> weight) {
+    total += weight;
+    cumulative->push_back(total);
+  }
+
+  return cumulative->size() == LLC_BDI_NUM_ENC && total > 0;
+}
+
+
+void llc_bdi_c::load_profile(const string& path)
+{
+  ifstream file(path.c_str());
+  ASSERTM(file.is_open(), "cannot open llc_bdi_profile %s\n", path.c_str());
+
+  string line;
+  while (getline(file, line)) {
+    stringstream sstr(line.substr(0, line.find('#')));
+    string page;
+    if (!(sstr >> page))
+      continue;
+
+    string weights;
+    getline(sstr, weights);
+    Addr page_addr = strtoull(page.c_str(), NULL, 16);
+    ASSERTM(parse_weights(weights, &m_profile[page_addr >> m_page_bits]), 
+        "%s: page %s : nine weights expected\n", path.c_str(), page.c_str());
+  }
+}
+
+
+// weighted pick by a hash of the line address
+int llc_bdi_c::encoding(Addr line_addr)
+{
+  vector<uns>* weights = &m_dist;
+  if (!m_profile.empty()) {
+    auto I = m_profile.find(line_addr >> m_page_bits);
+    if (I != m_profile.end())
+      weights = &I->second;
+  }
+
+  uns64 hash = (line_addr / m_line_size) * 0x9e3779b97f4a7c15ULL;
+  hash ^= hash >> 32;
+  uns pick = hash % weights->back();
+
+  int enc = 0;
+  while ((*weights)[enc] <= pick)
+    ++enc;
+
+  return enc;
+}
+
+
+void* llc_bdi_c::insert_cache(Addr addr, Addr *line_addr, Addr *updated_line, int appl_id, 
+    bool gpuline, bool skip)
+{
+  Addr tag;
+  int set;
+  *line_addr = base_cache_line(addr);
+  find_tag_and_set(addr, &tag, &set);
+
+  int enc  = encoding(*line_addr);
+  int need = m_enc_segs[enc];
+  STAT_EVENT(LLC_BDI_INSERT);
+  STAT_EVENT(LLC_BDI_ENC_ZEROS + enc);
+
+  cache_set_c* set_ptr = m_set[set];
+  uns8* segs = &m_segs[set * m_assoc];
+
+  // free tag entry and used segments
+  int free_way = -1;
+  int used = 0;
+  m_order.clear();
+  for (int ii = 0; ii < m_assoc; ++ii) {
+    if (set_ptr->is_valid(ii)) {
+      used += segs[ii];
+      m_order.push_back(ii);
+    }
+    else if (free_way == -1) {
+      free_way = ii;
+    }
+  }
+
+  // -------------------------------------
+  // victims : the oldest line that alone makes room, otherwise LRU order
+  // -------------------------------------
+  int num_victim = 0;
+  if (free_way == -1 || used + need > m_data_segs) {
+    sort(m_order.begin(), m_order.end(), [set_ptr](int a, int b) {
+        return set_ptr->m_last_access_time[a] < set_ptr->m_last_access_time[b]; });
+
+    int window = MIN2(m_window, static_cast<int>(m_order.size()));
+    for (int ii = 0; ii < window; ++ii) {
+      if (used - segs[m_order[ii]] + need <= m_data_segs) {
+        if (ii > 0)
+          STAT_EVENT(LLC_BDI_COMPACT_VICTIM);
+        swap(m_order[0], m_order[ii]);
+        num_victim = 1;
+        break;
+      }
+    }
+
+    if (num_victim == 0) {
+      while (used + need > m_data_segs) {
+        used -= segs[m_order[num_victim++]];
+      }
+    }
+  }
+
+  // -------------------------------------
+  // replace : the new line takes the tag entry of the first victim
+  // -------------------------------------
+  int way = free_way;
+  *updated_line = 0;
+  m_victims.clear();
+  for (int ii = 0; ii < num_victim; ++ii) {
+    int victim = m_order[ii];
+    cache_entry_c* line = &set_ptr->m_entry[victim];
+    update_set_on_replacement(tag, line->m_appl_id, set, line->m_gpuline);
+    if (ii == 0) {
+      way = victim;
+      *updated_line = line->m_base;
+    }
+    else {
+      // the data is copied out : invalidation clears the line
+      STAT_EVENT(LLC_BDI_MULTI_EVICT);
+      void* data = &m_victim_data[m_victims.size() * m_data_size];
+      memcpy(data, line->m_data, m_data_size);
+      m_victims.push_back(make_pair(line->m_base, data));
+      null_cache_line_fields(set, victim);
+    }
+  }
+
+  initialize_cache_line(way, tag, addr, appl_id, gpuline, set, skip);
+  segs[way] = need;
+  ++m_insert_count;
+
+  STAT_EVENT_N(LLC_BDI_SEGMENTS, need);
+  STAT_EVENT_N(LLC_BDI_COMPRESSION_RATIO, m_line_segs);
+  STAT_EVENT_N(LLC_BDI_SET_LINES, m_order.size() - num_victim + 1);
+
+  return set_ptr->m_entry[way].m_data;
+}
+
+
+bool llc_bdi_c::pop_victim(Addr *line_addr, void **data)
+{
+  if (m_victims.empty())
+    return false;
+
+  *line_addr = m_victims.back().first;
+  *data      = m_victims.back().second;
+  m_victims.pop_back();
+
+  return true;
+}
+
+
+// every victim frees at least one segment
+int llc_bdi_c::max_victims(void)
+{
+  return m_line_segs;
+}
+
+
+int llc_bdi_c::extra_hit_latency(Addr addr)
+{
+  Addr tag;
+  int set;
+  find_tag_and_set(addr, &tag, &set);
+
+  int way = m_set[set]->find_way(tag);
+  if (way == -1 || m_segs[set * m_assoc + way] == m_line_segs)
+    return 0;
+
+  return m_decomp_latency;
+}
@@ -0,0 +1,378 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/**********************************************************************************************
+ * File         : llc_policy.h
+ * Description  : last-level cache replacement/insertion policies
+ *********************************************************************************************/
+
+#ifndef LLC_POLICY_H_INCLUDED
+#define LLC_POLICY_H_INCLUDED
+
+
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+
+#include "cache.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief LLC policy kinds (llc_type knob)
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum Llc_Policy_enum {
+  LLC_LRU = 0,  /**< true LRU (also "default") */
+  LLC_PLRU,     /**< pseudo-LRU */
+  LLC_BIP,      /**< bimodal insertion */
+  LLC_DIP,      /**< dynamic insertion : LRU vs BIP set dueling */
+  LLC_TADIP,    /**< thread-aware DIP : set dueling per application */
+  LLC_SRRIP,    /**< static RRIP */
+  LLC_BRRIP,    /**< bimodal RRIP */
+  LLC_DRRIP,    /**< dynamic RRIP : SRRIP vs BRRIP set dueling */
+  LLC_TAP,      /**< TLP-aware RRIP : DRRIP per CPU/GPU, GPU lines distant when insensitive */
+  LLC_UCP,      /**< utility-based way partitioning between applications */
+  LLC_BDI,      /**< base-delta-immediate compressed LRU with decoupled tags */
+  LLC_POLICY_MAX
+} Llc_Policy;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Set dueling monitor
+///
+/// Sets are split into constituencies of m_constituency sets. In every constituency, set
+/// offset 2 * owner is a leader of policy A and 2 * owner + 1 a leader of policy B for that
+/// owner (an application, or CPU/GPU). A miss of an owner in its own leader set moves its
+/// saturating PSEL counter towards the other policy; the other sets follow the PSEL.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class set_dueling_c
+{
+  public:
+    /**
+     * Constructor
+     * @param num_sets - number of sets
+     * @param num_owners - number of owners with their own leader sets and PSEL
+     * @param psel_bits - PSEL counter width
+     */
+    set_dueling_c(int num_sets, int num_owners, int psel_bits);
+
+    /**
+     * Leader kind of a set for an owner : 0 (policy A), 1 (policy B), -1 (follower)
+     */
+    inline int leader(int set, int owner)
+    {
+      int offset = set % m_constituency - 2 * owner;
+      return (offset == 0 || offset == 1) ? offset : -1;
+    }
+
+    /**
+     * Check whether the owner uses policy B in the set
+     */
+    inline bool use_b(int set, int owner)
+    {
+      int kind = leader(set, owner);
+      if (kind != -1)
+        return kind == 1;
+
+      return m_psel[owner] > m_psel_max / 2;
+    }
+
+    /**
+     * Miss of an owner in a set (updates its PSEL in its leader sets)
+     */
+    inline void miss(int set, int owner)
+    {
+      int kind = leader(set, owner);
+      if (kind == 0 && m_psel[owner] < m_psel_max)
+        ++m_psel[owner];
+      else if (kind == 1 && m_psel[owner] > 0)
+        --m_psel[owner];
+    }
+
+  private:
+    int         m_constituency; /**< sets per constituency */
+    int         m_psel_max; /**< maximum PSEL value */
+    vector<int> m_psel; /**< PSEL counter per owner */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Pseudo-LRU LLC
+///
+/// Always uses the cache_c pseudo-LRU replacement (an MRU bit per line), which the other
+/// caches only use when cache_use_pseudo_lru is set.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class llc_plru_c : public cache_c
+{
+  public:
+    /**
+     * Constructor (see cache_c)
+     */
+    llc_plru_c(string name, int num_set, int assoc, int line_size, int data_size, 
+        int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+        bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase);
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief LRU insertion policy LLCs : BIP, DIP and TADIP
+///
+/// Replacement is LRU; the policies only choose the insertion position. BIP inserts at the
+/// LRU position, except for one fill out of 2^tadip_cache_bip_epsilon that goes to MRU.
+/// DIP duels LRU (A) against BIP (B) with one PSEL of tadip_cache_num_counter_bit bits;
+/// TADIP gives every application (appl_id) its own leader sets and PSEL.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class llc_dip_c : public cache_c
+{
+  public:
+    /**
+     * Constructor (see cache_c)
+     * @param policy - LLC_BIP, LLC_DIP or LLC_TADIP
+     */
+    llc_dip_c(string name, int num_set, int assoc, int line_size, int data_size, 
+        int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+        bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase,
+        Llc_Policy policy);
+
+    ~llc_dip_c();
+
+    void initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, bool gpuline, 
+        int set_id, bool skip);
+
+  private:
+    Llc_Policy     m_policy; /**< policy */
+    set_dueling_c* m_dueling; /**< set dueling monitor (DIP, TADIP) */
+    int            m_num_owners; /**< dueling owners */
+    Counter        m_bip_mask; /**< BIP : MRU insertion when (fill count & mask) == 0 */
+    Counter        m_bip_count; /**< BIP fill count */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief RRIP LLCs : SRRIP, BRRIP, DRRIP and TAP
+///
+/// Every line has an rrip_cache_num_bit re-reference prediction value (RRPV); a hit sets it
+/// to 0 and the victim is a line with the maximum RRPV (all lines age until one has it).
+/// SRRIP inserts at rrip_cache_insert_at; BRRIP inserts at the maximum, except for one fill
+/// out of 2^rrip_cache_bip_epsilon; DRRIP duels SRRIP (A) against BRRIP (B) with a PSEL of
+/// rrip_cache_num_counter_bit bits.
+///
+/// TAP (TLP-aware cache management) runs DRRIP with separate leader sets and PSEL for CPU
+/// and GPU lines. Every abip_cache_period cycles it compares the GPU misses of the SRRIP and
+/// BRRIP GPU leader sets; when they differ by less than llc_tap_threshold percent, the GPU
+/// application is cache-insensitive (its parallelism hides the misses) and GPU followers
+/// insert at the maximum RRPV, leaving the capacity to the CPU.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class llc_rrip_c : public cache_c
+{
+  public:
+    /**
+     * Constructor (see cache_c)
+     * @param policy - LLC_SRRIP, LLC_BRRIP, LLC_DRRIP or LLC_TAP
+     */
+    llc_rrip_c(string name, int num_set, int assoc, int line_size, int data_size, 
+        int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+        bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase,
+        Llc_Policy policy);
+
+    ~llc_rrip_c();
+
+    void update_line_on_hit(int set, int way, int appl_id);
+    int find_replacement_line(int set, int appl_id);
+    int peek_replacement_line(int set, int appl_id);
+    void initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, bool gpuline, 
+        int set_id, bool skip);
+
+  private:
+    /**
+     * TAP : re-evaluate GPU cache sensitivity at the end of a period
+     */
+    void tap_update_period(void);
+
+  private:
+    Llc_Policy     m_policy; /**< policy */
+    vector<uns8>   m_rrpv; /**< RRPV per line (set * assoc + way) */
+    uns8           m_max_rrpv; /**< distant re-reference value */
+    uns8           m_insert_rrpv; /**< SRRIP insertion value */
+    set_dueling_c* m_dueling; /**< set dueling monitor (DRRIP, TAP) */
+    Counter        m_bip_mask; /**< BRRIP : SRRIP insertion when (fill count & mask) == 0 */
+    Counter        m_bip_count; /**< BRRIP fill count */
+    Counter        m_tap_next_period; /**< TAP : end of the current period */
+    Counter        m_tap_period; /**< TAP : period in cycles */
+    Counter        m_tap_gpu_miss[2]; /**< TAP : GPU misses in GPU SRRIP / BRRIP leaders */
+    bool           m_tap_gpu_insensitive; /**< TAP : GPU application is cache-insensitive */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Utility-based cache partitioning (UCP) LLC
+///
+/// Every application (appl_id modulo ucp_cache_num_application) has a UMON: an LRU
+/// auxiliary tag directory over sampled sets (dynamic set sampling, one set out of every
+/// num_set / 32) that counts hits per LRU stack position, i.e. the hits the application
+/// would get with each number of ways. Every ucp_cache_partition_period cycles the
+/// lookahead algorithm hands out the ways by maximum marginal utility (each application
+/// keeps at least one way) and the UMON counters are halved.
+///
+/// Victim selection enforces the allocation per set, like the static CPU/GPU split of
+/// find_replacement_line_from_same_type but per application : below its allocation an
+/// application replaces the LRU line of an application above its own, otherwise its own
+/// LRU line.
+///
+/// With ucp_cache_for_gpu, GPU applications (seen through their fills) look ahead over at
+/// most ucp_cache_gpu_max_partition_lookup ways at a time, and ucp_cache_gpu_drop_probability
+/// percent of their accesses skip the UMON, so their much higher access rate does not
+/// outweigh the CPU utility.
+/// ucp.out (statistics directory) gets the allocation and the UMON hits/accesses of every
+/// application at every repartition.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class llc_ucp_c : public cache_c
+{
+  public:
+    /**
+     * Constructor (see cache_c)
+     */
+    llc_ucp_c(string name, int num_set, int assoc, int line_size, int data_size, 
+        int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+        bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase);
+
+    ~llc_ucp_c();
+
+    void update_cache_on_access(Addr tag, int set, int appl_id);
+    int find_replacement_line(int set, int appl_id);
+    void initialize_cache_line(int way, Addr tag, Addr addr, int appl_id, bool gpuline, 
+        int set_id, bool skip);
+
+  private:
+    /**
+     * Partition index of an application
+     */
+    inline int app_index(int appl_id)
+    {
+      return (appl_id < 0 ? 0 : appl_id) % m_num_app;
+    }
+
+    /**
+     * Run the lookahead algorithm and start a new period
+     */
+    void repartition(void);
+
+  private:
+    int     m_num_app; /**< number of partitions */
+    int     m_sample_stride; /**< one UMON set out of every m_sample_stride sets */
+    Counter m_period; /**< repartition period in cycles */
+    Counter m_next_partition; /**< cycle of the next repartition */
+    bool    m_for_gpu; /**< GPU specific lookahead and UMON throttling */
+    int     m_gpu_lookup; /**< GPU : maximum ways per lookahead step */
+    int     m_gpu_drop; /**< GPU : percentage of accesses that skip the UMON */
+    Counter m_gpu_access; /**< GPU : UMON access count (drop pattern) */
+    FILE*   m_file; /**< allocation report */
+    vector<int>     m_alloc; /**< ways per application */
+    vector<bool>    m_gpu_app; /**< application has filled GPU lines */
+    vector<Addr>    m_atd; /**< UMON tags [app][sampled set][stack position], 0 : empty */
+    vector<Counter> m_hit; /**< UMON hits [app][stack position] */
+    vector<Counter> m_access; /**< UMON accesses per application */
+    vector<int>     m_count; /**< lines per application in a set (victim selection) */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Base-Delta-Immediate (BDI) compressed LLC
+///
+/// Decoupled tags : a set has llc_bdi_tag_ratio times the tag entries of l3_assoc, and the
+/// l3_assoc lines of data are split into llc_bdi_segment_size byte segments. A line takes the
+/// segments of its compressed size, so a set holds more lines when they compress.
+///
+/// Traces carry no data values, so the BDI encoding of a line (zeros, repeated value,
+/// base8-delta1/2/4, base4-delta1/2, base2-delta1 or uncompressed) is drawn from a weight
+/// per encoding, by a hash of the line address (a line always gets the same encoding). The
+/// weights come from the page of the line in the llc_bdi_profile file (one page per line :
+/// page address in hex and the nine weights), or from llc_bdi_dist.
+///
+/// Replacement is LRU over the tag entries. When the free tags or segments do not fit a new
+/// line, the victim is the least recently used line, among the llc_bdi_victim_window oldest,
+/// whose segments alone make room (compaction-aware); otherwise lines are replaced in LRU
+/// order until the new line fits. Segments are compacted on replacement. A hit to a
+/// compressed line costs llc_bdi_decomp_latency more cycles.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class llc_bdi_c : public cache_c
+{
+  public:
+    /**
+     * Constructor (see cache_c; assoc is the data associativity)
+     */
+    llc_bdi_c(string name, int num_set, int assoc, int line_size, int data_size, 
+        int bank_num, bool cache_by_pass, int core_id, Cache_Type cache_type_info, 
+        bool enable_partition, int num_tiles, int interleave_factor, macsim_c* simBase);
+
+    void* insert_cache(Addr addr, Addr *line_addr, Addr *repl_line, int appl_id, 
+        bool gpuline, bool skip);
+    bool pop_victim(Addr *line_addr, void **data);
+    int max_victims(void);
+    int extra_hit_latency(Addr addr);
+
+  private:
+    /**
+     * BDI encoding of a line (LLC_BDI_ENC_* order)
+     */
+    int encoding(Addr line_addr);
+
+    /**
+     * Read the per-page encoding weights
+     */
+    void load_profile(const string& path);
+
+    /**
+     * Parse nine comma or space separated weights into cumulative weights
+     */
+    bool parse_weights(const string& weights, vector<uns>* cumulative);
+
+  private:
+    int           m_data_segs; /**< data segments per set */
+    int           m_line_segs; /**< segments of an uncompressed line */
+    int           m_decomp_latency; /**< additional hit latency of a compressed line */
+    int           m_window; /**< compaction-aware victim search depth */
+    int           m_page_bits; /**< log2 of the profile page size */
+    vector<uns8>  m_segs; /**< segments of each tag entry (set * tags + way) */
+    vector<int>   m_enc_segs; /**< segments of each encoding */
+    vector<uns>   m_dist; /**< cumulative encoding weights (llc_bdi_dist) */
+    unordered_map<Addr, vector<uns> > m_profile; /**< cumulative weights per page */
+    vector<pair<Addr, void*> > m_victims; /**< additional victims of the last insertion */
+    vector<char>  m_victim_data; /**< data of the additional victims (invalidated lines) */
+    vector<int>   m_order; /**< LRU order of a set (victim selection) */
+};
+
+
+/**
+ * Look up an LLC policy by its llc_type name ("default" is LRU)
+ * @return LLC_POLICY_MAX if unknown
+ */
+Llc_Policy llc_policy_from_name(const string& name);
+
+#endif
@@ -56,6 +56,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "dram.h"
 #include "utils.h"
 #include "bug_detector.h"
+#include "stat_sampler.h"
+#include "mem_latency.h"
+#include "pc_profiler.h"
+#include "cpi_stack.h"
 #include "fetch_factory.h"
 #include "pref_factory.h"
 #include "network.h"
@@ -169,6 +173,9 @@ void macsim_c::init_knobs(int argc, char** argv)
   // save the states of all knobs to a file
   m_knobsContainer->saveToFile("params.out");
 #endif
+
+  // knobs are final from here on; take the snapshot read by per-cycle code
+  m_knobs->freeze(&m_config);
 }
 
 
@@ -186,12 +193,27 @@ void macsim_c::register_functions(void)
 
   dram_factory_c::get()->register_class("FRFCFS", frfcfs_controller);
   dram_factory_c::get()->register_class("FCFS", fcfs_controller);
+  dram_factory_c::get()->register_class("PARBS", parbs_controller);
+  dram_factory_c::get()->register_class("ATLAS", atlas_controller);
+  dram_factory_c::get()->register_class("TCM", tcm_controller);
+  dram_factory_c::get()->register_class("BLISS", bliss_controller);
 
   fetch_factory_c::get()->register_class("rr", fetch_factory);
   pref_factory_c::get()->register_class(pref_factory);
   bp_factory_c::get()->register_class("gshare", default_bp); 
 
   llc_factory_c::get()->register_class("default", default_llc);
+  llc_factory_c::get()->register_class("lru", default_llc);
+  llc_factory_c::get()->register_class("plru", default_llc);
+  llc_factory_c::get()->register_class("bip", default_llc);
+  llc_factory_c::get()->register_class("dip", default_llc);
+  llc_factory_c::get()->register_class("tadip", default_llc);
+  llc_factory_c::get()->register_class("srrip", default_llc);
+  llc_factory_c::get()->register_class("brrip", default_llc);
+  llc_factory_c::get()->register_class("drrip", default_llc);
+  llc_factory_c::get()->register_class("tap", default_llc);
+  llc_factory_c::get()->register_class("ucp", default_llc);
+  llc_factory_c::get()->register_class("bdi", default_llc);
 
   network_factory_c::get()->register_class("ring", default_network);
   network_factory_c::get()->register_class("mesh", default_network);
@@ -208,8 +230,6 @@ void macsim_c::init_memory(void)
   m_thread_pool           = new pool_c<thread_s>(10, "thread_pool"); 
   m_section_pool          = new pool_c<section_info_s>(100, "section_pool"); 
   m_mem_map_entry_pool    = new pool_c<mem_map_entry_c>(200, "mem_map_pool");
-  m_heartbeat_pool        = new pool_c<heartbeat_s>(10, "heartbeat_pool");
-  m_bp_recovery_info_pool = new pool_c<bp_recovery_info_c>(10, "bp_recovery_info_pool");
   m_trace_node_pool       = new pool_c<thread_trace_info_node_s>(10, "thread_node_pool");
   m_uop_pool              = new pool_c<uop_c>(1000, "uop_pool");
 
@@ -252,6 +272,16 @@ void macsim_c::init_memory(void)
     m_bug_detector = new bug_detector_c(m_simBase);
   }
 
+  // memory request latency histograms
+  m_mem_latency = NULL;
+  if (*KNOB(KNOB_MEM_LATENCY_HIST))
+    m_mem_latency = new mem_latency_c(m_simBase);
+
+  // delinquent load profiler
+  m_pc_profiler = NULL;
+  if (*KNOB(KNOB_PC_PROFILER_ENABLE))
+    m_pc_profiler = new pc_profiler_c(m_simBase);
+
   // ETC
   m_termination_check = new bool[m_num_sim_cores];
   fill_n(m_termination_check, m_num_sim_cores, false);
@@ -332,7 +362,6 @@ void macsim_c::init_cores(int num_max_core)
   for (int ii = 0; ii < num_large_cores; ++ii) { 
     m_core_pointers[ii] = new core_c(ii, m_simBase, UNIT_LARGE);
     m_core_pointers[ii]->init();
-    m_core_pointers[ii]->pref_init();
 
     // insert to the core type pool
     if (static_cast<string>(*m_simBase->m_knobs->KNOB_LARGE_CORE_TYPE) == "ptx")
@@ -346,7 +375,6 @@ void macsim_c::init_cores(int num_max_core)
   for (int ii = 0; ii < *KNOB(KNOB_NUM_SIM_MEDIUM_CORES); ++ii) { 
     m_core_pointers[ii + num_large_cores] = new core_c(ii + num_large_cores, m_simBase, UNIT_MEDIUM);
     m_core_pointers[ii + num_large_cores]->init();
-    m_core_pointers[ii + num_large_cores]->pref_init();
 
     // insert to the core type pool
     if (static_cast<string>(*m_simBase->m_knobs->KNOB_MEDIUM_CORE_TYPE) == "ptx")
@@ -361,7 +389,6 @@ void macsim_c::init_cores(int num_max_core)
     m_core_pointers[ii + num_large_medium_cores] = 
       new core_c(ii + num_large_medium_cores, m_simBase, UNIT_SMALL);
     m_core_pointers[ii + num_large_medium_cores]->init();
-    m_core_pointers[ii + num_large_medium_cores]->pref_init();
 
     // insert to the core type pool
     if (static_cast<string>(*m_simBase->m_knobs->KNOB_CORE_TYPE) == "ptx")
@@ -589,8 +616,6 @@ void macsim_c::deallocate_memory(void)
   delete m_thread_pool;
   delete m_section_pool; 
   delete m_mem_map_entry_pool;
-  delete m_heartbeat_pool;
-  delete m_bp_recovery_info_pool;
   delete m_trace_node_pool;
   delete m_uop_pool;
   delete m_invalid_uop;
@@ -735,6 +760,11 @@ void macsim_c::initialize(int argc, char** argv)
   init_per_core_stats(m_num_sim_cores, m_simBase);
   cout << "number of cores : " << m_num_sim_cores << "\n";
 
+  // interval stat sampler
+  m_stat_sampler = NULL;
+  if (*KNOB(KNOB_STAT_SAMPLE_CYCLES) || *KNOB(KNOB_STAT_SAMPLE_INSTS))
+    m_stat_sampler = new stat_sampler_c(m_simBase);
+
   // register wrapper functions
   register_functions();
 
@@ -748,9 +778,19 @@ void macsim_c::initialize(int argc, char** argv)
   // initialize cores
   init_cores(m_num_sim_cores);
 
+  // CPI stack accounting
+  m_cpi_stack = NULL;
+  if (*KNOB(KNOB_COLLECT_CPI_INFO))
+    m_cpi_stack = new cpi_stack_c(m_simBase);
+
   // init memory
   init_memory();
 
+  // hardware prefetchers need the cache line size from the memory system
+  for (int ii = 0; ii < m_num_sim_cores; ++ii) {
+    m_core_pointers[ii]->pref_init();
+  }
+
   // initialize some of my output streams to the standards */
   init_output_streams();
 
@@ -831,8 +871,7 @@ void macsim_c::init_clock_domain(void)
   // Cores
   for (int ii = 0; ii < m_num_sim_cores; ++ii) {
     core_c *core = m_core_pointers[ii];
-    string core_type = core->get_core_type();
-    if (core_type == "ptx") {
+    if (core->is_ptx()) {
       m_domain_freq[ii]  = static_cast<int>(domain_f[CLOCK_GPU]);
     }
     else {
@@ -923,7 +962,6 @@ int macsim_c::run_a_cycle()
     unsigned int ii = (kk+pivot) % m_num_sim_cores;
 
     core_c *core = m_core_pointers[ii];
-    string core_type = core->get_core_type();
     if (m_clock_internal != m_domain_next[ii]) {
       continue;
     }
@@ -941,6 +979,9 @@ int macsim_c::run_a_cycle()
 
     // core ended or not started    
     if (m_sim_end[ii] || !m_core_started[ii]) {
+      // private caches of an ended core still answer coherence messages
+      if (m_sim_end[ii] && *KNOB(KNOB_ENABLE_CACHE_COHERENCE))
+        m_memory->run_a_cycle_core(ii, pll_locked);
       continue;
     }
 
@@ -967,12 +1008,12 @@ int macsim_c::run_a_cycle()
     // checking for threads 
     if (m_sim_end[ii] != true) {
       // when KNOB_MAX_INSTS is set, execute each thread for KNOB_MAX_INSTS instructions
-      if (*m_simBase->m_knobs->KNOB_MAX_INSTS && 
+      if (m_config.m_max_insts && 
           core->m_num_thread_reach_end == core->m_unique_scheduled_thread_num) {
         m_sim_end[ii] = true;
       }
       // when KNOB_SIM_CYCLE_COUNT is set, execute only KNOB_SIM_CYCLE_COUNT cycles
-      else if (*KNOB(KNOB_SIM_CYCLE_COUNT) && m_simulation_cycle >= *KNOB(KNOB_SIM_CYCLE_COUNT)) {
+      else if (m_config.m_sim_cycle_count && m_simulation_cycle >= m_config.m_sim_cycle_count) {
         m_sim_end[ii] = true;
       }
     }
@@ -999,6 +1040,15 @@ int macsim_c::run_a_cycle()
   m_simulation_cycle++;
   STAT_EVENT(CYC_COUNT_TOT);
 
+  if (m_stat_sampler)
+    m_stat_sampler->run_a_cycle(m_simulation_cycle);
+
+  if (m_pc_profiler)
+    m_pc_profiler->run_a_cycle(m_simulation_cycle);
+
+  if (m_cpi_stack)
+    m_cpi_stack->run_a_cycle(m_simulation_cycle);
+
 
   // m_termination_check[0] cpu [1] gpu
 
@@ -1025,6 +1075,29 @@ void macsim_c::finalize()
   // finalize simulation
   fini_sim();
 
+  // write the last sampling interval
+  if (m_stat_sampler) {
+    delete m_stat_sampler;
+    m_stat_sampler = NULL;
+  }
+
+  // write memory latency histograms
+  if (m_mem_latency) {
+    delete m_mem_latency;
+    m_mem_latency = NULL;
+  }
+
+  // write the final delinquent load report
+  if (m_pc_profiler) {
+    delete m_pc_profiler;
+    m_pc_profiler = NULL;
+  }
+
+  if (m_cpi_stack) {
+    delete m_cpi_stack;
+    m_cpi_stack = NULL;
+  }
+
   // dump out stat files at the end of simulation
   m_ProcessorStats->saveStats();
 
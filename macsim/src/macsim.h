@@ -45,6 +45,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "global_defs.h"
 #include "global_types.h"
+#include "all_knobs.h"
 
 
 #ifdef IRIS
@@ -73,6 +74,7 @@ class Topology;
 #define NETWORK m_simBase->m_network
 #define DRAM_CTRL m_simBase->m_dram_controller
 #define MEMORY m_simBase->m_memory
+#define CONFIG(var) m_simBase->m_config.var
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -206,6 +208,7 @@ class macsim_c
     // knob variables
 		KnobsContainer *m_knobsContainer; /**< knob container */
 		all_knobs_c    *m_knobs; /**< all knob variables */
+		sim_config_s    m_config; /**< frozen snapshot of hot knobs */
 
 		bool m_core_end_trace[MAX_NUM_CORES]; /**< core end trace flag */
 		bool m_sim_end[MAX_NUM_CORES]; /**< core sim end flag */
@@ -219,6 +222,10 @@ class macsim_c
 
     // bug detector
 		bug_detector_c *m_bug_detector; /**< bug detector */
+		stat_sampler_c *m_stat_sampler; /**< interval stat sampler */
+		mem_latency_c *m_mem_latency; /**< memory request latency histograms */
+		pc_profiler_c *m_pc_profiler; /**< delinquent load profiler */
+		cpi_stack_c *m_cpi_stack; /**< CPI stack accounting */
 
     // process manager
 		process_manager_c* m_process_manager; /**< process manager */
@@ -231,8 +238,6 @@ class macsim_c
 		pool_c<thread_s>* m_thread_pool; /**<  thread data pool */
 		pool_c<section_info_s>* m_section_pool; /**<  section data pool */
 		pool_c<mem_map_entry_c>* m_mem_map_entry_pool; /**<  memory dependence data pool */
-		pool_c<heartbeat_s>* m_heartbeat_pool; /**<  heartbeat data pool */
-		pool_c<bp_recovery_info_c>* m_bp_recovery_info_pool; /**<  bp recovery information pool */
 		pool_c<thread_trace_info_node_s>* m_trace_node_pool; /**<  trace node pool */
 		pool_c<uop_c> *m_uop_pool; /**<  uop pool */
 		uop_c *m_invalid_uop; /**<  invalide uop pointer (for uop pool maintenance) */
@@ -128,7 +128,7 @@ void map_c::set_not_rdy_bit (uop_c *uop, int bit)
   ASSERT(uop);
   ASSERT(bit < uop->m_num_srcs);
 
-  uop->m_srcs_not_rdy_vector |= (0x1 << bit);
+  uop->m_cold->m_srcs_not_rdy_vector |= (0x1 << bit);
 }
 
 
@@ -136,7 +136,7 @@ void map_c::set_not_rdy_bit (uop_c *uop, int bit)
 void map_c::add_src_from_map_entry(uop_c *uop, int src_num, map_entry_c *map_entry, 
     Dep_Type type)
 {
-  src_info_c *info = &(uop->m_map_src_info[src_num]); 
+  src_info_c *info = &(uop->m_warm->m_map_src_info[src_num]); 
 
   ASSERT(uop);
   ASSERT(map_entry);
@@ -144,13 +144,13 @@ void map_c::add_src_from_map_entry(uop_c *uop, int src_num, map_entry_c *map_ent
   ASSERT(type < NUM_DEP_TYPES);
 
   DEBUG("core_id:%d thread_id:%d Added dep uop_num:%s inst_num:%s src_uop_num:%s src_num:%d\n",
-        uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), unsstr64(uop->m_inst_num), 
+        uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), unsstr64(uop->m_warm->m_inst_num), 
         unsstr64(map_entry->m_uop_num), src_num);
 
   ASSERTM(src_num < MAX_UOP_SRC_DEPS, "src_num:%d MAX_UOP_SRC_DEPS:%d \n", 
       src_num, MAX_UOP_SRC_DEPS); 
 
-  ASSERTM(!(uop->m_uop_num) || ((map_entry->m_uop_num) < uop->m_uop_num) || uop->m_off_path, 
+  ASSERTM(!(uop->m_uop_num) || ((map_entry->m_uop_num) < uop->m_uop_num) || uop->m_warm->m_off_path, 
       "core_id:%d thread_id:%d map_entry->uop_num:%lld uop_num:%lld \n",  
       uop->m_core_id, uop->m_thread_id, map_entry->m_uop_num, uop->m_uop_num);;
 
@@ -166,8 +166,8 @@ void map_c::add_src_from_map_entry(uop_c *uop, int src_num, map_entry_c *map_ent
   DEBUG("core_id:%d thread_id:%d Added dep uop_num:%s src_uop_num:%s "
       "dep inst_num:%s src_inst_num:%s src_num:%d dep pc:0x%s src pc:0x%s\n", 
       uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), 
-      unsstr64(map_entry->m_uop_num), unsstr64(uop->m_inst_num), 
-      unsstr64(map_entry->m_inst_num), src_num, hexstr64s(uop->m_pc),
+      unsstr64(map_entry->m_uop_num), unsstr64(uop->m_warm->m_inst_num), 
+      unsstr64(map_entry->m_inst_num), src_num, hexstr64s(uop->m_warm->m_pc),
       hexstr64s(map_entry->m_pc));
 }
 
@@ -177,7 +177,7 @@ void map_c::add_src_from_uop (uop_c *uop, uop_c *src_uop, Dep_Type type)
 {
   // check whether we src_uop is already in the op or not. 
   for (int jj = 0 ; jj < uop->m_num_srcs ; ++jj) {
-    src_info_c *info = &uop->m_map_src_info[jj];
+    src_info_c *info = &uop->m_warm->m_map_src_info[jj];
     uop_c  *uop_src_uop = info->m_uop;
     if (uop_src_uop->m_uop_num == src_uop->m_uop_num) return; 
   }
@@ -186,7 +186,7 @@ void map_c::add_src_from_uop (uop_c *uop, uop_c *src_uop, Dep_Type type)
   ASSERT(type != REG_DATA_DEP); 
 
   uns src_num	     = uop->m_num_srcs++;
-  src_info_c *info = &(uop->m_map_src_info[src_num]);
+  src_info_c *info = &(uop->m_warm->m_map_src_info[src_num]);
 
   ASSERT(uop);
   ASSERT(src_uop);
@@ -196,7 +196,7 @@ void map_c::add_src_from_uop (uop_c *uop, uop_c *src_uop, Dep_Type type)
 
   ASSERTM(src_uop->m_uop_num < uop->m_uop_num ||
       (uop->m_thread_id != -1 && src_uop->m_thread_id != -1) ||
-      (uop->m_off_path && src_uop->m_thread_id != -1),
+      (uop->m_warm->m_off_path && src_uop->m_thread_id != -1),
       "uop:%s  src_uop:%s\n", 
       unsstr64(uop->m_uop_num), unsstr64(src_uop->m_uop_num));
 
@@ -210,7 +210,7 @@ void map_c::add_src_from_uop (uop_c *uop, uop_c *src_uop, Dep_Type type)
 
   DEBUG("core_id:%d thread_id:%d Added dep uop_num:%s src_uop_num:%s src_num:%d dep_type:%d "
       "pc:0x%s\n", uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), 
-      unsstr64(src_uop->m_uop_num), src_num, type, hexstr64s(uop->m_pc));
+      unsstr64(src_uop->m_uop_num), src_num, type, hexstr64s(uop->m_warm->m_pc));
 }
 
 
@@ -245,27 +245,27 @@ void map_c::update_map(uop_c *uop)
   ASSERT(NULL != map_data);
 
   // update the register map if the uop produces a value
-  for (int ii = 0; ii < uop->m_num_dests; ++ii) {
-    uns16 id = uop->m_dest_info[ii]; 
+  for (int ii = 0; ii < uop->m_warm->m_num_dests; ++ii) {
+    uns16 id = uop->m_cold->m_dest_info[ii]; 
 
     ASSERTM(id < NUM_REG_IDS, "id:%d \n", id); 
 
-    uns ind = id << 1 | uop->m_off_path; 
+    uns ind = id << 1 | uop->m_warm->m_off_path; 
     ASSERT(ind < NUM_REG_IDS*2); 
     map_entry_c *map_entry = &(map_data->m_reg_map[ind]); 
 
     DEBUG("core_id:%d thread_id:%d Writing map uop_num:%s inst_num:%s off_path:%d id:%d "
         "flag:%d ind:%d \n", uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), 
-        unsstr64(uop->m_inst_num), uop->m_off_path, id, map_data->m_map_flags[id], ind); 
+        unsstr64(uop->m_warm->m_inst_num), uop->m_warm->m_off_path, id, map_data->m_map_flags[id], ind); 
 
     // update dependence information
     map_entry->m_uop          = uop;
     map_entry->m_uop_num      = uop->m_uop_num;
     map_entry->m_unique_num   = uop->m_unique_num; 
-    map_entry->m_inst_num     = uop->m_inst_num; 
-    map_entry->m_pc           = uop->m_pc; 
+    map_entry->m_inst_num     = uop->m_warm->m_inst_num; 
+    map_entry->m_pc           = uop->m_warm->m_pc; 
     map_entry->m_mem_type     = uop->m_mem_type;
-    map_data->m_map_flags[id] = uop->m_off_path; 
+    map_data->m_map_flags[id] = uop->m_warm->m_off_path; 
   }
 }
 
@@ -296,7 +296,7 @@ void map_c::read_reg_map (uop_c *uop)
     map_data->initialize();
 
   for (int ii = 0; ii < uop->m_num_srcs; ++ii) {
-    uns id = uop->m_src_info[ii];
+    uns id = uop->m_cold->m_src_info[ii];
     ASSERT(id < NUM_REG_IDS); 
     uns ind = id << 1 | (map_data->m_map_flags[id]); 
     ASSERT(ind < NUM_REG_IDS*2); 
@@ -304,7 +304,7 @@ void map_c::read_reg_map (uop_c *uop)
     DEBUG("core_id:%d thread_id:%d Reading map uop_num:%s inst_num:%s "
           "off_path:%d id:%d flag:%d ind:%d ii:%d num_srcs:%d \n",
           uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), 
-          unsstr64(uop->m_inst_num), uop->m_off_path, id, 
+          unsstr64(uop->m_warm->m_inst_num), uop->m_warm->m_off_path, id, 
           map_data->m_map_flags[id], ind, ii, uop->m_num_srcs); 
 
     add_src_from_map_entry(uop, ii, map_entry, REG_DATA_DEP);
@@ -330,8 +330,8 @@ void map_c::read_store_map(uop_c *uop)
 
     DEBUG("core_id:%d thread_id:%d Reading store map uop_num:%s inst_num:%s off_path:%d "
         "flag:%d   ind:%d \n",
-        uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), unsstr64(uop->m_inst_num), 
-        uop->m_off_path, map_data->m_last_store_flag, ind); 
+        uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), unsstr64(uop->m_warm->m_inst_num), 
+        uop->m_warm->m_off_path, map_data->m_last_store_flag, ind); 
 
     add_src_from_map_entry(uop, uop->m_num_srcs++, map_entry, MEM_ADDR_DEP); 
   }
@@ -345,7 +345,7 @@ void map_c::update_store_hash (uop_c *uop)
   mem_map_entry_c * mem_map_p;
   Addr va = uop->m_vaddr; 
   int first_byte = va & 0x7; 
-  bool off_path = uop->m_off_path;
+  bool off_path = uop->m_warm->m_off_path;
   Quad old_data = 0;
   bool new_entry = false;
   map_data_c *map_data = m_core_map_data->hash_table_access(uop->m_thread_id);
@@ -365,7 +365,7 @@ void map_c::update_store_hash (uop_c *uop)
     DEBUG("add store_hash core_id:%d thread_id:%d fb:%d USH: (%s) inst:%s "
           "St(%d)[%s]: %s + %s => %s\n", 
           uop->m_core_id, uop->m_thread_id, first_byte, 
-          unsstr64(uop->m_uop_num), unsstr64(uop->m_inst_num), uop->m_mem_size,
+          unsstr64(uop->m_uop_num), unsstr64(uop->m_warm->m_inst_num), uop->m_warm->m_mem_size,
           hexstr64s(uop->m_vaddr), hexstr64s(old_data), "XXX", "XXX"); 
   } 
   else { 
@@ -378,7 +378,7 @@ void map_c::update_store_hash (uop_c *uop)
     ASSERT(!*KNOB(KNOB_USE_NEW_ORACLE) || (off_path && !MEM_GEN_OFF_PATH_VALS));
     DEBUG("core_id:%d thread_id:%d update_store_hash uop:%s inst:%s va:%s first_byte:%s\n",
           uop->m_core_id, uop->m_thread_id, unsstr64(uop->m_uop_num), 
-          unsstr64(uop->m_inst_num), hexstr64s(va), hexstr64s(first_byte)); 
+          unsstr64(uop->m_warm->m_inst_num), hexstr64s(va), hexstr64s(first_byte)); 
 
     mem_map_p->m_store_mask = 0;
   } 
@@ -401,7 +401,7 @@ uop_c* map_c::add_store_deps(uop_c * uop)
   mem_map_entry_c  * mem_map_p = NULL;
   Addr va = uop->m_vaddr;
   int first_byte  = va & 0x7;
-  bool off_path   = uop->m_off_path;
+  bool off_path   = uop->m_warm->m_off_path;
   uop_c * src_uop     = NULL;
   map_data_c *map_data = m_core_map_data->hash_table_access(uop->m_thread_id);
   ASSERT(NULL != map_data);
@@ -438,12 +438,12 @@ uop_c* map_c::add_store_deps(uop_c * uop)
       if (!xtestbit(mem_map_p->m_store_mask, ii)) 
         continue;           
 
-      if (!BYTE_OVERLAP(src_uop->m_vaddr, src_uop->m_mem_size, va, uop->m_mem_size)) 
+      if (!BYTE_OVERLAP(src_uop->m_vaddr, src_uop->m_warm->m_mem_size, va, uop->m_warm->m_mem_size)) 
         continue;
 
       DEBUG("src uop_num:%s va:%s mem_size:%d dest uop uop_num:%s va:%s mem_size:%d \n", 
-          unsstr64(src_uop->m_uop_num), hexstr64s(src_uop->m_vaddr), src_uop->m_mem_size, 
-          unsstr64(uop->m_uop_num), hexstr64s(uop->m_vaddr), uop->m_mem_size); 
+          unsstr64(src_uop->m_uop_num), hexstr64s(src_uop->m_vaddr), src_uop->m_warm->m_mem_size, 
+          unsstr64(uop->m_uop_num), hexstr64s(uop->m_vaddr), uop->m_warm->m_mem_size); 
 
       if (*m_simBase->m_knobs->KNOB_MEM_OOO_STORES) {
         add_src_from_uop(uop, mem_map_p->m_uop[ii], MEM_DATA_DEP);
@@ -465,7 +465,7 @@ uop_c* map_c::add_store_deps(uop_c * uop)
 
   ASSERT(mem_map_p->m_uop[first_byte]->m_uop_num < uop->m_uop_num || 
       uop->m_thread_id != -1 || 
-      uop->m_off_path);
+      uop->m_warm->m_off_path);
   ASSERT(MEM_MAP_KEY(va, off_path) ==  
       MEM_MAP_KEY(mem_map_p->m_uop[first_byte]->m_vaddr, off_path));
 
@@ -490,7 +490,7 @@ void map_c::delete_store_hash_entry(uop_c *uop)
 
   Addr va              = uop->m_vaddr;
   int first_byte       = va & 0x7;
-  bool off_path        = uop->m_off_path;
+  bool off_path        = uop->m_warm->m_off_path;
   map_data_c *map_data = m_core_map_data->hash_table_access(uop->m_thread_id);
 
   if (map_data == NULL)
@@ -0,0 +1,140 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : mem_latency.cc
+ * Description  : memory request lifecycle latency histograms
+ *********************************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "mem_latency.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+
+#include "all_knobs.h"
+
+
+// constructor
+mem_latency_c::mem_latency_c(macsim_c* simBase)
+{
+  m_simBase = simBase;
+
+  memset(m_hist, 0, sizeof(m_hist));
+  memset(m_sum, 0, sizeof(m_sum));
+}
+
+
+// destructor
+mem_latency_c::~mem_latency_c()
+{
+  write();
+}
+
+
+// record a completed request
+void mem_latency_c::record(mem_req_s* req, Counter cycle)
+{
+  req->set_stage(req->m_stage, cycle);
+
+  int pu    = req->m_ptx ? 1 : 0;
+  int level = req->m_service_level;
+
+  for (int stage = 0; stage < MEM_STAGE_MAX; ++stage) {
+    add(pu, req->m_type, level, stage, req->m_stage_cycles[stage]);
+  }
+  add(pu, req->m_type, level, MEM_LATENCY_TOTAL, cycle - req->m_in_global);
+}
+
+
+void mem_latency_c::add(int pu, int type, int level, int stage, Counter latency)
+{
+  int bucket = 0;
+  while (latency >> bucket && bucket < MEM_LATENCY_NUM_BUCKETS - 1)
+    ++bucket;
+
+  ++m_hist[pu][type][level][stage][bucket];
+  m_sum[pu][type][level][stage] += latency;
+}
+
+
+// write histograms
+void mem_latency_c::write(void)
+{
+  static const char* pu_name[2] = {"CPU", "GPU"};
+  static const char* level_name[MEM_LAST] = {"NONE", "L1", "L2", "L3", "MC"};
+
+  string stat_dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(stat_dir.c_str(), S_IRWXU);
+  string path = stat_dir + "/mem_latency.stat.out";
+
+  FILE* file = fopen(path.c_str(), "w");
+  if (file == NULL) {
+    REPORT("cannot open %s\n", path.c_str());
+    return;
+  }
+
+  fprintf(file, "# memory request latency per stage (cycles), log2 buckets\n");
+  fprintf(file, "%-4s %-12s %-5s %-11s %12s %12s", "PU", "TYPE", "LEVEL", "STAGE", "COUNT", "AVG");
+  for (int bucket = 0; bucket < MEM_LATENCY_NUM_BUCKETS; ++bucket) {
+    fprintf(file, " %10llu", bucket ? 1ULL << (bucket - 1) : 0ULL);
+  }
+  fprintf(file, "\n");
+
+  for (int pu = 0; pu < 2; ++pu) {
+    for (int type = 0; type < MAX_MEM_REQ_TYPE; ++type) {
+      for (int level = 0; level < MEM_LAST; ++level) {
+        for (int stage = 0; stage <= MEM_STAGE_MAX; ++stage) {
+          Counter* hist = m_hist[pu][type][level][stage];
+          Counter count = 0;
+          for (int bucket = 0; bucket < MEM_LATENCY_NUM_BUCKETS; ++bucket)
+            count += hist[bucket];
+
+          if (count == 0)
+            continue;
+
+          fprintf(file, "%-4s %-12s %-5s %-11s %12llu %12.2f", pu_name[pu],
+              mem_req_c::mem_req_type_name[type], level_name[level],
+              stage == MEM_LATENCY_TOTAL ? "TOTAL" : mem_req_c::mem_stage[stage],
+              count, (double)m_sum[pu][type][level][stage] / count);
+          for (int bucket = 0; bucket < MEM_LATENCY_NUM_BUCKETS; ++bucket) {
+            fprintf(file, " %10llu", hist[bucket]);
+          }
+          fprintf(file, "\n");
+        }
+      }
+    }
+  }
+
+  fclose(file);
+}
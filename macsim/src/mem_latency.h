@@ -0,0 +1,99 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : mem_latency.h
+ * Description  : memory request lifecycle latency histograms
+ *********************************************************************************************/
+
+#ifndef MEM_LATENCY_H_INCLUDED
+#define MEM_LATENCY_H_INCLUDED
+
+
+#include "macsim.h"
+#include "global_types.h"
+#include "global_defs.h"
+#include "memreq_info.h"
+
+
+#define MEM_LATENCY_NUM_BUCKETS 20
+#define MEM_LATENCY_TOTAL MEM_STAGE_MAX
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief memory request latency breakdown histograms
+///
+/// Every memory request accumulates the cycles it spends in each Mem_Req_Stage
+/// (mem_req_s::set_stage). When a request is freed, the per-stage cycles and the total
+/// lifetime are added to histograms split by CPU/GPU, request type and the level that
+/// serviced the request (L1/L2/L3 hit, MC for DRAM, NONE when not known, e.g. flushed).
+/// A request merged in the MSHR spends its whole lifetime in MEM_STAGE_MSHR.
+///
+/// Buckets are log2: [0], [1], [2,3], [4,7], ..., [2^18, inf).
+/// At the end of the simulation, mem_latency.stat.out in the statistics directory has
+/// one line per (pu, type, level, stage): count, average and bucket counts.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class mem_latency_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    mem_latency_c(macsim_c* simBase);
+
+    /**
+     * Destructor. Write the histograms.
+     */
+    ~mem_latency_c();
+
+    /**
+     * Close the current stage of a completed request and record all its stages
+     */
+    void record(mem_req_s* req, Counter cycle);
+
+  private:
+    /**
+     * Add one sample
+     */
+    void add(int pu, int type, int level, int stage, Counter latency);
+
+    /**
+     * Write all histograms to the statistics directory
+     */
+    void write(void);
+
+  private:
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+
+    Counter m_hist[2][MAX_MEM_REQ_TYPE][MEM_LAST][MEM_STAGE_MAX + 1][MEM_LATENCY_NUM_BUCKETS];
+      /**< [cpu/gpu][type][service level][stage or total][bucket] */
+    Counter m_sum[2][MAX_MEM_REQ_TYPE][MEM_LAST][MEM_STAGE_MAX + 1]; /**< latency sum */
+};
+
+#endif
@@ -38,19 +38,24 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <cmath>
+#include <unordered_set>
 
 #include "assert_macros.h"
 #include "cache.h"
 #include "core.h"
+#include "llc_policy.h"
 #include "debug_macros.h"
 #include "dram.h"
 #include "frontend.h"
 #include "memory.h"
 #include "network.h"
 #include "port.h"
+#include "schedule.h"
 #include "uop.h"
 #include "factory_class.h"
 #include "bug_detector.h"
+#include "mem_latency.h"
+#include "pc_profiler.h"
 
 #include "config.h"
 
@@ -100,6 +105,7 @@ int g_mem_priority[] = {
   0, // SW_T0
   0, // SW_T1
   0, // SW_T2
+  10, // COH
 };
 
 
@@ -132,6 +138,9 @@ bool dcache_fill_line_wrapper(mem_req_s* req)
 	bool result = true;
   list<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E = req->m_merge.end(); I != E; ++I) {
+    // merged requests are serviced where the request was
+    (*I)->m_service_level = req->m_service_level;
+    (*I)->m_coh_state     = req->m_coh_state;
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
       continue;
@@ -195,11 +204,12 @@ memory_c *default_mem(macsim_c* m_simBase)
 }
 
 
-// Default LLC constructor function
+// Default LLC constructor function : the replacement policy is picked by llc_type
 cache_c *default_llc(macsim_c* m_simBase)
 {
   string llc_type = KNOB(KNOB_LLC_TYPE)->getValue();
-  assert(llc_type == "default");
+  Llc_Policy policy = llc_policy_from_name(llc_type);
+  ASSERTM(policy != LLC_POLICY_MAX, "unknown llc_type %s\n", llc_type.c_str());
 
   int num_tiles;
   int interleaving;
@@ -218,9 +228,44 @@ cache_c *default_llc(macsim_c* m_simBase)
     }
   }
 
-  cache_c* llc = new cache_c("llc_default", *KNOB(KNOB_L3_NUM_SET), *KNOB(KNOB_L3_ASSOC),
-      *KNOB(KNOB_L3_LINE_SIZE), sizeof(dcache_data_s), *KNOB(KNOB_L3_NUM_BANK),
-      false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase);
+  int num_set   = *KNOB(KNOB_L3_NUM_SET);
+  int assoc     = *KNOB(KNOB_L3_ASSOC);
+  int line_size = *KNOB(KNOB_L3_LINE_SIZE);
+  int num_bank  = *KNOB(KNOB_L3_NUM_BANK);
+
+  cache_c* llc;
+  switch (policy) {
+    case LLC_PLRU:
+      llc = new llc_plru_c("llc_plru", num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase);
+      break;
+    case LLC_BIP:
+    case LLC_DIP:
+    case LLC_TADIP:
+      llc = new llc_dip_c("llc_" + llc_type, num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase, policy);
+      break;
+    case LLC_SRRIP:
+    case LLC_BRRIP:
+    case LLC_DRRIP:
+    case LLC_TAP:
+      llc = new llc_rrip_c("llc_" + llc_type, num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase, policy);
+      break;
+    case LLC_UCP:
+      llc = new llc_ucp_c("llc_ucp", num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase);
+      break;
+    case LLC_BDI:
+      llc = new llc_bdi_c("llc_bdi", num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase);
+      break;
+    default:
+      llc = new cache_c("llc_default", num_set, assoc, line_size, sizeof(dcache_data_s), 
+          num_bank, false, 0, CACHE_DL1, false, num_tiles, interleaving, m_simBase);
+      break;
+  }
+
   return llc;
 }
 
@@ -229,22 +274,31 @@ cache_c *default_llc(macsim_c* m_simBase)
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
-bool queue_c::sort_func::operator()(mem_req_s* a, mem_req_s* b)
+bool queue_c::sort_by_priority(mem_req_s* a, mem_req_s* b)
 {
-  if (*m_simBase->m_knobs->KNOB_HETERO_MEM_PRIORITY_CPU) {
-    if (a->m_ptx != true && b->m_ptx == true) {
-      return true;
-    }
-    else if (a->m_ptx == true && b->m_ptx != true)
-      return false;
+  return a->m_priority > b->m_priority;
+}
+
+
+bool queue_c::sort_cpu_first(mem_req_s* a, mem_req_s* b)
+{
+  if (a->m_ptx != true && b->m_ptx == true) {
+    return true;
   }
-  else if (*m_simBase->m_knobs->KNOB_HETERO_MEM_PRIORITY_GPU) {
-    if (a->m_ptx != true && b->m_ptx == true) {
-      return false;
-    }
-    else if (a->m_ptx == true && b->m_ptx != true)
-      return true;
+  else if (a->m_ptx == true && b->m_ptx != true)
+    return false;
+
+  return a->m_priority > b->m_priority;
+}
+
+
+bool queue_c::sort_gpu_first(mem_req_s* a, mem_req_s* b)
+{
+  if (a->m_ptx != true && b->m_ptx == true) {
+    return false;
   }
+  else if (a->m_ptx == true && b->m_ptx != true)
+    return true;
 
   return a->m_priority > b->m_priority;
 }
@@ -254,6 +308,13 @@ queue_c::queue_c(macsim_c* simBase, int size)
 {
   m_simBase = simBase;
   m_size = size;
+
+  if (CONFIG(m_hetero_mem_priority_cpu))
+    m_sort_func = sort_cpu_first;
+  else if (CONFIG(m_hetero_mem_priority_gpu))
+    m_sort_func = sort_gpu_first;
+  else
+    m_sort_func = sort_by_priority;
 }
 
 
@@ -305,7 +366,7 @@ bool queue_c::push(mem_req_s* req)
 
   req->m_queue = this;
   m_entry.push_back(req);
-  m_entry.sort(sort_func(m_simBase));
+  m_entry.sort(m_sort_func);
 
   return true;
 }
@@ -320,6 +381,13 @@ bool queue_c::full()
 }
 
 
+// free entries.
+unsigned int queue_c::space()
+{
+  return m_size - m_entry.size();
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -365,6 +433,20 @@ dcu_c::~dcu_c()
 }
 
 
+// inclusion policy of a knob value (-1 : unknown)
+static int inclusion_policy(const string& policy)
+{
+  if (policy == "non_inclusive")
+    return INCL_NON_INCLUSIVE;
+  else if (policy == "inclusive")
+    return INCL_INCLUSIVE;
+  else if (policy == "exclusive")
+    return INCL_EXCLUSIVE;
+
+  return -1;
+}
+
+
 // initialize data cache.
 void dcu_c::init(int next_id, int prev_id, bool done, bool coupled_up, bool coupled_down, \
     bool disable, bool has_router)
@@ -393,14 +475,31 @@ void dcu_c::init(int next_id, int prev_id, bool done, bool coupled_up, bool coup
     for (int ii = 0; ii < m_banks; ++ii) {
       m_port[ii] = new port_c("dcache_port", m_num_read_port, m_num_write_port, false, m_simBase);
     }
+
+    // a compressed cache may replace several lines per fill
+    m_max_victims = m_cache->max_victims();
   }
   else {
     m_latency = 1;
+    m_max_victims = 1;
   }
 
   if (m_bypass == true) {
     m_disable = true;
   }
+
+  // inclusion policy (L2 : towards its L1, L3 : towards all private caches)
+  m_inclusion = INCL_NON_INCLUSIVE;
+  m_clean_wb  = false;
+  if (m_level == MEM_L2) {
+    m_inclusion = inclusion_policy(KNOB(KNOB_L2_INCLUSION)->getValue());
+    m_clean_wb  = (inclusion_policy(KNOB(KNOB_L3_INCLUSION)->getValue()) == INCL_EXCLUSIVE);
+    ASSERTM(m_inclusion != INCL_EXCLUSIVE, "l2_inclusion exclusive is not supported\n");
+  }
+  else if (m_level == MEM_L3) {
+    m_inclusion = inclusion_policy(KNOB(KNOB_L3_INCLUSION)->getValue());
+  }
+  ASSERTM(m_inclusion != -1, "L%d: unknown inclusion policy\n", m_level);
 }
 
 
@@ -490,13 +589,13 @@ int dcu_c::access(uop_c* uop)
   else if (IsStore(type) && !m_port[bank]->get_write_port(m_cycle - 1)) {
     // port busy
     STAT_EVENT(CACHE_BANK_BUSY);
-    uop->m_dcache_bank_id = bank + 64;
+    uop->m_warm->m_dcache_bank_id = bank + 64;
     return 0;
   }
   else if (IsLoad(type) && !m_port[bank]->get_read_port(m_cycle - 1)) {
     // port busy
     STAT_EVENT(CACHE_BANK_BUSY);
-    uop->m_dcache_bank_id = bank;
+    uop->m_warm->m_dcache_bank_id = bank;
     return 0;
   }
   DEBUG("L%d[%d] uop_num:%lld addr:%llu port:%d acquired\n", m_level, m_id, uop->m_uop_num, \
@@ -525,6 +624,18 @@ int dcu_c::access(uop_c* uop)
       POWER_EVENT(POWER_L3CACHE_R_TAG);
     }
 
+    // a store to a shared copy is an upgrade miss (GetM to the directory)
+    if (line && IsStore(type) && m_memory->coherent(m_ptx_sim)) {
+      if (line->m_coh_state == E_STATE) {
+        line->m_coh_state = M_STATE;
+      }
+      else if (line->m_coh_state != M_STATE) {
+        STAT_EVENT(COH_UPGRADE);
+        line = NULL;
+        cache_hit = false;
+      }
+    }
+
 	  // prefetch cache should be here
   }
 
@@ -542,7 +653,7 @@ int dcu_c::access(uop_c* uop)
     STAT_EVENT(L1_HIT_CPU + this->m_ptx_sim);
     DEBUG("L%d[%d] uop_num:%lld cache hit\n", m_level, m_id, uop->m_uop_num);
     // stat
-    uop->m_uop_info.m_dcmiss = false;
+    uop->m_cold->m_uop_info.m_dcmiss = false;
 
     if (line && IsStore(type))
       line->m_dirty = true;
@@ -551,13 +662,10 @@ int dcu_c::access(uop_c* uop)
     // hardware prefetcher training
     // -------------------------------------
     m_simBase->m_core_pointers[uop->m_core_id]->train_hw_pref(MEM_L1, uop->m_thread_id, \
-        line_addr, uop->m_pc, uop, true);
+        line_addr, uop->m_warm->m_pc, uop, true);
 
 
-    if (*m_simBase->m_knobs->KNOB_ENABLE_CACHE_COHERENCE) {
-    }
-
-    if (this->m_ptx_sim && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+    if (this->m_ptx_sim && CONFIG(m_fermi)
         && type == MEM_ST) {
       //evict global data on write hit in L1
       m_cache->invalidate_cache_line(vaddr);
@@ -565,7 +673,7 @@ int dcu_c::access(uop_c* uop)
       int req_size;
       Addr req_addr;
       if (m_ptx_sim && *m_simBase->m_knobs->KNOB_BYTE_LEVEL_ACCESS) {
-        req_size = uop->m_mem_size;
+        req_size = uop->m_warm->m_mem_size;
         req_addr = vaddr;
       }
       else {
@@ -604,11 +712,11 @@ int dcu_c::access(uop_c* uop)
     // -------------------------------------
     if (!m_disable) {
       m_simBase->m_core_pointers[uop->m_core_id]->train_hw_pref(MEM_L1, uop->m_thread_id, line_addr, \
-          uop->m_pc, uop, false);
+          uop->m_warm->m_pc, uop, false);
     }
 
     // stat
-    uop->m_uop_info.m_dcmiss = true;
+    uop->m_cold->m_uop_info.m_dcmiss = true;
 
     // set type;
     Mem_Req_Type req_type;
@@ -638,7 +746,7 @@ int dcu_c::access(uop_c* uop)
     int req_size;
     Addr req_addr;
     if (m_ptx_sim && *m_simBase->m_knobs->KNOB_BYTE_LEVEL_ACCESS) {
-      req_size = uop->m_mem_size;
+      req_size = uop->m_warm->m_mem_size;
       req_addr = vaddr;
     }
     else {
@@ -649,18 +757,18 @@ int dcu_c::access(uop_c* uop)
 
     // FIXME (jaekyu, 10-26-2011)
     if (m_id == *m_simBase->m_knobs->KNOB_HETERO_GPU_CORE_DISABLE) {
-      uop->m_bypass_llc = true;
+      uop->m_warm->m_bypass_llc = true;
     }
 
     if (m_id == *m_simBase->m_knobs->KNOB_HETERO_GPU_CORE_DISABLE + 1) {
-      uop->m_skip_llc = true;
+      uop->m_warm->m_skip_llc = true;
     }
 
     // -------------------------------------
     // Generate a new memory request (MSHR access)
     // -------------------------------------
     function<bool (mem_req_s*)> done_func = NULL;
-    if (this->m_ptx_sim && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+    if (this->m_ptx_sim && CONFIG(m_fermi)
         && (type == MEM_ST || type == MEM_ST_LM)) {
       done_func = dcache_write_ack_wrapper;
     }
@@ -680,6 +788,10 @@ int dcu_c::access(uop_c* uop)
       uop->m_state = OS_DCACHE_MEM_ACCESS_DENIED;
       return 0;
     }
+
+    if (m_simBase->m_pc_profiler && req_type == MRT_DFETCH)
+      m_simBase->m_pc_profiler->miss(MEM_L1, uop->m_warm->m_pc, vaddr, uop->m_core_id);
+
     // -------------------------------------
     // In case of software prefetch, generate pref request and retire the instruction
     // -------------------------------------
@@ -701,6 +813,7 @@ bool dcu_c::fill(mem_req_s* req)
     req->m_queue = m_fill_queue;
     req->m_state = MEM_FILL_NEW;
     req->m_rdy_cycle = m_cycle + 1;
+    req->set_stage(MEM_STAGE_FILL, CYCLE);
     DEBUG("L%d[%d] (->fill_queue) req:%d type:%s\n", 
         m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
 
@@ -727,6 +840,7 @@ bool dcu_c::insert(mem_req_s* req)
   if (m_in_queue->push(req)) {
     req->m_queue = m_in_queue;
     req->m_rdy_cycle = m_cycle + m_latency;
+    req->set_stage(static_cast<Mem_Req_Stage>(MEM_STAGE_L1_QUEUE + m_level - MEM_L1), CYCLE);
     DEBUG("L%d[%d] (->in_queue) req:%d type:%s\n", 
         m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
     return true;
@@ -748,6 +862,7 @@ void dcu_c::run_a_cycle(bool pll_lock)
 
   process_wb_queue();
   process_fill_queue();
+  process_coh_queue();
   process_out_queue();
   process_in_queue();
 
@@ -797,7 +912,7 @@ void dcu_c::process_in_queue()
     // Cache access
     // -------------------------------------
     Addr line_addr;
-    dcache_data_s* line;
+    dcache_data_s* line = NULL;
     bool cache_hit = false;
     if (m_level == MEM_L3 && req->m_bypass == true) {
       line = NULL;
@@ -818,6 +933,30 @@ void dcu_c::process_in_queue()
     }
 
 
+    // -------------------------------------
+    // Coherence : a store needs an exclusive private copy; the home L3 tile checks the
+    // directory (the request may wait for invalidations/forwards)
+    // -------------------------------------
+    if (m_memory->coherent(req->m_ptx) && req->m_type != MRT_WB) {
+      if (m_level == MEM_L3) {
+        if (!m_memory->handle_coherence(m_id, req, line)) {
+          done_list.push_back(req);
+          ++count;
+          continue;
+        }
+      }
+      else if (cache_hit && req->m_type == MRT_DSTORE) {
+        if (line->m_coh_state == E_STATE) {
+          line->m_coh_state = M_STATE;
+        }
+        else if (line->m_coh_state != M_STATE) {
+          STAT_EVENT(COH_UPGRADE);
+          cache_hit = false;
+        }
+      }
+    }
+
+
     // -------------------------------------
     // Cache hit
     // -------------------------------------
@@ -829,19 +968,34 @@ void dcu_c::process_in_queue()
         POWER_EVENT(POWER_L3CACHE_R );
       }
 
+      // inclusive L3 : the core gets a private copy (coherent requests use the directory)
+      if (m_level == MEM_L3 && m_inclusion == INCL_INCLUSIVE && req->m_type != MRT_WB && 
+          !m_memory->coherent(req->m_ptx)) {
+        line->m_sharers |= 1ULL << req->m_core_id;
+      }
+
       // -------------------------------------
       // hardware prefetcher training
       // -------------------------------------
       m_simBase->m_core_pointers[req->m_core_id]->train_hw_pref(m_level, req->m_thread_id, \
           req->m_addr, req->m_pc, req->m_uop ? req->m_uop : NULL, true);
 
+      // first demand use of a prefetched line (prefetches fill up to the done level)
+      if (m_done && line && line->m_prefetcher_id && 
+          (req->m_type == MRT_DFETCH || req->m_type == MRT_DSTORE)) {
+        hwp_common_c* hw_pref = m_simBase->m_core_pointers[req->m_core_id]->get_hw_pref();
+        if (hw_pref)
+          hw_pref->pref_l2_pref_hit(req->m_thread_id, req->m_addr, req->m_pc, \
+              line->m_prefetcher_id, req->m_uop);
+        line->m_prefetcher_id = 0;
+      }
+
       STAT_EVENT(L1_HIT_CPU + (m_level - 1)*4 + req->m_ptx);
+      req->m_service_level = m_level;
       
       if (line && req->m_type == MRT_DSTORE) {
         line->m_dirty = true;
       }
-    
-//      handle_coherence(m_level, false, );
 
       // -------------------------------------
       // WB reqeust: the line should be changed to the dirty state and retire (no further act.)
@@ -870,6 +1024,13 @@ void dcu_c::process_in_queue()
             mem_req_c::mem_req_type_name[req->m_type]);
         if (!m_prev[req->m_cache_id[m_level-1]]->fill(req))
           continue;
+
+        // compressed LLC : decompression
+        int extra_latency = m_cache->extra_hit_latency(req->m_addr);
+        if (extra_latency > 0) {
+          STAT_EVENT(LLC_BDI_DECOMPRESS);
+          req->m_rdy_cycle += extra_latency;
+        }
       }
       // L3 cache - decoupled 
       // : send to l2 cache fill via NoC
@@ -883,6 +1044,22 @@ void dcu_c::process_in_queue()
             m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
         req->m_state = MEM_OUT_FILL;
         req->m_rdy_cycle = m_cycle + 1;
+
+        // compressed LLC : decompression
+        int extra_latency = m_cache->extra_hit_latency(req->m_addr);
+        if (extra_latency > 0) {
+          STAT_EVENT(LLC_BDI_DECOMPRESS);
+          req->m_rdy_cycle += extra_latency;
+        }
+        req->set_stage(MEM_STAGE_NOC, CYCLE);
+      }
+
+      // exclusive L3 : the line moves to the private cache (with its dirty data)
+      if (m_level == MEM_L3 && m_inclusion == INCL_EXCLUSIVE && req->m_type != MRT_WB && 
+          !req->m_with_data) {
+        STAT_EVENT(L3_EXCLUSIVE_MOVE);
+        req->m_dirty |= line->m_dirty;
+        m_cache->invalidate_cache_line(req->m_addr);
       }
 
       done_list.push_back(req);
@@ -900,9 +1077,16 @@ void dcu_c::process_in_queue()
         //    req->m_addr, req->m_pc, req->m_uop ? req->m_uop : NULL, false);
       }
 
-      STAT_EVENT(L1_HIT_CPU + (m_level - 1)*4 + 2 + req->m_ptx);
+      // prefetcher accuracy / coverage accounting at the level prefetches fill
+      hwp_common_c* hw_pref = m_simBase->m_core_pointers[req->m_core_id]->get_hw_pref();
+      if (m_done && !m_disable && hw_pref) {
+        if (req->m_type == MRT_DPRF)
+          hw_pref->pref_l2sent(req->m_prefetcher_id);
+        else if (req->m_type == MRT_DFETCH || req->m_type == MRT_DSTORE)
+          hw_pref->pref_l2_demand_miss(req->m_addr);
+      }
 
-//      handle_coherence(m_level, false, );
+      STAT_EVENT(L1_HIT_CPU + (m_level - 1)*4 + 2 + req->m_ptx);
 
       // -------------------------------------
       // If there is a direct link from current level and next lower level,
@@ -928,8 +1112,12 @@ void dcu_c::process_in_queue()
             m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
         req->m_state = MEM_OUTQUEUE_NEW;
         req->m_rdy_cycle = m_cycle + 1;
+        req->set_stage(MEM_STAGE_NOC, CYCLE);
       }
 
+      if (m_simBase->m_pc_profiler && req->m_type == MRT_DFETCH && m_level <= MEM_L3)
+        m_simBase->m_pc_profiler->miss(m_level, req->m_pc, req->m_addr, req->m_core_id);
+
       done_list.push_back(req);
       ++count;
     }
@@ -947,7 +1135,7 @@ void dcu_c::process_in_queue()
           m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type], \
           m_cycle - req->m_in);
 
-      if (req->m_ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f &&
+      if (req->m_ptx && CONFIG(m_fermi) &&
           req->m_type == MRT_DSTORE) {
         m_simBase->m_memory->free_write_req(req);
       }
@@ -986,6 +1174,9 @@ void dcu_c::receive_packet(void)
       else if (req->m_msg_type == NOC_NEW || req->m_msg_type == NOC_NEW_WITH_DATA) {
         insert_done = insert(req);
       }
+      else if (req->m_msg_type >= NOC_COH_INV && req->m_msg_type <= NOC_COH_DATA) {
+        insert_done = receive_coherence(req);
+      }
       else {
         assert(0);
       }
@@ -1031,6 +1222,258 @@ bool dcu_c::send_packet(mem_req_s* req, int msg_type, int dir)
 }
 
 
+// queue a coherence message
+void dcu_c::send_coherence(mem_req_s* msg)
+{
+  m_coh_queue.push_back(msg);
+}
+
+
+// send coherence messages (L3 : to the private L2s, L2 : acks to the home tile)
+void dcu_c::process_coh_queue()
+{
+  int count = 0;
+  while (!m_coh_queue.empty() && count < 4) {
+    mem_req_s* msg = m_coh_queue.front();
+    if (msg->m_rdy_cycle > m_cycle)
+      break;
+
+    int dir = (m_level == MEM_L3) ? -1 : 1;
+    if (!send_packet(msg, msg->m_msg_type, dir))
+      break;
+
+    DEBUG("L%d[%d]->L%d[%d] (coh_queue->noc) msg:%d type:%d addr:%s\n", 
+        m_level, m_id, m_level+dir, msg->m_cache_id[m_level+dir], msg->m_id, 
+        msg->m_msg_type, hexstr64s(msg->m_addr));
+    m_coh_queue.pop_front();
+    ++count;
+  }
+}
+
+
+// coherence message from the NoC
+bool dcu_c::receive_coherence(mem_req_s* msg)
+{
+  Addr line_addr;
+
+  // -------------------------------------
+  // Home L3 tile : acknowledgement
+  // -------------------------------------
+  if (m_level == MEM_L3) {
+    dcache_data_s* line = (dcache_data_s*)m_cache->access_cache(msg->m_addr, &line_addr, 
+        false, msg->m_appl_id);
+    POWER_EVENT(POWER_L3CACHE_R_TAG);
+
+    // dirty data of a replaced line goes to memory
+    if (msg->m_msg_type == NOC_COH_DATA && line == NULL) {
+      if (m_wb_queue->full())
+        return false;
+
+      dcache_data_s data;
+      data.m_core_id   = msg->m_core_id;
+      data.m_tid       = msg->m_thread_id;
+      data.m_pc        = 0;
+      data.m_coh_state = I_STATE;
+      mem_req_s* wb = m_memory->new_wb_req(msg->m_addr, m_line_size, false, &data, m_level);
+      wb->m_rdy_cycle = m_cycle + 1;
+      m_wb_queue->push(wb);
+      POWER_EVENT(POWER_L3CACHE_WB_BUF_W);
+    }
+    else if (msg->m_msg_type == NOC_COH_DATA) {
+      POWER_EVENT(POWER_L3CACHE_W);
+    }
+
+    m_memory->coherence_ack(m_id, msg, line);
+    delete msg;
+    return true;
+  }
+
+  // -------------------------------------
+  // Private L2 and its L1 : invalidate, or downgrade to S for a forwarded GetS
+  // -------------------------------------
+  bool forward = (msg->m_msg_type == NOC_COH_FWD);
+  bool present = false;
+  bool dirty   = false;
+  dcu_c* level[2] = {m_prev[m_id], this};
+  for (int ii = 0; ii < 2; ++ii) {
+    if (level[ii]->m_disable)
+      continue;
+
+    dcache_data_s* line = (dcache_data_s*)level[ii]->m_cache->access_cache(msg->m_addr, 
+        &line_addr, false, msg->m_appl_id);
+    POWER_CORE_EVENT(msg->m_core_id, POWER_DCACHE_R_TAG + (level[ii]->m_level - 1));
+    if (line == NULL)
+      continue;
+
+    present = true;
+    dirty  |= line->m_dirty;
+    if (forward) {
+      line->m_dirty     = false;
+      line->m_coh_state = S_STATE;
+    }
+    else {
+      level[ii]->m_cache->invalidate_cache_line(msg->m_addr);
+    }
+  }
+
+  // reply to the home tile
+  msg->m_msg_type  = dirty ? NOC_COH_DATA : NOC_COH_ACK;
+  msg->m_coh_state = (forward && present) ? S_STATE : I_STATE;
+  msg->m_dirty     = dirty;
+  msg->m_rdy_cycle = m_cycle + m_latency;
+  send_coherence(msg);
+
+  return true;
+}
+
+
+// inclusive L2 : invalidate the L1 copy of a victim
+void dcu_c::back_invalidate_l1(Addr line_addr, dcache_data_s* victim, int appl_id)
+{
+  dcu_c* l1 = m_prev[m_id];
+  if (l1->m_disable)
+    return;
+
+  Addr addr;
+  dcache_data_s* copy = l1->access_cache(line_addr, &addr, false, appl_id);
+  POWER_CORE_EVENT(m_id, POWER_DCACHE_R_TAG);
+  if (copy == NULL)
+    return;
+
+  STAT_EVENT(L2_INCLUSION_VICTIM);
+  victim->m_dirty |= copy->m_dirty;
+  l1->m_cache->invalidate_cache_line(line_addr);
+}
+
+
+// Inclusive L3 : the presence vector is not updated on silent private evictions, so the
+// private caches of the set bits are queried (L2 and its L1). With the directory protocol,
+// the sharer vector is left alone (a granted copy may still be on its way).
+bool dcu_c::query_private(Addr line_addr, dcache_data_s* line, int appl_id)
+{
+  Addr addr;
+  bool held = false;
+  bool directory = m_memory->coherent(false);
+  uns64 sharers = line->m_sharers;
+  while (sharers) {
+    int core_id = __builtin_ctzll(sharers);
+    sharers &= sharers - 1;
+
+    bool present = false;
+    dcu_c* level[2] = {m_prev[core_id]->m_prev[core_id], m_prev[core_id]};
+    for (int ii = 0; ii < 2 && !present; ++ii) {
+      if (!level[ii]->m_disable && level[ii]->access_cache(line_addr, &addr, false, appl_id))
+        present = true;
+    }
+
+    if (present)
+      held = true;
+    else if (!directory)
+      line->m_sharers &= ~(1ULL << core_id);
+  }
+
+  return held;
+}
+
+
+// TLA-style query based selection : a victim candidate that a core still holds would cause
+// an inclusion victim, so it is promoted (as on a hit) and the next candidate is checked.
+// Neither the probe nor the promotion counts as an access of the requester.
+void dcu_c::select_inclusion_victim(mem_req_s* req)
+{
+  Addr line_addr;
+  int set;
+  int way;
+  uns max_query = *KNOB(KNOB_L3_INCLUSION_QBS);
+  for (uns ii = 0; ii < max_query; ++ii) {
+    Addr victim_addr = m_cache->find_victim_line(req->m_addr, req->m_appl_id, req->m_ptx, 
+        &set, &way);
+    if (victim_addr == 0)
+      return;
+
+    dcache_data_s* victim = (dcache_data_s*)m_cache->access_cache(victim_addr, &line_addr, 
+        false, req->m_appl_id);
+    if (victim->m_sharers == 0)
+      return;
+
+    STAT_EVENT(L3_INCLUSION_QBS_QUERY);
+    if (!query_private(victim_addr, victim, req->m_appl_id))
+      return;
+
+    STAT_EVENT(L3_INCLUSION_QBS_SKIP);
+    m_cache->promote_line(set, way, req->m_appl_id);
+  }
+}
+
+
+// write-back, inclusion and coherence actions for a replaced line
+void dcu_c::evict_line(mem_req_s* req, Addr victim_line_addr, dcache_data_s* data, bool coherent)
+{
+  // inclusive L2 : the L1 copy goes as well
+  if (m_level == MEM_L2 && m_inclusion == INCL_INCLUSIVE)
+    back_invalidate_l1(victim_line_addr, data, req->m_appl_id);
+
+  // (exclusive L3 : clean victims are inserted into the L3 as well)
+  if (data->m_dirty || m_clean_wb) {
+    if (*(m_simBase->m_knobs->KNOB_USE_INCOMING_TID_CID_FOR_WB)) {
+      data->m_core_id = req->m_core_id;
+      data->m_tid = req->m_thread_id;
+    } 
+
+    // new write-back request
+    mem_req_s* wb = m_simBase->m_memory->new_wb_req(victim_line_addr, m_line_size, 
+        m_ptx_sim, data, m_level);
+
+    wb->m_rdy_cycle = m_cycle + 1;
+    if (!data->m_dirty) {
+      STAT_EVENT(L3_EXCLUSIVE_CLEAN_VICTIM);
+      wb->m_dirty = false;
+    }
+
+    if (!m_wb_queue->push(wb))
+      ASSERT(0);
+
+    if (m_level != MEM_L3) {
+      POWER_CORE_EVENT(req->m_core_id, POWER_DCACHE_WB_BUF_W + m_level - MEM_L1);
+    }
+    else {
+      POWER_EVENT( POWER_L3CACHE_WB_BUF_W );
+    }
+
+    DEBUG("L%d[%d] (fill_queue) new_wb_req:%d addr:%s type:%s by req:%d\n", 
+        m_level, m_id, wb->m_id, hexstr64s(victim_line_addr), \
+        mem_req_c::mem_req_type_name[wb->m_type], req->m_id);
+  }
+
+  // private copies of an L3 victim are back-invalidated
+  if (m_level == MEM_L3 && m_inclusion == INCL_INCLUSIVE && data->m_sharers && 
+      query_private(victim_line_addr, data, req->m_appl_id)) {
+    STAT_EVENT(L3_INCLUSION_VICTIM);
+  }
+  if (m_level == MEM_L3 && (coherent || m_inclusion == INCL_INCLUSIVE))
+    m_memory->coherence_evict(m_id, victim_line_addr, data);
+
+  if (m_done) {
+    hwp_common_c* hw_pref = m_simBase->m_core_pointers[req->m_core_id]->get_hw_pref();
+    if (hw_pref) {
+      hw_pref->pref_l2evict(victim_line_addr);
+      if (data->m_prefetcher_id)
+        hw_pref->pref_evictline_notused(victim_line_addr);
+      else if (req->m_type == MRT_DPRF)
+        hw_pref->pref_l2evictOnPF(victim_line_addr);
+    }
+  }
+}
+
+
+// collect the addresses of the valid lines
+void dcu_c::get_line_addrs(vector<Addr>& addrs)
+{
+  if (!m_disable)
+    m_cache->get_line_addrs(addrs);
+}
+
+
 // process out queue
 // output request
 //   request that are waiting to be sent to the router 
@@ -1054,7 +1497,7 @@ void dcu_c::process_out_queue()
     // -------------------------------------
     if (req->m_state == MEM_OUTQUEUE_NEW) {
       int msg_type;
-      if (req->m_ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+      if (req->m_ptx && CONFIG(m_fermi)
           && req->m_with_data && m_level != MEM_L3) {
         //can change if to req->m_type == MRT_DSTORE
         msg_type = NOC_NEW_WITH_DATA;
@@ -1075,7 +1518,7 @@ void dcu_c::process_out_queue()
     // -------------------------------------
     else if (req->m_state == MEM_OUT_FILL) {
       int msg_type;
-      if (req->m_ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+      if (req->m_ptx && CONFIG(m_fermi)
           && req->m_with_data && m_level == MEM_L3) {
         //can change if to req->m_type == MRT_DSTORE
         msg_type = NOC_ACK;
@@ -1134,13 +1577,13 @@ void dcu_c::process_fill_queue()
     if (count == 4) 
       break;
     
-    // if wb-queue is full, fill request cannot be made
-    if (m_wb_queue->full())
+    // if wb-queue cannot take the victims, fill request cannot be made
+    if (m_wb_queue->space() < m_max_victims)
       break;
 
     mem_req_s* req = (*I);
 
-    if (req->m_ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f 
+    if (req->m_ptx && CONFIG(m_fermi) 
         && m_level == MEM_L1 && req->m_type == MRT_DSTORE) {
         ASSERTM(m_done && req->m_done_func && req->m_done_func(req), "done function failed\n");
         req->m_done = true;
@@ -1178,6 +1621,7 @@ void dcu_c::process_fill_queue()
         Addr line_addr, victim_line_addr;
         dcache_data_s* line = NULL;
         bool cache_hit = true;
+        bool coherent = m_memory->coherent(req->m_ptx);
 
         // Access cache to check whether there is the same line in the cache.
         if (!m_disable) {
@@ -1185,6 +1629,17 @@ void dcu_c::process_fill_queue()
           cache_hit = (line) ? true: false;
         }
 
+        // exclusive L3 : memory data only fills the private caches (an L3 copy moves up)
+        if (m_level == MEM_L3 && m_inclusion == INCL_EXCLUSIVE && req->m_type != MRT_WB && 
+            !req->m_with_data) {
+          if (line != NULL) {
+            req->m_dirty |= line->m_dirty;
+            m_cache->invalidate_cache_line(req->m_addr);
+            line = NULL;
+          }
+          cache_hit = true;
+        }
+
         if (!cache_hit) { // !cache_hit
           // Access write ports
           int bank = m_cache->get_bank_num(req->m_addr);
@@ -1193,6 +1648,10 @@ void dcu_c::process_fill_queue()
             continue;
           }
 
+          // inclusive L3 : avoid victims that are still in a private cache
+          if (m_level == MEM_L3 && m_inclusion == INCL_INCLUSIVE)
+            select_inclusion_victim(req);
+
           // -------------------------------------
           // Insert a cache line
           // -------------------------------------
@@ -1210,31 +1669,13 @@ void dcu_c::process_fill_queue()
           // If there is a victim line, we do the write-back.
           // -------------------------------------
           if (victim_line_addr) {
-            if (data->m_dirty) {
-              if (*(m_simBase->m_knobs->KNOB_USE_INCOMING_TID_CID_FOR_WB)) {
-                data->m_core_id = req->m_core_id;
-                data->m_tid = req->m_thread_id;
-              } 
-
-              // new write-back request
-              mem_req_s* wb = m_simBase->m_memory->new_wb_req(victim_line_addr, m_line_size, 
-                  m_ptx_sim, data, m_level);
-
-              wb->m_rdy_cycle = m_cycle + 1;
-
-              if (!m_wb_queue->push(wb))
-                ASSERT(0);
-
-              if (m_level != MEM_L3) {
-                POWER_CORE_EVENT(req->m_core_id, POWER_DCACHE_WB_BUF_W + m_level - MEM_L1);
-              }
-              else {
-                POWER_EVENT( POWER_L3CACHE_WB_BUF_W );
-              }
-
-              DEBUG("L%d[%d] (fill_queue) new_wb_req:%d addr:%s type:%s by req:%d\n", 
-                  m_level, m_id, wb->m_id, hexstr64s(victim_line_addr), \
-                  mem_req_c::mem_req_type_name[wb->m_type], req->m_id);
+            evict_line(req, victim_line_addr, data, coherent);
+
+            // compressed cache : a fill may replace more lines
+            Addr extra_line_addr;
+            void* extra_data;
+            while (m_cache->pop_victim(&extra_line_addr, &extra_data)) {
+              evict_line(req, extra_line_addr, (dcache_data_s*)extra_data, coherent);
             }
           }
 
@@ -1246,11 +1687,30 @@ void dcu_c::process_fill_queue()
           data->m_core_id     = req->m_core_id;
           data->m_pc          = req->m_pc;
           data->m_tid         = req->m_thread_id;
+          data->m_coh_state   = I_STATE;
+          data->m_sharers     = 0;
+          data->m_prefetcher_id = (m_done && req->m_type == MRT_DPRF) ? req->m_prefetcher_id : 0;
+          line = data;
         }
         else if (line != NULL) {
           line->m_dirty |= req->m_dirty;
         }
 
+        // -------------------------------------
+        // Coherence : directory update at the home tile, granted state in private caches
+        // -------------------------------------
+        if (coherent && line != NULL) {
+          if (m_level == MEM_L3)
+            m_memory->coherence_fill(m_id, req, line);
+          else if (req->m_coh_state != I_STATE)
+            line->m_coh_state = req->m_coh_state;
+        }
+        // inclusive L3 : the core gets a private copy
+        else if (m_level == MEM_L3 && m_inclusion == INCL_INCLUSIVE && line != NULL && 
+            req->m_type != MRT_WB) {
+          line->m_sharers |= 1ULL << req->m_core_id;
+        }
+
         // L2: done function has been called in this level
         if (m_done == true) {
           ASSERTM(m_level != MEM_L3, "req:%d type:%s", req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
@@ -1297,6 +1757,7 @@ void dcu_c::process_fill_queue()
               continue;
             }
             req->m_state = MEM_OUT_FILL;
+            req->set_stage(MEM_STAGE_NOC, CYCLE);
             DEBUG("L%d[%d] (fill_queue->out_queue) hit:%d req:%d type:%s filled\n",
                 m_level, m_id, cache_hit, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
           }
@@ -1340,6 +1801,7 @@ void dcu_c::process_fill_queue()
             continue;
           }
           req->m_state = MEM_OUT_FILL;
+          req->set_stage(MEM_STAGE_NOC, CYCLE);
           DEBUG("L%d[%d] (fill_queue->out_queue) req:%d type:%s filled\n",
               m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
         }
@@ -1364,7 +1826,7 @@ void dcu_c::process_fill_queue()
           m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type], \
           m_cycle - req->m_in);
 
-      if (req->m_ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f &&
+      if (req->m_ptx && CONFIG(m_fermi) &&
           req->m_type == MRT_DSTORE) {
         m_simBase->m_memory->free_write_req(req);
       }
@@ -1426,6 +1888,7 @@ void dcu_c::process_wb_queue()
       DEBUG("L%d[%d] req:%d type:%s send to busout queue\n", 
           m_level, m_id, req->m_id, mem_req_c::mem_req_type_name[req->m_type]);
       req->m_state = MEM_OUT_WB;
+      req->set_stage(MEM_STAGE_NOC, CYCLE);
     }
 
     done_list.push_back(req);
@@ -1486,9 +1949,6 @@ bool dcu_c::done(mem_req_s* req)
         POWER_EVENT(POWER_L3CACHE_W);
       }
 
-      if (*m_simBase->m_knobs->KNOB_ENABLE_CACHE_COHERENCE) {
-      }
-
       // -------------------------------------
       // evict a line
       // -------------------------------------
@@ -1528,10 +1988,17 @@ bool dcu_c::done(mem_req_s* req)
       data->m_core_id = req->m_core_id;
       data->m_pc = req->m_pc;
       data->m_tid = req->m_thread_id;
+      data->m_coh_state = I_STATE;
+      data->m_sharers = 0;
+      line = data;
     }
     else {
       line->m_dirty |= req->m_dirty;
     }
+
+    // coherence : state granted by the directory
+    if (m_memory->coherent(req->m_ptx) && req->m_coh_state != I_STATE)
+      line->m_coh_state = req->m_coh_state;
   }
 
 
@@ -1542,11 +2009,13 @@ bool dcu_c::done(mem_req_s* req)
         req->m_id, uop->m_uop_num, req->m_in_global);
     uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
     uop->m_state = OS_SCHEDULED;
+    uop->m_cold->m_uop_info.m_mem_level = req->m_service_level;
+    m_simBase->m_core_pointers[uop->m_core_id]->get_scheduler()->wakeup(uop);
     if (m_ptx_sim) {
-      if (uop->m_parent_uop) {
-        uop_c* puop = uop->m_parent_uop;
-        ++puop->m_num_child_uops_done;
-        if (puop->m_num_child_uops_done == puop->m_num_child_uops) {
+      if (uop->m_warm->m_parent_uop) {
+        uop_c* puop = uop->m_warm->m_parent_uop;
+        ++puop->m_warm->m_num_child_uops_done;
+        if (puop->m_warm->m_num_child_uops_done == puop->m_warm->m_num_child_uops) {
           if (*m_simBase->m_knobs->KNOB_FETCH_ONLY_LOAD_READY) {
             m_simBase->m_core_pointers[puop->m_core_id]->get_frontend()->set_load_ready( \
                 puop->m_thread_id, puop->m_uop_num);
@@ -1554,6 +2023,7 @@ bool dcu_c::done(mem_req_s* req)
 
           puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
           puop->m_state = OS_SCHEDULED;
+          m_simBase->m_core_pointers[puop->m_core_id]->get_scheduler()->wakeup(puop);
         }
       } // uop->m_parent_uop
       else {
@@ -1574,11 +2044,12 @@ bool dcu_c::write_done(mem_req_s* req)
   uop_c* uop = req->m_uop;
   uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
   uop->m_state = OS_SCHEDULED;
+  m_simBase->m_core_pointers[uop->m_core_id]->get_scheduler()->wakeup(uop);
   if (m_ptx_sim) {
-    if (uop->m_parent_uop) {
-      uop_c* puop = uop->m_parent_uop;
-      ++puop->m_num_child_uops_done;
-      if (puop->m_num_child_uops_done == puop->m_num_child_uops) {
+    if (uop->m_warm->m_parent_uop) {
+      uop_c* puop = uop->m_warm->m_parent_uop;
+      ++puop->m_warm->m_num_child_uops_done;
+      if (puop->m_warm->m_num_child_uops_done == puop->m_warm->m_num_child_uops) {
         if (*m_simBase->m_knobs->KNOB_FETCH_ONLY_LOAD_READY) {
           m_simBase->m_core_pointers[puop->m_core_id]->get_frontend()->set_load_ready( \
               puop->m_thread_id, puop->m_uop_num);
@@ -1586,6 +2057,7 @@ bool dcu_c::write_done(mem_req_s* req)
 
         puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
         puop->m_state = OS_SCHEDULED;
+        m_simBase->m_core_pointers[puop->m_core_id]->get_scheduler()->wakeup(puop);
       }
     } // uop->m_parent_uop
     else {
@@ -1621,6 +2093,8 @@ memory_c::memory_c(macsim_c* simBase)
   m_num_core = *m_simBase->m_knobs->KNOB_NUM_SIM_CORES;
   m_num_l3   = *m_simBase->m_knobs->KNOB_NUM_L3;
   m_num_mc   = *m_simBase->m_knobs->KNOB_DRAM_NUM_MC;
+  m_num_cpu  = 0;
+  m_num_gpu  = 0;
 
 
   if (KNOB(KNOB_LARGE_CORE_TYPE)->getValue() == "ptx")
@@ -1696,6 +2170,35 @@ memory_c::memory_c(macsim_c* simBase)
   // misc
   m_stop_prefetch = 0;
 
+  // directory coherence : one sharer bit per core, messages through the NoC
+  m_coherence = *KNOB(KNOB_ENABLE_CACHE_COHERENCE);
+  if (m_coherence) {
+    string memory_type = KNOB(KNOB_MEMORY_TYPE)->getValue();
+    ASSERTM(memory_type.compare(0, 3, "l3_") == 0, 
+        "cache coherence needs a shared L3 (memory_type l3_*)\n");
+    ASSERTM(m_num_core <= 64, "cache coherence supports up to 64 cores\n");
+    ASSERTM(*KNOB(KNOB_ENABLE_NEW_NOC) || *KNOB(KNOB_ENABLE_IRIS), 
+        "cache coherence needs the NoC\n");
+  }
+
+  // inclusion policy of the L3 : back-invalidations use the directory messages and the
+  // presence vector (one bit per core); exclusive lines leave no directory entry behind
+  string l3_inclusion = KNOB(KNOB_L3_INCLUSION)->getValue();
+  if (l3_inclusion != "non_inclusive") {
+    string memory_type = KNOB(KNOB_MEMORY_TYPE)->getValue();
+    ASSERTM(memory_type.compare(0, 3, "l3_") == 0, 
+        "l3_inclusion %s needs a shared L3 (memory_type l3_*)\n", l3_inclusion.c_str());
+  }
+  if (l3_inclusion == "inclusive") {
+    ASSERTM(m_num_core <= 64, "inclusive L3 supports up to 64 cores\n");
+    ASSERTM(*KNOB(KNOB_ENABLE_NEW_NOC) || *KNOB(KNOB_ENABLE_IRIS), 
+        "inclusive L3 needs the NoC\n");
+  }
+  else if (l3_inclusion == "exclusive") {
+    ASSERTM(!m_coherence, "exclusive L3 does not support cache coherence\n");
+  }
+  m_capacity_sample = *KNOB(KNOB_INCLUSION_SAMPLE_INTERVAL);
+
   if (*m_simBase->m_knobs->KNOB_DEFAULT_INTERLEAVING) {
     m_l3_interleave_factor = log2_int(*m_simBase->m_knobs->KNOB_L3_NUM_SET) + log2_int(*m_simBase->m_knobs->KNOB_L3_LINE_SIZE);
     m_l3_interleave_factor = static_cast<int>(pow(2, m_l3_interleave_factor));
@@ -1774,13 +2277,13 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
     }
   }
 
-  if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+  if (ptx && CONFIG(m_fermi)
       && type == MRT_DSTORE) {
     STAT_CORE_EVENT(core_id, NUM_WRITES);
     STAT_EVENT(TOTAL_WRITES);
   }
 
-  if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+  if (ptx && CONFIG(m_fermi)
       && matching_req && type == MRT_DSTORE) {
     // nbl: TBD dec-20-2012
     // store matching a load, we cannot have a load matching 
@@ -1797,6 +2300,14 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
       // promotion from hardware prefetch to demand
       DEBUG("req:%d has been promoted type:%s\n", matching_req->m_id, 
           mem_req_c::mem_req_type_name[matching_req->m_type]);
+
+      // the demand caught up with the prefetch in flight : late prefetch
+      // (one still waiting for its l2 lookup was never sent and gets no credit)
+      hwp_common_c* hw_pref = m_simBase->m_core_pointers[core_id]->get_hw_pref();
+      if (hw_pref && matching_req->m_prefetcher_id && 
+          matching_req->m_stage > MEM_STAGE_L2_QUEUE)
+        hw_pref->pref_l2_pref_hit_late(thread_id, addr, uop ? uop->m_warm->m_pc : 0, \
+            matching_req->m_prefetcher_id, uop);
       adjust_req(matching_req, type, addr, size, delay, uop, done_func, unique_num, \
           g_mem_priority[type], core_id, thread_id, ptx);
       return true;
@@ -1824,7 +2335,7 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
   // allocate an entry
   mem_req_s* new_req = NULL;
   
-  if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
+  if (ptx && CONFIG(m_fermi)
       && type == MRT_DSTORE) {
     new_req = m_mem_req_pool->acquire_entry(m_simBase);
   }
@@ -1867,8 +2378,13 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
   init_new_req(new_req, type, addr, size, with_data, delay, uop, done_func, unique_num, \
       priority, core_id, thread_id, ptx);
 
+  if (pref_info) {
+    new_req->m_prefetcher_id = pref_info->m_prefetcher_id;
+    new_req->m_pref_loadPC   = pref_info->m_loadPC;
+  }
+
   // merge to existing request
-  if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f 
+  if (ptx && CONFIG(m_fermi) 
       && matching_req && type == MRT_DSTORE) {
     //nbl: TBD - dec-20-2012
     // store matching a load, we cannot have a load matching 
@@ -1883,6 +2399,7 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
     matching_req->m_merge.push_back(new_req);
     new_req->m_merged_req = matching_req;
     new_req->m_state = MEM_MERGED;
+    new_req->set_stage(MEM_STAGE_MSHR, CYCLE);
 
     // adjust priority
     if (matching_req->m_priority < priority)
@@ -1943,7 +2460,7 @@ void memory_c::init_new_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int si
   req->m_size                   = size;
   req->m_with_data              = with_data;
   req->m_rdy_cycle              = m_cycle + delay;
-  req->m_pc                     = uop ? uop->m_pc : 0;
+  req->m_pc                     = uop ? uop->m_warm->m_pc : 0;
   req->m_prefetcher_id          = 0;
   req->m_pref_loadPC            = 0;
   req->m_ptx                    = ptx;
@@ -1957,8 +2474,10 @@ void memory_c::init_new_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int si
   req->m_dirty                  = false;
   req->m_done                   = false;
   req->m_merged_req             = NULL;
-  req->m_bypass                 = uop ? uop->m_bypass_llc : false;
-  req->m_skip                   = uop ? uop->m_skip_llc : false;
+  req->m_service_level          = 0;
+  req->init_stage(CYCLE);
+  req->m_bypass                 = uop ? uop->m_warm->m_bypass_llc : false;
+  req->m_skip                   = uop ? uop->m_warm->m_skip_llc : false;
 
   ASSERT(req->m_merge.empty());
 
@@ -1979,7 +2498,7 @@ void memory_c::adjust_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int size
   req->m_priority               = priority;
   req->m_addr                   = addr;
   req->m_size                   = size;
-  req->m_pc                     = uop ? uop->m_pc : 0;
+  req->m_pc                     = uop ? uop->m_warm->m_pc : 0;
   req->m_prefetcher_id          = 0;
   req->m_pref_loadPC            = 0;
   req->m_ptx                    = ptx;
@@ -1993,6 +2512,8 @@ void memory_c::adjust_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int size
   req->m_dirty                  = false;
   req->m_done                   = false;
   req->m_merged_req             = NULL;
+  req->m_service_level          = 0;
+  req->init_stage(CYCLE);
   req->m_bypass                 = false;
   req->m_skip                   = false;
 
@@ -2017,6 +2538,12 @@ void memory_c::free_req(int core_id, mem_req_s* req)
   STAT_EVENT(AVG_MEMORY_LATENCY_BASE);
   STAT_EVENT_N(AVG_MEMORY_LATENCY, m_cycle - req->m_in);
 
+  if (m_simBase->m_mem_latency)
+    m_simBase->m_mem_latency->record(req, CYCLE);
+
+  if (m_simBase->m_pc_profiler && req->m_type == MRT_DFETCH)
+    m_simBase->m_pc_profiler->latency(req->m_pc, CYCLE - req->m_in_global);
+
   // when there are still merged requests, call done wrapper function
   if (!req->m_merge.empty()) {
     DEBUG("req:%d has merged req type:%s\n",
@@ -2026,6 +2553,14 @@ void memory_c::free_req(int core_id, mem_req_s* req)
 
   ASSERTM(req->m_merge.empty(), "type:%s\n", mem_req_c::mem_req_type_name[req->m_type]);
 
+  // a flushed prefetch may still block its line at the home tile (memory fetch)
+  if (!m_coh_txn.empty() && req->m_type == MRT_DPRF) {
+    Addr line_addr = m_l3_cache[req->m_cache_id[MEM_L3]]->base_addr(req->m_addr);
+    auto I = m_coh_txn.find(line_addr);
+    if (I != m_coh_txn.end() && I->second->m_req == req)
+      release_coh_txn(line_addr, I->second);
+  }
+
   if (req->m_type == MRT_WB) {
     delete req;
   }
@@ -2041,6 +2576,9 @@ void memory_c::free_write_req(mem_req_s* req)
   STAT_EVENT(AVG_MEMORY_LATENCY_BASE);
   STAT_EVENT_N(AVG_MEMORY_LATENCY, m_cycle - req->m_in);
 
+  if (m_simBase->m_mem_latency)
+    m_simBase->m_mem_latency->record(req, CYCLE);
+
   m_mem_req_pool->release_entry(req);
 }
 
@@ -2120,6 +2658,9 @@ void memory_c::run_a_cycle(bool pll_lock)
 {
   run_a_cycle_uncore(pll_lock);
   ++m_cycle;
+
+  if (m_capacity_sample && m_cycle % m_capacity_sample == 0)
+    sample_capacity();
 }
 
 void memory_c::run_a_cycle_core(int core_id, bool pll_lock)
@@ -2130,6 +2671,9 @@ void memory_c::run_a_cycle_core(int core_id, bool pll_lock)
 
 void memory_c::run_a_cycle_uncore(bool pll_lock)
 {
+  if (!pll_lock && !m_coh_replay.empty())
+    replay_coherence();
+
   int index = m_cycle % m_num_l3;
   for (int ii = index; ii < index + m_num_l3; ++ii) {
     m_l3_cache[ii % m_num_l3]->run_a_cycle(pll_lock);
@@ -2178,6 +2722,8 @@ mem_req_s* memory_c::new_wb_req(Addr addr, int size, bool ptx, dcache_data_s* da
   req->m_core_in                = m_simBase->m_core_cycle[data->m_core_id];
   req->m_dirty                  = true;
   req->m_done                   = false;
+  req->m_coh_state              = data->m_coh_state;
+  req->init_stage(CYCLE);
 
   set_cache_id(req);
   //req->m_cache_id[MEM_L1] = data->m_core_id;
@@ -2215,6 +2761,19 @@ void memory_c::print_mshr(void)
     }
     fprintf(fp, "\n");
   }
+
+  // print coherence transactions
+  if (m_coherence) {
+    fprintf(fp, "== Coherence ==\n");
+    for (auto I = m_coh_txn.begin(), E = m_coh_txn.end(); I != E; ++I) {
+      coh_txn_s* txn = I->second;
+      fprintf(fp, "%-20llx state:%d acks:%d req:%d (%s) start:%llu waiting:%d\n",
+          I->first, txn->m_state, txn->m_acks, (txn->m_req ? txn->m_req->m_id : -1),
+          (txn->m_req ? mem_req_c::mem_state[txn->m_req->m_state] : "NULL"),
+          txn->m_start, (int)txn->m_waiting.size());
+    }
+    fprintf(fp, "replay:%d\n", (int)m_coh_replay.size());
+  }
   fclose(fp);
 }
 
@@ -2238,115 +2797,273 @@ void memory_c::flush_prefetch(int core_id)
 }
 
 
-void memory_c::handle_coherence(int level, bool hit, bool store, Addr addr, dcu_c* cache)
+// requests of CPU cores follow the directory protocol (GPU caches are not coherent)
+bool memory_c::coherent(bool ptx)
 {
-  int state = I_STATE;
+  return m_coherence && !ptx;
+}
 
-  // READ Hit
-  if (!store && hit) {
-    if (level == MEM_L1) {
-      assert(state != I_STATE);
-      // do nothing
-    }
-    else if (level == MEM_L2) {
-      assert(state != I_STATE);
-      if (state == M_STATE) {
-        // L2 : Write-back to memory
-        // L2 -> L1
-        // Update TD L1:S L2:S
-        // Lock TD // Free when L1 insert
-      }
-      else if (state == S_STATE) {
-        // L2 -> L1
-        // Update TD L1:S L2:S
-        // Lock TD // Free when L1 insert
-      }
+
+// grant the requested permission at the home tile (the line is stable)
+static void coh_grant(dcache_data_s* line, mem_req_s* req)
+{
+  uns64 self = 1ULL << req->m_core_id;
+  if (req->m_type == MRT_DSTORE) {
+    line->m_sharers   = self;
+    line->m_coh_state = M_STATE;
+  }
+  else {
+    line->m_sharers  |= self;
+    line->m_coh_state = (line->m_sharers == self && req->m_type != MRT_IFETCH && 
+        req->m_type != MRT_IPRF) ? E_STATE : S_STATE;
+  }
+  req->m_coh_state = line->m_coh_state;
+}
+
+
+// Directory access at the home L3 tile. A line in a transient state blocks every request
+// but the one that started the transaction. Requests that have to wait are taken out of the
+// in_queue and re-inserted (replayed) when the line is stable again.
+bool memory_c::handle_coherence(int home, mem_req_s* req, dcache_data_s* line)
+{
+  Addr line_addr = m_l3_cache[home]->base_addr(req->m_addr);
+  bool store     = (req->m_type == MRT_DSTORE);
+  coh_txn_s* txn = NULL;
+
+  auto I = m_coh_txn.find(line_addr);
+  if (I != m_coh_txn.end()) {
+    txn = I->second;
+    if (txn->m_req != req || txn->m_acks > 0) {
+      STAT_EVENT(COH_BLOCKED_REQ);
+      txn->m_waiting.push_back(req);
+      req->m_state = MEM_COH_WAIT;
+      req->m_queue = NULL;
+      return false;
     }
-    else if (level == MEM_L3) {
-      assert(state != I_STATE);
-      if (state == M_STATE) {
-      }
-      else if (state == S_STATE) {
+
+    // memory fetch already started (retry after a full out_queue)
+    if (txn->m_state == ID_STATE)
+      return true;
+
+    // acks collected : the requester proceeds with the stable line
+    release_coh_txn(line_addr, txn);
+    txn = NULL;
+  }
+
+  // -------------------------------------
+  // L3 miss : block the line until it is filled from memory
+  // -------------------------------------
+  if (line == NULL) {
+    new_coh_txn(line_addr, ID_STATE, req, 0);
+    return true;
+  }
+
+  uns64 others = line->m_sharers & ~(1ULL << req->m_core_id);
+
+  // -------------------------------------
+  // GetM : invalidate all other copies
+  // GetS to an M/E line : the owner downgrades to S (and returns dirty data)
+  // -------------------------------------
+  if (others && (store || line->m_coh_state == M_STATE || line->m_coh_state == E_STATE)) {
+    txn = new_coh_txn(line_addr, store ? MA_STATE : SD_STATE, req, 0);
+    for (int ii = 0; ii < m_num_core; ++ii) {
+      if (others & (1ULL << ii)) {
+        m_l3_cache[home]->send_coherence(
+            new_coh_msg(store ? NOC_COH_INV : NOC_COH_FWD, line_addr, ii, home));
+        ++txn->m_acks;
       }
     }
+    DEBUG("L3[%d] req:%d addr:%s %s to %d cores\n", home, req->m_id, hexstr64s(line_addr), 
+        store ? "invalidation" : "forward", txn->m_acks);
+
+    req->m_state = MEM_COH_WAIT;
+    req->m_queue = NULL;
+    return false;
   }
 
-  // Write Hit
-  if (store && hit) {
-    if (level == MEM_L1) {
-    }
-    else if (level == MEM_L2) {
-    }
-    else if (level == MEM_L3) {
+  coh_grant(line, req);
+  return true;
+}
+
+
+// memory data (or a write-back) has been inserted into the home tile
+void memory_c::coherence_fill(int home, mem_req_s* req, dcache_data_s* line)
+{
+  // write-back (PutM) : the core does not hold the line any more
+  if (req->m_type == MRT_WB) {
+    line->m_sharers &= ~(1ULL << req->m_core_id);
+    if (line->m_sharers == 0)
+      line->m_coh_state = I_STATE;
+    return;
+  }
+
+  coh_grant(line, req);
+
+  Addr line_addr = m_l3_cache[home]->base_addr(req->m_addr);
+  auto I = m_coh_txn.find(line_addr);
+  if (I != m_coh_txn.end() && I->second->m_req == req)
+    release_coh_txn(line_addr, I->second);
+}
+
+
+// The directory entry goes away with the L3 line, so private copies are invalidated.
+// A transaction in progress on the line waits for these acks as well and then replays
+// its requester.
+void memory_c::coherence_evict(int home, Addr line_addr, dcache_data_s* victim)
+{
+  coh_txn_s* txn;
+  auto I = m_coh_txn.find(line_addr);
+  if (I != m_coh_txn.end()) {
+    txn = I->second;
+    // (with all acks in, the requester is already in the replay list)
+    if (txn->m_req && txn->m_acks > 0)
+      txn->m_waiting.push_front(txn->m_req);
+    txn->m_req   = NULL;
+    txn->m_state = IA_STATE;
+  }
+  else if (victim->m_sharers) {
+    txn = new_coh_txn(line_addr, IA_STATE, NULL, 0);
+  }
+  else {
+    return;
+  }
+
+  for (int ii = 0; ii < m_num_core; ++ii) {
+    if (victim->m_sharers & (1ULL << ii)) {
+      STAT_EVENT(COH_BACK_INV_MSG);
+      m_l3_cache[home]->send_coherence(new_coh_msg(NOC_COH_INV, line_addr, ii, home));
+      ++txn->m_acks;
     }
   }
 
-  // Read Miss
-  if (!store && !hit && level == MEM_L3) {
+  if (txn->m_acks == 0)
+    release_coh_txn(line_addr, txn);
+}
+
+
+void memory_c::coherence_ack(int home, mem_req_s* msg, dcache_data_s* line)
+{
+  STAT_EVENT(msg->m_msg_type == NOC_COH_DATA ? COH_DATA_MSG : COH_ACK_MSG);
+
+  // the directory transaction lives at the tile that sent the invalidation/forward
+  ASSERTM(home == msg->m_cache_id[MEM_L3] && 
+      home == static_cast<int>(BANK(msg->m_addr, m_num_l3, m_l3_interleave_factor)), 
+      "addr:%s ack at L3[%d], home L3[%d]\n", hexstr64s(msg->m_addr), home, 
+      msg->m_cache_id[MEM_L3]);
+
+  uns64 sharer = 1ULL << msg->m_core_id;
+  if (line) {
+    line->m_dirty |= msg->m_dirty;
+    if (msg->m_coh_state == S_STATE)
+      line->m_sharers |= sharer;
+    else
+      line->m_sharers &= ~sharer;
   }
 
-  // Write Miss
-  if (store && !hit && level == MEM_L3) {
+  auto I = m_coh_txn.find(msg->m_addr);
+  ASSERTM(I != m_coh_txn.end(), "addr:%s no directory transaction\n", hexstr64s(msg->m_addr));
+  coh_txn_s* txn = I->second;
+  if (--txn->m_acks > 0)
+    return;
+
+  if (txn->m_state == IA_STATE) {
+    release_coh_txn(msg->m_addr, txn);
+    return;
   }
+
+  // stable again : the requester goes first, the transaction ends when it is replayed
+  ASSERT(line != NULL);
+  line->m_coh_state = line->m_sharers ? S_STATE : I_STATE;
+  m_coh_replay.push_front(txn->m_req);
 }
 
-#if 0
-void memory_c::handle_coherence()
+
+// Lines held in the private caches and the L3. A line in several caches counts once in the
+// effective capacity; the difference is the capacity lost to duplication.
+void memory_c::sample_capacity(void)
 {
-  if (*KNOB(KNOB_ENABLE_CACHE_COHERENCE) == false)
-    return ;
+  vector<Addr> addrs;
+  unordered_set<Addr> unique;
+  Counter private_lines;
 
-  // assume that all write-back requests are in M-state (single-copy in the system)
-  if (write_back == true)
-    return ;
+  for (int ii = 0; ii < m_num_core; ++ii) {
+    m_l1_cache[ii]->get_line_addrs(addrs);
+    m_l2_cache[ii]->get_line_addrs(addrs);
+  }
+  private_lines = addrs.size();
 
-  int state = m_memory->get_td_state(req->m_addr); 
-  if (m_level == MEM_L3) {
-    // L3 Read Miss
-    if (!store) {
-      if (state == COHE_M) {
-        // TD -> M-state block : forward-data-cmd
-        // M-state block -> Memory controller : write-back
-        // M-state block -> Requestor : forward-data
-        // Requestor -> TD : confirmation
-        // Update TD
-      }
-      else if (state == COHE_S) {
-        // TD -> any S-state block : forward-data-cmd
-        // Any S-state block -> Requestor : forward-data
-        // Requestor -> TD : confirmation
-        // Update TD
-      }
-      else if (state == COHE_I) {
-        // Memory controller -> L1, L2, L3 : provide-data
-        // L1 -> TD : confirmation
-        // Update TD
-      }
-    }
-    // L3 Write Miss
-    else {
-      if (state == COHE_M) {
-        // TD -> M-state block : forward data cmd
-        // M-state block -> requestor : forward data / invalidate self
-        // Requestor -> TD : confirmation
-        // Update TD
-      }
-      else if (state == COHE_S) {
-        // TD -> one S-state block : forward data cmd
-        // TD -> all S-state blocks : invalidation
-        // One S-state block -> requestor : forward data / invalidate self
-        // Requestor -> TD : confirmation
-        // Update TD
-      }
-      else if (state == COHE_I) {
-        // Memory controller -> L1 : provide-data
-        // L1 -> TD : confirmation
-        // Update TD
-      }
-    }
+  for (int ii = 0; ii < m_num_l3; ++ii) {
+    m_l3_cache[ii]->get_line_addrs(addrs);
+  }
+
+  unique.insert(addrs.begin(), addrs.end());
+
+  STAT_EVENT(CACHE_CAPACITY_SAMPLE);
+  STAT_EVENT_N(CACHE_PRIVATE_LINES, private_lines);
+  STAT_EVENT_N(CACHE_LLC_LINES, addrs.size() - private_lines);
+  STAT_EVENT_N(CACHE_DUPLICATE_LINES, addrs.size() - unique.size());
+  STAT_EVENT_N(CACHE_EFFECTIVE_LINES, unique.size());
+}
+
+
+mem_req_s* memory_c::new_coh_msg(int msg_type, Addr line_addr, int core_id, int home)
+{
+  STAT_EVENT(msg_type == NOC_COH_INV ? COH_INV_MSG : COH_FWD_MSG);
+
+  mem_req_s* msg = new mem_req_s(m_simBase);
+  msg->m_id        = m_unique_id++;
+  msg->m_type      = MRT_COH;
+  msg->m_priority  = g_mem_priority[MRT_COH];
+  msg->m_msg_type  = msg_type;
+  msg->m_addr      = line_addr;
+  msg->m_size      = m_l3_cache[home]->line_size();
+  msg->m_core_id   = core_id;
+  msg->m_in        = m_cycle;
+  msg->m_in_global = CYCLE;
+  msg->m_cache_id[MEM_L1] = core_id;
+  msg->m_cache_id[MEM_L2] = core_id;
+  msg->m_cache_id[MEM_L3] = home;
+
+  return msg;
+}
+
+
+coh_txn_s* memory_c::new_coh_txn(Addr line_addr, int state, mem_req_s* req, int acks)
+{
+  coh_txn_s* txn = new coh_txn_s;
+  txn->m_state = state;
+  txn->m_acks  = acks;
+  txn->m_req   = req;
+  txn->m_start = CYCLE;
+  m_coh_txn[line_addr] = txn;
+
+  return txn;
+}
+
+
+void memory_c::release_coh_txn(Addr line_addr, coh_txn_s* txn)
+{
+  if (txn->m_state != ID_STATE) {
+    STAT_EVENT(COH_TXN_LATENCY_BASE);
+    STAT_EVENT_N(COH_TXN_LATENCY, CYCLE - txn->m_start);
+  }
+
+  m_coh_replay.splice(m_coh_replay.end(), txn->m_waiting);
+  m_coh_txn.erase(line_addr);
+  delete txn;
+}
+
+
+void memory_c::replay_coherence(void)
+{
+  for (auto I = m_coh_replay.begin(); I != m_coh_replay.end(); ) {
+    mem_req_s* req = *I;
+    if (m_l3_cache[req->m_cache_id[MEM_L3]]->insert(req))
+      I = m_coh_replay.erase(I);
+    else
+      ++I;
   }
 }
-#endif
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
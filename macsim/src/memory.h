@@ -53,13 +53,44 @@ POSSIBILITY OF SUCH DAMAGE.
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief MESI states. Private caches keep the state of their copy; the L3 (home) keeps the
+/// directory state of the line. Transient states only exist in the directory transactions.
+///////////////////////////////////////////////////////////////////////////////////////////////
 enum COHERENCE_STATE {
   I_STATE,
   M_STATE,
   S_STATE,
+  E_STATE,
+  ID_STATE,  /**< home : memory fetch outstanding, line not in the L3 yet */
+  SD_STATE,  /**< home : owner forwarded a GetS, waiting for its data/ack (M/E -> S) */
+  MA_STATE,  /**< home : GetM, waiting for invalidation acks (-> M) */
+  IA_STATE,  /**< home : L3 victim, waiting for back-invalidation acks (-> not present) */
 }; 
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Inclusion policy of a cache level towards the levels above it
+///////////////////////////////////////////////////////////////////////////////////////////////
+enum INCLUSION_POLICY {
+  INCL_NON_INCLUSIVE, /**< no inclusion property (default) */
+  INCL_INCLUSIVE,     /**< victims back-invalidate the copies in the upper levels */
+  INCL_EXCLUSIVE,     /**< hits move the line up, upper-level victims are inserted */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Directory transaction : a line in a transient state at its home L3 tile
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct coh_txn_s {
+  int        m_state;   /**< transient state */
+  int        m_acks;    /**< outstanding acknowledgements */
+  mem_req_s* m_req;     /**< request that started the transaction (NULL : L3 eviction) */
+  Counter    m_start;   /**< start cycle */
+  list<mem_req_s*> m_waiting; /**< requests blocked on the line, in arrival order */
+} coh_txn_s;
+
+
 bool IsStore(Mem_Type type);
 bool IsLoad(Mem_Type type);
 bool dcache_fill_line_wrapper(mem_req_s *req);
@@ -74,6 +105,9 @@ typedef struct dcache_data_s {
   int     m_core_id;            /**< core id */
   Addr    m_pc;                 /**< pc address */
   int     m_tid;                /**< thread id */
+  uns8    m_coh_state;          /**< coherence state (L3 : directory state) */
+  uns64   m_sharers;            /**< L3 : directory sharer vector, one bit per core */
+  uns8    m_prefetcher_id;      /**< hw prefetcher that brought the line, until its first use (0 : none) */
 } dcache_data_s;
 
 
@@ -84,16 +118,12 @@ typedef struct dcache_data_s {
 class queue_c
 {
   /**
-   * Queue sort function based on the priority
+   * Queue sort functions based on the priority. One of them is picked at construction
+   * from the heterogeneous memory priority knobs.
    */
-  struct sort_func {
-    macsim_c* m_simBase; /**< pointer to the base simulation class */
-    /**
-     * Assign a base class pointer
-     */
-    sort_func(macsim_c* simBase) {m_simBase = simBase;}; 
-    bool operator()(mem_req_s* a, mem_req_s* b); /**< comparison function */
-  }; /**< sort function */
+  static bool sort_by_priority(mem_req_s* a, mem_req_s* b); /**< request priority only */
+  static bool sort_cpu_first(mem_req_s* a, mem_req_s* b); /**< cpu requests first */
+  static bool sort_gpu_first(mem_req_s* a, mem_req_s* b); /**< gpu requests first */
 
   public:
     /**
@@ -131,6 +161,11 @@ class queue_c
      */
     bool full();
 
+    /**
+     * Number of free entries
+     */
+    unsigned int space();
+
   private:
     queue_c(); //Do not implement
 
@@ -139,6 +174,7 @@ class queue_c
 
   private:
     unsigned int m_size; /**< queue size */
+    bool (*m_sort_func)(mem_req_s*, mem_req_s*); /**< sort function */
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
 
 };
@@ -257,6 +293,17 @@ class dcu_c
      */
     void receive_packet(void);
 
+    /**
+     * Collect the base addresses of the valid lines (none if disabled)
+     */
+    void get_line_addrs(vector<Addr>& addrs);
+
+    /**
+     * Queue a coherence message to be sent (L2 : acks to the home, L3 : invalidations and
+     * forwards to the private caches)
+     */
+    void send_coherence(mem_req_s* msg);
+
   private:
     /**
      * data cache default constructor
@@ -283,12 +330,48 @@ class dcu_c
      */
     void process_wb_queue();
 
+    /**
+     * Send queued coherence messages to the NoC
+     */
+    void process_coh_queue();
+
+    /**
+     * Handle a received coherence message
+     * @return false, if it cannot be handled in this cycle
+     */
+    bool receive_coherence(mem_req_s* msg);
+
+    /**
+     * Inclusive L2 : invalidate the L1 copy of a victim (its dirty data goes with the victim)
+     */
+    void back_invalidate_l1(Addr line_addr, dcache_data_s* victim, int appl_id);
+
+    /**
+     * Inclusive L3 : check whether a private cache in the presence vector of a line still
+     * holds it. Stale presence bits are cleared.
+     */
+    bool query_private(Addr line_addr, dcache_data_s* line, int appl_id);
+
+    /**
+     * Inclusive L3 : query-based victim selection. A victim candidate still held in a private
+     * cache is promoted instead, for up to l3_inclusion_qbs queries per insertion.
+     */
+    void select_inclusion_victim(mem_req_s* req);
+
+    /**
+     * Handle a line replaced by a fill : write-back, inclusion and coherence actions
+     */
+    void evict_line(mem_req_s* req, Addr victim_line_addr, dcache_data_s* data, bool coherent);
+
   private:
     int       m_id; /**< cache id */
     int       m_noc_id; /**< cache network id */
     int       m_level; /**< cache level (L1, L2, L3, or memory controller) */
     bool      m_disable; /**< disabled */
     bool      m_bypass; /**< bypass cache */
+    int       m_inclusion; /**< inclusion policy towards the upper levels (INCL_*) */
+    bool      m_clean_wb; /**< clean victims are written back as well (exclusive next level) */
+    unsigned  m_max_victims; /**< most lines replaced by one fill (write-back queue space) */
     cache_c*  m_cache; /**< cache structure */
     port_c**  m_port; /**< cache port */
     int       m_next_id; /**< next-level cache id */
@@ -310,6 +393,7 @@ class dcu_c
     queue_c*  m_wb_queue; /**< write-back queue */
     queue_c*  m_fill_queue; /**< fill queue */
     queue_c*  m_out_queue; /**< out queue */
+    list<mem_req_s*> m_coh_queue; /**< outgoing coherence messages (own buffer, never full) */
     bool      m_req_llc_bypass; /**< bypass llc */
     int       m_num_read_port; /**< number of read ports */
     int       m_num_write_port; /**< number of write ports */
@@ -471,9 +555,44 @@ class memory_c
     void init(void);
 
     /**
-     * Handle coherence traffic (currently empty, will support coherence soon)
+     * Check whether requests of a core type take part in the coherence protocol
+     */
+    bool coherent(bool ptx);
+
+    /**
+     * Directory access of a request at its home L3 tile (line: NULL on L3 miss).
+     * Grants the permission or starts invalidations/forwards.
+     * @return true, if the request can proceed
+     * @return false, if it waits on a directory transaction (removed from the in_queue)
      */
-    void handle_coherence(int level, bool hit, bool store, Addr addr, dcu_c* cache);
+    bool handle_coherence(int home, mem_req_s* req, dcache_data_s* line);
+
+    /**
+     * A request filled its home L3 tile from memory : grant and unblock the line
+     */
+    void coherence_fill(int home, mem_req_s* req, dcache_data_s* line);
+
+    /**
+     * An L3 line with private copies is replaced : back-invalidate the sharers
+     */
+    void coherence_evict(int home, Addr line_addr, dcache_data_s* victim);
+
+    /**
+     * An invalidation/forward acknowledgement arrived at the home L3 tile
+     * @param home - L3 tile that received the acknowledgement (checked to be the home tile)
+     * @param line - L3 line (NULL : already replaced)
+     */
+    void coherence_ack(int home, mem_req_s* msg, dcache_data_s* line);
+
+    /**
+     * Generate a coherence message
+     */
+    mem_req_s* new_coh_msg(int msg_type, Addr line_addr, int core_id, int home);
+
+    /**
+     * Sample the lines held in the private L2s and the L3 (inclusion_sample_interval)
+     */
+    void sample_capacity(void);
     
 
   public:
@@ -522,6 +641,21 @@ class memory_c
      */
     void flush_prefetch(int core_id);
 
+    /**
+     * Start a directory transaction on a line
+     */
+    coh_txn_s* new_coh_txn(Addr line_addr, int state, mem_req_s* req, int acks);
+
+    /**
+     * End a directory transaction and replay the requests blocked on the line
+     */
+    void release_coh_txn(Addr line_addr, coh_txn_s* txn);
+
+    /**
+     * Re-insert unblocked requests into their home L3 tile
+     */
+    void replay_coherence(void);
+
 
 
   protected:
@@ -543,8 +677,10 @@ class memory_c
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
 
     // cache coherence
-    unordered_map<Addr, vector<bool>*> m_tag_directory; /**< oracle cache coherence table */
-    unordered_map<Addr, bool> m_td_pending_req; /**< pending requests in tag directory */
+    bool m_coherence; /**< directory MESI protocol enabled */
+    unordered_map<Addr, coh_txn_s*> m_coh_txn; /**< lines in a transient state */
+    list<mem_req_s*> m_coh_replay; /**< unblocked requests to re-insert into the L3 */
+    Counter m_capacity_sample; /**< capacity sampling interval (0 : off) */
 
     Counter m_cycle; /**< clock cycle */
     pool_c<mem_req_s> *m_mem_req_pool; /**< pool for write requests in ptx simulations */
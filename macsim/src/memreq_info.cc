@@ -52,6 +52,7 @@ const char* mem_req_c::mem_req_type_name[MAX_MEM_REQ_TYPE] = {
   "SW_DPRF_T0",
   "SW_DPRF_T1",
   "SW_DPRF_T2",
+  "COH",
 };
 
 
@@ -73,6 +74,21 @@ const char* mem_req_c::mem_state[MEM_STATE_MAX] = {
   "MEM_DRAM_DONE",
   "MEM_NOC_START",
   "MEM_NOC_DONE",
+  "MEM_COH_WAIT",
+};
+
+
+// memory request lifecycle stage string
+const char* mem_req_c::mem_stage[MEM_STAGE_MAX] = {
+  "NEW",
+  "MSHR",
+  "L1_QUEUE",
+  "L2_QUEUE",
+  "L3_QUEUE",
+  "NOC",
+  "DRAM_QUEUE",
+  "DRAM",
+  "FILL",
 };
 
 
@@ -114,6 +130,18 @@ void mem_req_s::init(void)
   m_msg_dst        = 0;
   m_done_func      = NULL;
   m_bypass         = 0;
+  m_service_level  = 0;
+  m_coh_state      = 0;
+  init_stage(0);
+}
+
+
+void mem_req_s::init_stage(Counter cycle)
+{
+  m_stage         = MEM_STAGE_NEW;
+  m_stage_start   = cycle;
+  for (int ii = 0; ii < MEM_STAGE_MAX; ++ii)
+    m_stage_cycles[ii] = 0;
 }
 
 
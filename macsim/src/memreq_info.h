@@ -71,6 +71,10 @@ enum NOC_TYPE {
   NOC_ACK,
   NOC_NEW,
   NOC_NEW_WITH_DATA,
+  NOC_COH_INV,       /**< directory -> private cache : invalidate */
+  NOC_COH_FWD,       /**< directory -> owner : downgrade to S */
+  NOC_COH_ACK,       /**< private cache -> directory : acknowledgement */
+  NOC_COH_DATA,      /**< private cache -> directory : acknowledgement with dirty data */
   NOC_LAST,
   MAX_NOC_STATE,
 };
@@ -97,11 +101,31 @@ typedef enum Mem_Req_State_enum {
   MEM_DRAM_DONE,
   MEM_NOC_START,
   MEM_NOC_DONE,
+  MEM_COH_WAIT,
   MEM_STATE_MAX,
 } Mem_Req_State;
 
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Memory request lifecycle stage (where the request spends its cycles)
+///
+/// if you change this order or add anything, fix mem_stage[] in memreq_info.cc
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum Mem_Req_Stage_enum {
+  MEM_STAGE_NEW,         /**< allocated, not queued yet */
+  MEM_STAGE_MSHR,        /**< L1 MSHR : merged into an in-flight request, waiting for it */
+  MEM_STAGE_L1_QUEUE,    /**< L1 input queue */
+  MEM_STAGE_L2_QUEUE,    /**< L2 input queue */
+  MEM_STAGE_L3_QUEUE,    /**< L3 input queue */
+  MEM_STAGE_NOC,         /**< output queue and interconnection network */
+  MEM_STAGE_DRAM_QUEUE,  /**< DRAM request buffer, before the first command */
+  MEM_STAGE_DRAM,        /**< DRAM service, first command to data */
+  MEM_STAGE_FILL,        /**< fill queues on the way back */
+  MEM_STAGE_MAX,
+} Mem_Req_Stage;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Memory request type
 ///
@@ -120,6 +144,7 @@ typedef enum Mem_Req_Type_enum {
   MRT_SW_DPRF_T0,
   MRT_SW_DPRF_T1,
   MRT_SW_DPRF_T2,
+  MRT_COH,
   MAX_MEM_REQ_TYPE,
 } Mem_Req_Type;
 
@@ -144,6 +169,21 @@ typedef struct mem_req_s {
   mem_req_s(macsim_c* simBase);
   void init(void);
 
+  /**
+   * Start the lifecycle at cycle (stage NEW, all stage times cleared)
+   */
+  void init_stage(Counter cycle);
+
+  /**
+   * Move to a new lifecycle stage; time since the last transition goes to the current one.
+   */
+  inline void set_stage(Mem_Req_Stage stage, Counter cycle)
+  {
+    m_stage_cycles[m_stage] += cycle - m_stage_start;
+    m_stage       = stage;
+    m_stage_start = cycle;
+  }
+
   int           m_id;           /**< unique request id */                         
   int           m_appl_id;      /**< application id */
   int           m_core_id;      /**< core id */
@@ -176,6 +216,11 @@ typedef struct mem_req_s {
   bool          m_skip;         /**< llc skip bit */ 
   int           m_noc_type;     /**< noc request type: req or reply */
   Counter       m_noc_cycle;    /**< noc start cycle */
+  Mem_Req_Stage m_stage;        /**< current lifecycle stage */
+  Counter       m_stage_start;  /**< cycle the current stage was entered */
+  Counter       m_stage_cycles[MEM_STAGE_MAX]; /**< cycles spent in each stage */
+  int           m_service_level; /**< level that serviced the request (0: none yet) */
+  int           m_coh_state;    /**< coherence state granted by the directory (fills, acks) */
   macsim_c*     m_simBase;      /**< reference to macsim base class for sim globals */
   
   function<bool (mem_req_s*)> m_done_func; /**< done function */
@@ -190,6 +235,7 @@ class mem_req_c {
   public:
     static const char* mem_req_type_name[MAX_MEM_REQ_TYPE]; /**< memory request type string */
     static const char* mem_state[MEM_STATE_MAX];            /**< memory request state string */
+    static const char* mem_stage[MEM_STAGE_MAX];            /**< lifecycle stage string */
     
 };
 
@@ -165,6 +165,8 @@ router_c::router_c(macsim_c* simBase, int type, int id, int num_port)
   m_arbitration_policy  = *KNOB(KNOB_ARBITRATION_POLICY);
   m_link_width          = *KNOB(KNOB_LINK_WIDTH);
   m_num_vc_cpu          = *KNOB(KNOB_CPU_VC_PARTITION);
+  m_ideal_noc           = CONFIG(m_ideal_noc);
+  m_ideal_noc_latency   = CONFIG(m_ideal_noc_latency);
   m_next_vc             = 0;
   
   // link setting
@@ -277,7 +279,7 @@ void router_c::run_a_cycle(bool pll_lock)
     return;
   }
 
-  if (*KNOB(KNOB_IDEAL_NOC)) {
+  if (m_ideal_noc) {
     stage_vca();
     stage_rc();
     local_packet_injection();
@@ -334,10 +336,11 @@ void router_c::local_packet_injection(void)
 
       assert(req);
       int num_flit = 1;
-      if ((req->m_msg_type == NOC_NEW_WITH_DATA) || (req->m_msg_type == NOC_FILL)) 
+      if ((req->m_msg_type == NOC_NEW_WITH_DATA) || (req->m_msg_type == NOC_FILL) ||
+          (req->m_msg_type == NOC_COH_DATA)) 
         num_flit += req->m_size / m_link_width; 
 
-      if (*KNOB(KNOB_IDEAL_NOC))
+      if (m_ideal_noc)
         num_flit = 1;
 
 
@@ -420,7 +423,7 @@ void router_c::local_packet_injection(void)
 
 void router_c::stage_vca(void)
 {
-  if (*KNOB(KNOB_IDEAL_NOC)) {
+  if (m_ideal_noc) {
     for (int ip = 0; ip < m_num_port; ++ip) {
       for (int ivc = 0; ivc < m_num_vc; ++ivc) {
         if (m_input_buffer[ip][ivc].empty()) {
@@ -428,7 +431,7 @@ void router_c::stage_vca(void)
         }
 
         flit_c* flit = m_input_buffer[ip][ivc].front();
-        if (flit->m_state != RC || flit->m_timestamp + *KNOB(KNOB_IDEAL_NOC_LATENCY) > m_cycle) {
+        if (flit->m_state != RC || flit->m_timestamp + m_ideal_noc_latency > m_cycle) {
           continue;
         }
         // insert to next router
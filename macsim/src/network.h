@@ -255,6 +255,8 @@ class router_c
     int* m_total_packet; /**< number of total packets (global) */
     bool m_enable_vc_partition; /**< enable virtual channel partition */
     int m_num_vc_cpu; /**< number of vcs for CPU */
+    bool m_ideal_noc; /**< ideal network (fixed latency, no contention) */
+    int m_ideal_noc_latency; /**< ideal network latency */
     int m_next_vc; /**<id of next vc for local packet injection */
  
     // pools for data structure
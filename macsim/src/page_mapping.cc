@@ -33,6 +33,7 @@ POSSIBILITY OF SUCH DAMAGE.
  * Date         : 2/25/2013
  * Description  : Virtual-to-Physical Page Mapping
  *********************************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include "page_mapping.h"
@@ -42,8 +43,114 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "debug_macros.h"
 #include "assert_macros.h"
 
+#include "all_knobs.h"
+
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////
+// Flat Page Table
+//////////////////////////////////////////////////////////////////////
+
+// Constructor
+PageTable::PageTable()
+  : m_capacity(1024), m_mask(1023), m_hash_shift(64 - 10), m_size(0)
+{
+  m_vpn = new uint64_t[m_capacity];
+  m_ppn = new uint64_t[m_capacity];
+  std::fill_n(m_vpn, m_capacity, EMPTY);
+}
+
+// Destructor
+PageTable::~PageTable()
+{
+  delete[] m_vpn;
+  delete[] m_ppn;
+}
+
+// linear probing from the hashed slot
+bool PageTable::find(uint64_t vpn, uint64_t* ppn)
+{
+  for (uint64_t slot = hash(vpn); ; slot = (slot + 1) & m_mask) {
+    if (m_vpn[slot] == vpn) {
+      *ppn = m_ppn[slot];
+      return true;
+    }
+    if (m_vpn[slot] == EMPTY) 
+      return false;
+  }
+}
+
+// the table is kept at most half full so probe chains stay short
+void PageTable::insert(uint64_t vpn, uint64_t ppn)
+{
+  if ((m_size + 1) * 2 > m_capacity) 
+    grow();
+
+  uint64_t slot = hash(vpn);
+  while (m_vpn[slot] != EMPTY && m_vpn[slot] != vpn) 
+    slot = (slot + 1) & m_mask;
+
+  if (m_vpn[slot] == EMPTY) 
+    ++m_size;
+
+  m_vpn[slot] = vpn;
+  m_ppn[slot] = ppn;
+}
+
+// rehash all mappings into a table twice as large
+void PageTable::grow()
+{
+  uint64_t* old_vpn = m_vpn;
+  uint64_t* old_ppn = m_ppn;
+  uint64_t old_capacity = m_capacity;
+
+  m_capacity *= 2;
+  m_mask = m_capacity - 1;
+  --m_hash_shift;
+  m_vpn = new uint64_t[m_capacity];
+  m_ppn = new uint64_t[m_capacity];
+  std::fill_n(m_vpn, m_capacity, EMPTY);
+
+  for (uint64_t ii = 0; ii < old_capacity; ++ii) {
+    if (old_vpn[ii] == EMPTY) 
+      continue;
+
+    uint64_t slot = hash(old_vpn[ii]);
+    while (m_vpn[slot] != EMPTY) 
+      slot = (slot + 1) & m_mask;
+    m_vpn[slot] = old_vpn[ii];
+    m_ppn[slot] = old_ppn[ii];
+  }
+
+  delete[] old_vpn;
+  delete[] old_ppn;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Page Mapper
+//////////////////////////////////////////////////////////////////////
+
+// Constructor
+PageMapper::PageMapper(macsim_c* simBase, uint32_t page_size, uint64_t physical_tag)
+  : m_simBase(simBase), m_page_size(page_size), m_physical_tag(physical_tag)
+{
+  ASSERTM((page_size & (page_size - 1)) == 0, "The page size should be a power of two.\n");
+  m_page_shift = (int)log2(m_page_size);
+
+  m_num_tlb = *KNOB(KNOB_NUM_SIM_CORES);
+  m_tlb = new TlbEntry[m_num_tlb * TLB_SIZE];
+  for (int ii = 0; ii < m_num_tlb * TLB_SIZE; ++ii) {
+    m_tlb[ii].m_vpn = ~0ULL;
+    m_tlb[ii].m_ppn = 0;
+  }
+}
+
+// Destructor
+PageMapper::~PageMapper()
+{
+  delete[] m_tlb;
+}
+
 //////////////////////////////////////////////////////////////////////
 // First-Come-First-Serve Page Mapper
 //////////////////////////////////////////////////////////////////////
@@ -62,31 +169,30 @@ FCFSPageMapper::~FCFSPageMapper()
 
 // This function provides a physical address (not ppn) for a given virtual address.
 // If there does not exist mapping for the virtual address, a new ppn is allocated and we return it.
-uint64_t FCFSPageMapper::translate(uint64_t virtual_address)
+uint64_t FCFSPageMapper::translate(uint64_t virtual_address, int core_id)
 {
+  uint64_t physical_address;
+  if (tlbLookup(virtual_address, core_id, &physical_address))
+    return physical_address;
+
   // get virtual page number (vpn) and offset for the given virtual address
-  uint64_t vpn    = virtual_address >> (int)log2(m_page_size);
+  uint64_t vpn    = virtual_address >> m_page_shift;
   uint64_t offset = virtual_address & (m_page_size - 1);
 
-  std::map<uint64_t, uint64_t>::iterator it;
-  it = m_page_table.find(vpn);    // see if there is a matching entry
-
-  if (it == m_page_table.end())
+  uint64_t ppn;
+  if (!m_page_table.find(vpn, &ppn))    // see if there is a matching entry
   {
     // did not find a matching entry. allocate a new ppn to this vpn
-    uint64_t physical_address = (m_physical_tag << (int)log2(m_page_size)) | offset;
-    m_page_table[vpn] = m_physical_tag++;
+    ppn = m_physical_tag++;
+    m_page_table.insert(vpn, ppn);
 
     // increment the number of pages allocated
     STAT_EVENT(NUM_PHYSICAL_PAGES);
-
-    return physical_address;
-  }
-  else
-  {
-    // there already exists a PPN entry for the virtual address, so just use it
-    return (it->second << (int)log2(m_page_size)) | offset;
   }
+
+  tlbFill(vpn, ppn, core_id);
+
+  return (ppn << m_page_shift) | offset;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -100,6 +206,8 @@ RegionBasedFCFSPageMapper::RegionBasedFCFSPageMapper(
 {
   REPORT("## Region-based FCFS virtual to physical translation enabled");
   ASSERTM(region_size >= page_size, "The page size should be smaller than the region size.\n");
+  ASSERTM((region_size & (region_size - 1)) == 0, "The region size should be a power of two.\n");
+  m_region_shift = (int)log2(m_region_size);
 }
 
 // Destructor
@@ -109,49 +217,52 @@ RegionBasedFCFSPageMapper::~RegionBasedFCFSPageMapper()
 
 // This function provides a physical address (not ppn) for a given virtual address.
 // If there does not exist mapping for the virtual address, a new ppn is allocated and we return it.
-uint64_t RegionBasedFCFSPageMapper::translate(uint64_t virtual_address)
+uint64_t RegionBasedFCFSPageMapper::translate(uint64_t virtual_address, int core_id)
 {
+  uint64_t physical_address;
+  if (tlbLookup(virtual_address, core_id, &physical_address))
+    return physical_address;
+
   // get virtual region and offset for the given virtual address
-  uint64_t vpn    = virtual_address >> (int)log2(m_page_size);
-  uint64_t region = virtual_address >> (int)log2(m_region_size);
+  uint64_t vpn    = virtual_address >> m_page_shift;
+  uint64_t region = virtual_address >> m_region_shift;
 
   uint64_t offset = virtual_address & (m_region_size - 1); // region offset
 
-  std::map<uint64_t, uint64_t>::iterator it;
-  it = m_region_table.find(region);    // see if this region is touched before
-
-  if (it == m_region_table.end())
+  uint64_t physical_region;
+  if (!m_region_table.find(region, &physical_region))    // see if this region is touched before
   {
     // did not find a matching entry. allocate a new region to this vpn
-    uint64_t physical_address = (m_physical_tag << (int)log2(m_region_size)) | offset;
-    m_region_table[region] = m_physical_tag++;
+    physical_region = m_physical_tag++;
+    m_region_table.insert(region, physical_region);
+
+    physical_address = (physical_region << m_region_shift) | offset;
 
     // maintain a separate page table for later use
-    m_page_table[vpn] = physical_address >> (int)log2(m_page_size);
+    m_page_table.insert(vpn, physical_address >> m_page_shift);
 
     // increment the number of pages allocated
     STAT_EVENT(NUM_PHYSICAL_PAGES);
-
-    return physical_address;
   }
   else
   {
     // There already exists a physical region for this virtual region, so we can know the 
     // physical address. But, the corresponding physical address may not be new one in this region.
     // We maintain the page table for later use.
-    uint64_t physical_address = (it->second << (int)log2(m_region_size)) | offset;
+    physical_address = (physical_region << m_region_shift) | offset;
 
-    it = m_page_table.find(vpn);
-
-    if (it == m_page_table.end())
+    uint64_t mapped_ppn;
+    if (!m_page_table.find(vpn, &mapped_ppn))
     {
       // put the ppn corresponding to the vpn of this virtual address
-      m_page_table[vpn] = physical_address >> (int)log2(m_page_size);
-
+      m_page_table.insert(vpn, physical_address >> m_page_shift);
       // increment the number of pages allocated
       STAT_EVENT(NUM_PHYSICAL_PAGES);
     }
-
-    return physical_address;
   }
+
+  uint64_t ppn = physical_address >> m_page_shift;
+  tlbFill(vpn, ppn, core_id);
+
+  return physical_address;
 }
@@ -37,25 +37,85 @@ POSSIBILITY OF SUCH DAMAGE.
 #define PAGE_MAPPING_H_INCLUDED
 
 #include <cmath>
-#include <map>
+#include <stdint.h>
 
 #include "macsim.h"
 
+///////////////////////////////////////////////////////////////////////////////
+//! Flat page table : open-addressing hash from a virtual page (or region) number 
+//! to a physical page (or region) number. A lookup is one or two probes in the
+//! common case instead of a red-black tree walk.
+///////////////////////////////////////////////////////////////////////////////
+class PageTable
+{
+  public:
+    PageTable();
+    ~PageTable();
+
+    bool find(uint64_t vpn, uint64_t* ppn);         //!< find the mapping of a virtual page
+    void insert(uint64_t vpn, uint64_t ppn);        //!< add a new mapping
+    uint64_t size() { return m_size; }              //!< number of mappings
+
+  private:
+    uint64_t hash(uint64_t vpn) { return (vpn * 0x9E3779B97F4A7C15ULL) >> m_hash_shift; }
+    void grow();                                    //!< double the table
+
+  private:
+    static const uint64_t EMPTY = ~0ULL;            //!< empty slot marker
+
+    uint64_t* m_vpn;                                //!< virtual page numbers
+    uint64_t* m_ppn;                                //!< physical page numbers
+    uint64_t  m_capacity;                           //!< number of slots (power of two)
+    uint64_t  m_mask;                               //!< m_capacity - 1
+    int       m_hash_shift;                         //!< 64 - log2(m_capacity)
+    uint64_t  m_size;                               //!< number of mappings
+};
+
 class PageMapper
 {
   public:
-    virtual ~PageMapper() {}
-    virtual uint64_t translate(uint64_t virtual_address) = 0;
+    virtual ~PageMapper();
+    virtual uint64_t translate(uint64_t virtual_address, int core_id) = 0;
     uint64_t getNumPhysicalPages() { return m_page_table.size(); }  //!< get the number of physical pages allocated
 
   protected:
+    //! software TLB : per-core direct-mapped memo of recent vpn -> ppn translations
+    struct TlbEntry 
+    {
+      uint64_t m_vpn;                               //!< virtual page number
+      uint64_t m_ppn;                               //!< physical page number
+    };
+    static const int TLB_SIZE = 64;                 //!< memo entries per core
+
     macsim_c* m_simBase;                            //!< macsim base class for simulation globals
-    std::map<uint64_t, uint64_t> m_page_table;      //!< page table (virtual page && physical page)
+    PageTable m_page_table;                         //!< page table (virtual page && physical page)
     uint32_t m_page_size;                           //!< page size (4KB default)
+    int m_page_shift;                               //!< log2(page size)
     uint64_t m_physical_tag;                        //!< physical page/region number allocated to a new virtual page/region
-
-    PageMapper(macsim_c* simBase, uint32_t page_size, uint64_t physical_tag)
-      : m_simBase(simBase), m_page_size(page_size), m_physical_tag(physical_tag) {} 
+    TlbEntry* m_tlb;                                //!< translation memo, TLB_SIZE entries per core
+    int m_num_tlb;                                  //!< number of per-core memos
+
+    PageMapper(macsim_c* simBase, uint32_t page_size, uint64_t physical_tag);
+
+    //! look up the memo of a core; on a hit, return the physical address
+    bool tlbLookup(uint64_t virtual_address, int core_id, uint64_t* physical_address)
+    {
+      uint64_t vpn = virtual_address >> m_page_shift;
+      TlbEntry* entry = &m_tlb[(core_id % m_num_tlb) * TLB_SIZE + (vpn & (TLB_SIZE - 1))];
+      if (entry->m_vpn != vpn) 
+        return false;
+
+      *physical_address = (entry->m_ppn << m_page_shift) | (virtual_address & (m_page_size - 1));
+      return true;
+    }
+
+    //! remember a translation in the memo of a core
+    void tlbFill(uint64_t vpn, uint64_t ppn, int core_id)
+    {
+      TlbEntry* entry = &m_tlb[(core_id % m_num_tlb) * TLB_SIZE + (vpn & (TLB_SIZE - 1))];
+      entry->m_vpn = vpn;
+      entry->m_ppn = ppn;
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -68,7 +128,7 @@ class FCFSPageMapper : public PageMapper
     ~FCFSPageMapper();
 
   public:
-    uint64_t translate(uint64_t virtual_address);   //!< provide physical translation for virtual address
+    uint64_t translate(uint64_t virtual_address, int core_id);   //!< provide physical translation for virtual address
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -84,11 +144,12 @@ class RegionBasedFCFSPageMapper : public PageMapper
 
   public:
     uint64_t getNumPhysicalRegions() { return m_region_table.size(); }  //!< get the number of physical regions allocated
-    uint64_t translate(uint64_t virtual_address);   //!< provide physical translation for virtual address
+    uint64_t translate(uint64_t virtual_address, int core_id);   //!< provide physical translation for virtual address
 
   private:
-    std::map<uint64_t, uint64_t> m_region_table;    //!< region mapping table
+    PageTable m_region_table;                       //!< region mapping table
     uint32_t m_region_size;                         //!< region size 
+    int m_region_shift;                             //!< log2(region size)
 };
 
 #endif //!PAGE_MAPPING_H_INCLUDED
@@ -0,0 +1,217 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pc_profiler.cc
+ * Description  : delinquent load (per-PC miss) profiler
+ *********************************************************************************************/
+
+
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <algorithm>
+
+#include "pc_profiler.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+
+#include "all_knobs.h"
+
+
+// constructor
+pc_profiler_c::pc_profiler_c(macsim_c* simBase)
+{
+  m_simBase     = simBase;
+  m_size        = *KNOB(KNOB_PC_PROFILER_SIZE);
+  m_interval    = *KNOB(KNOB_PC_PROFILER_INTERVAL);
+  m_next_report = m_interval ? m_interval : MAX_CTR;
+
+  ASSERTM(m_size > 0, "pc_profiler_size should be positive\n");
+
+  m_entry.reserve(m_size);
+  m_heap.reserve(m_size);
+  m_index.reserve(m_size * 2);
+
+  string stat_dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(stat_dir.c_str(), S_IRWXU);
+  string path = stat_dir + "/pc_profile.out";
+  m_file = fopen(path.c_str(), "w");
+  ASSERTM(m_file, "cannot open %s\n", path.c_str());
+}
+
+
+// destructor
+pc_profiler_c::~pc_profiler_c()
+{
+  write_report(CYCLE);
+  fclose(m_file);
+}
+
+
+// space-saving lookup
+pc_profile_entry_s* pc_profiler_c::lookup(Addr pc)
+{
+  unordered_map<Addr, int>::iterator itr = m_index.find(pc);
+  if (itr != m_index.end())
+    return &m_entry[itr->second];
+
+  int index;
+  Counter base = 0;
+  if (m_entry.size() < m_size) {
+    index = m_entry.size();
+    m_entry.push_back(pc_profile_entry_s());
+    m_heap.push_back(index);
+    m_entry[index].m_heap_pos = m_heap.size() - 1;
+  }
+  // replace the minimum; the newcomer may have had up to base misses before
+  else {
+    index = m_heap[0];
+    base  = m_entry[index].m_count;
+    m_index.erase(m_entry[index].m_pc);
+  }
+
+  pc_profile_entry_s* entry = &m_entry[index];
+  int heap_pos = entry->m_heap_pos;
+  memset(entry, 0, sizeof(pc_profile_entry_s));
+  entry->m_pc       = pc;
+  entry->m_count    = base;
+  entry->m_error    = base;
+  entry->m_heap_pos = heap_pos;
+  m_index[pc] = index;
+
+  return entry;
+}
+
+
+// count increased: move the entry down the min-heap
+void pc_profiler_c::sift_down(int pos)
+{
+  int size = m_heap.size();
+  while (true) {
+    int smallest = pos;
+    int left     = 2 * pos + 1;
+    int right    = left + 1;
+    if (left < size && m_entry[m_heap[left]].m_count < m_entry[m_heap[smallest]].m_count)
+      smallest = left;
+    if (right < size && m_entry[m_heap[right]].m_count < m_entry[m_heap[smallest]].m_count)
+      smallest = right;
+    if (smallest == pos)
+      break;
+
+    swap(m_heap[pos], m_heap[smallest]);
+    m_entry[m_heap[pos]].m_heap_pos      = pos;
+    m_entry[m_heap[smallest]].m_heap_pos = smallest;
+    pos = smallest;
+  }
+}
+
+
+// load miss
+void pc_profiler_c::miss(int level, Addr pc, Addr addr, int core_id)
+{
+  pc_profile_entry_s* entry = lookup(pc);
+  ++entry->m_count;
+  ++entry->m_miss[level];
+
+  // stride signature (Boyer-Moore majority vote)
+  if (level == MEM_L1) {
+    if (entry->m_last_addr && entry->m_last_core == core_id) {
+      int64 stride = static_cast<int64>(addr - entry->m_last_addr);
+      if (entry->m_stride_vote == 0) {
+        entry->m_stride      = stride;
+        entry->m_stride_vote = 1;
+      }
+      else if (entry->m_stride == stride) {
+        ++entry->m_stride_vote;
+      }
+      else {
+        --entry->m_stride_vote;
+      }
+    }
+    entry->m_last_addr = addr;
+    entry->m_last_core = core_id;
+  }
+
+  sift_down(entry->m_heap_pos);
+}
+
+
+// dram row conflict
+void pc_profiler_c::row_conflict(Addr pc)
+{
+  unordered_map<Addr, int>::iterator itr = m_index.find(pc);
+  if (itr != m_index.end())
+    ++m_entry[itr->second].m_row_conflict;
+}
+
+
+// miss latency
+void pc_profiler_c::latency(Addr pc, Counter cycles)
+{
+  unordered_map<Addr, int>::iterator itr = m_index.find(pc);
+  if (itr != m_index.end()) {
+    m_entry[itr->second].m_latency += cycles;
+    ++m_entry[itr->second].m_num_latency;
+  }
+}
+
+
+static bool sort_by_count(const pc_profile_entry_s* a, const pc_profile_entry_s* b)
+{
+  return a->m_count > b->m_count;
+}
+
+
+// append a sorted report
+void pc_profiler_c::write_report(Counter cycle)
+{
+  vector<pc_profile_entry_s*> sorted;
+  for (unsigned ii = 0; ii < m_entry.size(); ++ii) {
+    sorted.push_back(&m_entry[ii]);
+  }
+  sort(sorted.begin(), sorted.end(), sort_by_count);
+
+  fprintf(m_file, "# cycle %llu, %u pcs\n", cycle, (unsigned)sorted.size());
+  fprintf(m_file, "%-18s %12s %10s %12s %12s %12s %12s %10s %10s %10s\n", "PC", "MISSES",
+      "ERROR", "L1_MISS", "L2_MISS", "L3_MISS", "ROW_CONFL", "AVG_LAT", "STRIDE", "STRIDE_VOTE");
+  for (unsigned ii = 0; ii < sorted.size(); ++ii) {
+    pc_profile_entry_s* entry = sorted[ii];
+    fprintf(m_file, "0x%-16llx %12llu %10llu %12llu %12llu %12llu %12llu %10.1f %10lld %10llu\n",
+        entry->m_pc, entry->m_count, entry->m_error, entry->m_miss[MEM_L1],
+        entry->m_miss[MEM_L2], entry->m_miss[MEM_L3], entry->m_row_conflict,
+        entry->m_num_latency ? (double)entry->m_latency / entry->m_num_latency : 0.0,
+        entry->m_stride, entry->m_stride_vote);
+  }
+  fprintf(m_file, "\n");
+  fflush(m_file);
+
+  if (m_interval)
+    m_next_report = cycle + m_interval;
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pc_profiler.h
+ * Description  : delinquent load (per-PC miss) profiler
+ *********************************************************************************************/
+
+#ifndef PC_PROFILER_H_INCLUDED
+#define PC_PROFILER_H_INCLUDED
+
+
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+
+#include "macsim.h"
+#include "global_types.h"
+#include "global_defs.h"
+#include "memreq_info.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief per-PC profile entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct pc_profile_entry_s {
+  Addr    m_pc;                 /**< load pc */
+  Counter m_count;              /**< estimated misses (all levels) */
+  Counter m_error;              /**< overestimation bound of m_count */
+  Counter m_miss[MEM_LAST];     /**< misses per level (MEM_L1 .. MEM_L3) */
+  Counter m_row_conflict;       /**< dram row conflicts */
+  Counter m_latency;            /**< sum of miss latencies */
+  Counter m_num_latency;        /**< number of latency samples */
+  Addr    m_last_addr;          /**< last L1 miss address */
+  int     m_last_core;          /**< core of the last L1 miss */
+  int64   m_stride;             /**< majority stride candidate */
+  Counter m_stride_vote;        /**< majority vote counter of m_stride */
+  int     m_heap_pos;           /**< position in the min-heap */
+} pc_profile_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief delinquent load profiler
+///
+/// Keeps the top-K load PCs by misses with the space-saving algorithm: a PC that is not
+/// tracked replaces the entry with the smallest count and inherits that count as its error
+/// bound, so memory is bounded by pc_profiler_size regardless of the number of static loads.
+/// Entries are kept in a min-heap by count.
+///
+/// Per PC: misses at L1/L2/L3, dram row conflicts, average miss latency (L1 miss to fill)
+/// and a stride signature (majority vote over the strides of successive L1 miss addresses
+/// from the same core).
+/// The report (pc_profile.out in the statistics directory, sorted by misses) is appended
+/// every pc_profiler_interval cycles and at the end of the simulation.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pc_profiler_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pc_profiler_c(macsim_c* simBase);
+
+    /**
+     * Destructor. Write the final report.
+     */
+    ~pc_profiler_c();
+
+    /**
+     * Write a report when the interval has elapsed
+     */
+    inline void run_a_cycle(Counter cycle)
+    {
+      if (cycle >= m_next_report)
+        write_report(cycle);
+    }
+
+    /**
+     * Load miss at a cache level
+     * @param level MEM_L1 .. MEM_L3
+     * @param pc load pc
+     * @param addr miss address
+     * @param core_id core id
+     */
+    void miss(int level, Addr pc, Addr addr, int core_id);
+
+    /**
+     * DRAM row conflict caused by a load (tracked pcs only)
+     */
+    void row_conflict(Addr pc);
+
+    /**
+     * Latency of a completed load miss (tracked pcs only)
+     */
+    void latency(Addr pc, Counter cycles);
+
+  private:
+    /**
+     * Find the entry of pc, or replace the minimum entry
+     */
+    pc_profile_entry_s* lookup(Addr pc);
+
+    /**
+     * Restore the heap property below pos after its count has increased
+     */
+    void sift_down(int pos);
+
+    /**
+     * Append a sorted report
+     */
+    void write_report(Counter cycle);
+
+  private:
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+    FILE*     m_file; /**< report file */
+    unsigned  m_size; /**< number of entries (K) */
+    Counter   m_interval; /**< report interval in cycles (0: end only) */
+    Counter   m_next_report; /**< cycle of the next report */
+    vector<pc_profile_entry_s> m_entry; /**< entries */
+    vector<int> m_heap; /**< min-heap of entry indices by count */
+    unordered_map<Addr, int> m_index; /**< pc to entry index */
+};
+
+#endif
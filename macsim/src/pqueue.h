@@ -40,12 +40,14 @@ POSSIBILITY OF SUCH DAMAGE.
  * Summary: Model priority queue
  *
  *   Priority queue models latency + priority.
- *   There are N+1 (same as modeled latency) slots.
- *   Each slot is a list that may have several elements.
- *   Elemented are sorted by priority (highest priority is in the front)
- *   New entry is inserted in the back.
- *   Each cycle (if possible), each list is moved one slot ahead.
- *   Dequeue() will get highest priority + oldest entry from the first list.
+ *   Slots form a ring whose size is the next power of two above the modeled latency,
+ *   so rotation is an index increment masked with (ring size - 1).
+ *   Each slot is a small inline array that spills to the heap only when it overflows.
+ *   Elements in a slot are sorted by priority (highest priority is in the front);
+ *   equal priorities keep insertion order (per-slot head/tail insertion indices).
+ *   New entries are inserted into the slot that is (latency) slots behind the head slot.
+ *   Each cycle (if possible), the head slot moves one slot ahead.
+ *   Dequeue() will get highest priority + oldest entry from the head slot.
  */
 
 
@@ -54,7 +56,6 @@ POSSIBILITY OF SUCH DAMAGE.
 #define PQUEUE_H_INCLUDED
 
 
-#include <list>
 #include <string>
 #include <sys/types.h>
 #include <typeinfo>
@@ -71,6 +72,11 @@ POSSIBILITY OF SUCH DAMAGE.
 template <class T>
 class pqueue_c
 {
+  /**
+   * number of entries stored inline in each slot before spilling to the heap
+   */
+  static const int k_inline_entries = 8;
+
   /**
    * pqueue entry
    */
@@ -79,6 +85,33 @@ class pqueue_c
     T m_data;  /**< entry data */
   } pqueue_entry_s;
 
+  /**
+   * pqueue slot (one cycle of latency)
+   */
+  typedef struct pqueue_slot_s {
+    pqueue_entry_s  m_inline[k_inline_entries]; /**< inline entries */
+    pqueue_entry_s* m_spill; /**< overflow entries */
+    int             m_spill_capacity; /**< number of overflow entries */
+    int             m_head; /**< index of the highest priority entry */
+    int             m_tail; /**< insertion index */
+
+    /**
+     * Access i-th entry of the slot
+     */
+    pqueue_entry_s& at(int index)
+    {
+      return index < k_inline_entries ? m_inline[index] : m_spill[index - k_inline_entries];
+    }
+
+    /**
+     * Check empty slot
+     */
+    bool empty() const
+    {
+      return m_head == m_tail;
+    }
+  } pqueue_slot_s;
+
   public:
     /**
      * pqueue constructor
@@ -86,16 +119,26 @@ class pqueue_c
     pqueue_c(const int& size, const int& latency, const string name, macsim_c* simBase)
     {
       m_capacity      = size;
-      m_last_index    = latency;
+      m_latency       = latency;
       m_current_index = 0;
       m_num_entry     = 0;
       m_name          = name;
-      m_size          = latency + 1;
 
       m_simBase       = simBase;
 
-      m_entry = new list<pqueue_entry_s *>[m_size];
-      m_entry_pool = new pool_c<pqueue_entry_s>(100, name + "_pqueue_entry_pool");
+      // ring size : next power of two that can hold (latency + 1) slots
+      m_size = 1;
+      while (m_size < latency + 1)
+        m_size <<= 1;
+      m_mask = m_size - 1;
+
+      m_entry = new pqueue_slot_s[m_size];
+      for (int ii = 0; ii < m_size; ++ii) {
+        m_entry[ii].m_spill          = NULL;
+        m_entry[ii].m_spill_capacity = 0;
+        m_entry[ii].m_head           = 0;
+        m_entry[ii].m_tail           = 0;
+      }
     }
 
     /**
@@ -104,6 +147,9 @@ class pqueue_c
     ~pqueue_c()
     {
       flush();
+      for (int ii = 0; ii < m_size; ++ii) {
+        delete[] m_entry[ii].m_spill;
+      }
       delete[] m_entry;
     }
 
@@ -124,24 +170,20 @@ class pqueue_c
 
       m_num_entry++;
 
-      pqueue_entry_s *new_entry = m_entry_pool->acquire_entry(); 
-      new_entry->m_data     = data;
-      new_entry->m_priority = priority;
+      pqueue_slot_s* slot = &m_entry[(m_current_index + m_latency) & m_mask];
+      if (slot->m_tail == k_inline_entries + slot->m_spill_capacity)
+        make_room(slot);
 
-      bool insert = false;
-      int count = 0;
-      for (auto I = m_entry[m_last_index].begin(), E = m_entry[m_last_index].end(); 
-          I != E; ++I) {
-          count++;
-        if ((*I)->m_priority < priority) {
-          m_entry[m_last_index].insert(I, new_entry);
-          insert = true;
-          break;
-        }
+      // entries with lower priority move one position back
+      int index = slot->m_tail;
+      while (index > slot->m_head && slot->at(index - 1).m_priority < priority) {
+        slot->at(index) = slot->at(index - 1);
+        --index;
       }
 
-      if (!insert)
-        m_entry[m_last_index].push_back(new_entry);
+      slot->at(index).m_data     = data;
+      slot->at(index).m_priority = priority;
+      ++slot->m_tail;
 
       return true;
     }
@@ -151,7 +193,8 @@ class pqueue_c
      */
     T dequeue(int64_t *priority = 0)
     {
-      pqueue_entry_s *entry = m_entry[m_current_index].front();
+      pqueue_slot_s* slot = &m_entry[m_current_index];
+      pqueue_entry_s* entry = &slot->at(slot->m_head);
       if (priority)
         *priority = entry->m_priority;
 
@@ -160,8 +203,10 @@ class pqueue_c
       entry->m_data     = T(0);
       entry->m_priority = -1;
 
-      m_entry[m_current_index].pop_front();
-      m_entry_pool->release_entry(entry); 
+      if (++slot->m_head == slot->m_tail) {
+        slot->m_head = 0;
+        slot->m_tail = 0;
+      }
 
       --m_num_entry;
       
@@ -180,8 +225,7 @@ class pqueue_c
       if (!m_entry[m_current_index].empty())
         return true;
 
-      m_last_index    = m_current_index;
-      m_current_index = (m_current_index + 1) % m_size;
+      m_current_index = (m_current_index + 1) & m_mask;
 
       return true;
     }
@@ -195,19 +239,27 @@ class pqueue_c
 
       T data;
       int count = 0;
-      for (int ii = m_current_index; ii < m_current_index + m_size; ++ii) {
-        int index = ii % m_size;
-        for (auto I = m_entry[index].begin(), E = m_entry[index].end(); I != E; ++I) {
-          if (count++ == entry) {
-            data = (*I)->m_data;
-            break;
-          }
+      for (int ii = 0; ii < m_size; ++ii) {
+        pqueue_slot_s* slot = &m_entry[(m_current_index + ii) & m_mask];
+        int num_entry = slot->m_tail - slot->m_head;
+        if (count + num_entry > entry) {
+          data = slot->at(slot->m_head + entry - count).m_data;
+          break;
         }
+        count += num_entry;
       }
       
       return data;
     }
 
+    /**
+     * Return the modeled latency in cycles
+     */
+    int latency()
+    {
+      return m_latency;
+    }
+
     /**
      * Return available spaces
      */
@@ -222,42 +274,69 @@ class pqueue_c
     void flush()
     {
       for (int ii = 0; ii < m_size; ++ii) {
-        while (!m_entry[ii].empty()) {
-          pqueue_entry_s *entry = m_entry[ii].front();
-
-          m_entry[ii].pop_front();
-
-          entry->m_data = T(0);
-          entry->m_priority = -1;
-
-          m_entry_pool->release_entry(entry);
+        pqueue_slot_s* slot = &m_entry[ii];
+        for (int jj = slot->m_head; jj < slot->m_tail; ++jj) {
+          slot->at(jj).m_data     = T(0);
+          slot->at(jj).m_priority = -1;
         }
+        slot->m_head = 0;
+        slot->m_tail = 0;
       }
 
       m_num_entry     = 0;
       m_current_index = 0;
-      m_last_index    = m_size;
     }
 
     /**
-     * Return pool size
+     * Return pool size (number of entries allocated beyond the inline slot storage)
      */
     int pool_size(void)
     {
-      return m_entry_pool->size();
+      int size = 0;
+      for (int ii = 0; ii < m_size; ++ii) {
+        size += m_entry[ii].m_spill_capacity;
+      }
+      return size;
     }
 
   private:
     pqueue_c(); // do not implement
 
-    list<pqueue_entry_s *>* m_entry; /**< queue buckets */
-    pool_c<pqueue_entry_s>* m_entry_pool; /**< queue entry full */
+    /**
+     * Make room for a new entry at the tail of a full slot. Already dequeued
+     * entries are reclaimed first; otherwise the spill storage is doubled.
+     */
+    void make_room(pqueue_slot_s* slot)
+    {
+      if (slot->m_head > 0) {
+        int num_entry = slot->m_tail - slot->m_head;
+        for (int ii = 0; ii < num_entry; ++ii) {
+          slot->at(ii) = slot->at(slot->m_head + ii);
+        }
+        slot->m_head = 0;
+        slot->m_tail = num_entry;
+        return;
+      }
+
+      int new_capacity = (slot->m_spill_capacity == 0) ? 
+        k_inline_entries : slot->m_spill_capacity * 2;
+      pqueue_entry_s* new_spill = new pqueue_entry_s[new_capacity];
+      for (int ii = 0; ii < slot->m_spill_capacity; ++ii) {
+        new_spill[ii] = slot->m_spill[ii];
+      }
+      delete[] slot->m_spill;
+      slot->m_spill          = new_spill;
+      slot->m_spill_capacity = new_capacity;
+    }
+
+    pqueue_slot_s* m_entry; /**< queue slots (ring) */
     string m_name; /**< queue name */
-    int m_size; /**< queue bucket size */
+    int m_size; /**< number of slots (power of two) */
+    int m_mask; /**< slot index mask (m_size - 1) */
+    int m_latency; /**< modeled latency */
     int m_capacity; /**< queue capacity */
     int m_num_entry; /**< current queue entries */
-    int m_last_index; /**< last bucket index */
-    int m_current_index; /**< current bucket index */
+    int m_current_index; /**< current (head) slot index */
     
     macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
 };
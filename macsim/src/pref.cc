@@ -40,8 +40,6 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "all_knobs.h"
 
-static int prefetcher_id = 0;
-
 // hardware prefetcher base class constructor
 pref_base_c::pref_base_c(macsim_c* simBase)
   : init(true), done(false), l1_miss(false), l1_hit(false), l1_pref_hit(false),
@@ -52,7 +50,7 @@ pref_base_c::pref_base_c(macsim_c* simBase)
   // hwp_info holds all hardware prefetcher related information
   hwp_info = new pref_info_s;
 
-  hwp_info->id                = prefetcher_id++;
+  hwp_info->id                = 0; // set by hwp_common_c (index in its pref_table)
   hwp_info->useful            = 0;
   hwp_info->sent              = 0;
   hwp_info->late              = 0;
@@ -63,6 +61,9 @@ pref_base_c::pref_base_c(macsim_c* simBase)
   hwp_info->enabled           = false;
   hwp_info->hybrid_lastuseful = 0;
   hwp_info->hybrid_lastsent   = 0;
+  hwp_info->total_useful      = 0;
+  hwp_info->total_sent        = 0;
+  hwp_info->total_late        = 0;
   hwp_info->prefhit_count     = 0;
   hwp_info->dyn_degree        = 2;
 
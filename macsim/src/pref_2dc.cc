@@ -0,0 +1,209 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_2dc.cc
+ * Description  : Two-delta correlation (2DC) prefetcher
+ *********************************************************************************************/
+
+
+#include "global_defs.h"
+#include "global_types.h"
+#include "debug_macros.h"
+
+#include "utils.h"
+#include "assert_macros.h"
+#include "memory.h"
+
+#include "pref_2dc.h"
+
+#include "all_knobs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define DEBUG(args...)		_DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_PREF_2DC, ## args)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+pref_2dc_c::pref_2dc_c(hwp_common_c *hcc, Unit_Type type, macsim_c* simBase)
+  : pref_base_c(simBase)
+{
+  name = "2dc";
+  hwp_type = Mem_To_UL1;
+  hwp_common = hcc;
+  switch (type) {
+    case UNIT_SMALL:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_2DC_ON;
+      break;
+    case UNIT_MEDIUM:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_2DC_ON_MEDIUM_CORE;
+      break;
+    case UNIT_LARGE:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_2DC_ON_LARGE_CORE;
+      break;
+  }
+
+  // configuration
+  l1_miss     = true;
+  l2_pref_hit = true;
+
+  m_region = NULL;
+  m_cache  = NULL;
+}
+
+
+// destructor
+pref_2dc_c::~pref_2dc_c()
+{
+  delete[] m_region;
+  delete[] m_cache;
+}
+
+
+// initialization
+void pref_2dc_c::init_func(int cid)
+{
+  if (!knob_enable)
+    return;
+
+  core_id   = cid;
+  shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  hwp_info->enabled = true;
+  m_num_region      = *m_simBase->m_knobs->KNOB_PREF_2DC_NUM_REGIONS;
+  m_region_hash     = *m_simBase->m_knobs->KNOB_PREF_2DC_REGION_HASH;
+  m_assoc           = *m_simBase->m_knobs->KNOB_PREF_2DC_CACHE_ASSOC;
+  uns cache_size    = *m_simBase->m_knobs->KNOB_PREF_2DC_CACHE_SIZE;
+  m_num_set         = (m_assoc > 0) ? cache_size / m_assoc : 0;
+
+  ASSERTM(m_region_hash > 0 && m_region_hash <= m_num_region,
+      "pref_2dc_region_hash:%d pref_2dc_num_regions:%d\n", m_region_hash, m_num_region);
+  ASSERTM(m_num_set > 0, "pref_2dc_cache_size:%d pref_2dc_cache_assoc:%d\n", cache_size, m_assoc);
+
+  m_region = new pref_2dc_region_s[m_num_region];
+  m_cache  = new pref_2dc_entry_s[m_num_set * m_assoc];
+}
+
+
+// L1 miss training function
+void pref_2dc_c::l1_miss_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr >> shift_bit);
+}
+
+
+// prefetched line hit : it would have been a miss
+void pref_2dc_c::l2_pref_hit_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr >> shift_bit);
+}
+
+
+// correlation cache access
+pref_2dc_entry_s* pref_2dc_c::access(int64_t delta2, int64_t delta1, bool allocate)
+{
+  uns64 key = (static_cast<uns64>(delta2) * 0x9e3779b97f4a7c15ULL) ^ static_cast<uns64>(delta1);
+  uns set   = key % m_num_set;
+  uns tag   = (key / m_num_set) & N_BIT_MASK(*m_simBase->m_knobs->KNOB_PREF_2DC_TAG_SIZE);
+
+  pref_2dc_entry_s* ways   = &m_cache[set * m_assoc];
+  pref_2dc_entry_s* victim = &ways[0];
+  for (uns ii = 0; ii < m_assoc; ++ii) {
+    if (ways[ii].valid && ways[ii].tag == tag) {
+      ways[ii].last_access = CYCLE;
+      return &ways[ii];
+    }
+    if (victim->valid && (!ways[ii].valid || ways[ii].last_access < victim->last_access))
+      victim = &ways[ii];
+  }
+
+  if (!allocate)
+    return NULL;
+
+  victim->valid       = true;
+  victim->tag         = tag;
+  victim->last_access = CYCLE;
+  return victim;
+}
+
+
+// learn the new delta, then chain the predictions
+void pref_2dc_c::train(Addr line_index)
+{
+  Addr zone = line_index >> *m_simBase->m_knobs->KNOB_PREF_2DC_ZONE_SHIFT;
+  pref_2dc_region_s* region = &m_region[zone % m_region_hash];
+
+  if (!region->valid || region->zone != zone) {
+    region->valid      = true;
+    region->zone       = zone;
+    region->last_index = line_index;
+    region->num_delta  = 0;
+    return;
+  }
+
+  int64_t delta = static_cast<int64_t>(line_index - region->last_index);
+  if (delta == 0)
+    return;
+
+  if (region->num_delta == 2)
+    access(region->delta2, region->delta1, true)->delta = delta;
+  else
+    ++region->num_delta;
+
+  region->delta2     = region->delta1;
+  region->delta1     = delta;
+  region->last_index = line_index;
+
+  if (region->num_delta < 2)
+    return;
+
+  int64_t delta2 = region->delta2;
+  int64_t delta1 = region->delta1;
+  Addr pref_index = line_index;
+  uns degree = MIN2(hwp_common->pref_get_degree(hwp_info->id, *m_simBase->m_knobs->KNOB_PREF_2DC_DEGREE),
+      *m_simBase->m_knobs->KNOB_PREF_2DC_MAX_DEGREE);
+  for (uns ii = 0; ii < degree; ++ii) {
+    pref_2dc_entry_s* next = access(delta2, delta1, false);
+    if (next == NULL)
+      break;
+
+    pref_index += next->delta;
+    DEBUG("core:%d line:%s predicted delta:%lld\n", core_id, hexstr64s(line_index),
+        (long long)next->delta);
+    if (!hwp_common->pref_addto_l2req_queue(pref_index, hwp_info->id))
+      break; // queue is full
+
+    delta2 = delta1;
+    delta1 = next->delta;
+  }
+}
@@ -0,0 +1,166 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_2dc.h
+ * Description  : Two-delta correlation (2DC) prefetcher
+ *********************************************************************************************/
+
+#ifndef PREF_2DC_H
+#define PREF_2DC_H
+
+
+#include "pref_common.h"
+#include "pref.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief 2dc tracked region (last miss and deltas of a zone)
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct pref_2dc_region_s {
+  bool    valid;      /**< valid */
+  Addr    zone;       /**< zone (tag) */
+  Addr    last_index; /**< last miss line index */
+  int64_t delta1;     /**< latest delta */
+  int64_t delta2;     /**< delta before delta1 */
+  uns     num_delta;  /**< number of deltas seen (saturates at 2) */
+
+  /**
+   * Constructor
+   */
+  pref_2dc_region_s() {
+    valid = false;
+  }
+} pref_2dc_region_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief 2dc correlation cache entry : (delta2, delta1) -> next delta
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct pref_2dc_entry_s {
+  bool    valid;       /**< valid */
+  uns     tag;         /**< hashed delta pair tag */
+  int64_t delta;       /**< predicted next delta */
+  Counter last_access; /**< lru */
+
+  /**
+   * Constructor
+   */
+  pref_2dc_entry_s() {
+    valid = false;
+  }
+} pref_2dc_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief two-delta correlation prefetcher
+///
+/// Each of pref_2dc_num_regions tracked zones (2^pref_2dc_zone_shift lines, placed by
+/// zone % pref_2dc_region_hash) keeps its last L2 miss and last two deltas. A set-associative
+/// correlation cache (pref_2dc_cache_size entries, pref_2dc_cache_assoc ways,
+/// pref_2dc_tag_size tag bits) learns the delta that follows each delta pair; predictions
+/// are chained for up to pref_2dc_degree prefetches. The table is not banked
+/// (pref_2dc_banks and pref_2dc_cache_line_size are not modeled).
+/// @see pref_base_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pref_2dc_c : public pref_base_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pref_2dc_c(hwp_common_c *, Unit_Type, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~pref_2dc_c();
+
+    /**
+     * Init function
+     */
+    void init_func(int);
+
+    /**
+     * Done function
+     */
+    void done_func() {}
+
+    /**
+     * L1 miss function
+     */
+    void l1_miss_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 hit function
+     */
+    void l1_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L1 prefetch hit function
+     */
+    void l1_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 miss function
+     */
+    void l2_miss_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 hit function
+     */
+    void l2_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 prefetch hit function
+     */
+    void l2_pref_hit_func(int, Addr, Addr, uop_c *);
+
+  private:
+    /**
+     * Learn the delta of a miss and send prefetches
+     */
+    void train(Addr line_index);
+
+    /**
+     * Correlation cache access. Returns the entry of the pair (NULL on a miss), or the
+     * entry to replace if allocate is set.
+     */
+    pref_2dc_entry_s* access(int64_t delta2, int64_t delta1, bool allocate);
+
+  private:
+    pref_2dc_region_s *m_region; /**< tracked regions */
+    pref_2dc_entry_s  *m_cache; /**< correlation cache */
+    uns                m_num_region; /**< number of tracked regions */
+    uns                m_region_hash; /**< region placement modulo */
+    uns                m_num_set; /**< correlation cache sets */
+    uns                m_assoc; /**< correlation cache ways */
+};
+
+#endif
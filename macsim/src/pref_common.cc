@@ -115,9 +115,18 @@ hwp_common_c::hwp_common_c(int cid, Unit_Type type, macsim_c* simBase)
   core_id = cid;
   m_simBase = simBase;
 
+  // slot 0 is a disabled placeholder : prefetcher id 0 marks a request (or a cache line)
+  // that was not brought by a hardware prefetcher
+  pref_table.push_back(new pref_dummy_c(m_simBase));
+
   // allocate all registered prefetchers
   pref_factory_c::get()->allocate_pref(pref_table, this, type, m_simBase);
-  m_shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  // a prefetcher id is its index in this table (prefetch requests carry it)
+  for (unsigned int ii = 0; ii < pref_table.size(); ++ii) {
+    pref_table[ii]->hwp_info->id = ii;
+    pref_table[ii]->core_id      = core_id;
+  }
 }
 
 
@@ -151,6 +160,7 @@ void hwp_common_c::pref_init(bool ptx)
     return;
 
   knob_ptx_sim = ptx;
+  m_shift_bit  = LOG2_DCACHE_LINE_SIZE;
 
   // initialize queues
   m_l1req_queue = new pref_mem_req_s[*m_simBase->m_knobs->KNOB_PREF_DL0REQ_QUEUE_SIZE];
@@ -191,6 +201,10 @@ void hwp_common_c::pref_init(bool ptx)
   m_overall_l2sent        = 0;
   m_l2_misses             = 0;
   m_curr_l2_misses        = 0;
+  m_total_l2_misses       = 0;
+  m_global_last_sent      = 0;
+  m_global_last_traffic   = 0;
+  m_global_last_demand    = 0;
   m_num_uselesspref_evict = 0;
 
   // Initialize hybrid structures : IF we are doing hybrid prefetching, note that 
@@ -199,6 +213,21 @@ void hwp_common_c::pref_init(bool ptx)
   m_default_prefetcher = *m_simBase->m_knobs->KNOB_PREF_HYBRID_DEFAULT;
   m_last_update_time   = m_simBase->m_simulation_cycle;
 
+  if (*m_simBase->m_knobs->KNOB_PREF_HYBRID_ON) {
+    ASSERTM(*m_simBase->m_knobs->KNOB_PREF_REGION_ON, "pref_hybrid_on needs pref_region_on\n");
+
+    // fall back to the first enabled prefetcher
+    if (m_default_prefetcher >= pref_table.size() || 
+        !pref_table[m_default_prefetcher]->hwp_info->enabled) {
+      for (unsigned int ii = 1; ii < pref_table.size(); ++ii) {
+        if (pref_table[ii]->hwp_info->enabled) {
+          m_default_prefetcher = ii;
+          break;
+        }
+      }
+    }
+  }
+
   // region
   if (*m_simBase->m_knobs->KNOB_PREF_REGION_ON) {
     region_info = new pref_region_info_s[*m_simBase->m_knobs->KNOB_PREF_NUMTRACKING_REGIONS];
@@ -220,6 +249,13 @@ void hwp_common_c::pref_init(bool ptx)
   // pollution bit vector
   if (*m_simBase->m_knobs->KNOB_PREF_POLBV_ON) {
     m_polbv_info = new char[*m_simBase->m_knobs->KNOB_PREF_POLBV_SIZE];
+    memset(m_polbv_info, 0, *m_simBase->m_knobs->KNOB_PREF_POLBV_SIZE);
+  }
+
+  // feedback-directed throttling works on intervals of l2 evictions
+  if (*m_simBase->m_knobs->KNOB_PREF_THROTTLEFB_ON || *m_simBase->m_knobs->KNOB_PREF_THROTTLE_ON) {
+    ASSERTM(*m_simBase->m_knobs->KNOB_PREF_UPDATE_INTERVAL != 0, 
+        "pref_throttlefb_on/pref_throttle_on need pref_update_interval\n");
   }
 
   m_pfpol         = 0;
@@ -273,9 +309,9 @@ void hwp_common_c::pref_l1_miss(int tid, Addr line_addr, Addr load_PC, uop_c *uo
       if (pref_table[ii]->hwp_info->enabled && pref_table[ii]->l1_miss) {
         if (*m_simBase->m_knobs->KNOB_PREF_TRAIN_INST_ONCE) {
           if (m_last_inst_num.find(tid) == m_last_inst_num.end() ||
-              m_last_inst_num[tid] != uop->m_inst_num) {
+              m_last_inst_num[tid] != uop->m_warm->m_inst_num) {
             pref_table[ii]->l1_miss_func(tid, line_addr, load_PC, uop);
-            m_last_inst_num[tid] = uop->m_inst_num;
+            m_last_inst_num[tid] = uop->m_warm->m_inst_num;
           }
         }
         else {
@@ -298,9 +334,9 @@ void hwp_common_c::pref_l1_hit(int tid, Addr line_addr, Addr load_PC, uop_c *uop
       if (pref_table[ii]->hwp_info->enabled && pref_table[ii]->l1_hit) {
         if (*m_simBase->m_knobs->KNOB_PREF_TRAIN_INST_ONCE) {
           if (m_last_inst_num.find(tid) == m_last_inst_num.end() ||
-              m_last_inst_num[tid] != uop->m_inst_num) {
+              m_last_inst_num[tid] != uop->m_warm->m_inst_num) {
             pref_table[ii]->l1_hit_func(tid, line_addr, load_PC, uop);
-            m_last_inst_num[tid] = uop->m_inst_num;
+            m_last_inst_num[tid] = uop->m_warm->m_inst_num;
           }
         }
         else {
@@ -337,12 +373,10 @@ void hwp_common_c::pref_l1_pref_hit(int tid, Addr line_addr, Addr load_PC, uns8
 // L2 miss handler
 void hwp_common_c::pref_l2_miss(int tid, Addr line_addr, uop_c* uop)
 {
-  Addr load_PC = uop ? uop->m_pc : 0;
+  Addr load_PC = uop ? uop->m_warm->m_pc : 0;
   if (!*m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON)
     return;
 
-  m_curr_l2_misses++;
-
   if (*m_simBase->m_knobs->KNOB_PREF_TRACE_ON)
     fprintf(PREF_TRACE_OUT, "%s \t %s \t %s \t %s\n", 
         hexstr64s(m_simBase->m_simulation_cycle), hexstr64s(load_PC), hexstr64s(line_addr), "UL1_MISS");
@@ -353,23 +387,13 @@ void hwp_common_c::pref_l2_miss(int tid, Addr line_addr, uop_c* uop)
   if (*m_simBase->m_knobs->KNOB_PREF_ACC_STUDY) 
     pref_acc_useupdate(line_addr);
 
-  if (*m_simBase->m_knobs->KNOB_PREF_POLBV_ON) {
-    // UPDATE prefpolbv reset entry
-    Addr line_index = (line_addr>>m_shift_bit);
-    if ((*pref_polbv_access(line_index))==1) {
-      m_curr_pfpol++;
-      STAT_EVENT(PREF_PFPOL);
-    }
-    *pref_polbv_access(line_index) = 0;
-  }
-
   for (unsigned int ii = 0; ii < pref_table.size(); ++ii) {
     if (pref_table[ii]->hwp_info->enabled && pref_table[ii]->l2_miss) { 
       if (*m_simBase->m_knobs->KNOB_PREF_TRAIN_INST_ONCE) {
         if (m_last_inst_num.find(tid) == m_last_inst_num.end() ||
-            m_last_inst_num[tid] != uop->m_inst_num) {
+            m_last_inst_num[tid] != uop->m_warm->m_inst_num) {
           pref_table[ii]->l2_miss_func(tid, line_addr, load_PC, uop);
-          m_last_inst_num[tid] = uop->m_inst_num;
+          m_last_inst_num[tid] = uop->m_warm->m_inst_num;
         }
       }
       else {
@@ -400,9 +424,9 @@ void hwp_common_c::pref_l2_hit(int tid, Addr line_addr, Addr load_PC, uop_c *uop
     if (pref_table[ii]->hwp_info->enabled && pref_table[ii]->l2_hit) { 
       if (*m_simBase->m_knobs->KNOB_PREF_TRAIN_INST_ONCE) {
         if (m_last_inst_num.find(tid) == m_last_inst_num.end() ||
-            m_last_inst_num[tid] != uop->m_inst_num) {
+            m_last_inst_num[tid] != uop->m_warm->m_inst_num) {
           pref_table[ii]->l2_hit_func(tid, line_addr, load_PC, uop);
-          m_last_inst_num[tid] = uop->m_inst_num;
+          m_last_inst_num[tid] = uop->m_warm->m_inst_num;
         }
       }
       else {
@@ -423,8 +447,13 @@ void hwp_common_c::pref_l2_pref_hit_late(int tid, Addr line_addr, Addr load_PC,
   if (prefetcher_id == 0)
     return;
     
-  m_curr_l2_misses--; // We counted this as a miss earlier...
   pref_table[prefetcher_id]->hwp_info->curr_late++;
+  pref_table[prefetcher_id]->hwp_info->total_late++;
+
+  if (prefetcher_id <= PREF_STAT_NUM) {
+    STAT_EVENT(PREF_STRIDE_LATE + prefetcher_id - 1);
+    STAT_EVENT(PREF_STRIDE_TIMELINESS + prefetcher_id - 1);
+  }
 
   pref_l2_pref_hit(tid, line_addr, load_PC, prefetcher_id, uop);
 }
@@ -449,6 +478,19 @@ void hwp_common_c::pref_l2_pref_hit(int tid, Addr line_addr, Addr load_PC, uns8
 
     pref_table[prefetcher_id]->hwp_info->curr_useful++;
   }
+  pref_table[prefetcher_id]->hwp_info->total_useful++;
+
+  // the demand did not reach the lower level; record the use for hybrid selection
+  if (*m_simBase->m_knobs->KNOB_PREF_REGION_ON)
+    pref_update_regioninfo(line_addr, true, false, false, 0, 0);
+
+  // a useful prefetch is a demand miss removed (or shortened, if late)
+  STAT_EVENT(PREF_POTENTIAL_MISS);
+  if (prefetcher_id <= PREF_STAT_NUM) {
+    STAT_EVENT(PREF_STRIDE_USEFUL + prefetcher_id - 1);
+    STAT_EVENT(PREF_STRIDE_ACCURACY + prefetcher_id - 1);
+    STAT_EVENT(PREF_STRIDE_COVERAGE + prefetcher_id - 1);
+  }
 
   for (unsigned int ii = 0; ii < pref_table.size(); ++ii) {
     if (pref_table[ii]->hwp_info->enabled && pref_table[ii]->l2_pref_hit) {
@@ -586,59 +628,6 @@ bool hwp_common_c::pref_addto_l2req_queue_set(Addr line_index, uns8 prefetcher_i
     
   line_addr = (line_index) << m_shift_bit;
     
-  if (*m_simBase->m_knobs->KNOB_PREF_UPDATE_INTERVAL!=0  && m_num_l2_evicts > *m_simBase->m_knobs->KNOB_PREF_UPDATE_INTERVAL) {
-    float pol;   
-    
-    pref_info_s *hwp_info = pref_table[prefetcher_id]->hwp_info;
-
-    m_num_l2_evicts = 0;
-    if (hwp_info->curr_sent) {
-      hwp_info->useful = 
-        static_cast<Counter>(0.5*hwp_info->useful + (0.5*hwp_info->curr_useful));
-      hwp_info->curr_useful = 0;
-      m_useful = hwp_info->useful;
-
-      hwp_info->sent = 
-        static_cast<Counter>((0.5*hwp_info->sent) + (0.5*hwp_info->curr_sent));
-      hwp_info->curr_sent   = 0;
-
-      m_pfpol = static_cast<Counter>((0.5*m_pfpol) + (0.5*m_curr_pfpol));
-      m_curr_pfpol = 0;
-
-      hwp_info->late = static_cast<Counter>(0.5*hwp_info->late + (0.5*hwp_info->curr_late));
-      hwp_info->curr_late = 0;
-
-      m_l2_misses = 
-        static_cast<Counter>((0.5*m_l2_misses) + (0.5*m_curr_l2_misses));
-      m_curr_l2_misses = 0;
-
-      m_update_acc = true;
-		    
-      pol = pref_get_l2pollution();
-
-      if (pol > 0.5) 
-        STAT_EVENT(PREF_POL_1);
-      else if (pol > 0.40) 
-        STAT_EVENT(PREF_POL_2);
-      else if (pol > 0.25) 
-        STAT_EVENT(PREF_POL_3);
-      else if (pol > 0.10) 
-        STAT_EVENT(PREF_POL_4);
-      else if (pol > 0.05) 
-        STAT_EVENT(PREF_POL_5);
-      else if (pol > 0.01) 
-        STAT_EVENT(PREF_POL_6);
-      else if (pol > 0.0075) 
-        STAT_EVENT(PREF_POL_7);
-      else if (pol > 0.005) 
-        STAT_EVENT(PREF_POL_8);
-      else if (pol > 0.001) 
-        STAT_EVENT(PREF_POL_9);
-      else 
-        STAT_EVENT(PREF_POL_10);
-    }
-  }
-
   if (*m_simBase->m_knobs->KNOB_PREF_POLBV_ON) {
     // UPDATE prefpolbv reset entry
     *pref_polbv_access(line_index) = 0;
@@ -876,6 +865,11 @@ void hwp_common_c::pref_l2sent(uns8 prefetcher_id)
   if (prefetcher_id==0)
     return;
 
+  pref_table[prefetcher_id]->hwp_info->total_sent++;
+  if (prefetcher_id <= PREF_STAT_NUM) {
+    STAT_EVENT(PREF_STRIDE_SENT + prefetcher_id - 1);
+  }
+
   if (!*m_simBase->m_knobs->KNOB_PREF_USEREGION_TOCALC_ACC) {
     // prefetch missed in the l2 and went out on the bus
     m_overall_l2sent++;
@@ -932,6 +926,183 @@ void hwp_common_c::pref_l2evict(Addr addr)
     return;
 
   m_num_l2_evicts++;
+
+  if (*m_simBase->m_knobs->KNOB_PREF_UPDATE_INTERVAL != 0 && 
+      m_num_l2_evicts > *m_simBase->m_knobs->KNOB_PREF_UPDATE_INTERVAL) {
+    pref_update_feedback();
+  }
+}
+
+
+// End of a feedback interval : fold the interval counters into the running averages and
+// adjust the aggressiveness of each prefetcher
+void hwp_common_c::pref_update_feedback(void)
+{
+  m_num_l2_evicts = 0;
+
+  for (unsigned int ii = 1; ii < pref_table.size(); ++ii) {
+    pref_info_s *hwp_info = pref_table[ii]->hwp_info;
+    if (!hwp_info->enabled)
+      continue;
+
+    hwp_info->useful = 
+      static_cast<Counter>(0.5*hwp_info->useful + (0.5*hwp_info->curr_useful));
+    hwp_info->curr_useful = 0;
+
+    hwp_info->sent = 
+      static_cast<Counter>((0.5*hwp_info->sent) + (0.5*hwp_info->curr_sent));
+    hwp_info->curr_sent   = 0;
+
+    hwp_info->late = static_cast<Counter>(0.5*hwp_info->late + (0.5*hwp_info->curr_late));
+    hwp_info->curr_late = 0;
+  }
+
+  m_pfpol = static_cast<Counter>((0.5*m_pfpol) + (0.5*m_curr_pfpol));
+  m_curr_pfpol = 0;
+
+  m_l2_misses = 
+    static_cast<Counter>((0.5*m_l2_misses) + (0.5*m_curr_l2_misses));
+  m_curr_l2_misses = 0;
+
+  float pol = pref_get_l2pollution();
+
+  if (pol > 0.5) 
+    STAT_EVENT(PREF_POL_1);
+  else if (pol > 0.40) 
+    STAT_EVENT(PREF_POL_2);
+  else if (pol > 0.25) 
+    STAT_EVENT(PREF_POL_3);
+  else if (pol > 0.10) 
+    STAT_EVENT(PREF_POL_4);
+  else if (pol > 0.05) 
+    STAT_EVENT(PREF_POL_5);
+  else if (pol > 0.01) 
+    STAT_EVENT(PREF_POL_6);
+  else if (pol > 0.0075) 
+    STAT_EVENT(PREF_POL_7);
+  else if (pol > 0.005) 
+    STAT_EVENT(PREF_POL_8);
+  else if (pol > 0.001) 
+    STAT_EVENT(PREF_POL_9);
+  else 
+    STAT_EVENT(PREF_POL_10);
+
+  bool global_throttle = pref_global_throttle();
+
+  for (unsigned int ii = 1; ii < pref_table.size(); ++ii) {
+    pref_info_s *hwp_info = pref_table[ii]->hwp_info;
+    if (!hwp_info->enabled)
+      continue;
+
+    // cross-core decision overrides the local one for inaccurate or polluting prefetchers
+    if (global_throttle && 
+        (pref_get_accuracy(ii) < *m_simBase->m_knobs->KNOB_PREF_ACC_THRESH_4 || 
+         pol > *m_simBase->m_knobs->KNOB_PREF_POL_THRESH_1)) {
+      STAT_EVENT(PREF_GLOBAL_THROTTLE);
+      if (hwp_info->dyn_degree > 0)
+        hwp_info->dyn_degree--;
+      DEBUG("core:%d pref:%s globally throttled to level:%d\n", core_id, 
+          pref_table[ii]->name.c_str(), hwp_info->dyn_degree);
+    }
+    else if (*m_simBase->m_knobs->KNOB_PREF_THROTTLEFB_ON) {
+      m_update_acc = true;
+      pref_get_degfb(ii);
+    }
+  }
+}
+
+
+// Prefetches of this core take more than pref_throttle_bw_thresh of the memory traffic
+// of all cores since the last interval, while other cores miss as well
+bool hwp_common_c::pref_global_throttle(void)
+{
+  Counter sent    = pref_get_total_sent();
+  Counter traffic = 0;
+  Counter demand  = 0;
+  for (int ii = 0; ii < *m_simBase->m_knobs->KNOB_NUM_SIM_CORES; ++ii) {
+    hwp_common_c* hw_pref = m_simBase->m_core_pointers[ii]->get_hw_pref();
+    if (hw_pref == NULL)
+      continue;
+
+    traffic += hw_pref->pref_get_total_sent() + hw_pref->pref_get_total_demand_misses();
+    if (ii != core_id)
+      demand += hw_pref->pref_get_total_demand_misses();
+  }
+
+  Counter my_sent      = sent - m_global_last_sent;
+  Counter all_traffic  = traffic - m_global_last_traffic;
+  Counter other_demand = demand - m_global_last_demand;
+
+  m_global_last_sent    = sent;
+  m_global_last_traffic = traffic;
+  m_global_last_demand  = demand;
+
+  if (!*m_simBase->m_knobs->KNOB_PREF_THROTTLE_ON || all_traffic == 0 || other_demand == 0)
+    return false;
+
+  return (static_cast<float>(my_sent) / all_traffic > 
+      *m_simBase->m_knobs->KNOB_PREF_THROTTLE_BW_THRESH);
+}
+
+
+// Demand miss at the cache prefetches fill
+void hwp_common_c::pref_l2_demand_miss(Addr line_addr)
+{
+  if (!*m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON)
+    return;
+
+  STAT_EVENT(PREF_POTENTIAL_MISS);
+  m_curr_l2_misses++;
+  m_total_l2_misses++;
+
+  if (*m_simBase->m_knobs->KNOB_PREF_POLBV_ON) {
+    // UPDATE prefpolbv reset entry
+    Addr line_index = (line_addr>>m_shift_bit);
+    if ((*pref_polbv_access(line_index))==1) {
+      m_curr_pfpol++;
+      STAT_EVENT(PREF_PFPOL);
+    }
+    *pref_polbv_access(line_index) = 0;
+  }
+}
+
+
+// Prefetches sent to memory by all prefetchers of this core
+Counter hwp_common_c::pref_get_total_sent(void)
+{
+  Counter sent = 0;
+  for (unsigned int ii = 1; ii < pref_table.size(); ++ii) {
+    sent += pref_table[ii]->hwp_info->total_sent;
+  }
+  return sent;
+}
+
+
+// aggressiveness levels (dyn_degree 0 to 4) : very conservative, conservative, middle,
+// aggressive, very aggressive. Middle is the prefetcher's own degree and distance.
+static const int fdp_degree_shift[]   = {-1, -1, 0, 1, 1};
+static const int fdp_distance_shift[] = {-2, -1, 0, 1, 2};
+
+
+// Prefetch degree at the current aggressiveness level
+uns hwp_common_c::pref_get_degree(uns8 prefetcher_id, uns degree)
+{
+  if (!*m_simBase->m_knobs->KNOB_PREF_THROTTLEFB_ON && !*m_simBase->m_knobs->KNOB_PREF_THROTTLE_ON)
+    return degree;
+
+  int shift = fdp_degree_shift[MIN2(pref_table[prefetcher_id]->hwp_info->dyn_degree, 4)];
+  return (shift < 0) ? MAX2(degree >> -shift, 1) : degree << shift;
+}
+
+
+// Prefetch distance at the current aggressiveness level
+uns hwp_common_c::pref_get_distance(uns8 prefetcher_id, uns distance)
+{
+  if (!*m_simBase->m_knobs->KNOB_PREF_THROTTLEFB_ON && !*m_simBase->m_knobs->KNOB_PREF_THROTTLE_ON)
+    return distance;
+
+  int shift = fdp_distance_shift[MIN2(pref_table[prefetcher_id]->hwp_info->dyn_degree, 4)];
+  return (shift < 0) ? MAX2(distance >> -shift, 1) : distance << shift;
 }
 
 
@@ -1308,7 +1479,8 @@ void  hwp_common_c::pref_update_regioninfo(Addr line_addr, bool l2_hit, bool l2_
 
   region_linenum = (line_addr >> m_shift_bit) & (N_BIT_MASK(LOG2_PREF_REGION_SIZE));
   reg_id = line_addr >> (LOG2_PREF_REGION_SIZE + m_shift_bit);
-  idx = pref_matchregion(reg_id, evict_onPF);
+  // a prefetch also allocates a region, so that hybrid selection can train on it
+  idx = pref_matchregion(reg_id, evict_onPF || prefetcher_id != 0);
 
   if (idx == -1)
     return;
@@ -1346,6 +1518,7 @@ void  hwp_common_c::pref_update_regioninfo(Addr line_addr, bool l2_hit, bool l2_
     }
     status->l2_evict   = false;
     status->evict_onPF = false;
+    status->pref_sent |= (1 << prefetcher_id);
   }
 }
 
@@ -1421,12 +1594,12 @@ void  hwp_common_c::pref_hybrid_makeselection(int reg_idx)
         Counter useful;
         Counter sent;
 				
-        useful = hwp_info->useful - hwp_info->hybrid_lastuseful;
-        sent   = hwp_info->sent   - hwp_info->hybrid_lastsent;
+        useful = hwp_info->total_useful - hwp_info->hybrid_lastuseful;
+        sent   = hwp_info->total_sent   - hwp_info->hybrid_lastsent;
 				
         if (update_ctrs) {
-          hwp_info->hybrid_lastuseful = hwp_info->useful;
-          hwp_info->hybrid_lastsent   = hwp_info->sent;
+          hwp_info->hybrid_lastuseful = hwp_info->total_useful;
+          hwp_info->hybrid_lastsent   = hwp_info->total_sent;
         }
 
         acc = (sent > 20) ? ((float) useful/ (float) sent) : 0.0;  
@@ -1436,10 +1609,10 @@ void  hwp_common_c::pref_hybrid_makeselection(int reg_idx)
         }
       }
     }
-    if (best_pref_id == -1) {
-      best_pref_id = *m_simBase->m_knobs->KNOB_PREF_HYBRID_DEFAULT;
+    // keep the current default until a prefetcher has sent enough
+    if (best_pref_id != -1) {
+      m_default_prefetcher = best_pref_id;
     }
-    m_default_prefetcher = best_pref_id;
   }
 	    
   best_acc     = 0.0;
@@ -1455,9 +1628,6 @@ void  hwp_common_c::pref_hybrid_makeselection(int reg_idx)
 
   for (int ii = 0; ii < *m_simBase->m_knobs->KNOB_PREF_REGION_SIZE; ++ii) {
     bool useful = false;
-    if (0) { // to prevent compilation error, jaekyu (11-3-2009)
-      printf("%d", useful);
-    }
 
     if ((region_info[reg_idx].status[ii].l2_hit || 
           region_info[reg_idx].status[ii].l2_miss)) {
@@ -1465,16 +1635,14 @@ void  hwp_common_c::pref_hybrid_makeselection(int reg_idx)
       mem_accesses++;
     }
 
-
+    // a line prefetched by a prefetcher (selected or not) and then demanded
     for (unsigned int jj = 0; jj < pref_table.size(); ++jj) {
-#if NEED_TO_DEBUG
-      if (g_pref_table[jj].hwp_info->enabled && 
-          TESTBIT(region_info[reg_idx].status[ii].pref_sent, jj)) {
+      if (pref_table[jj]->hwp_info->enabled && 
+          (region_info[reg_idx].status[ii].pref_sent >> jj) & 1) {
         pref_sent[jj]++;
-        if (m_useful) 
+        if (useful) 
           pref_useful[jj]++;
       }
-#endif
     }
   }
 
@@ -54,6 +54,8 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #define PREF_TRACKERS_NUM 16
+// prefetchers with their own stats (PREF_<NAME>_*) : ids 1 to 6 in the factory order
+#define PREF_STAT_NUM 6
 #define LOG2_DCACHE_LINE_SIZE log2_int(m_simBase->m_memory->line_size(core_id))
 #define LOG2_PREF_REGION_SIZE log2_int(*m_simBase->m_knobs->KNOB_PREF_REGION_SIZE)
 
@@ -101,6 +103,9 @@ typedef struct pref_info_s {
   Counter curr_late;            /**< num of current period late prefetches */
   Counter hybrid_lastuseful;    /**< used for Hybrid */
   Counter hybrid_lastsent;      /**< This helps maintain a better indication of recent history */
+  Counter total_useful;         /**< num of useful prefetches (whole run) */
+  Counter total_sent;           /**< num of sent prefetches (whole run) */
+  Counter total_late;           /**< num of late prefetches (whole run) */
   Addr    trackers[PREF_TRACKERS_NUM]; /**< tracking information */
   bool    trackers_used[PREF_TRACKERS_NUM]; /**< tracker used */
   int     track_num; /**< number of tracks */
@@ -290,6 +295,11 @@ class hwp_common_c
     void pref_l2_pref_hit(int tid, Addr line_addr, Addr load_PC, uns8 prefetcher_id, 
         uop_c *uop);
 
+    /**
+     * Demand miss at the cache prefetches fill : miss and pollution counts for feedback
+     */
+    void pref_l2_demand_miss(Addr line_addr);
+
     /**
      * L2 late prefetch hit handler. Late prefetch indicates that prefetch request is
      * begin serviced when a demand arrives.
@@ -346,6 +356,27 @@ class hwp_common_c
      */
     float pref_get_timeliness(uns8 prefetcher_id);
 
+    /**
+     * Prefetch degree of a prefetcher : its own degree, scaled by its aggressiveness level
+     * (dyn_degree) when pref_throttlefb_on or pref_throttle_on is set
+     */
+    uns pref_get_degree(uns8 prefetcher_id, uns degree);
+
+    /**
+     * Prefetch distance of a prefetcher, scaled like pref_get_degree
+     */
+    uns pref_get_distance(uns8 prefetcher_id, uns distance);
+
+    /**
+     * Prefetches sent to memory by this core (whole run)
+     */
+    Counter pref_get_total_sent(void);
+
+    /**
+     * Demand misses of this core at the cache prefetches fill (whole run)
+     */
+    Counter pref_get_total_demand_misses(void) { return m_total_l2_misses; }
+
     /**
      * For hybrid prefetching, try to make a prefetcher selection based on the policy.
      */
@@ -362,17 +393,17 @@ class hwp_common_c
     char* pref_polbv_access(Addr lineIndex);
 
     /**
-     * Update useless prefetch counter for unused prefetch eviction (Deprecated)
+     * Update useless prefetch counter for unused prefetch eviction
      */
     void pref_evictline_notused(Addr);
 
     /**
-     * Update L2 prefetch eviction counter. (Deprecated)
+     * Update L2 prefetch eviction counter; ends a feedback interval
      */
     void pref_l2evict(Addr addr);
 
     /**
-     * L2 eviction by prefetch. Update pollution related data. (Deprecated)
+     * L2 eviction by prefetch. Update pollution related data.
      */
     void pref_l2evictOnPF(Addr addr);
     
@@ -387,7 +418,7 @@ class hwp_common_c
     bool pref_l2req_queue_filter(Addr line_addr);
     
     /**
-     * Event handler : prefetch missed in the l2 and went out on the bus. (Deprecated)
+     * Event handler : prefetch missed in the l2 and went out on the bus.
      */
     void pref_l2sent(uns8 prefetcher_id);
     
@@ -405,6 +436,18 @@ class hwp_common_c
      */
     hwp_common_c();
 
+    /**
+     * End of a feedback interval (pref_update_interval l2 evictions) : update the 
+     * accuracy, lateness and pollution averages and throttle the prefetchers
+     */
+    void pref_update_feedback(void);
+
+    /**
+     * Cross-core throttling : true if the prefetches of this core take more than
+     * pref_throttle_bw_thresh of the memory traffic of all cores while others miss too
+     */
+    bool pref_global_throttle(void);
+
   private:
     int core_id; /**< core id */
     bool knob_ptx_sim; /**< GPU simulation */
@@ -431,6 +474,10 @@ class hwp_common_c
     pref_region_info_s *region_info; /**< prefetch region information */
     Counter m_l2_misses; /**< number of total l2 misses */ 
     Counter m_curr_l2_misses; /**< number of total l2 misses in current period */
+    Counter m_total_l2_misses; /**< number of total l2 misses (whole run) */
+    Counter m_global_last_sent; /**< prefetches sent at the last feedback interval */
+    Counter m_global_last_traffic; /**< traffic of all cores at the last feedback interval */
+    Counter m_global_last_demand; /**< misses of other cores at the last feedback interval */
     Counter m_pfpol; /**< number of prefetch pollution */
     Counter m_curr_pfpol; /**< number of prefetch pollution in current period */
     Counter m_useful;  /**< number of useful prefetches */
@@ -39,6 +39,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "pref_factory.h"
 #include "assert.h"
 #include "pref_stride.h"
+#include "pref_stridepc.h"
+#include "pref_stream.h"
+#include "pref_ghb.h"
+#include "pref_2dc.h"
+#include "pref_phase.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -47,8 +52,13 @@ POSSIBILITY OF SUCH DAMAGE.
 void pref_factory(vector<pref_base_c *> &pref_table, hwp_common_c *hcc, 
                   Unit_Type type, macsim_c* simBase)
 {
-  pref_base_c *pref_stride = new pref_stride_c(hcc, type, simBase);
-  pref_table.push_back(pref_stride);
+  // the order sets the prefetcher ids (1 to PREF_STAT_NUM) and their PREF_<NAME>_* stats
+  pref_table.push_back(new pref_stride_c(hcc, type, simBase));
+  pref_table.push_back(new pref_stridepc_c(hcc, type, simBase));
+  pref_table.push_back(new pref_stream_c(hcc, type, simBase));
+  pref_table.push_back(new pref_ghb_c(hcc, type, simBase));
+  pref_table.push_back(new pref_2dc_c(hcc, type, simBase));
+  pref_table.push_back(new pref_phase_c(hcc, type, simBase));
 } 
 
 
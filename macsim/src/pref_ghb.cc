@@ -0,0 +1,213 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_ghb.cc
+ * Description  : Global history buffer prefetcher (CZone delta correlation)
+ *********************************************************************************************/
+
+
+#include "global_defs.h"
+#include "global_types.h"
+#include "debug_macros.h"
+
+#include "utils.h"
+#include "assert_macros.h"
+#include "memory.h"
+
+#include "pref_ghb.h"
+
+#include "all_knobs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define DEBUG(args...)		_DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_PREF_GHB, ## args)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+pref_ghb_c::pref_ghb_c(hwp_common_c *hcc, Unit_Type type, macsim_c* simBase)
+  : pref_base_c(simBase)
+{
+  name = "ghb";
+  hwp_type = Mem_To_UL1;
+  hwp_common = hcc;
+  switch (type) {
+    case UNIT_SMALL:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_GHB_ON;
+      break;
+    case UNIT_MEDIUM:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_GHB_ON_MEDIUM_CORE;
+      break;
+    case UNIT_LARGE:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_GHB_ON_LARGE_CORE;
+      break;
+  }
+
+  // configuration
+  l1_miss     = true;
+  l2_pref_hit = true;
+
+  m_buffer = NULL;
+  m_index  = NULL;
+}
+
+
+// destructor
+pref_ghb_c::~pref_ghb_c()
+{
+  delete[] m_buffer;
+  delete[] m_index;
+}
+
+
+// initialization
+void pref_ghb_c::init_func(int cid)
+{
+  if (!knob_enable)
+    return;
+
+  core_id   = cid;
+  shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  hwp_info->enabled = true;
+  m_buffer_size     = *m_simBase->m_knobs->KNOB_PREF_GHB_BUFFER_N;
+  m_index_size      = *m_simBase->m_knobs->KNOB_PREF_GHB_INDEX_N;
+  m_buffer          = new ghb_entry_s[m_buffer_size];
+  m_index           = new ghb_index_s[m_index_size];
+  m_next_seq        = 0;
+}
+
+
+// L1 miss training function
+void pref_ghb_c::l1_miss_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr);
+}
+
+
+// prefetched line hit : it would have been a miss
+void pref_ghb_c::l2_pref_hit_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr);
+}
+
+
+// entry of a sequence number
+ghb_entry_s* pref_ghb_c::entry(Counter seq)
+{
+  if (seq >= m_next_seq || seq + m_buffer_size < m_next_seq)
+    return NULL;
+
+  return &m_buffer[seq % m_buffer_size];
+}
+
+
+// insert a miss into the ghb and send prefetches
+void pref_ghb_c::train(Addr line_addr)
+{
+  Addr czone      = line_addr >> *m_simBase->m_knobs->KNOB_PREF_GHB_CZONE_BITS;
+  Addr line_index = line_addr >> shift_bit;
+
+  // index table : hit or lru victim
+  ghb_index_s* index  = NULL;
+  ghb_index_s* victim = &m_index[0];
+  for (uns ii = 0; ii < m_index_size; ++ii) {
+    if (m_index[ii].valid && m_index[ii].czone == czone) {
+      index = &m_index[ii];
+      break;
+    }
+    if (victim->valid && (!m_index[ii].valid ||
+          m_index[ii].last_access < victim->last_access)) {
+      victim = &m_index[ii];
+    }
+  }
+
+  if (index == NULL) {
+    index        = victim;
+    index->valid = true;
+    index->czone = czone;
+    index->head  = m_next_seq; // no previous miss
+  }
+  index->last_access = CYCLE;
+
+  // the same line again
+  ghb_entry_s* last = entry(index->head);
+  if (last && last->line_index == line_index)
+    return;
+
+  // insert
+  ghb_entry_s* new_entry = &m_buffer[m_next_seq % m_buffer_size];
+  new_entry->line_index = line_index;
+  new_entry->prev       = index->head;
+  index->head           = m_next_seq++;
+
+  // walk the czone history (newest first)
+  uns degree = MIN2(hwp_common->pref_get_degree(hwp_info->id, *m_simBase->m_knobs->KNOB_PREF_GHB_DEGREE),
+      *m_simBase->m_knobs->KNOB_PREF_GHB_MAX_DEGREE);
+  uns max_history = 2 * *m_simBase->m_knobs->KNOB_PREF_GHB_MAX_DEGREE + 3;
+  m_history.clear();
+  for (Counter seq = index->head; m_history.size() < max_history; ) {
+    ghb_entry_s* cur = entry(seq);
+    if (cur == NULL)
+      break;
+    m_history.push_back(cur->line_index);
+    if (cur->prev >= seq)
+      break;
+    seq = cur->prev;
+  }
+  if (m_history.size() < 4)
+    return;
+
+  m_delta.clear();
+  for (uns ii = 0; ii + 1 < m_history.size(); ++ii) {
+    m_delta.push_back(static_cast<int64_t>(m_history[ii] - m_history[ii+1]));
+  }
+
+  // the latest delta pair seen earlier : replay the deltas that followed it
+  for (uns jj = 1; jj + 1 < m_delta.size(); ++jj) {
+    if (m_delta[jj] != m_delta[0] || m_delta[jj+1] != m_delta[1])
+      continue;
+
+    DEBUG("core:%d czone:%s line:%s correlation period:%d\n", core_id, hexstr64s(czone),
+        hexstr64s(line_index), jj);
+    Addr pref_index = line_index;
+    for (uns ii = 0; ii < degree; ++ii) {
+      pref_index += m_delta[jj - 1 - (ii % jj)];
+      if (pref_index == line_index)
+        continue;
+      if (!hwp_common->pref_addto_l2req_queue(pref_index, hwp_info->id))
+        break; // queue is full
+    }
+    break;
+  }
+}
@@ -0,0 +1,156 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_ghb.h
+ * Description  : Global history buffer prefetcher (CZone delta correlation)
+ *********************************************************************************************/
+
+#ifndef PREF_GHB_H
+#define PREF_GHB_H
+
+
+#include <vector>
+
+#include "pref_common.h"
+#include "pref.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief global history buffer entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct ghb_entry_s {
+  Addr    line_index; /**< miss line index */
+  Counter prev;       /**< sequence number of the previous miss of the czone */
+} ghb_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief ghb index table entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct ghb_index_s {
+  bool    valid;       /**< valid */
+  Addr    czone;       /**< concentration zone (tag) */
+  Counter head;        /**< sequence number of the last miss of the czone */
+  Counter last_access; /**< lru */
+
+  /**
+   * Constructor
+   */
+  ghb_index_s() {
+    valid = false;
+  }
+} ghb_index_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief global history buffer prefetcher
+///
+/// CZone delta correlation (Nesbit and Smith, HPCA 2004). L2 misses are kept in a circular
+/// buffer of pref_ghb_buffer_n entries, linked per concentration zone (2^pref_ghb_czone_bits
+/// bytes) through an index table of pref_ghb_index_n entries. On a miss, the delta history
+/// of the zone is searched for an earlier occurrence of the two latest deltas; the deltas
+/// that followed it are replayed for pref_ghb_degree prefetches.
+/// @see pref_base_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pref_ghb_c : public pref_base_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pref_ghb_c(hwp_common_c *, Unit_Type, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~pref_ghb_c();
+
+    /**
+     * Init function
+     */
+    void init_func(int);
+
+    /**
+     * Done function
+     */
+    void done_func() {}
+
+    /**
+     * L1 miss function
+     */
+    void l1_miss_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 hit function
+     */
+    void l1_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L1 prefetch hit function
+     */
+    void l1_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 miss function
+     */
+    void l2_miss_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 hit function
+     */
+    void l2_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 prefetch hit function
+     */
+    void l2_pref_hit_func(int, Addr, Addr, uop_c *);
+
+  private:
+    /**
+     * Insert a miss and send prefetches
+     */
+    void train(Addr line_addr);
+
+    /**
+     * Entry of a sequence number still in the buffer (NULL if overwritten)
+     */
+    ghb_entry_s* entry(Counter seq);
+
+  private:
+    ghb_entry_s      *m_buffer; /**< global history buffer */
+    ghb_index_s      *m_index; /**< index table */
+    uns               m_buffer_size; /**< number of buffer entries */
+    uns               m_index_size; /**< number of index entries */
+    Counter           m_next_seq; /**< sequence number of the next miss */
+    vector<Addr>      m_history; /**< misses of the zone, newest first */
+    vector<int64_t>   m_delta; /**< deltas of the zone, newest first */
+};
+
+#endif
@@ -0,0 +1,289 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_phase.cc
+ * Description  : Phase-based footprint prefetcher
+ *********************************************************************************************/
+
+
+#include <algorithm>
+#include <sstream>
+
+#include "global_defs.h"
+#include "global_types.h"
+#include "debug_macros.h"
+
+#include "utils.h"
+#include "assert_macros.h"
+#include "statistics.h"
+#include "memory.h"
+
+#include "pref_phase.h"
+
+#include "all_knobs.h"
+#include "all_stats.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define DEBUG(args...)		_DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_PREF_PHASE, ## args)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// signature histograms are normalized to this total
+#define PHASE_SIG_SCALE 256
+
+
+// constructor
+pref_phase_c::pref_phase_c(hwp_common_c *hcc, Unit_Type type, macsim_c* simBase)
+  : pref_base_c(simBase)
+{
+  name = "phase";
+  hwp_type = Mem_To_UL1;
+  hwp_common = hcc;
+  switch (type) {
+    case UNIT_SMALL:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_PHASE_ON;
+      break;
+    case UNIT_MEDIUM:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_PHASE_ON_MEDIUM_CORE;
+      break;
+    case UNIT_LARGE:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_PHASE_ON_LARGE_CORE;
+      break;
+  }
+
+  // configuration
+  l1_miss     = true;
+  l2_pref_hit = true;
+
+  m_region    = NULL;
+  m_phase     = NULL;
+  m_study_out = NULL;
+}
+
+
+// destructor
+pref_phase_c::~pref_phase_c()
+{
+  delete[] m_region;
+  delete[] m_phase;
+  if (m_study_out)
+    fclose(m_study_out);
+}
+
+
+// initialization
+void pref_phase_c::init_func(int cid)
+{
+  if (!knob_enable)
+    return;
+
+  core_id   = cid;
+  shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  hwp_info->enabled = true;
+  m_region_size     = *m_simBase->m_knobs->KNOB_PREF_PHASE_INFOSIZE;
+  m_region_hash     = *m_simBase->m_knobs->KNOB_PREF_PHASE_PRIME_HASH;
+  m_num_phase       = *m_simBase->m_knobs->KNOB_PREF_PHASE_TABLE_SIZE;
+  m_region_lines    = 1 << (*m_simBase->m_knobs->KNOB_PREF_PHASE_LOG2REGIONSIZE - LOG2_DCACHE_LINE_SIZE);
+
+  ASSERTM(m_region_hash > 0 && m_region_hash <= m_region_size,
+      "pref_phase_prime_hash:%d pref_phase_infosize:%d\n", m_region_hash, m_region_size);
+  uns region_entries = *m_simBase->m_knobs->KNOB_PREF_PHASE_REGIONENTRIES;
+  ASSERTM(m_region_lines == region_entries && m_region_lines <= 64,
+      "pref_phase_regionentries:%d must be the lines per region (at most 64)\n", region_entries);
+
+  m_region = new phase_region_s[m_region_size];
+  m_phase  = new phase_entry_s[m_num_phase];
+  m_miss_hist.assign(*m_simBase->m_knobs->KNOB_PREF_PHASE_TRACKEDREGIONS, 0);
+
+  m_num_miss       = 0;
+  m_interval       = 0;
+  m_interval_start = CYCLE;
+  m_cur_phase      = -1;
+  m_next_phase_id  = 0;
+
+  if (*m_simBase->m_knobs->KNOB_PREF_PHASE_STUDY) {
+    stringstream sstr;
+    sstr << "pref_phase_core" << core_id;
+    m_study_out = file_tag_fopen(sstr.str(), "w", m_simBase);
+    if (m_study_out)
+      fprintf(m_study_out, "interval phase misses recurring distance\n");
+  }
+}
+
+
+// L1 miss training function
+void pref_phase_c::l1_miss_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr);
+}
+
+
+// prefetched line hit : it would have been a miss
+void pref_phase_c::l2_pref_hit_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr);
+}
+
+
+// record a miss and prefetch the footprint of its region
+void pref_phase_c::train(Addr line_addr)
+{
+  if (CYCLE - m_interval_start >= *m_simBase->m_knobs->KNOB_PREF_PHASE_INTERVAL)
+    end_interval();
+
+  Addr region = line_addr >> *m_simBase->m_knobs->KNOB_PREF_PHASE_LOG2REGIONSIZE;
+  uns  offset = (line_addr >> shift_bit) & (m_region_lines - 1);
+  uns  slot   = region % m_region_hash;
+
+  phase_region_s* entry = &m_region[slot];
+  if (!entry->valid || entry->region != region) {
+    if (entry->valid) {
+      STAT_EVENT(PREF_PHASE_OVERWRITE_PAGE);
+    }
+    entry->valid            = true;
+    entry->region           = region;
+    entry->cur_mask         = 0;
+    entry->footprint        = 0;
+    entry->phase            = -1;
+    entry->trigger_interval = m_interval;
+  }
+
+  if (entry->cur_mask == 0)
+    m_touched.push_back(slot);
+  entry->cur_mask |= (static_cast<uns64>(1) << offset);
+
+  ++m_miss_hist[region % m_miss_hist.size()];
+  ++m_num_miss;
+
+  // first miss to the region in a recurring phase : prefetch its footprint
+  if (m_cur_phase == -1 || entry->phase != m_cur_phase || entry->trigger_interval == m_interval)
+    return;
+  entry->trigger_interval = m_interval;
+
+  uns64 footprint = entry->footprint & ~entry->cur_mask;
+  if (__builtin_popcountll(entry->footprint) <
+      *m_simBase->m_knobs->KNOB_PREF_PHASE_MISSPER * m_region_lines)
+    return;
+
+  DEBUG("core:%d region:%s phase:%d footprint:%s\n", core_id, hexstr64s(region), m_cur_phase,
+      hexstr64s(entry->footprint));
+  Addr region_index = region * m_region_lines;
+  for (uns ii = 0; ii < m_region_lines; ++ii) {
+    if (!(footprint & (static_cast<uns64>(1) << ii)))
+      continue;
+    if (!hwp_common->pref_addto_l2req_queue(region_index + ii, hwp_info->id))
+      break; // queue is full
+  }
+}
+
+
+// classify the finished interval and commit the region footprints
+void pref_phase_c::end_interval(void)
+{
+  int  phase     = -1;
+  bool recurring = false;
+  uns  best_dist = 0;
+
+  if (m_num_miss >= *m_simBase->m_knobs->KNOB_PREF_PHASE_MIN_MISSES) {
+    vector<uns> signature(m_miss_hist.size());
+    for (uns ii = 0; ii < m_miss_hist.size(); ++ii) {
+      signature[ii] = m_miss_hist[ii] * PHASE_SIG_SCALE / m_num_miss;
+    }
+
+    // closest known phase
+    phase_entry_s* match  = NULL;
+    phase_entry_s* victim = &m_phase[0];
+    for (uns ii = 0; ii < m_num_phase; ++ii) {
+      phase_entry_s* cur = &m_phase[ii];
+      if (!cur->valid) {
+        if (victim->valid)
+          victim = cur;
+        continue;
+      }
+      if (victim->valid && cur->last_access < victim->last_access)
+        victim = cur;
+
+      uns dist = 0;
+      for (uns jj = 0; jj < signature.size(); ++jj) {
+        dist += (cur->signature[jj] > signature[jj]) ? cur->signature[jj] - signature[jj] :
+          signature[jj] - cur->signature[jj];
+      }
+      if (dist <= *m_simBase->m_knobs->KNOB_PREF_PHASE_MAXDIFF_THRESH &&
+          (match == NULL || dist < best_dist)) {
+        match     = cur;
+        best_dist = dist;
+      }
+    }
+
+    if (match == NULL) {
+      match            = victim;
+      match->valid     = true;
+      match->id        = m_next_phase_id++;
+      match->signature = signature;
+    }
+    else {
+      recurring = true;
+    }
+    match->last_access = CYCLE;
+    phase = match->id;
+
+    DEBUG("core:%d interval:%lld phase:%d misses:%d recurring:%d\n", core_id,
+        (long long)m_interval, phase, m_num_miss, recurring);
+  }
+
+  if (m_study_out) {
+    fprintf(m_study_out, "%lld %d %d %d %d\n", (long long)m_interval, phase, m_num_miss,
+        recurring, best_dist);
+  }
+
+  // the footprints of this interval belong to its phase
+  for (uns ii = 0; ii < m_touched.size(); ++ii) {
+    phase_region_s* entry = &m_region[m_touched[ii]];
+    if (entry->cur_mask == 0)
+      continue;
+    if (phase != -1) {
+      entry->footprint = entry->cur_mask;
+      entry->phase     = phase;
+    }
+    entry->cur_mask = 0;
+  }
+  m_touched.clear();
+
+  fill(m_miss_hist.begin(), m_miss_hist.end(), 0);
+  m_num_miss       = 0;
+  m_cur_phase      = phase; // phases are assumed to last more than one interval
+  m_interval_start = CYCLE;
+  ++m_interval;
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_phase.h
+ * Description  : Phase-based footprint prefetcher
+ *********************************************************************************************/
+
+#ifndef PREF_PHASE_H
+#define PREF_PHASE_H
+
+
+#include <cstdio>
+#include <vector>
+
+#include "pref_common.h"
+#include "pref.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief footprint of a memory region
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct phase_region_s {
+  bool    valid;          /**< valid */
+  Addr    region;         /**< region number (tag) */
+  uns64   cur_mask;       /**< lines missed in the current interval */
+  uns64   footprint;      /**< lines missed in the last interval the region was active */
+  int     phase;          /**< phase of the interval that recorded footprint */
+  Counter trigger_interval; /**< last interval the footprint was prefetched */
+
+  /**
+   * Constructor
+   */
+  phase_region_s() {
+    valid = false;
+  }
+} phase_region_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief phase table entry : normalized miss signature of a phase
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct phase_entry_s {
+  bool        valid;       /**< valid */
+  int         id;          /**< phase id */
+  vector<uns> signature;   /**< miss share of each tracked region bucket */
+  Counter     last_access; /**< lru */
+
+  /**
+   * Constructor
+   */
+  phase_entry_s() {
+    valid = false;
+  }
+} phase_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief phase-based footprint prefetcher
+///
+/// Execution is cut into intervals of pref_phase_interval cycles. The L2 misses of an interval
+/// are bucketed into pref_phase_trackedregions region groups; the normalized histogram is the
+/// phase signature, matched against a table of pref_phase_table_size known phases
+/// (Manhattan distance <= pref_phase_maxdiff_thresh). Each 2^pref_phase_log2regionsize byte
+/// region remembers the lines missed in the last interval it was active, tagged with that
+/// interval's phase. While the same phase runs again, the first miss to a region prefetches
+/// its footprint, if it covers at least pref_phase_missper of the region.
+/// @see pref_base_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pref_phase_c : public pref_base_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pref_phase_c(hwp_common_c *, Unit_Type, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~pref_phase_c();
+
+    /**
+     * Init function
+     */
+    void init_func(int);
+
+    /**
+     * Done function
+     */
+    void done_func() {}
+
+    /**
+     * L1 miss function
+     */
+    void l1_miss_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 hit function
+     */
+    void l1_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L1 prefetch hit function
+     */
+    void l1_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 miss function
+     */
+    void l2_miss_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 hit function
+     */
+    void l2_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 prefetch hit function
+     */
+    void l2_pref_hit_func(int, Addr, Addr, uop_c *);
+
+  private:
+    /**
+     * Record a miss and prefetch the footprint of its region
+     */
+    void train(Addr line_addr);
+
+    /**
+     * Close the current interval : classify its phase and commit the footprints
+     */
+    void end_interval(void);
+
+  private:
+    phase_region_s *m_region; /**< region footprint table */
+    phase_entry_s  *m_phase; /**< phase table */
+    uns             m_region_size; /**< region table entries */
+    uns             m_region_hash; /**< region placement modulo */
+    uns             m_region_lines; /**< lines per region */
+    uns             m_num_phase; /**< phase table entries */
+    vector<uns>     m_miss_hist; /**< misses of each region bucket in this interval */
+    vector<uns>     m_touched; /**< region entries missed in this interval */
+    uns             m_num_miss; /**< misses in this interval */
+    Counter         m_interval; /**< current interval number */
+    Counter         m_interval_start; /**< first cycle of the current interval */
+    int             m_cur_phase; /**< phase predicted for this interval (-1 : unknown) */
+    int             m_next_phase_id; /**< id of the next new phase */
+    FILE           *m_study_out; /**< per-interval phase log (pref_phase_study) */
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_stream.cc
+ * Description  : Stream prefetcher
+ *********************************************************************************************/
+
+
+#include "global_defs.h"
+#include "global_types.h"
+#include "debug_macros.h"
+
+#include "utils.h"
+#include "assert_macros.h"
+#include "memory.h"
+
+#include "pref_stream.h"
+
+#include "all_knobs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define DEBUG(args...)		_DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_PREF, ## args)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+pref_stream_c::pref_stream_c(hwp_common_c *hcc, Unit_Type type, macsim_c* simBase)
+  : pref_base_c(simBase)
+{
+  name = "stream";
+  hwp_type = Mem_To_UL1;
+  hwp_common = hcc;
+  switch (type) {
+    case UNIT_SMALL:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STREAM_ON;
+      break;
+    case UNIT_MEDIUM:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STREAM_ON_MEDIUM_CORE;
+      break;
+    case UNIT_LARGE:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STREAM_ON_LARGE_CORE;
+      break;
+  }
+
+  // configuration
+  l1_miss     = true;
+  l2_pref_hit = true;
+
+  m_stream = NULL;
+}
+
+
+// destructor
+pref_stream_c::~pref_stream_c()
+{
+  delete[] m_stream;
+}
+
+
+// initialization
+void pref_stream_c::init_func(int cid)
+{
+  if (!knob_enable)
+    return;
+
+  core_id   = cid;
+  shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  hwp_info->enabled = true;
+  m_num_stream      = *m_simBase->m_knobs->KNOB_STREAM_BUFFER_N;
+  m_stream          = new stream_buffer_s[m_num_stream];
+}
+
+
+// L1 miss training function
+void pref_stream_c::l1_miss_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr >> shift_bit);
+}
+
+
+// prefetched line hit : the stream is still in use
+void pref_stream_c::l2_pref_hit_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr >> shift_bit);
+}
+
+
+// train streams
+void pref_stream_c::train(Addr line_index)
+{
+  stream_buffer_s* victim = &m_stream[0];
+
+  // monitoring : demand in the window of a trained stream
+  for (uns ii = 0; ii < m_num_stream; ++ii) {
+    stream_buffer_s* stream = &m_stream[ii];
+    if (!stream->valid) {
+      if (victim->valid)
+        victim = stream;
+      continue;
+    }
+    if (victim->valid && stream->last_access < victim->last_access)
+      victim = stream;
+
+    if (!stream->trained)
+      continue;
+
+    // start_index <= line_index <= pref_index in the stream direction
+    int64_t from_start = static_cast<int64_t>(line_index - stream->start_index) * stream->dir;
+    int64_t to_end     = static_cast<int64_t>(stream->pref_index - line_index) * stream->dir;
+    if (from_start >= 0 && to_end >= 0) {
+      stream->last_access = CYCLE;
+      send(stream, hwp_common->pref_get_degree(hwp_info->id,
+            *m_simBase->m_knobs->KNOB_STREAM_PREFETCH_N));
+      return;
+    }
+  }
+
+  // training : miss close to the first miss of a stream
+  for (uns ii = 0; ii < m_num_stream; ++ii) {
+    stream_buffer_s* stream = &m_stream[ii];
+    if (!stream->valid || stream->trained)
+      continue;
+
+    int64_t delta = static_cast<int64_t>(line_index - stream->start_index);
+    if (delta == 0)
+      return;
+    if (delta > static_cast<int64_t>(*m_simBase->m_knobs->KNOB_STREAM_TRAIN_LENGTH) ||
+        -delta > static_cast<int64_t>(*m_simBase->m_knobs->KNOB_STREAM_TRAIN_LENGTH))
+      continue;
+
+    int dir = (delta > 0) ? 1 : -1;
+    if (stream->train_hit == 0 || stream->dir != dir) {
+      stream->dir       = dir;
+      stream->train_hit = 0;
+    }
+    ++stream->train_hit;
+    stream->last_access = CYCLE;
+
+    if (stream->train_hit >= *m_simBase->m_knobs->KNOB_STREAM_TRAIN_NUM) {
+      stream->trained     = true;
+      stream->start_index = line_index;
+      stream->pref_index  = line_index;
+      DEBUG("core:%d stream:%d trained index:%s dir:%d\n", core_id, ii,
+          hexstr64s(line_index), dir);
+      send(stream, *m_simBase->m_knobs->KNOB_STREAM_START_DIS);
+    }
+    return;
+  }
+
+  // allocate a new stream
+  victim->valid       = true;
+  victim->trained     = false;
+  victim->dir         = 1;
+  victim->start_index = line_index;
+  victim->pref_index  = line_index;
+  victim->train_hit   = 0;
+  victim->last_access = CYCLE;
+}
+
+
+// send prefetches and slide the window (at most stream_length lines)
+void pref_stream_c::send(stream_buffer_s* stream, uns num)
+{
+  uns length = hwp_common->pref_get_distance(hwp_info->id, *m_simBase->m_knobs->KNOB_STREAM_LENGTH);
+  for (uns ii = 0; ii < num; ++ii) {
+    Addr pref_index = stream->pref_index + stream->dir;
+    if (!hwp_common->pref_addto_l2req_queue(pref_index, hwp_info->id))
+      break; // queue is full
+
+    stream->pref_index = pref_index;
+    if (static_cast<int64_t>(stream->pref_index - stream->start_index) * stream->dir >
+        static_cast<int64_t>(length)) {
+      stream->start_index += stream->dir;
+    }
+  }
+}
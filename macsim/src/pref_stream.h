@@ -0,0 +1,144 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_stream.h
+ * Description  : Stream prefetcher
+ *********************************************************************************************/
+
+#ifndef PREF_STREAM_H
+#define PREF_STREAM_H
+
+
+#include "pref_common.h"
+#include "pref.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief stream buffer (stream tracking entry)
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct stream_buffer_s {
+  bool    valid;       /**< valid */
+  bool    trained;     /**< direction confirmed, prefetching */
+  int     dir;         /**< direction (+1 / -1) */
+  Addr    start_index; /**< training : first miss, monitoring : start of the window */
+  Addr    pref_index;  /**< last prefetched line index (end of the window) */
+  uns     train_hit;   /**< misses seen in the direction while training */
+  Counter last_access; /**< lru */
+
+  /**
+   * Constructor
+   */
+  stream_buffer_s() {
+    valid = false;
+  }
+} stream_buffer_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief stream prefetcher
+///
+/// Tracks stream_buffer_n streams of L2 misses (IBM POWER4 style, as in Srinath et al.,
+/// HPCA 2007). A miss starts a stream; stream_train_num misses within stream_train_length
+/// lines in one direction train it and the first stream_start_dis lines are prefetched.
+/// A trained stream monitors the window of stream_length lines behind its last prefetch;
+/// a demand miss or a prefetched-line hit in the window sends stream_prefetch_n more
+/// prefetches and slides the window.
+/// @see pref_base_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pref_stream_c : public pref_base_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pref_stream_c(hwp_common_c *, Unit_Type, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~pref_stream_c();
+
+    /**
+     * Init function
+     */
+    void init_func(int);
+
+    /**
+     * Done function
+     */
+    void done_func() {}
+
+    /**
+     * L1 miss function
+     */
+    void l1_miss_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 hit function
+     */
+    void l1_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L1 prefetch hit function
+     */
+    void l1_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 miss function
+     */
+    void l2_miss_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 hit function
+     */
+    void l2_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 prefetch hit function
+     */
+    void l2_pref_hit_func(int, Addr, Addr, uop_c *);
+
+  private:
+    /**
+     * Train streams with a line index
+     */
+    void train(Addr line_index);
+
+    /**
+     * Send prefetches of a stream
+     */
+    void send(stream_buffer_s* stream, uns num);
+
+  private:
+    stream_buffer_s *m_stream; /**< streams */
+    uns              m_num_stream; /**< number of streams */
+};
+
+#endif
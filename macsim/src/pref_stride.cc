@@ -300,13 +300,14 @@ void pref_stride_c::train(int tid, Addr lineAddr, Addr loadPC, bool l2_hit)
   // entry has been already trained
   else {
     Addr pref_index;
+    int degree   = hwp_common->pref_get_degree(hwp_info->id, *KNOB(KNOB_PREF_STRIDE_DEGREE));
+    int distance = hwp_common->pref_get_distance(hwp_info->id, *KNOB(KNOB_PREF_STRIDE_DISTANCE));
     if (entry->pref_sent)
       entry->pref_sent--;
     // single stride case
     if (entry->num_states == 1 && stride == entry->stride[0]) {
       for (ii = 0; 
-          (ii < *KNOB(KNOB_PREF_STRIDE_DEGREE) && 
-           entry->pref_sent < *KNOB(KNOB_PREF_STRIDE_DISTANCE)); 
+          (ii < degree && entry->pref_sent < distance); 
           ++ii, entry->pref_sent++) {
         pref_index = entry->pref_last_index + entry->stride[0];
         if (!hwp_common->pref_addto_l2req_queue(pref_index, hwp_info->id))
@@ -329,8 +330,7 @@ void pref_stride_c::train(int tid, Addr lineAddr, Addr loadPC, bool l2_hit)
       }
       // now send out prefetches
       for (ii = 0; 
-          (ii < *KNOB(KNOB_PREF_STRIDE_DEGREE) && 
-           entry->pref_sent < *KNOB(KNOB_PREF_STRIDE_DISTANCE)); 
+          (ii < degree && entry->pref_sent < distance); 
           ++ii, entry->pref_sent++) { 
         if (entry->pref_count == entry->s_cnt[entry->pref_curr_state]){
           pref_index = entry->pref_last_index + entry->strans[entry->pref_curr_state];
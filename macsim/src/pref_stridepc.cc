@@ -0,0 +1,207 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_stridepc.cc
+ * Description  : PC-based stride prefetcher
+ *********************************************************************************************/
+
+
+#include "global_defs.h"
+#include "global_types.h"
+#include "debug_macros.h"
+
+#include "utils.h"
+#include "assert_macros.h"
+#include "memory.h"
+
+#include "pref_stridepc.h"
+
+#include "all_knobs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define DEBUG(args...)		_DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_PREF_STRIDEPC, ## args)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+pref_stridepc_c::pref_stridepc_c(hwp_common_c *hcc, Unit_Type type, macsim_c* simBase)
+  : pref_base_c(simBase)
+{
+  name = "stridepc";
+  hwp_type = Mem_To_UL1;
+  hwp_common = hcc;
+  switch (type) {
+    case UNIT_SMALL:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_ON;
+      break;
+    case UNIT_MEDIUM:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_ON_MEDIUM_CORE;
+      break;
+    case UNIT_LARGE:
+      knob_enable = *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_ON_LARGE_CORE;
+      break;
+  }
+
+  // configuration
+  l1_miss = true;
+  l1_hit  = true;
+
+  m_table = NULL;
+}
+
+
+// destructor
+pref_stridepc_c::~pref_stridepc_c()
+{
+  delete[] m_table;
+}
+
+
+// initialization
+void pref_stridepc_c::init_func(int cid)
+{
+  if (!knob_enable)
+    return;
+
+  core_id   = cid;
+  shift_bit = LOG2_DCACHE_LINE_SIZE;
+
+  hwp_info->enabled = true;
+  m_table_size      = *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_TABLE_N;
+  m_table           = new stridepc_table_entry_s[m_table_size];
+}
+
+
+// L1 miss training function
+void pref_stridepc_c::l1_miss_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr, load_pc);
+}
+
+
+// L1 hit training function
+void pref_stridepc_c::l1_hit_func(int tid, Addr line_addr, Addr load_pc, uop_c *uop)
+{
+  train(line_addr, load_pc);
+}
+
+
+// train the entry of the load and send prefetches
+void pref_stridepc_c::train(Addr line_addr, Addr load_pc)
+{
+  if (load_pc == 0)
+    return;
+
+  bool use_addr = *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_USELOADADDR;
+  Addr addr     = use_addr ? line_addr : (line_addr >> shift_bit);
+
+  // search the table : hit or lru victim
+  stridepc_table_entry_s* entry  = NULL;
+  stridepc_table_entry_s* victim = &m_table[0];
+  for (uns ii = 0; ii < m_table_size; ++ii) {
+    if (m_table[ii].valid && m_table[ii].load_pc == load_pc) {
+      entry = &m_table[ii];
+      break;
+    }
+    if (victim->valid && (!m_table[ii].valid ||
+          m_table[ii].last_access < victim->last_access)) {
+      victim = &m_table[ii];
+    }
+  }
+
+  // new load
+  if (entry == NULL) {
+    victim->valid          = true;
+    victim->load_pc        = load_pc;
+    victim->last_addr      = addr;
+    victim->stride         = 0;
+    victim->train_num      = 0;
+    victim->trained        = false;
+    victim->pref_last_addr = addr;
+    victim->last_access    = CYCLE;
+    return;
+  }
+
+  entry->last_access = CYCLE;
+
+  int64_t stride = static_cast<int64_t>(addr - entry->last_addr);
+  if (stride == 0)
+    return;
+
+  entry->last_addr = addr;
+  if (stride == entry->stride) {
+    if (entry->train_num < *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_TRAINNUM)
+      ++entry->train_num;
+  }
+  else {
+    entry->stride    = stride;
+    entry->train_num = 1;
+    entry->trained   = false;
+    return;
+  }
+
+  if (entry->train_num < *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_TRAINNUM)
+    return;
+
+  // newly trained (or fell behind the demand) : start pref_stridepc_startdis strides ahead
+  int64_t ahead = static_cast<int64_t>(entry->pref_last_addr - addr) / stride;
+  if (!entry->trained || ahead <= 0) {
+    entry->trained        = true;
+    entry->pref_last_addr = addr + stride *
+      (static_cast<int64_t>(*m_simBase->m_knobs->KNOB_PREF_STRIDEPC_STARTDIS) - 1);
+    DEBUG("core:%d pc:%s trained stride:%lld\n", core_id, hexstr64s(load_pc),
+        (long long)stride);
+  }
+
+  uns degree = hwp_common->pref_get_degree(hwp_info->id,
+      *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_DEGREE);
+  uns distance = hwp_common->pref_get_distance(hwp_info->id,
+      *m_simBase->m_knobs->KNOB_PREF_STRIDEPC_DISTANCE);
+
+  Addr last_line = use_addr ? (entry->pref_last_addr >> shift_bit) : entry->pref_last_addr;
+  for (uns ii = 0; ii < degree; ++ii) {
+    Addr pref_addr = entry->pref_last_addr + stride;
+    if (static_cast<int64_t>(pref_addr - addr) / stride > static_cast<int64_t>(distance))
+      break;
+
+    // byte strides smaller than a line touch the same line several times
+    Addr pref_line = use_addr ? (pref_addr >> shift_bit) : pref_addr;
+    if (pref_line != last_line &&
+        !hwp_common->pref_addto_l2req_queue(pref_line, hwp_info->id, load_pc))
+      break; // queue is full
+
+    entry->pref_last_addr = pref_addr;
+    last_line = pref_line;
+  }
+}
@@ -0,0 +1,139 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : pref_stridepc.h
+ * Description  : PC-based stride prefetcher
+ *********************************************************************************************/
+
+#ifndef PREF_STRIDEPC_H
+#define PREF_STRIDEPC_H
+
+
+#include "pref_common.h"
+#include "pref.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief stride-pc prefetcher table entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct stridepc_table_entry_s {
+  bool    valid;          /**< valid */
+  Addr    load_pc;        /**< load pc (tag) */
+  Addr    last_addr;      /**< last address (line index unless pref_stridepc_useloadaddr) */
+  int64_t stride;         /**< stride */
+  uns     train_num;      /**< number of times the stride has been seen in a row */
+  bool    trained;        /**< trained */
+  Addr    pref_last_addr; /**< last prefetched address */
+  Counter last_access;    /**< lru */
+
+  /**
+   * Constructor
+   */
+  stridepc_table_entry_s() {
+    valid = false;
+  }
+} stridepc_table_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief stride-pc prefetcher
+///
+/// Reference prediction table indexed by the load pc (Chen and Baer, 1995). A load whose
+/// stride has repeated pref_stridepc_trainnum times starts prefetching
+/// pref_stridepc_startdis strides ahead, pref_stridepc_degree lines per access and at most
+/// pref_stridepc_distance strides ahead of the demand. Strides are in lines, or in bytes with
+/// pref_stridepc_useloadaddr. Trains on L2 accesses.
+/// @see pref_base_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+class pref_stridepc_c : public pref_base_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    pref_stridepc_c(hwp_common_c *, Unit_Type, macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~pref_stridepc_c();
+
+    /**
+     * Init function
+     */
+    void init_func(int);
+
+    /**
+     * Done function
+     */
+    void done_func() {}
+
+    /**
+     * L1 miss function
+     */
+    void l1_miss_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 hit function
+     */
+    void l1_hit_func(int, Addr, Addr, uop_c *);
+
+    /**
+     * L1 prefetch hit function
+     */
+    void l1_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 miss function
+     */
+    void l2_miss_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 hit function
+     */
+    void l2_hit_func(int, Addr, Addr, uop_c *) {}
+
+    /**
+     * L2 prefetch hit function
+     */
+    void l2_pref_hit_func(int, Addr, Addr, uop_c *) {}
+
+  private:
+    /**
+     * Train the entry of the load pc and send prefetches
+     */
+    void train(Addr line_addr, Addr load_pc);
+
+  private:
+    stridepc_table_entry_s *m_table; /**< reference prediction table */
+    uns                     m_table_size; /**< number of entries */
+};
+
+#endif
@@ -835,7 +835,7 @@ int process_manager_c::terminate_thread(int core_id, thread_s* trace_info, int t
     m_simBase->m_core_end_trace[core_id] = true;
 
   // Mark thread terminated
-  core->m_thread_finished[thread_id] = 1; 
+  core->m_thread_state->m_thread_finished[core->get_thread_slot(thread_id)] = true; 
 
   // final heartbeat for the thread
   core->final_heartbeat(thread_id);
@@ -1051,13 +1051,13 @@ void process_manager_c::sim_thread_schedule(bool initial)
     core_c* core = m_simBase->m_core_pointers[core_id];
 
     if (*KNOB(KNOB_ROUTER_PLACEMENT) == 1 &&
-        core->get_core_type() != "ptx" &&
+        !core->is_ptx() &&
         (core_id < *KNOB(KNOB_CORE_ENABLE_BEGIN) || core_id > *KNOB(KNOB_CORE_ENABLE_END))) 
         continue;
 
     if (core->m_running_thread_num < core->get_max_threads_per_core()) {
       // schedule a thread to x86 core
-      if (core->get_core_type() != "ptx") {
+      if (!core->is_ptx()) {
         // fetch a new thread
         trace_to_run = fetch_thread();
         if (trace_to_run != NULL) {
@@ -1089,7 +1089,7 @@ void process_manager_c::sim_thread_schedule(bool initial)
         }
       }
       // GPU simulation
-      else if (core->get_core_type() == "ptx") { 
+      else if (core->is_ptx()) { 
         // get currently fetching id
         int prev_fetching_block_id = core->m_fetching_block_id;
 
@@ -52,6 +52,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "memory.h"
 #include "memreq_info.h"
 #include "readonly_cache.h"
+#include "schedule.h"
 #include "statistics.h"
 #include "uop.h"
 #include "utils.h"
@@ -129,7 +130,7 @@ int readonly_cache_c::load(uop_c *uop)
     Mem_Req_Type req_type = MRT_DFETCH;
 
     // generate a new request
-    int req_status = m_simBase->m_memory->new_mem_req(req_type, line_addr, uop->m_mem_size,
+    int req_status = m_simBase->m_memory->new_mem_req(req_type, line_addr, uop->m_warm->m_mem_size,
         false, false, m_cache_cycles - 1 + *KNOB(KNOB_EXTRA_LD_LATENCY), uop, 
         readonly_cache_fill_line_wrapper, uop->m_unique_num, NULL, m_core_id, 
         uop->m_thread_id, 1);
@@ -157,6 +158,7 @@ bool readonly_cache_fill_line_wrapper(mem_req_s* req)
   macsim_c* m_simBase = req->m_simBase;
   list<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E = req->m_merge.end(); I != E; ++I) {
+    (*I)->m_service_level = req->m_service_level;
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
       continue;
@@ -202,6 +204,7 @@ bool readonly_cache_c::cache_fill_line(mem_req_s *req)
     DEBUG("uop:%lld done\n", uop->m_uop_num);
     uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
     uop->m_state = OS_SCHEDULED;
+    m_simBase->m_core_pointers[uop->m_core_id]->get_scheduler()->wakeup(uop);
 
     if (uop->m_mem_type == MEM_LD_CM) {
       POWER_CORE_EVENT(uop->m_core_id, POWER_CONST_CACHE_W);
@@ -213,10 +216,10 @@ bool readonly_cache_c::cache_fill_line(mem_req_s *req)
     }
 
     // multiple uops case : let parent uop know
-    if (uop->m_parent_uop) {
-      uop_c* puop = uop->m_parent_uop;
-      ++puop->m_num_child_uops_done;
-      if (puop->m_num_child_uops_done == puop->m_num_child_uops) {
+    if (uop->m_warm->m_parent_uop) {
+      uop_c* puop = uop->m_warm->m_parent_uop;
+      ++puop->m_warm->m_num_child_uops_done;
+      if (puop->m_warm->m_num_child_uops_done == puop->m_warm->m_num_child_uops) {
         if (*m_simBase->m_knobs->KNOB_FETCH_ONLY_LOAD_READY) {
           // set load ready
           core_c* core = m_simBase->m_core_pointers[puop->m_core_id];
@@ -225,6 +228,7 @@ bool readonly_cache_c::cache_fill_line(mem_req_s *req)
 
         puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;;
         puop->m_state = OS_SCHEDULED;
+        m_simBase->m_core_pointers[puop->m_core_id]->get_scheduler()->wakeup(puop);
       }
     } // uop->m_parent_uop
     else {
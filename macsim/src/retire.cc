@@ -77,8 +77,10 @@ POSSIBILITY OF SUCH DAMAGE.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include "allocate.h"
 #include "bug_detector.h"
 #include "core.h"
+#include "cpi_stack.h"
 #include "frontend.h"
 #include "process_manager.h"
 #include "retire.h"
@@ -109,6 +111,13 @@ retire_c::retire_c(RETIRE_INTERFACE_PARAMS(), macsim_c* simBase) : RETIRE_INTERF
 
   if (m_knob_ptx_sim)
     m_knob_width = 1000;
+
+  switch (m_core_kind) {
+    case CORE_X86_OOO: m_retire_uops = &retire_c::retire_uops<CORE_X86_OOO>; break;
+    case CORE_X86_IO:  m_retire_uops = &retire_c::retire_uops<CORE_X86_IO>;  break;
+    case CORE_PTX:     m_retire_uops = &retire_c::retire_uops<CORE_PTX>;     break;
+    case CORE_PTX_SM:  m_retire_uops = &retire_c::retire_uops<CORE_PTX_SM>;  break;
+  }
 }
 
 
@@ -129,25 +138,40 @@ void retire_c::run_a_cycle()
   }
 
   m_cur_core_cycle = m_simBase->m_core_cycle[m_core_id];
+
+  (this->*m_retire_uops)();
+}
+
+
+// retirement loop : the core pipeline kind is a template parameter, so the x86/ptx
+// choices below are resolved at compile time
+template <Core_Kind K>
+void retire_c::retire_uops(void)
+{
+  const bool ptx_sim   = (K == CORE_PTX || K == CORE_PTX_SM);
+  const bool gpu_sched = (K == CORE_PTX_SM);
+
   core_c *core = m_simBase->m_core_pointers[m_core_id];
     
   vector<uop_c*>* uop_list = NULL;
   unsigned int uop_list_index = 0;
-  if (m_knob_ptx_sim && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+  if (gpu_sched) {
     // GPU : many retireable uops from multiple threads. Get entire retireable uops
     uop_list = m_gpu_rob->get_n_uops_in_ready_order(m_knob_width, m_cur_core_cycle);
   }
 
 
   // retire instructions : all micro-ops within an inst. need to be retired for an inst.
-  for (int count = 0; count < m_knob_width; ++count) {
+  int count;
+  uop_c* head = NULL; // uop that blocks the rob head
+  for (count = 0; count < m_knob_width; ++count) {
     uop_c* cur_uop;
     rob_c* rob;
 
     // we need to handle retirement for x86 and ptx separately
     
     // retirement logic for GPU
-    if (m_knob_ptx_sim && *m_simBase->m_knobs->KNOB_GPU_SCHED) {
+    if (gpu_sched) {
       // GPU : many retireable uops from multiple threads. Get entire retireable uops
       if (uop_list_index == uop_list->size()) {
         uop_list->clear();
@@ -171,7 +195,8 @@ void retire_c::run_a_cycle()
       cur_uop = rob->front();
 
       // uop cannot be retired
-      if (!cur_uop->m_done_cycle || cur_uop->m_done_cycle > m_cur_core_cycle || cur_uop->m_exec_cycle == 0) {
+      if (!cur_uop->m_done_cycle || cur_uop->m_done_cycle > m_cur_core_cycle || cur_uop->m_warm->m_exec_cycle == 0) {
+        head = cur_uop;
         break;
       }
 
@@ -187,7 +212,7 @@ void retire_c::run_a_cycle()
     // nagesh - ISTR that I tried changing and something failed - not 100% 
     // sure though : (jaekyu) I think this is the matter of the design. we can update
     // everything from the first uop of an instruction.
-    if (cur_uop->m_isitBOM) {
+    if (cur_uop->m_warm->m_isitBOM) {
       if (cur_uop->m_uop_type >= UOP_FCF && cur_uop->m_uop_type <= UOP_FCMOV) {
         STAT_EVENT(FP_OPS_TOT);
         STAT_CORE_EVENT(cur_uop->m_core_id, FP_OPS);
@@ -207,35 +232,39 @@ void retire_c::run_a_cycle()
 
 
     // GPU : barrier
-    if (m_knob_ptx_sim && cur_uop->m_bar_type == BAR_FETCH) {
+    if (ptx_sim && cur_uop->m_warm->m_bar_type == BAR_FETCH) {
       frontend_c *frontend = core->get_frontend();
-      frontend->synch_thread(cur_uop->m_block_id, cur_uop->m_thread_id);
+      frontend->synch_thread(cur_uop->m_warm->m_block_id, cur_uop->m_thread_id);
     }
 
 
     // Terminate thread : current uop is last uop of a thread, so we can retire a thread now
-    thread_s* thread_trace_info = core->get_trace_info(cur_uop->m_thread_id);
+    thread_state_c* thread_state = core->m_thread_state;
+    int slot = core->get_thread_slot(cur_uop->m_thread_id);
+    thread_s* thread_trace_info = thread_state->m_trace_info[slot];
     process_s *process = thread_trace_info->m_process;
-    if (cur_uop->m_last_uop || m_insts_retired[cur_uop->m_thread_id] >= *m_simBase->m_knobs->KNOB_MAX_INSTS) {
-      core->m_thread_reach_end[cur_uop->m_thread_id] = true;
-      if (!core->m_thread_finished[cur_uop->m_thread_id]) {
+    if (cur_uop->m_warm->m_last_uop || m_insts_retired[cur_uop->m_thread_id] >= CONFIG(m_max_insts)) {
+      thread_state->m_thread_reach_end[slot] = true;
+      if (!thread_state->m_thread_finished[slot]) {
         ++core->m_num_thread_reach_end;
         DEBUG("core_id:%d thread_id:%d terminated\n", m_core_id, cur_uop->m_thread_id);
 
+        // the slot is released by terminate_thread
+        bool fetch_ended = thread_state->m_fetch_ended[slot];
+
         // terminate thread
         m_simBase->m_process_manager->terminate_thread(m_core_id, thread_trace_info, \
-            cur_uop->m_thread_id, cur_uop->m_block_id);
+            cur_uop->m_thread_id, cur_uop->m_warm->m_block_id);
 
         // disable current thread's fetch engine
-        if (!core->m_fetch_ended[cur_uop->m_thread_id]) {
-          core->m_fetch_ended[cur_uop->m_thread_id] = true;
+        if (!fetch_ended) {
           core->m_fetching_thread_num--;
         }
 
         // all threads in an application have been retired. Thus, we can retire an appliacation
         if (process->m_no_of_threads_terminated == process->m_no_of_threads_created) {
           if (process->m_current_vector_index == process->m_applications.size() 
-            || (*m_simBase->m_ProcessorStats)[INST_COUNT_TOT].getCount() >= *KNOB(KNOB_MAX_INSTS1)) {
+            || (*m_simBase->m_ProcessorStats)[INST_COUNT_TOT].getCount() >= CONFIG(m_max_insts1)) {
             update_stats(process);
             m_simBase->m_process_manager->terminate_process(process);
             if (m_simBase->m_process_count_without_repeat == 0) {
@@ -260,35 +289,39 @@ void retire_c::run_a_cycle()
     // update number of retired uops
     ++m_uops_retired[cur_uop->m_thread_id];
 
+    // CPI stack : x86 slots are uops, GPU slots are cycles (see account_cpi)
+    if (m_simBase->m_cpi_stack)
+      m_simBase->m_cpi_stack->retire_uop(cur_uop, !ptx_sim);
+
     DEBUG("core_id:%d thread_id:%d retired_insts:%lld uop->inst_num:%lld uop_num:%lld " 
         "done_cycle:%lld\n",
         m_core_id, cur_uop->m_thread_id, m_insts_retired[cur_uop->m_thread_id], 
-        cur_uop->m_inst_num, cur_uop->m_uop_num, cur_uop->m_done_cycle);
+        cur_uop->m_warm->m_inst_num, cur_uop->m_uop_num, cur_uop->m_done_cycle);
 
     // free uop
-    for (int ii = 0; ii < cur_uop->m_num_child_uops; ++ii) {
+    for (int ii = 0; ii < cur_uop->m_warm->m_num_child_uops; ++ii) {
 			if (*m_simBase->m_knobs->KNOB_BUG_DETECTOR_ENABLE)
-	      m_simBase->m_bug_detector->deallocate(cur_uop->m_child_uops[ii]);
-      m_uop_pool->release_entry(cur_uop->m_child_uops[ii]->free());
+	      m_simBase->m_bug_detector->deallocate(cur_uop->m_warm->m_child_uops[ii]);
+      m_uop_pool->release_entry(cur_uop->m_warm->m_child_uops[ii]->free());
     }
 
     if (*m_simBase->m_knobs->KNOB_BUG_DETECTOR_ENABLE)
 			m_simBase->m_bug_detector->deallocate(cur_uop);
 
-    delete [] cur_uop->m_child_uops;
+    delete [] cur_uop->m_warm->m_child_uops;
     m_uop_pool->release_entry(cur_uop->free());
   
     // release physical registers
-    if (cur_uop->m_req_lb) {
+    if (cur_uop->m_warm->m_req_lb) {
       rob->dealloc_lb();
     }
-    if (cur_uop->m_req_sb) {
+    if (cur_uop->m_warm->m_req_sb) {
       rob->dealloc_sb();
     }
-    if (cur_uop->m_req_int_reg) {
+    if (cur_uop->m_warm->m_req_int_reg) {
       rob->dealloc_int_reg();
     }
-    if (cur_uop->m_req_fp_reg) {
+    if (cur_uop->m_warm->m_req_fp_reg) {
       rob->dealloc_fp_reg();
     }
   }
@@ -296,6 +329,59 @@ void retire_c::run_a_cycle()
   if (m_core_id == 0) {
     m_simBase->m_core0_inst_count = m_insts_retired[0];
   }
+
+  if (m_simBase->m_cpi_stack)
+    account_cpi(count, head);
+}
+
+
+// CPI stack : charge the retire slots left unused this cycle
+void retire_c::account_cpi(int retired, uop_c* head)
+{
+  cpi_stack_c* cpi_stack = m_simBase->m_cpi_stack;
+  core_c* core = m_simBase->m_core_pointers[m_core_id];
+  frontend_c* frontend = core->get_frontend();
+
+  cpi_stack->cycle(m_core_id);
+
+  // GPU : the whole cycle is one slot
+  if (m_core_kind == CORE_PTX || m_core_kind == CORE_PTX_SM) {
+    Cpi_Component component = CPI_BASE;
+    if (!retired) {
+      bool load_pending = (m_core_kind == CORE_PTX_SM) ? 
+        m_gpu_rob->load_pending(m_cur_core_cycle) : (head && head->m_mem_type == MEM_LD);
+      if (load_pending)
+        component = CPI_GPU_MEM;
+      else if (frontend->barrier_blocked_thread_num())
+        component = CPI_GPU_BARRIER;
+      else
+        component = CPI_GPU_NO_WARP;
+    }
+    cpi_stack->add(m_core_id, -1, component, 1);
+    return;
+  }
+
+  if (retired == m_knob_width)
+    return;
+
+  Counter slots = m_knob_width - retired;
+
+  // empty rob : fetch bubble
+  if (head == NULL) {
+    int thread_id;
+    Cpi_Component component = frontend->cpi_bubble(m_cur_core_cycle, &thread_id);
+    cpi_stack->add(m_core_id, thread_id, component, slots);
+  }
+  // load at the head : charged when it retires and the servicing level is known
+  else if (head->m_mem_type == MEM_LD) {
+    cpi_stack->stall_load(head, slots);
+  }
+  else if (core->get_allocate()->resource_stalled()) {
+    cpi_stack->add(m_core_id, head->m_thread_id, CPI_STRUCTURAL, slots);
+  }
+  else {
+    cpi_stack->add(m_core_id, head->m_thread_id, CPI_EXEC, slots);
+  }
 }
 
 
@@ -357,7 +443,7 @@ void retire_c::update_stats(process_s* process)
   // repeating traces in case of running multiple applications
   // TOCHECK I will get back to this later
   if (*KNOB(KNOB_REPEAT_TRACE) && process->m_repeat < *KNOB(KNOB_REPEAT_TRACE_N) &&
-      core->get_core_type() == "ptx") {
+      core->is_ptx()) {
     if ((process->m_repeat+1) == *m_simBase->m_knobs->KNOB_REPEAT_TRACE_N) {
       --m_simBase->m_process_count_without_repeat;
       STAT_EVENT_N(CYC_COUNT_PTX, CYCLE);
@@ -368,7 +454,7 @@ void retire_c::update_stats(process_s* process)
   } 
   else {
     if (process->m_repeat == 0) {
-      if (core->get_core_type() == "ptx") {
+      if (core->is_ptx()) {
         STAT_EVENT_N(CYC_COUNT_PTX, CYCLE);
       }
       else {
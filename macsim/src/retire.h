@@ -56,7 +56,8 @@ POSSIBILITY OF SUCH DAMAGE.
     pool_c<uop_c>* m_uop_pool, \
     rob_c* m_rob, \
     smc_rob_c* m_gpu_rob, \
-    Unit_Type m_unit_type \
+    Unit_Type m_unit_type, \
+    Core_Kind m_core_kind \
 // end macro
 
 
@@ -69,6 +70,7 @@ POSSIBILITY OF SUCH DAMAGE.
     rob_c* m_rob; /**< reorder buffer */ \
     smc_rob_c* m_gpu_rob; /**< gpu reorder buffer */ \
     Unit_Type m_unit_type; /**< unit type */ \
+    Core_Kind m_core_kind; /**< core pipeline kind */ \
 // end macro
 
 
@@ -80,7 +82,8 @@ POSSIBILITY OF SUCH DAMAGE.
     m_uop_pool, \
     m_rob, \
     m_gpu_rob, \
-    m_unit_type \
+    m_unit_type, \
+    m_core_kind \
 // end macro
 
 
@@ -92,7 +95,8 @@ POSSIBILITY OF SUCH DAMAGE.
     m_uop_pool ( m_uop_pool ), \
     m_rob ( m_rob ), \
     m_gpu_rob ( m_gpu_rob ), \
-    m_unit_type ( m_unit_type ) \
+    m_unit_type ( m_unit_type ), \
+    m_core_kind ( m_core_kind ) \
 // end macro
 
 
@@ -105,6 +109,7 @@ POSSIBILITY OF SUCH DAMAGE.
     static_cast<void>(m_rob); \
     static_cast<void>(m_gpu_rob); \
     static_cast<void>(m_unit_type); \
+    static_cast<void>(m_core_kind); \
 // end macro
 
 
@@ -205,6 +210,18 @@ class retire_c
      */
     void repeat_traces(process_s*);
 
+    /**
+     * Retire up to pipeline width uops, specialized by the core pipeline kind
+     */
+    template <Core_Kind K> void retire_uops(void);
+
+    /**
+     * CPI stack : charge the unused retire slots of this cycle
+     * @param retired uops retired this cycle
+     * @param head uop that blocked the rob head (NULL: empty rob)
+     */
+    void account_cpi(int retired, uop_c* head);
+
   private:
     RETIRE_INTERFACE_DECL(); /**< declaration macro */
 
@@ -213,6 +230,7 @@ class retire_c
     Counter                     m_cur_core_cycle; /**< current core cycle */ 
     uns16                       m_knob_width; /**< pipeline width */
     bool                        m_knob_ptx_sim; /**< gpu simulation */
+    void (retire_c::*m_retire_uops)(void); /**< retire_uops specialized for this core */
     unordered_map<int, Counter> m_insts_retired; /**< number of retired inst. per thread */
     unordered_map<int, Counter> m_uops_retired; /**< number of retired uop per thread */
 
@@ -184,49 +184,102 @@ void smc_rob_c::free_rob(int thread_id)
 }
 
 
-// uop sort function used in get_n_uops_in_ready_order
-bool sort_uops(uop_c *a, uop_c *b) 
+// insert a warp's oldest uop into the retirement heap
+void smc_rob_c::push_retire_entry(uop_c* uop)
 {
-  if (a->m_done_cycle < b->m_done_cycle) {
-    return true;
+  rob_retire_entry_s entry = {uop->m_done_cycle, uop->m_warm->m_sched_cycle, uop->m_thread_id, 
+    uop->m_uop_num, uop};
+  m_retire_heap.push(entry);
+}
+
+
+// done cycle of an uop is known : candidate for retirement if oldest in its warp
+void smc_rob_c::uop_done(uop_c* uop)
+{
+  int index = get_thread_rob_id(uop->m_thread_id);
+  if (index == -1) {
+    return;
   }
-  else if (a->m_done_cycle == b->m_done_cycle) {
-    if (a->m_sched_cycle < b->m_sched_cycle) {
-      return true;
+
+  rob_c* rob = m_thread_robs[index];
+  if (rob->entries() && rob->front() == uop) {
+    push_retire_entry(uop);
+  }
+}
+
+
+// any warp waiting for memory at its oldest uop
+bool smc_rob_c::load_pending(Counter core_cycle)
+{
+  for (auto I = m_thread_to_rob_map.begin(), E = m_thread_to_rob_map.end(); I != E; ++I) {
+    rob_c* rob = m_thread_robs[I->second];
+    if (!rob->entries()) {
+      continue;
     }
-    else if (a->m_sched_cycle == b->m_sched_cycle) {
-      //aon this cannot happen because we are using width of 1
-      return a->m_thread_id < b->m_thread_id;
+
+    uop_c* uop = rob->front();
+    if (uop->m_mem_type == MEM_LD && 
+        (!uop->m_done_cycle || uop->m_done_cycle > core_cycle)) {
+      return true;
     }
   }
+
   return false;
 }
 
 
-// get a list of retireable uops from multiple threads
-// called by retire stage
+// get a list of retireable uops from multiple threads, ordered by 
+// (done cycle, sched cycle, thread id). called by retire stage
 vector<uop_c *>* smc_rob_c::get_n_uops_in_ready_order(int n, Counter core_cycle) 
 {
-  for (auto I = m_thread_to_rob_map.begin(), E = m_thread_to_rob_map.end(); I != E; ++I) {
-    int index = I->second;
-    rob_c *rob = m_thread_robs[index];
+  m_uop_list.clear();
 
-    if (rob->entries()) {
-      uop_c* uop = rob->front();
-      if (uop->m_done_cycle && uop->m_done_cycle <= core_cycle) {
-        m_uop_list.push_back(uop);
-      }
-      else {
-        // uop cannot be retired due to cache miss
-        // increase memory stall cycle
-        if (uop->m_uop_info.m_l2_miss == true) {
-          STAT_CORE_EVENT(uop->m_core_id, MEM_STALL_CYCLE);
-        }
-      }
+  // warps that retired an uop last time expose their next oldest uop
+  for (int ii = 0, size = m_retired_threads.size(); ii < size; ++ii) {
+    int index = get_thread_rob_id(m_retired_threads[ii]);
+    if (index == -1) {
+      continue;
+    }
+
+    rob_c* rob = m_thread_robs[index];
+    if (rob->entries() && rob->front()->m_done_cycle) {
+      push_retire_entry(rob->front());
     }
   }
+  m_retired_threads.clear();
 
-  return &m_uop_list;
-}
+  while (!m_retire_heap.empty() && static_cast<int>(m_uop_list.size()) < n) {
+    rob_retire_entry_s entry = m_retire_heap.top();
+    if (entry.m_done_cycle > core_cycle) {
+      break;
+    }
+    m_retire_heap.pop();
+
+    // stale entry : uop retired and recycled, or its done cycle has changed
+    uop_c* uop = entry.m_uop;
+    if (!uop->m_valid || 
+        uop->m_uop_num != entry.m_uop_num ||
+        uop->m_thread_id != entry.m_thread_id ||
+        uop->m_done_cycle != entry.m_done_cycle ||
+        uop->m_warm->m_sched_cycle != entry.m_sched_cycle) {
+      continue;
+    }
+
+    int index = get_thread_rob_id(entry.m_thread_id);
+    if (index == -1 || 
+        !m_thread_robs[index]->entries() || 
+        m_thread_robs[index]->front() != uop) {
+      continue;
+    }
+
+    // same uop notified more than once
+    if (!m_uop_list.empty() && m_uop_list.back() == uop) {
+      continue;
+    }
 
+    m_uop_list.push_back(uop);
+    m_retired_threads.push_back(entry.m_thread_id);
+  }
 
+  return &m_uop_list;
+}
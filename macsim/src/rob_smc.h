@@ -42,6 +42,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <cassert>
+#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -49,6 +50,26 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "rob.h"
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Retirement heap entry : oldest uop of a warp, ordered by (done, sched, thread id)
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct rob_retire_entry_s {
+  Counter m_done_cycle; /**< done cycle */
+  Counter m_sched_cycle; /**< scheduled cycle */
+  int     m_thread_id; /**< thread id */
+  Counter m_uop_num; /**< uop number, to detect recycled uops */
+  uop_c*  m_uop; /**< uop */
+
+  bool operator>(const rob_retire_entry_s& rhs) const {
+    if (m_done_cycle != rhs.m_done_cycle) 
+      return m_done_cycle > rhs.m_done_cycle;
+    if (m_sched_cycle != rhs.m_sched_cycle) 
+      return m_sched_cycle > rhs.m_sched_cycle;
+    return m_thread_id > rhs.m_thread_id;
+  }
+} rob_retire_entry_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Reorder buffer class for GPU simulation
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -107,11 +128,36 @@ class smc_rob_c
      */
     vector<uop_c *>* get_n_uops_in_ready_order(int n, Counter cur_core_cycle);
 
+    /*! \fn void uop_done(uop_c* uop)
+     *  \brief Notify that the done cycle of an uop is known. If it is the oldest uop 
+     *  of its warp, it becomes a retirement candidate.
+     *  \param uop - uop whose m_done_cycle has been set
+     *  \return void
+     */
+    void uop_done(uop_c* uop);
+
+    /*! \fn bool load_pending(Counter cur_core_cycle)
+     *  \brief Check whether the oldest uop of any warp is a load that is not done
+     *  \param cur_core_cycle Current core cycle
+     *  \return bool - True if a warp waits for memory
+     */
+    bool load_pending(Counter cur_core_cycle);
+
+  private:
+    /**
+     *  \brief Insert the oldest uop of a warp into the retirement heap
+     *  \param uop - oldest uop of a warp with a known done cycle
+     */
+    void push_retire_entry(uop_c* uop);
+
   private:
     int             m_knob_num_threads; /**< max threads per core */
     rob_c **        m_thread_robs; /**< reorder buffer per thread */
     list<int>       m_free_list;  /**< thread rob pool */ 
     vector<uop_c *> m_uop_list;   /**< retireable uop list */ 
+    priority_queue<rob_retire_entry_s, vector<rob_retire_entry_s>, 
+      greater<rob_retire_entry_s> > m_retire_heap; /**< retirement candidates across warps */
+    vector<int>     m_retired_threads; /**< warps that retired an uop in the last call */
     int             m_core_id;    /**< core id */
     Unit_Type       m_unit_type;  /**< core type */
     
@@ -67,6 +67,7 @@ schedule_c::schedule_c(exec_c* exec, int core_id, Unit_Type unit_type, frontend_
   m_num_in_sched      = 0;
   m_first_schlist_ptr = 0;
   m_last_schlist_ptr  = 0;
+  m_sched_seq         = 0;
 
   m_sched_size    = new int [max_ALLOCQ];
   m_sched_rate    = new int [max_ALLOCQ];
@@ -113,6 +114,63 @@ bool schedule_c::is_running()
 }
 
 
+// compute when all sources of an uop are ready; park it on a pending source otherwise
+bool schedule_c::set_wakeup_cycle(uop_c* uop)
+{
+  Counter wakeup_cycle = 0;
+
+  for (int i = 0; i < uop->m_num_srcs; ++i) {
+    uop_c* src_uop = uop->m_warm->m_map_src_info[i].m_uop;
+
+    // same filter as check_srcs
+    if (!src_uop || 
+        !src_uop->m_valid ||
+        (src_uop->m_uop_num != uop->m_warm->m_map_src_info[i].m_uop_num) ||
+        (src_uop->m_thread_id != uop->m_thread_id)) {
+      continue;
+    }
+
+    if (src_uop->m_done_cycle == 0) {
+      uop->m_wakeup_cycle    = MAX_CTR;
+      uop->m_wakeup_next     = src_uop->m_wakeup_head;
+      src_uop->m_wakeup_head = uop;
+      return false;
+    }
+
+    if (src_uop->m_done_cycle > wakeup_cycle)
+      wakeup_cycle = src_uop->m_done_cycle;
+  }
+
+  uop->m_wakeup_cycle = wakeup_cycle;
+
+  return true;
+}
+
+
+// a producer got its done cycle : re-evaluate all uops parked on it
+void schedule_c::wakeup(uop_c* producer)
+{
+  uop_c* consumer = producer->m_wakeup_head;
+  producer->m_wakeup_head = NULL;
+
+  while (consumer) {
+    uop_c* next = consumer->m_wakeup_next;
+    consumer->m_wakeup_next = NULL;
+
+    if (set_wakeup_cycle(consumer))
+      uop_woken(consumer);
+
+    consumer = next;
+  }
+}
+
+
+// default : schedulers that scan the window do not track woken uops
+void schedule_c::uop_woken(uop_c* uop)
+{
+}
+
+
 // check source registers are ready
 bool schedule_c::check_srcs(int entry)
 {
@@ -130,13 +188,13 @@ bool schedule_c::check_srcs(int entry)
   // search all source (dependent) uops
   for (int i = 0; i < cur_uop->m_num_srcs; ++i) {
 
-    if (cur_uop->m_map_src_info[i].m_uop == NULL) {
+    if (cur_uop->m_warm->m_map_src_info[i].m_uop == NULL) {
       continue;
     }
 
     // Extract the source uop info
-    uop_c* src_uop      = cur_uop->m_map_src_info[i].m_uop;
-    Counter src_uop_num = cur_uop->m_map_src_info[i].m_uop_num;
+    uop_c* src_uop      = cur_uop->m_warm->m_map_src_info[i].m_uop;
+    Counter src_uop_num = cur_uop->m_warm->m_map_src_info[i].m_uop_num;
 
     // Check if source uop is valid
     if (!src_uop || 
@@ -191,7 +249,7 @@ bool schedule_c::uop_schedule(int entry, SCHED_FAIL_TYPE* sched_fail_reason)
   DEBUG("cycle_m_count:%llu m_core_id:%d thread_id:%d uop_num:%lld inst_num:%lld uop.va:%s "
       "allocq:%d mem_type:%d last_dep_exec:%llu done_cycle:%llu\n",
       m_cur_core_cycle, m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num,
-      cur_uop->m_inst_num, hexstr64s(cur_uop->m_vaddr), cur_uop->m_allocq_num,
+      cur_uop->m_warm->m_inst_num, hexstr64s(cur_uop->m_vaddr), cur_uop->m_allocq_num,
       cur_uop->m_mem_type, (cur_uop->m_last_dep_exec? *(cur_uop->m_last_dep_exec) : 0),
       cur_uop->m_done_cycle);
 
@@ -245,16 +303,21 @@ bool schedule_c::uop_schedule(int entry, SCHED_FAIL_TYPE* sched_fail_reason)
     return false;
   }
 
+  // latency is known at issue; wake up dependent uops
+  if (cur_uop->m_done_cycle)
+    wakeup(cur_uop);
+
 
   // Generate Stat events
   STAT_EVENT(DISPATCHED_INST);
-  STAT_EVENT_N(DISPATCH_WAIT, m_cur_core_cycle - cur_uop->m_alloc_cycle);
+  STAT_EVENT_N(DISPATCH_WAIT, m_cur_core_cycle - cur_uop->m_warm->m_alloc_cycle);
   STAT_CORE_EVENT(m_core_id, CORE_DISPATCHED_INST);
   STAT_CORE_EVENT_N(m_core_id, CORE_DISPATCH_WAIT, 
-      m_cur_core_cycle - cur_uop->m_alloc_cycle);
+      m_cur_core_cycle - cur_uop->m_warm->m_alloc_cycle);
 
   // Decrement dispatch m_count for the current thread
-  --m_simBase->m_core_pointers[m_core_id]->m_ops_to_be_dispatched[cur_uop->m_thread_id];
+  core_c* core = m_simBase->m_core_pointers[m_core_id];
+  --core->m_thread_state->m_ops_to_be_dispatched[core->get_thread_slot(cur_uop->m_thread_id)];
 
   // Uop exec ok; update scheduler
   cur_uop->m_in_scheduler = false;
@@ -281,7 +344,7 @@ bool schedule_c::uop_schedule(int entry, SCHED_FAIL_TYPE* sched_fail_reason)
       "allocq:%d m_num_in_sched:%d m_num_per_sched[general]:%d m_num_per_sched[mem]:%d "
       "m_num_per_sched[fp]:%d done_cycle:%lld\n",
       m_cur_core_cycle, m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num,
-      cur_uop->m_inst_num, entry, cur_uop->m_allocq_num, m_num_in_sched,
+      cur_uop->m_warm->m_inst_num, entry, cur_uop->m_allocq_num, m_num_in_sched,
       m_num_per_sched[gen_ALLOCQ], m_num_per_sched[mem_ALLOCQ], m_num_per_sched[fp_ALLOCQ], 
       cur_uop->m_done_cycle);
 
@@ -326,7 +389,7 @@ void schedule_c::advance(int q_index)
 
     DEBUG("cycle_m_count:%lld entry:%d m_core_id:%d thread_id:%d uop_num:%lld "
         "inst_num:%lld uop.va:%s allocq:%d mem_type:%d \n", m_cur_core_cycle,
-        entry, m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num, cur_uop->m_inst_num, 
+        entry, m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num, cur_uop->m_warm->m_inst_num, 
         hexstr64s(cur_uop->m_vaddr), cur_uop->m_allocq_num, cur_uop->m_mem_type);
 
     // Take out the corresponding entries queue type 
@@ -346,6 +409,7 @@ void schedule_c::advance(int q_index)
     // Check if the entry has been flushed. If so just move ahead.
     if (cur_uop->m_bogus || (cur_uop->m_done_cycle)) {
       cur_uop->m_done_cycle = (m_simBase->m_core_cycle[m_core_id]);
+      wakeup(cur_uop);
       continue;
     }
 
@@ -353,7 +417,7 @@ void schedule_c::advance(int q_index)
     ++m_count[q_type];
 
     // Update uop has been tranferred from alloc queue to the sched queue
-    cur_uop->m_in_iaq       = false;
+    cur_uop->m_warm->m_in_iaq       = false;
     cur_uop->m_in_scheduler = true;
 
     ++m_num_in_sched;
@@ -366,6 +430,11 @@ void schedule_c::advance(int q_index)
     m_schedule_list[m_last_schlist_ptr] = entry;
     m_last_schlist_ptr = (m_last_schlist_ptr + 1) % MAX_SCHED_SIZE;
 
+    // sched_seq % MAX_SCHED_SIZE is the schedule list index of the uop
+    cur_uop->m_sched_seq = m_sched_seq++;
+    if (set_wakeup_cycle(cur_uop))
+      uop_woken(cur_uop);
+
     // update the element m_count for the corresponding sched queue
     m_num_per_sched[q_type] = m_num_per_sched[q_type] + 1;
   }
@@ -44,6 +44,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "uop.h"
 #include "pqueue.h"
 
+#include <queue>
+#include <vector>
+
 
 #define SCHEDULE_INTERFACE_PARAMS() \
     int core_id, \
@@ -122,6 +125,20 @@ enum SCHED_FAIL_TYPE
 };  
 
 
+/**
+ * Wakeup network entry. Ordered by key (wakeup cycle or 0), then by scheduler age
+ */
+typedef struct sched_wakeup_s {
+  Counter m_key; /**< wakeup cycle */
+  Counter m_seq; /**< insertion order in the scheduler */
+  uop_c*  m_uop; /**< uop */
+
+  bool operator>(const sched_wakeup_s& rhs) const {
+    return (m_key > rhs.m_key) || (m_key == rhs.m_key && m_seq > rhs.m_seq);
+  }
+} sched_wakeup_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Instruction scheduler base class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -161,8 +178,30 @@ class schedule_c
      *  \return void 
      */
     virtual bool is_running(void);
+
+    /*! \fn void wakeup(uop_c* producer)
+     *  \brief Wake up uops parked on a producer whose done cycle has become known.
+     *  Called wherever m_done_cycle is set (exec, dcache and readonly cache fills).
+     *  \param producer - uop that just got its done cycle
+     *  \return void
+     */
+    virtual void wakeup(uop_c* producer);
     
   protected:
+    /**
+     *  \brief Compute the cycle at which all sources of an uop are ready. If a source
+     *  does not know its done cycle yet, park the uop on that source until wakeup().
+     *  \param uop - uop in the scheduler
+     *  \return bool - True if the wakeup cycle is known
+     */
+    bool set_wakeup_cycle(uop_c* uop);
+
+    /**
+     *  \brief Hook called when the wakeup cycle of an uop becomes known
+     *  \param uop - uop in the scheduler
+     */
+    virtual void uop_woken(uop_c* uop);
+
     /**
      *  \brief Function to check if the source of an uop are yet tp be scheduled
      *  \param entry - ROB entry of the uop
@@ -205,6 +244,7 @@ class schedule_c
     int             m_schedule_list[MAX_SCHED_SIZE]; /**< schedule list in OOO */
     int             m_first_schlist_ptr; /**< first index to sched list in OOO */
     int             m_last_schlist_ptr; /**< last index to sched list in OOO */
+    Counter         m_sched_seq; /**< number of uops inserted in the scheduler */
     uns16           m_knob_sched_to_width; /**< knob sched to width FIXME */
 
    macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
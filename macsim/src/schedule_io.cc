@@ -119,7 +119,7 @@ void schedule_io_c::run_a_cycle(void)
       // find the next entry to schedule
       int dec_index = m_rob->dec_index(m_next_inorder_to_schedule);
       ASSERT(m_next_inorder_to_schedule == m_rob->front_rob() ||
-             (*m_rob)[dec_index]->m_sched_cycle);
+             (*m_rob)[dec_index]->m_warm->m_sched_cycle);
       m_next_inorder_to_schedule = m_rob->inc_index(m_next_inorder_to_schedule);
     }
 
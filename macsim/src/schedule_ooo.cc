@@ -74,8 +74,17 @@ schedule_ooo_c::~schedule_ooo_c(void)
 }
 
 
+// an uop knows when its operands are ready : wait in the wakeup queue
+void schedule_ooo_c::uop_woken(uop_c* uop)
+{
+  sched_wakeup_s wakeup_entry = {uop->m_wakeup_cycle, uop->m_sched_seq, uop};
+  m_wakeup_queue.push(wakeup_entry);
+}
+
+
 // main execution routine
-// In every cycle, schedule uops from rob
+// In every cycle, select ready uops in age order. Uops enter the ready queue when 
+// their wakeup cycle arrives instead of re-checking every source of every uop.
 void schedule_ooo_c::run_a_cycle(void)
 {
   // Check if the schedule isn't running
@@ -87,38 +96,74 @@ void schedule_ooo_c::run_a_cycle(void)
   // clear execution ports
   m_exec->clear_ports();
 
+  // wakeup : move uops whose operands become ready by this cycle to the ready queue
+  while (!m_wakeup_queue.empty() && m_wakeup_queue.top().m_key <= m_cur_core_cycle) {
+    sched_wakeup_s ready_entry = m_wakeup_queue.top();
+    m_wakeup_queue.pop();
+
+    ready_entry.m_key = 0;
+    m_ready_queue.push(ready_entry);
+  }
+
   int count = 0;
   if (m_num_in_sched) { 
-    for (int i = m_first_schlist_ptr; i != m_last_schlist_ptr; i = (i + 1) % MAX_SCHED_SIZE) {
-      if (m_schedule_list[i] != -1) {
-        SCHED_FAIL_TYPE sched_fail_reason;
-
-        // schedule un uop
-        if (uop_schedule(m_schedule_list[i], &sched_fail_reason)) {
-          STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS);
-          if (i == m_first_schlist_ptr) {
-            m_first_schlist_ptr = (m_first_schlist_ptr + 1) % MAX_SCHED_SIZE;
-          }
-
-          m_schedule_list[i] = -1;
-          ++count;
-
-          // schedule enough uops, break it
-          if (m_knob_sched_to_width && count >= m_knob_width) 
-            break;
+    // uops still waiting for operands
+    STAT_CORE_EVENT_N(m_core_id, SCHED_FAILED_OPERANDS_NOT_READY,
+        m_num_in_sched - m_ready_queue.size());
+
+    // the schedule list index right after the last examined uop
+    int scan_end = m_last_schlist_ptr;
+
+    // select : oldest ready uop first
+    while (!m_ready_queue.empty()) {
+      sched_wakeup_s ready_entry = m_ready_queue.top();
+      m_ready_queue.pop();
+
+      int i = ready_entry.m_seq % MAX_SCHED_SIZE;
+      ASSERT(m_schedule_list[i] != -1);
+
+      SCHED_FAIL_TYPE sched_fail_reason;
+
+      // schedule un uop
+      if (uop_schedule(m_schedule_list[i], &sched_fail_reason)) {
+        STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS);
+
+        m_schedule_list[i] = -1;
+        ++count;
+
+        // schedule enough uops, break it
+        if (m_knob_sched_to_width && count >= m_knob_width) {
+          scan_end = (i + 1) % MAX_SCHED_SIZE;
+          break;
+        }
+      }
+      else {
+        // schedule has been failed for current uop
+        // try to find next available one
+        STAT_CORE_EVENT(m_core_id, 
+            SCHED_FAILED_REASON_SUCCESS + MIN2(sched_fail_reason, 2));
+
+        // a producer changed its done cycle : wait for it again
+        if (sched_fail_reason == SCHED_FAIL_OPERANDS_NOT_READY) {
+          if (set_wakeup_cycle(ready_entry.m_uop))
+            uop_woken(ready_entry.m_uop);
         }
         else {
-          // schedule has been failed for current uop
-          // try to find next available one
-          STAT_CORE_EVENT(m_core_id, 
-              SCHED_FAILED_REASON_SUCCESS + MIN2(sched_fail_reason, 2));
+          m_retry_list.push_back(ready_entry);
         }
-      } 
-      else if (i == m_first_schlist_ptr) {
-        m_first_schlist_ptr = (m_first_schlist_ptr + 1) % MAX_SCHED_SIZE;
       }
     }
 
+    for (int ii = 0, size = m_retry_list.size(); ii < size; ++ii) {
+      m_ready_queue.push(m_retry_list[ii]);
+    }
+    m_retry_list.clear();
+
+    // skip scheduled entries at the head of the schedule list
+    while (m_first_schlist_ptr != scan_end && m_schedule_list[m_first_schlist_ptr] == -1) {
+      m_first_schlist_ptr = (m_first_schlist_ptr + 1) % MAX_SCHED_SIZE;
+    }
+
     // no uop has been scheduled
     if (m_count == 0) 
       STAT_CORE_EVENT(m_core_id, NUM_NO_SCHED_CYCLE);
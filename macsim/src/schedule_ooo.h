@@ -76,6 +76,19 @@ class schedule_ooo_c : public schedule_c
     void run_a_cycle();
 
   private:
+    /**
+     *  \brief Queue an uop whose wakeup cycle is known for select
+     *  \param uop - uop in the scheduler
+     */
+    void uop_woken(uop_c* uop);
+
+  private:
+    priority_queue<sched_wakeup_s, vector<sched_wakeup_s>, 
+      greater<sched_wakeup_s> > m_wakeup_queue; /**< uops by (operand ready cycle, age) */
+    priority_queue<sched_wakeup_s, vector<sched_wakeup_s>, 
+      greater<sched_wakeup_s> > m_ready_queue; /**< uops with ready operands by age */
+    vector<sched_wakeup_s> m_retry_list; /**< ready uops that failed select this cycle */
+
      macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
    
 };
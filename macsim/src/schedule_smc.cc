@@ -178,13 +178,14 @@ void schedule_smc_c::advance(int q_index) {
     // if the entry has been flushed
     if (cur_uop->m_bogus || (cur_uop->m_done_cycle) ) {
       cur_uop->m_done_cycle = (m_simBase->m_core_cycle[m_core_id]);
+      wakeup(cur_uop);
       continue;
     }
 
 
     // update the element m_count for corresponding scheduled queue
     m_count[allocq]         = m_count[allocq]+1;
-    cur_uop->m_in_iaq       = false;
+    cur_uop->m_warm->m_in_iaq       = false;
     cur_uop->m_in_scheduler = true;
 
     //    int queue = get_reserved_sched_queue(allocq_entry.m_thread_id);
@@ -193,6 +194,10 @@ void schedule_smc_c::advance(int q_index) {
     m_schlist_entry[m_last_schlist] = entry;
     m_schlist_tid[m_last_schlist++] = tid;
     m_last_schlist %= m_schlist_size;
+
+    // sched_seq % m_schlist_size is the schedule list index of the uop
+    cur_uop->m_sched_seq = m_sched_seq++;
+    push_thread_uop(cur_uop);
     ++m_num_in_sched;
     ++m_num_per_sched[allocq];
     assert(m_last_schlist != m_first_schlist);
@@ -205,6 +210,50 @@ void schedule_smc_c::advance(int q_index) {
 }
 
 
+// insert an uop to the thread queue. only the oldest uop of a thread can be scheduled,
+// so only heads are registered in the wakeup network.
+void schedule_smc_c::push_thread_uop(uop_c* uop)
+{
+  int slot = m_simBase->m_core_pointers[m_core_id]->get_thread_slot(uop->m_thread_id);
+  if (slot >= static_cast<int>(m_thread_queue.size())) {
+    m_thread_queue.resize(slot + 1);
+  }
+
+  deque<uop_c*>& queue = m_thread_queue[slot];
+  queue.push_back(uop);
+  if (queue.size() == 1) {
+    m_thread_head[uop->m_sched_seq] = uop;
+    set_wakeup_cycle(uop);
+  }
+}
+
+
+// remove the scheduled head of a thread and promote the next uop
+void schedule_smc_c::pop_thread_uop(uop_c* uop)
+{
+  int slot = m_simBase->m_core_pointers[m_core_id]->get_thread_slot(uop->m_thread_id);
+  deque<uop_c*>& queue = m_thread_queue[slot];
+  ASSERT(!queue.empty() && queue.front() == uop);
+
+  queue.pop_front();
+  m_thread_head.erase(uop->m_sched_seq);
+
+  if (!queue.empty()) {
+    uop_c* next_uop = queue.front();
+    m_thread_head[next_uop->m_sched_seq] = next_uop;
+    set_wakeup_cycle(next_uop);
+  }
+}
+
+
+// GPU : a done uop may be the oldest uop of its warp; let the retirement heap know
+void schedule_smc_c::wakeup(uop_c* producer)
+{
+  schedule_c::wakeup(producer);
+  m_gpu_rob->uop_done(producer);
+}
+
+
 // check source registers are ready
 bool schedule_smc_c::check_srcs_smc(int thread_id, int entry)
 {
@@ -220,14 +269,14 @@ bool schedule_smc_c::check_srcs_smc(int thread_id, int entry)
   }
 
   for (int i = 0; i < cur_uop->m_num_srcs; ++i) {
-    if (cur_uop->m_map_src_info[i].m_uop == NULL) {
+    if (cur_uop->m_warm->m_map_src_info[i].m_uop == NULL) {
       continue;
     }
 
 
     // Extract the source uop info
-    uop_c* src_uop = cur_uop->m_map_src_info[i].m_uop;
-    uns src_uop_num = cur_uop->m_map_src_info[i].m_uop_num;
+    uop_c* src_uop = cur_uop->m_warm->m_map_src_info[i].m_uop;
+    uns src_uop_num = cur_uop->m_warm->m_map_src_info[i].m_uop_num;
     
 
     // Check if source uop is valid
@@ -287,7 +336,7 @@ bool schedule_smc_c::uop_schedule_smc(int thread_id, int entry, SCHED_FAIL_TYPE*
     
   DEBUG("uop_schedule core_id:%d thread_id:%d uop_num:%lld inst_num:%lld "
       "uop.va:%s allocq:%d mem_type:%d last_dep_exec:%llu done_cycle:%llu\n",
-      m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num, cur_uop->m_inst_num, 
+      m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num, cur_uop->m_warm->m_inst_num, 
       hexstr64s(cur_uop->m_vaddr), cur_uop->m_allocq_num, cur_uop->m_mem_type, 
       (cur_uop->m_last_dep_exec? *(cur_uop->m_last_dep_exec) : 0), cur_uop->m_done_cycle); 
 
@@ -322,9 +371,9 @@ bool schedule_smc_c::uop_schedule_smc(int thread_id, int entry, SCHED_FAIL_TYPE*
 
     // check available mshr spaces for scheduling
     core_c *core = m_simBase->m_core_pointers[m_core_id];
-    if ("ptx" == core->get_core_type() && 
+    if (core->is_ptx() && 
         cur_uop->m_mem_type != NOT_MEM && 
-        cur_uop->m_num_child_uops > 0) {
+        cur_uop->m_warm->m_num_child_uops > 0) {
       // constant or texture memory access
       if (cur_uop->m_mem_type == MEM_LD_CM || cur_uop->m_mem_type == MEM_LD_TM) {
         if (!m_simBase->m_memory->get_num_avail_entry(m_core_id)) {
@@ -350,20 +399,25 @@ bool schedule_smc_c::uop_schedule_smc(int thread_id, int entry, SCHED_FAIL_TYPE*
     return false;
   }
 
+  // latency is known at issue; wake up dependent uops
+  if (cur_uop->m_done_cycle)
+    wakeup(cur_uop);
+
 
   // Generate Stat events
   STAT_EVENT(DISPATCHED_INST);
-  STAT_EVENT_N(DISPATCH_WAIT, m_cur_core_cycle - cur_uop->m_alloc_cycle);
+  STAT_EVENT_N(DISPATCH_WAIT, m_cur_core_cycle - cur_uop->m_warm->m_alloc_cycle);
   STAT_CORE_EVENT(m_core_id, CORE_DISPATCHED_INST);
   STAT_CORE_EVENT_N(m_core_id, CORE_DISPATCH_WAIT, 
-      m_cur_core_cycle - cur_uop->m_alloc_cycle);
+      m_cur_core_cycle - cur_uop->m_warm->m_alloc_cycle);
 
   POWER_CORE_EVENT(m_core_id, POWER_RESERVATION_STATION_R_TAG);
   POWER_CORE_EVENT(m_core_id, POWER_INST_ISSUE_SEL_LOGIC_R);
   POWER_CORE_EVENT(m_core_id, POWER_PAYLOAD_RAM_R);
 
   // Decrement dispatch m_count for the current thread
-  --m_simBase->m_core_pointers[m_core_id]->m_ops_to_be_dispatched[cur_uop->m_thread_id];
+  core_c* core = m_simBase->m_core_pointers[m_core_id];
+  --core->m_thread_state->m_ops_to_be_dispatched[core->get_thread_slot(cur_uop->m_thread_id)];
 
 
   // Uop m_exec ok; update scheduler
@@ -392,7 +446,7 @@ bool schedule_smc_c::uop_schedule_smc(int thread_id, int entry, SCHED_FAIL_TYPE*
       "entry:%d queue:%d m_num_in_sched:%d m_num_per_sched[general]:%d "
       "m_num_per_sched[mem]:%d m_num_per_sched[fp]:%d done_cycle:%lld\n",
       m_core_id, cur_uop->m_thread_id, cur_uop->m_uop_num,
-      cur_uop->m_inst_num, entry, cur_uop->m_allocq_num, m_num_in_sched,
+      cur_uop->m_warm->m_inst_num, entry, cur_uop->m_allocq_num, m_num_in_sched,
       m_num_per_sched[gen_ALLOCQ], m_num_per_sched[mem_ALLOCQ],
       m_num_per_sched[fp_ALLOCQ], cur_uop->m_done_cycle); 
 
@@ -431,8 +485,7 @@ void schedule_smc_c::run_a_cycle(void)
     if (m_dispatch_busy_cycle[sched_id] > m_cur_core_cycle) {
       continue;
     }
-    round_count = 0;
-  for (int ii = m_first_schlist; ii != m_last_schlist; ii = (ii + 1) % m_schlist_size) {
+
     // -------------------------------------
     // Schedule stops when
     // 1) no uops in the scheduler (m_num_in_sched and first == last)
@@ -441,35 +494,37 @@ void schedule_smc_c::run_a_cycle(void)
     // -------------------------------------
     if (!m_num_in_sched || 
         m_first_schlist == m_last_schlist) 
-      break;
-
-    SCHED_FAIL_TYPE sched_fail_reason;
-
-    int thread_id = m_schlist_tid[ii];
-    int entry     = m_schlist_entry[ii];
-    bool sfu_inst;
-
-    if (thread_id != -1 && (thread_id % num_schedulers) != sched_id) {
       continue;
-    }
 
-    bool uop_scheduled = false;
-
-    if (entry != -1) {
-      if (m_processed_threads.find(thread_id) != m_processed_threads.end()) {
+    // instructions within a thread are scheduled in order, so visit the oldest uop
+    // of each thread, oldest thread first
+    round_count  = 0;
+    int scan_end = m_last_schlist;
+    map<Counter, uop_c*>::iterator next;
+    for (map<Counter, uop_c*>::iterator itr = m_thread_head.begin(); 
+        itr != m_thread_head.end(); itr = next) {
+      next = itr;
+      ++next;
+      SCHED_FAIL_TYPE sched_fail_reason;
+
+      uop_c* cur_uop = itr->second;
+      int thread_id  = cur_uop->m_thread_id;
+      int ii         = itr->first % m_schlist_size;
+      int entry      = m_schlist_entry[ii];
+
+      if ((thread_id % num_schedulers) != sched_id) {
         continue;
       }
 
-      m_processed_threads[thread_id] = 1;
-
-      {
-        rob_c *thread_m_rob = m_gpu_rob->get_thread_rob(thread_id);
-        uop_c *cur_uop = (*thread_m_rob)[entry];
+      bool sfu_inst = is_sfu_inst(cur_uop);
+      if (sfu_inst && m_sfu_dispatch_busy_cycle > m_cur_core_cycle) {
+        continue;
+      }
 
-        sfu_inst = is_sfu_inst(cur_uop);
-        if (sfu_inst && m_sfu_dispatch_busy_cycle > m_cur_core_cycle) {
-          continue;
-        }
+      // operands are not ready yet
+      if (cur_uop->m_wakeup_cycle > m_cur_core_cycle) {
+        STAT_CORE_EVENT(m_core_id, SCHED_FAILED_OPERANDS_NOT_READY);
+        continue;
       }
 
       //cout << m_cur_core_cycle << " trying " << setw(3) << thread_id << "\n";
@@ -480,47 +535,44 @@ void schedule_smc_c::run_a_cycle(void)
 
         m_schlist_entry[ii] = -1;
         m_schlist_tid[ii] = -1;
-        if (ii == m_first_schlist) {
-          m_first_schlist = (m_first_schlist + 1) % m_schlist_size;
-        }
 
-        uop_scheduled = true;
-        ++count;
+        // pop_thread_uop erases this entry and may add the thread's next uop (a younger
+        // key), so continue after the popped key
+        Counter seq = itr->first;
+        pop_thread_uop(cur_uop);
+        next = m_thread_head.upper_bound(seq);
 
-        {
-          rob_c *thread_m_rob = m_gpu_rob->get_thread_rob(thread_id);
-          uop_c *cur_uop = (*thread_m_rob)[entry];
-          /*
-          cout << m_cur_core_cycle << " " 
-               << sched_id << " " 
-               << thread_id << " " 
-               << sfu_inst << " " 
-               << m_dispatch_latency[cur_uop->m_uop_type] << "\n";
-          */
-
-          if (sfu_inst) {
-            m_sfu_dispatch_busy_cycle = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
-          }
-          else {
-            m_dispatch_busy_cycle[sched_id] = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
-          }
+        ++count;
 
+        if (sfu_inst) {
+          m_sfu_dispatch_busy_cycle = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
+        }
+        else {
+          m_dispatch_busy_cycle[sched_id] = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
         }
+
         ++round_count;
         if (round_count == inst_per_sched) {
+          scan_end = (ii + 1) % m_schlist_size;
           break;
         }
       }
       else {
         STAT_CORE_EVENT(m_core_id, 
             SCHED_FAILED_REASON_SUCCESS + MIN2(sched_fail_reason, 2));
+
+        // a producer changed its done cycle : wait for it again
+        if (sched_fail_reason == SCHED_FAIL_OPERANDS_NOT_READY) {
+          set_wakeup_cycle(cur_uop);
+        }
       }
     }
-    else if (ii == m_first_schlist) {
+
+    // skip scheduled entries at the head of the schedule list
+    while (m_first_schlist != scan_end && m_schlist_entry[m_first_schlist] == -1) {
       m_first_schlist = (m_first_schlist + 1) % m_schlist_size;
     }
   }
-  }
 
 
   m_next_sched_id = (m_next_sched_id + 1) % num_schedulers;
@@ -530,8 +582,6 @@ void schedule_smc_c::run_a_cycle(void)
     STAT_EVENT(AVG_CORE_IDLE_CYCLE);
   }
 
-  m_processed_threads.clear();
-
 
   // advance entries from alloc queue to schedule queue 
   for (int ii = 0; ii < max_ALLOCQ; ++ii) {
@@ -39,6 +39,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #define SCHEDULE_ORIG_GPU_H_INCLUDED
 
 
+#include <deque>
+#include <map>
+
 #include "rob.h"
 #include "schedule.h"
 #include "uop.h"
@@ -78,6 +81,13 @@ class schedule_smc_c : public schedule_c
      */
     void run_a_cycle();
 
+    /*! \fn void wakeup(uop_c* producer)
+     *  \brief Wake up dependent uops; the producer may also become retireable
+     *  \param producer - uop that just got its done cycle
+     *  \return void
+     */
+    void wakeup(uop_c* producer);
+
   private:
     /*! \fn void advance(int ALLOCQ_index)
      *  \brief Function to move the allocation queue ahead.
@@ -110,6 +120,20 @@ class schedule_smc_c : public schedule_c
      */
     bool is_sfu_inst(uop_c *uop);
 
+    /*! \fn void push_thread_uop(uop_c* uop)
+     *  \brief Append an uop to its thread's in-order scheduler queue
+     *  \param uop - uop inserted in the scheduler
+     *  \return void
+     */
+    void push_thread_uop(uop_c* uop);
+
+    /*! \fn void pop_thread_uop(uop_c* uop)
+     *  \brief Remove a scheduled head uop; the next uop of the thread becomes its head
+     *  \param uop - head uop of a thread
+     *  \return void
+     */
+    void pop_thread_uop(uop_c* uop);
+
   private:
     static const int MAX_GPU_SCHED_SIZE = 128; /**< max sched table size */
 
@@ -122,7 +146,8 @@ class schedule_smc_c : public schedule_c
     int m_first_schlist; /**< current index in schedule list */
     int m_last_schlist; /**< last index in schedule list */
     int m_schlist_size; /**< schedule list size */
-    map<int, int> m_processed_threads; /**<to track threads which have already been examined by the scheduler */
+    vector<deque<uop_c*> > m_thread_queue; /**< per-thread in-order uops, indexed by thread slot */
+    map<Counter, uop_c*> m_thread_head; /**< oldest uop of each thread, ordered by age */
     Counter *m_dispatch_busy_cycle; /**<model the variable throughputs of different instructions */
     Counter m_sfu_dispatch_busy_cycle; /**<track when a SFU instruction can be dispatched */
     int m_dispatch_latency[NUM_UOP_TYPES]; /**<dispatch latency of different instructions */
@@ -0,0 +1,204 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : stat_sampler.cc
+ * Description  : periodic (interval) sampling of stat counters
+ *********************************************************************************************/
+
+
+#include <fnmatch.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sstream>
+
+#include "stat_sampler.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+
+#include "all_knobs.h"
+
+
+// constructor
+stat_sampler_c::stat_sampler_c(macsim_c* simBase)
+{
+  m_simBase = simBase;
+
+  ProcessorStatistics* proc_stats = m_simBase->m_ProcessorStats;
+
+  m_cycle_interval = *KNOB(KNOB_STAT_SAMPLE_CYCLES);
+  m_inst_interval  = *KNOB(KNOB_STAT_SAMPLE_INSTS);
+  m_next_cycle     = m_cycle_interval ? m_cycle_interval : MAX_CTR;
+  m_next_inst      = m_inst_interval ? m_inst_interval : MAX_CTR;
+  m_last_cycle     = 0;
+
+  // glob patterns
+  stringstream sstr(static_cast<string>(*KNOB(KNOB_STAT_SAMPLE_FILTER)));
+  string pattern;
+  while (getline(sstr, pattern, ',')) {
+    pattern.erase(0, pattern.find_first_not_of(" \t"));
+    pattern.erase(pattern.find_last_not_of(" \t") + 1);
+    if (!pattern.empty())
+      m_patterns.push_back(pattern);
+  }
+
+  // a full copy is the global block followed by all core blocks
+  m_num_global = proc_stats->globalStats()->size();
+  m_block_size = m_num_global + proc_stats->coreStride() * proc_stats->numCores();
+
+  // select columns
+  vector<string> names;
+  for (unsigned int ii = 0; ii < m_num_global; ++ii) {
+    AbstractStat& stat = (*proc_stats)[ii];
+    if (selected(stat.getName(), stat.getOutputFilename())) {
+      m_columns.push_back(ii);
+      names.push_back(stat.getName());
+    }
+  }
+
+  for (unsigned int core_id = 0; core_id < proc_stats->numCores(); ++core_id) {
+    CoreStatistics& core_stats = proc_stats->core(core_id);
+    for (int ii = 0; ii < core_stats.size(); ++ii) {
+      stringstream name;
+      name << core_stats[ii].getName() << "_CORE_" << core_id;
+      if (selected(name.str(), core_stats[ii].getOutputFilename())) {
+        m_columns.push_back(m_num_global + core_id * proc_stats->coreStride() + ii);
+        names.push_back(name.str());
+      }
+    }
+  }
+
+  m_prev   = new unsigned long long[m_block_size];
+  m_cur    = new unsigned long long[m_block_size];
+  m_record = new unsigned long long[m_columns.size() + 2];
+  copy_counts(m_prev);
+
+  // output file and header
+  string stat_dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(stat_dir.c_str(), S_IRWXU);
+  string path = stat_dir + "/" + static_cast<string>(*KNOB(KNOB_STAT_SAMPLE_FILE));
+  m_file = fopen(path.c_str(), "wb");
+  ASSERTM(m_file, "cannot open %s\n", path.c_str());
+
+  fwrite("MSSTAT01", 1, 8, m_file);
+  uns32 num_columns = m_columns.size();
+  fwrite(&num_columns, sizeof(num_columns), 1, m_file);
+  for (unsigned int ii = 0; ii < names.size(); ++ii) {
+    uns16 length = names[ii].size();
+    fwrite(&length, sizeof(length), 1, m_file);
+    fwrite(names[ii].c_str(), 1, length, m_file);
+  }
+
+  proc_stats->setSampler(this);
+
+  report("stat sampler: " << m_columns.size() << " stats to " << path);
+}
+
+
+// destructor
+stat_sampler_c::~stat_sampler_c()
+{
+  if (CYCLE > m_last_cycle)
+    sample(CYCLE);
+
+  m_simBase->m_ProcessorStats->setSampler(NULL);
+
+  fclose(m_file);
+
+  delete[] m_prev;
+  delete[] m_cur;
+  delete[] m_record;
+}
+
+
+// append the deltas of selected counters since the last sample
+void stat_sampler_c::sample(Counter cycle)
+{
+  copy_counts(m_cur);
+
+  Counter insts = inst_count();
+  m_record[0] = cycle;
+  m_record[1] = insts;
+  for (unsigned int ii = 0; ii < m_columns.size(); ++ii) {
+    m_record[ii + 2] = m_cur[m_columns[ii]] - m_prev[m_columns[ii]];
+  }
+  fwrite(m_record, sizeof(unsigned long long), m_columns.size() + 2, m_file);
+
+  unsigned long long* temp = m_prev;
+  m_prev = m_cur;
+  m_cur  = temp;
+
+  m_last_cycle = cycle;
+  if (m_cycle_interval)
+    m_next_cycle = cycle + m_cycle_interval;
+  if (m_inst_interval)
+    m_next_inst = insts + m_inst_interval;
+}
+
+
+// Blocks are zeroed after a merge; move the baseline by the same amount so the next
+// delta still counts the events before the merge.
+void stat_sampler_c::counts_merged(void)
+{
+  copy_counts(m_cur);
+  for (unsigned int ii = 0; ii < m_block_size; ++ii) {
+    m_prev[ii] -= m_cur[ii];
+  }
+}
+
+
+Counter stat_sampler_c::inst_count(void)
+{
+  return (*m_simBase->m_ProcessorStats)[INST_COUNT_TOT].getCount();
+}
+
+
+void stat_sampler_c::copy_counts(unsigned long long* buffer)
+{
+  ProcessorStatistics* proc_stats = m_simBase->m_ProcessorStats;
+
+  memcpy(buffer, proc_stats->globalCounts(), m_num_global * sizeof(unsigned long long));
+  memcpy(buffer + m_num_global, proc_stats->coreCounts(0),
+      (m_block_size - m_num_global) * sizeof(unsigned long long));
+}
+
+
+bool stat_sampler_c::selected(const string& name, const string& file)
+{
+  string group = file.substr(0, file.find(".stat.out"));
+  for (unsigned int ii = 0; ii < m_patterns.size(); ++ii) {
+    if (fnmatch(m_patterns[ii].c_str(), name.c_str(), 0) == 0 ||
+        fnmatch(m_patterns[ii].c_str(), group.c_str(), 0) == 0)
+      return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,139 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : stat_sampler.h
+ * Description  : periodic (interval) sampling of stat counters
+ *********************************************************************************************/
+
+#ifndef STAT_SAMPLER_H_INCLUDED
+#define STAT_SAMPLER_H_INCLUDED
+
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "macsim.h"
+#include "global_types.h"
+#include "global_defs.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief interval stat sampler
+///
+/// Every stat_sample_cycles cycles and/or stat_sample_insts retired instructions, copy the
+/// stat counter blocks and append the per-interval deltas of the selected stats to
+/// stat_sample_file (in the statistics output directory).
+///
+/// Selection (stat_sample_filter) is a comma separated list of glob patterns. A stat is
+/// selected when a pattern matches its name (core stats carry the _CORE_<id> suffix, as in
+/// the .stat.out files) or its group, the output file name without ".stat.out"
+/// (e.g. "memory", "core").
+///
+/// File format (host byte order, no padding):
+///   char[8]  magic "MSSTAT01"
+///   uint32   number of columns N
+///   N times  uint16 name length L, L bytes of stat name
+///   records  uint64 cycle, uint64 retired instructions (INST_COUNT_TOT), N x uint64 delta
+///
+/// A record covers the interval since the previous record (the last one is written at the
+/// end of the simulation). Reader:
+///   import struct, numpy
+///   f = open(path, 'rb'); assert f.read(8) == b'MSSTAT01'
+///   n = struct.unpack('I', f.read(4))[0]
+///   names = [f.read(struct.unpack('H', f.read(2))[0]).decode() for _ in range(n)]
+///   rows = numpy.fromfile(f, dtype=numpy.uint64).reshape(-1, n + 2)
+///////////////////////////////////////////////////////////////////////////////////////////////
+class stat_sampler_c
+{
+  public:
+    /**
+     * Constructor. Select stats and open the output file.
+     */
+    stat_sampler_c(macsim_c* simBase);
+
+    /**
+     * Destructor. Write the last interval and close the file.
+     */
+    ~stat_sampler_c();
+
+    /**
+     * Check whether the interval has elapsed; take a sample if so.
+     */
+    inline void run_a_cycle(Counter cycle)
+    {
+      if (cycle >= m_next_cycle || (m_inst_interval && inst_count() >= m_next_inst))
+        sample(cycle);
+    }
+
+    /**
+     * Counter blocks are about to be folded into the stat objects (and zeroed)
+     */
+    void counts_merged(void);
+
+  private:
+    /**
+     * Take a sample and append one record
+     */
+    void sample(Counter cycle);
+
+    /**
+     * Total retired instructions so far
+     */
+    Counter inst_count(void);
+
+    /**
+     * Copy all counter blocks into buffer
+     */
+    void copy_counts(unsigned long long* buffer);
+
+    /**
+     * Check whether a stat name or group matches the filter
+     */
+    bool selected(const string& name, const string& file);
+
+  private:
+    macsim_c*    m_simBase; /**< macsim_c base class for simulation globals */
+    FILE*        m_file; /**< output file */
+    Counter      m_cycle_interval; /**< sampling period in cycles (0: off) */
+    Counter      m_inst_interval; /**< sampling period in retired instructions (0: off) */
+    Counter      m_next_cycle; /**< cycle of the next sample */
+    Counter      m_next_inst; /**< instruction count of the next sample */
+    Counter      m_last_cycle; /**< cycle of the last sample */
+    vector<string> m_patterns; /**< glob patterns */
+    vector<unsigned int> m_columns; /**< selected slots, indexed into a full block copy */
+    unsigned int m_num_global; /**< counters in the global block */
+    unsigned int m_block_size; /**< counters in a full block copy */
+    unsigned long long* m_prev; /**< counters at the last sample */
+    unsigned long long* m_cur; /**< counters at this sample */
+    unsigned long long* m_record; /**< output record */
+};
+
+#endif
@@ -37,14 +37,19 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <sstream>
 
 #include "all_knobs.h"
 #include "macsim.h"
 #include "statistics.h"
+#include "stat_sampler.h"
+#include "assert_macros.h"
 
 using namespace std;
 
@@ -314,6 +319,24 @@ void GlobalStatistics::saveStats(string ext)
 
 
 // dump out all stats to the file
+// bind stat i to counter slot block[i]
+void GlobalStatistics::bindPrivateCounts(unsigned long long* block)
+{
+  for (unsigned int ii = 0; ii < m_globalStats.size(); ++ii) {
+    m_globalStats[ii]->bindPrivateCount(&block[ii]);
+  }
+}
+
+
+// fold the counter slots into the stats
+void GlobalStatistics::mergePrivateCounts()
+{
+  for (unsigned int ii = 0; ii < m_globalStats.size(); ++ii) {
+    m_globalStats[ii]->mergePrivateCount();
+  }
+}
+
+
 void GlobalStatistics::writeTo(ofstream& stream)
 {
   vector<AbstractStat*>::iterator iter = m_globalStats.begin();
@@ -335,6 +358,24 @@ void GlobalStatistics::writeTo(ofstream& stream)
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 // destructor
+// bind stat i to counter slot block[i]
+void CoreStatistics::bindPrivateCounts(unsigned long long* block)
+{
+  for (unsigned int ii = 0; ii < m_CoreStats.size(); ++ii) {
+    m_CoreStats[ii]->bindPrivateCount(&block[ii]);
+  }
+}
+
+
+// fold the counter slots into the stats
+void CoreStatistics::mergePrivateCounts()
+{
+  for (unsigned int ii = 0; ii < m_CoreStats.size(); ++ii) {
+    m_CoreStats[ii]->mergePrivateCount();
+  }
+}
+
+
 CoreStatistics::~CoreStatistics()
 {
   m_CoreStats.clear();
@@ -393,11 +434,121 @@ void CoreStatistics::saveStats(string ext)
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// check whether name is in the comma separated format list
+static bool outputFormatEnabled(const string& format, const string& name)
+{
+  stringstream sstr(format);
+  string token;
+  while (getline(sstr, token, ',')) {
+    token.erase(0, token.find_first_not_of(" \t"));
+    token.erase(token.find_last_not_of(" \t") + 1);
+    if (token == name)
+      return true;
+  }
+
+  return false;
+}
+
+
+// output group of a stat: file name without ".stat.out"
+static string statGroup(AbstractStat& stat)
+{
+  const string& filename = stat.getOutputFilename();
+  return filename.substr(0, filename.find(".stat.out"));
+}
+
+
+// JSON number, null for NaN
+static void writeJsonNumber(FILE* file, double value)
+{
+  if (isnan(value))
+    fprintf(file, "null");
+  else
+    fprintf(file, "%.9g", value);
+}
+
+
+// one "NAME": {...} entry
+static void writeJsonStat(FILE* file, AbstractStat& stat, bool first, const char* indent)
+{
+  fprintf(file, "%s\n%s\"%s\": {\"group\": \"%s\", \"count\": %llu", first ? "" : ",",
+      indent, stat.getName().c_str(), statGroup(stat).c_str(), stat.getCount());
+
+  double value;
+  if (stat.getValue(value)) {
+    fprintf(file, ", \"value\": ");
+    writeJsonNumber(file, value);
+  }
+
+  fprintf(file, "}");
+}
+
+
+// distributions with their buckets and percentages resolved
+static void writeJsonDistributions(FILE* file, const vector<DIST_Stat*>& distributions,
+    const char* indent)
+{
+  for (unsigned int ii = 0; ii < distributions.size(); ++ii) {
+    DIST_Stat* pDistribution = distributions[ii];
+    const vector<long>& members = pDistribution->getMembers();
+
+    vector<AbstractStat*> stats;
+    unsigned long long total = 0;
+    for (unsigned int jj = 0; jj < members.size(); ++jj) {
+      AbstractStat* pMember = pDistribution->getMember(members[jj]);
+      stats.push_back(pMember);
+      total += pMember->getCount();
+    }
+
+    fprintf(file, "%s\n%s\"%s\": {\"group\": \"%s\", \"total\": %llu, \"buckets\": {",
+        ii ? "," : "", indent, pDistribution->getName().c_str(),
+        statGroup(*pDistribution).c_str(), total);
+
+    for (unsigned int jj = 0; jj < stats.size(); ++jj) {
+      fprintf(file, "%s\n%s  \"%s\": {\"count\": %llu, \"percent\": ", jj ? "," : "",
+          indent, stats[jj]->getName().c_str(), stats[jj]->getCount());
+      writeJsonNumber(file, total ? 100.0 * stats[jj]->getCount() / total : NAN);
+      fprintf(file, "}");
+    }
+
+    fprintf(file, "}}");
+  }
+}
+
+
+// binary stat descriptor; base is the stat id of table index 0
+static void writeBinaryDescriptor(FILE* file, AbstractStat& stat, long base)
+{
+  const string& name = stat.getName();
+  string group = statGroup(stat);
+  uns16 length;
+
+  length = name.size();
+  fwrite(&length, sizeof(uns16), 1, file);
+  fwrite(name.c_str(), 1, length, file);
+
+  length = group.size();
+  fwrite(&length, sizeof(uns16), 1, file);
+  fwrite(group.c_str(), 1, length, file);
+
+  int32 parent = -1;
+  if (stat.memberOfDistribution())
+    parent = static_cast<DISTMember_Stat&>(stat).getParentDistroID() - base;
+  fwrite(&parent, sizeof(int32), 1, file);
+}
+
+
 // constructor
 ProcessorStatistics::ProcessorStatistics(macsim_c* simBase)
 {
   m_simBase = simBase;
   m_globalStatistics = new GlobalStatistics(simBase);
+
+  m_globalCounts = NULL;
+  m_coreCounts   = NULL;
+  m_coreStride   = 0;
+  m_numCores     = 0;
+  m_sampler      = NULL;
 }
 
 
@@ -415,6 +566,9 @@ ProcessorStatistics::~ProcessorStatistics()
   }
 
   m_allCoresStats.clear();
+
+  free(m_globalCounts);
+  free(m_coreCounts);
 }
 
 
@@ -448,6 +602,54 @@ void ProcessorStatistics::setNumCores(unsigned int numCores)
     CoreStatistics* pCoreModel = m_simBase->m_coreStatsTemplate->clone(coreId, m_simBase);
     m_allCoresStats.push_back(pCoreModel);
   }
+
+  // counter blocks : one for global stats and one per core. A core block is rounded up
+  // to whole cache lines and every block is line aligned, so counters of different cores
+  // never share a line.
+  const unsigned int line_counts = 64 / sizeof(unsigned long long);
+  unsigned int num_global = m_globalStatistics->size();
+  unsigned int num_core   = m_simBase->m_coreStatsTemplate->size();
+
+  free(m_globalCounts);
+  free(m_coreCounts);
+
+  m_numCores   = numCores;
+  m_coreStride = (num_core + line_counts - 1) / line_counts * line_counts;
+
+  void* block;
+  if (posix_memalign(&block, 64, (num_global + 1) * sizeof(unsigned long long)) != 0)
+    block = NULL;
+  m_globalCounts = static_cast<unsigned long long*>(block);
+  if (posix_memalign(&block, 64, (m_coreStride * numCores + 1) * sizeof(unsigned long long)) != 0)
+    block = NULL;
+  m_coreCounts = static_cast<unsigned long long*>(block);
+  ASSERTM(m_globalCounts && m_coreCounts, "stat counter allocation failed\n");
+
+  memset(m_globalCounts, 0, (num_global + 1) * sizeof(unsigned long long));
+  memset(m_coreCounts, 0, (m_coreStride * numCores + 1) * sizeof(unsigned long long));
+
+  m_globalStatistics->bindPrivateCounts(m_globalCounts);
+  for (unsigned int coreId = 0; coreId < numCores; ++coreId) {
+    m_allCoresStats[coreId]->bindPrivateCounts(coreCounts(coreId));
+  }
+}
+
+
+// fold all counter blocks into the stat objects
+void ProcessorStatistics::mergeCounts()
+{
+  if (m_sampler)
+    m_sampler->counts_merged();
+
+  m_globalStatistics->mergePrivateCounts();
+
+  vector<CoreStatistics*>::iterator iter = m_allCoresStats.begin();
+  vector<CoreStatistics*>::iterator end = m_allCoresStats.end();
+
+  while (iter != end) {
+    (*iter)->mergePrivateCounts();
+    iter++;
+  }
 }
 
 
@@ -466,24 +668,156 @@ void ProcessorStatistics::saveStats(string ext)
   const char *Path = stat_path.c_str(); 
 
   int check = mkdir(Path, S_IRWXU);
+
+  // fold counter blocks into the stat objects before they are written
+  mergeCounts();
   check = check; // avoid "unused variable" warning
   //if (chdir(Path) != 0)
   //  exit(0);
 
-  // svae global statistics
-  m_globalStatistics->saveStats(ext);
+  string format = *m_simBase->m_knobs->KNOB_STAT_OUTPUT_FORMAT;
+
+  if (outputFormatEnabled(format, "text")) {
+    // svae global statistics
+    m_globalStatistics->saveStats(ext);
 
-  // save core-wide statistics
-  // iterate through each core, ask the core to save its stats
-  vector<CoreStatistics*>::iterator iterCoreStats = m_allCoresStats.begin();
-  vector<CoreStatistics*>::iterator endCoreStats = m_allCoresStats.end();
+    // save core-wide statistics
+    // iterate through each core, ask the core to save its stats
+    vector<CoreStatistics*>::iterator iterCoreStats = m_allCoresStats.begin();
+    vector<CoreStatistics*>::iterator endCoreStats = m_allCoresStats.end();
 
-  while (iterCoreStats != endCoreStats) {
-    CoreStatistics* pCoreStats = (*iterCoreStats);
-    pCoreStats->saveStats(ext);
+    while (iterCoreStats != endCoreStats) {
+      CoreStatistics* pCoreStats = (*iterCoreStats);
+      pCoreStats->saveStats(ext);
 
-    iterCoreStats++;
+      iterCoreStats++;
+    }
   }
+
+  if (outputFormatEnabled(format, "json"))
+    saveStatsJson(stat_path + "/stats.json" + ext);
+
+  if (outputFormatEnabled(format, "binary"))
+    saveStatsBinary(stat_path + "/stats.bin" + ext);
+}
+
+
+// write all stats to one JSON file
+//
+// {
+//   "num_cores": N,
+//   "global": {"NAME": {"group": "core", "count": C[, "value": V]}, ...},
+//   "distributions": {"NAME": {"group": "bp", "total": T,
+//                              "buckets": {"MEMBER": {"count": C, "percent": P}, ...}}, ...},
+//   "cores": [{"id": 0, "stats": {...}, "distributions": {...}}, ...]
+// }
+//
+// Core stat names carry no _CORE_<id> suffix. "value" is the derived column of the text
+// output (ratio, percent, per-inst ...); null when undefined (NaN). Distribution members
+// are listed both as plain counts and as buckets of their distribution.
+void ProcessorStatistics::saveStatsJson(const string& path)
+{
+  FILE* file = fopen(path.c_str(), "w");
+  if (file == NULL) {
+    cout << "cannot open " << path << endl;
+    return;
+  }
+
+  // the whole dump is a few hundred KB; keep it to a handful of writes
+  setvbuf(file, NULL, _IOFBF, 1 << 20);
+
+  fprintf(file, "{\n  \"num_cores\": %u,\n", m_numCores);
+
+  fprintf(file, "  \"global\": {");
+  for (int ii = 0; ii < m_globalStatistics->size(); ++ii) {
+    writeJsonStat(file, (*m_globalStatistics)[ii], ii == 0, "    ");
+  }
+  fprintf(file, "\n  },\n");
+
+  fprintf(file, "  \"distributions\": {");
+  writeJsonDistributions(file, m_globalStatistics->distributions(), "    ");
+  fprintf(file, "\n  },\n");
+
+  fprintf(file, "  \"cores\": [");
+  for (unsigned int core_id = 0; core_id < m_allCoresStats.size(); ++core_id) {
+    CoreStatistics& core_stats = *m_allCoresStats[core_id];
+
+    fprintf(file, "%s\n    {\"id\": %u,\n      \"stats\": {", core_id ? "," : "", core_id);
+    for (int ii = 0; ii < core_stats.size(); ++ii) {
+      writeJsonStat(file, core_stats[ii], ii == 0, "        ");
+    }
+    fprintf(file, "\n      },\n      \"distributions\": {");
+    writeJsonDistributions(file, core_stats.distributions(), "        ");
+    fprintf(file, "\n      }\n    }");
+  }
+  fprintf(file, "\n  ]\n}\n");
+
+  fclose(file);
+}
+
+
+// write all stats to one binary file
+//
+// (host byte order, no padding)
+//   char[8]  magic "MSSTATB1"
+//   uint32   number of cores C, number of global stats G, number of core stats K
+//   G + K    stat descriptors (global stats, then core stats):
+//              uint16 name length, name, uint16 group length, group,
+//              int32 index of the parent distribution in the same table (-1: none)
+//   G x uint64 count, G x double value
+//   C times  K x uint64 count, K x double value
+//
+// value is NaN when the stat has no derived value or it is undefined.
+void ProcessorStatistics::saveStatsBinary(const string& path)
+{
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == NULL) {
+    cout << "cannot open " << path << endl;
+    return;
+  }
+
+  setvbuf(file, NULL, _IOFBF, 1 << 20);
+
+  uns32 num_global = m_globalStatistics->size();
+  uns32 num_core   = m_allCoresStats.empty() ? 0 : m_allCoresStats[0]->size();
+  uns32 num_cores  = m_allCoresStats.size();
+
+  fwrite("MSSTATB1", 1, 8, file);
+  fwrite(&num_cores, sizeof(uns32), 1, file);
+  fwrite(&num_global, sizeof(uns32), 1, file);
+  fwrite(&num_core, sizeof(uns32), 1, file);
+
+  for (uns32 ii = 0; ii < num_global; ++ii) {
+    writeBinaryDescriptor(file, (*m_globalStatistics)[ii], 0);
+  }
+  for (uns32 ii = 0; ii < num_core; ++ii) {
+    writeBinaryDescriptor(file, (*m_allCoresStats[0])[ii], PER_CORE_STATS_ENUM_FIRST);
+  }
+
+  vector<unsigned long long> counts(max(num_global, num_core));
+  vector<double> values(max(num_global, num_core));
+
+  for (uns32 ii = 0; ii < num_global; ++ii) {
+    AbstractStat& stat = (*m_globalStatistics)[ii];
+    counts[ii] = stat.getCount();
+    if (!stat.getValue(values[ii]))
+      values[ii] = NAN;
+  }
+  fwrite(&counts[0], sizeof(unsigned long long), num_global, file);
+  fwrite(&values[0], sizeof(double), num_global, file);
+
+  for (uns32 core_id = 0; core_id < num_cores; ++core_id) {
+    CoreStatistics& core_stats = *m_allCoresStats[core_id];
+    for (uns32 ii = 0; ii < num_core; ++ii) {
+      counts[ii] = core_stats[ii].getCount();
+      if (!core_stats[ii].getValue(values[ii]))
+        values[ii] = NAN;
+    }
+    fwrite(&counts[0], sizeof(unsigned long long), num_core, file);
+    fwrite(&values[0], sizeof(double), num_core, file);
+  }
+
+  fclose(file);
 }
 
 
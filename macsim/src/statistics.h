@@ -65,6 +65,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
 #include "statsEnums.h"
 #include "global_defs.h"
@@ -92,6 +93,7 @@ void init_per_core_stats(unsigned num_cores, macsim_c* simBase);
 ofstream* getOutputStream(const string& filename);
 
 class AbstractStat;
+class stat_sampler_c;
 
 AbstractStat& getGLobalStat(long ID, ProcessorStatistics* m_ProcStat);
 AbstractStat& getCoreWideStat(int coreID, long statID, ProcessorStatistics* m_ProcStat);
@@ -112,7 +114,7 @@ class AbstractStat
         bool corewide = false, bool isTemplate = true):
       m_name(str), m_count(0), m_total_count(0), m_pRatioStat(NULL), 
       m_fileName(outputfilename), m_ID(ID), m_bCoreWide(corewide), m_coreID(0),
-      m_isTemplate(isTemplate), m_suffix("") {}
+      m_isTemplate(isTemplate), m_suffix(""), m_pPrivateCount(NULL) {}
 
     /**
      * Destructor.
@@ -203,13 +205,34 @@ class AbstractStat
     }
 
     /**
-     * Get the value of the counter.
+     * Get the value of the counter, including events not merged yet.
      */
     inline unsigned long long getCount()
     {
+      if (m_pPrivateCount)
+        return m_count + *m_pPrivateCount;
       return m_count;
     }
 
+    /**
+     * Bind the counter slot that the STAT macros increment.
+     */
+    inline void bindPrivateCount(unsigned long long* pCount)
+    {
+      m_pPrivateCount = pCount;
+    }
+
+    /**
+     * Fold the private counter slot into this stat.
+     */
+    inline void mergePrivateCount()
+    {
+      if (m_pPrivateCount) {
+        m_count += *m_pPrivateCount;
+        *m_pPrivateCount = 0;
+      }
+    }
+
     /**
      * Dump out all stats to the file.
      */
@@ -225,6 +248,15 @@ class AbstractStat
         endl << endl;
     }
 
+    /**
+     * Get the derived value (third column of the text output).
+     * Return false if the stat has no derived value. NaN when undefined.
+     */
+    virtual bool getValue(double& value)
+    {
+      return false;
+    }
+
   protected:
     string m_name; /**< name of stat */
     unsigned long long m_count; /**< count during the current stat interval */
@@ -236,6 +268,7 @@ class AbstractStat
     unsigned int m_coreID; /**< core id */
     bool m_isTemplate; /**< is template */
     string m_suffix; /**< stat suffix */
+    unsigned long long* m_pPrivateCount; /**< counter slot incremented by the STAT macros */
 };
 
 
@@ -313,6 +346,14 @@ class DISTMember_Stat : public AbstractStat
       m_parentDistroID = ID;
     }
 
+    /**
+     * Get the parent distribution id.
+     */
+    inline long getParentDistroID() const
+    {
+      return m_parentDistroID;
+    }
+
     /**
      * Clone a stat.
      */
@@ -397,6 +438,25 @@ class DIST_Stat : public AbstractStat
      */
     virtual void writeTo(ofstream& stream);
 
+    /**
+     * Get member stat ids.
+     */
+    const vector<long>& getMembers() const
+    {
+      return m_distributionMembers;
+    }
+
+    /**
+     * Get a member stat of this distribution (global or of this core).
+     */
+    AbstractStat* getMember(long memberID)
+    {
+      if (m_bCoreWide)
+        return &getCoreWideStat(m_coreID, memberID, m_ProcStat);
+
+      return &getGLobalStat(memberID, m_ProcStat);
+    }
+
     private:
       ProcessorStatistics* m_ProcStat; /**< reference to simulation-scoped processor stats */
 
@@ -449,6 +509,15 @@ class PER_INST_Stat : public AbstractStat
         << per_inst_value << endl << endl;
     }
   
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      value = (float)getCount() / getInstructionCount();
+      return true;
+    }
+
   private:
     float per_inst_value; /**< stat value */
 };
@@ -504,6 +573,16 @@ class PER_CYCLE_Stat : public AbstractStat
       }
     }
 
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      unsigned int cycleCount = getCycleCount();
+      value = cycleCount > 0 ? (float)getCount() / cycleCount : NAN;
+      return true;
+    }
+
   private:
     float per_cycle; /**< stat value */
 };
@@ -598,6 +677,19 @@ class RATIO_Stat : public AbstractStat
       stream << endl;
     }
 
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      unsigned long long refValue = m_bCoreWide ?
+        getCoreWideStat(m_coreID, m_RatioID, m_ProcStat).getCount() :
+        getGLobalStat(m_RatioID, m_ProcStat).getCount();
+
+      value = refValue ? (float)getCount() / (float)refValue : NAN;
+      return true;
+    }
+
   private:
     long m_RatioID; /**< ratio id */
     float ratio; /**< ratio */
@@ -681,6 +773,19 @@ class PERCENT_Stat : public AbstractStat
     }
 
 
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      unsigned long long refValue = m_bCoreWide ?
+        getCoreWideStat(m_coreID, m_denominatorID, m_ProcStat).getCount() :
+        getGLobalStat(m_denominatorID, m_ProcStat).getCount();
+
+      value = refValue ? 100 * ((float)getCount() / (float)refValue) : NAN;
+      return true;
+    }
+
   private:
     long m_denominatorID; /**< stat id */
     float ratio; /**< ratio */
@@ -738,6 +843,15 @@ class PER_1000_INST_Stat : public AbstractStat
       stream << setw(FILED3_LENGTH) << per_1000_inst_value << endl << endl;
     }
 
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      value = 1000 * ((float)getCount() / (float)getInstructionCount());
+      return true;
+    }
+
   private:
     float per_1000_inst_value; /**< per 1000 instruction value */
 };
@@ -791,6 +905,15 @@ class PER_1000_PRET_INST_Stat : public AbstractStat
       stream << setw(FILED3_LENGTH) << per_1000_pret_inst_value << endl << endl;
     }
 
+    /**
+     * Get the derived value.
+     */
+    virtual bool getValue(double& value)
+    {
+      value = 1000 * ((float)getCount() / (float)getPseudoRetiredInstructionCount());
+      return true;
+    }
+
   private:
     float per_1000_pret_inst_value; /**< stat value */
 };
@@ -870,6 +993,24 @@ class GlobalStatistics
       return m_globalStats.size();
     }
 
+    /**
+     * Return distribution stats.
+     */
+    const vector<DIST_Stat*>& distributions() const
+    {
+      return m_distributions;
+    }
+
+    /**
+     * Bind stat i to counter slot block[i].
+     */
+    void bindPrivateCounts(unsigned long long* block);
+
+    /**
+     * Fold the counter slots into the stats.
+     */
+    void mergePrivateCounts();
+
     /**
      * Dump out all stats in the standrad output.
      */
@@ -963,6 +1104,32 @@ class CoreStatistics
       return (*pStat);
     }
 
+    /**
+     * Return number of core stats.
+     */
+    int size() const
+    {
+      return m_CoreStats.size();
+    }
+
+    /**
+     * Return distribution stats.
+     */
+    const vector<DIST_Stat*>& distributions() const
+    {
+      return m_distributions;
+    }
+
+    /**
+     * Bind stat i to counter slot block[i].
+     */
+    void bindPrivateCounts(unsigned long long* block);
+
+    /**
+     * Fold the counter slots into the stats.
+     */
+    void mergePrivateCounts();
+
     /**
      * Make a clone stats for the core.
      */
@@ -1085,6 +1252,56 @@ class ProcessorStatistics
      */
     void setNumCores(unsigned int numCores);
 
+    /**
+     * Counter block of the global stats, indexed by stat id.
+     */
+    inline unsigned long long* globalCounts() const
+    {
+      return m_globalCounts;
+    }
+
+    /**
+     * Counter block of a core, indexed by (stat id - PER_CORE_STATS_ENUM_FIRST).
+     * @param coreID core id
+     */
+    inline unsigned long long* coreCounts(unsigned int coreID) const
+    {
+      // if invalid coreID, default to the last one
+      if (coreID >= m_numCores)
+        coreID = m_numCores - 1;
+
+      return m_coreCounts + coreID * m_coreStride;
+    }
+
+    /**
+     * Fold all counter blocks into the stat objects.
+     */
+    void mergeCounts();
+
+    /**
+     * Number of core counter blocks.
+     */
+    unsigned int numCores() const
+    {
+      return m_numCores;
+    }
+
+    /**
+     * Distance between two core counter blocks.
+     */
+    unsigned int coreStride() const
+    {
+      return m_coreStride;
+    }
+
+    /**
+     * Register the interval sampler, told before counter blocks are merged.
+     */
+    void setSampler(stat_sampler_c* sampler)
+    {
+      m_sampler = sampler;
+    }
+
     /**
      * Print all stats after the simulation.
      * @param ext extension to the stat.out file
@@ -1096,9 +1313,30 @@ class ProcessorStatistics
      */
     void saveStats();
 
+  private:
+    /**
+     * Write all global and core stats to one JSON file in a single pass.
+     * @param path output file
+     */
+    void saveStatsJson(const string& path);
+
+    /**
+     * Write all global and core stats to one binary file.
+     * @param path output file
+     */
+    void saveStatsBinary(const string& path);
+
   private:
     GlobalStatistics*  m_globalStatistics; /**< global stats */
     vector<CoreStatistics*> m_allCoresStats; /**< core stats table */
+
+    // STAT macros increment plain counters here; stat objects are updated on dump.
+    // Each core block starts on its own cache line so cores never share one.
+    unsigned long long* m_globalCounts; /**< global stat counters */
+    unsigned long long* m_coreCounts; /**< per-core stat counters, m_coreStride apart */
+    unsigned int m_coreStride; /**< counters per core block (multiple of a cache line) */
+    unsigned int m_numCores; /**< number of core blocks */
+    stat_sampler_c* m_sampler; /**< interval sampler (NULL: disabled) */
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
 };
 
@@ -1120,30 +1358,31 @@ class ProcessorStatistics
   TheProcessorPowerModel[E_##UnitName][E_##ComponentName]+=delta;
 
 #define STAT_CORE_EVENT(coreID, Event)                                  \
-  m_simBase->m_ProcessorStats->core(coreID)[Event - PER_CORE_STATS_ENUM_FIRST]++;
+  m_simBase->m_ProcessorStats->coreCounts(coreID)[Event - PER_CORE_STATS_ENUM_FIRST]++;
 
 
 #define STAT_CORE_EVENT_M(coreID, Event)                                \
-  m_simBase->m_ProcessorStats->core(coreID)[Event - PER_CORE_STATS_ENUM_FIRST]--;
+  m_simBase->m_ProcessorStats->coreCounts(coreID)[Event - PER_CORE_STATS_ENUM_FIRST]--;
 
 
 #define STAT_CORE_EVENT_N(coreID, Event, delta)                         \
-  m_simBase->m_ProcessorStats->core(coreID)[Event  - PER_CORE_STATS_ENUM_FIRST]+=delta;
+  m_simBase->m_ProcessorStats->coreCounts(coreID)[Event  - PER_CORE_STATS_ENUM_FIRST] += \
+    static_cast<unsigned int>(delta);
 
 
 // increment a stat
 #define STAT_EVENT(ID)                                                   \
-  (*m_simBase->m_ProcessorStats)[ID]++
+  m_simBase->m_ProcessorStats->globalCounts()[ID]++
 
 
 // decrement a stat
 #define STAT_EVENT_M(ID)                                                 \
-  (*m_simBase->m_ProcessorStats)[ID]--
+  m_simBase->m_ProcessorStats->globalCounts()[ID]--
 
 
 // increat a stat with delta value
 #define STAT_EVENT_N(ID, delta)                                          \
-  (*m_simBase->m_ProcessorStats)[ID] += delta
+  m_simBase->m_ProcessorStats->globalCounts()[ID] += static_cast<unsigned int>(delta)
 
 
 
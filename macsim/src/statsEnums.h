@@ -14,6 +14,45 @@ AVG_CORE_IDLE_CYCLE,
 DRAM_PRECHARGE,
 DRAM_ACTIVATE,
 DRAM_COLUMN,
+DRAM_AUTO_PRECHARGE,
+DRAM_REFRESH,
+DRAM_TIMING_STALL,
+DRAM_WQ_INSERT,
+DRAM_WQ_COALESCED,
+DRAM_WQ_FULL,
+DRAM_WQ_DRAIN,
+DRAM_WQ_DRAIN_CYCLE,
+DRAM_WQ_DRAIN_WRITE,
+DRAM_WQ_IDLE_WRITE,
+DRAM_TURNAROUND_RD_TO_WR,
+DRAM_TURNAROUND_WR_TO_RD,
+DRAM_WTR_STALL,
+DRAM_READ_LATENCY_BASE,
+DRAM_READ_LATENCY,
+DRAM_APP0_BANDWIDTH,
+DRAM_APP1_BANDWIDTH,
+DRAM_APP2_BANDWIDTH,
+DRAM_APP3_BANDWIDTH,
+DRAM_APP4_BANDWIDTH,
+DRAM_APP5_BANDWIDTH,
+DRAM_APP6_BANDWIDTH,
+DRAM_APP7_BANDWIDTH,
+DRAM_APP0_ALONE_LATENCY,
+DRAM_APP1_ALONE_LATENCY,
+DRAM_APP2_ALONE_LATENCY,
+DRAM_APP3_ALONE_LATENCY,
+DRAM_APP4_ALONE_LATENCY,
+DRAM_APP5_ALONE_LATENCY,
+DRAM_APP6_ALONE_LATENCY,
+DRAM_APP7_ALONE_LATENCY,
+DRAM_APP0_SLOWDOWN,
+DRAM_APP1_SLOWDOWN,
+DRAM_APP2_SLOWDOWN,
+DRAM_APP3_SLOWDOWN,
+DRAM_APP4_SLOWDOWN,
+DRAM_APP5_SLOWDOWN,
+DRAM_APP6_SLOWDOWN,
+DRAM_APP7_SLOWDOWN,
 DRAM_AVG_LATENCY_BASE,
 DRAM_AVG_LATENCY,
 BANDWIDTH_TOT,
@@ -144,6 +183,42 @@ ABIP_AVG_RATIO,
 TOTAL_WRITE_ACKS,
 TOTAL_WRITES,
 NUM_PHYSICAL_PAGES,
+COH_INV_MSG,
+COH_FWD_MSG,
+COH_BACK_INV_MSG,
+COH_ACK_MSG,
+COH_DATA_MSG,
+COH_UPGRADE,
+COH_BLOCKED_REQ,
+COH_TXN_LATENCY_BASE,
+COH_TXN_LATENCY,
+L2_INCLUSION_VICTIM,
+L3_INCLUSION_VICTIM,
+L3_INCLUSION_QBS_QUERY,
+L3_INCLUSION_QBS_SKIP,
+L3_EXCLUSIVE_MOVE,
+L3_EXCLUSIVE_CLEAN_VICTIM,
+CACHE_CAPACITY_SAMPLE,
+CACHE_PRIVATE_LINES,
+CACHE_LLC_LINES,
+CACHE_DUPLICATE_LINES,
+CACHE_EFFECTIVE_LINES,
+LLC_BDI_INSERT,
+LLC_BDI_ENC_ZEROS,
+LLC_BDI_ENC_REPEAT,
+LLC_BDI_ENC_B8D1,
+LLC_BDI_ENC_B8D2,
+LLC_BDI_ENC_B8D4,
+LLC_BDI_ENC_B4D1,
+LLC_BDI_ENC_B4D2,
+LLC_BDI_ENC_B2D1,
+LLC_BDI_ENC_NONE,
+LLC_BDI_SEGMENTS,
+LLC_BDI_COMPRESSION_RATIO,
+LLC_BDI_SET_LINES,
+LLC_BDI_MULTI_EVICT,
+LLC_BDI_COMPACT_VICTIM,
+LLC_BDI_DECOMPRESS,
 TOTAL_PACKET_CPU,
 TOTAL_PACKET_GPU,
 NOC_AVG_LATENCY_BASE,
@@ -251,6 +326,7 @@ PREF_REGION_USEFUL,
 PREF_REGION_EVICT,
 PREF_PHASE_OVERWRITE_PAGE,
 PREF_UPDATE_COUNT,
+PREF_GLOBAL_THROTTLE,
 PREF_HYBRID_SEL_0,
 PREF_HYBRID_SEL_1,
 PREF_HYBRID_SEL_2,
@@ -258,6 +334,43 @@ PREF_HYBRID_SEL_3,
 PREF_HYBRID_SEL_4,
 PREF_HYBRID_SEL_5,
 PREF_HYBRID_SEL_6,
+PREF_POTENTIAL_MISS,
+PREF_STRIDE_SENT,
+PREF_STRIDEPC_SENT,
+PREF_STREAM_SENT,
+PREF_GHB_SENT,
+PREF_2DC_SENT,
+PREF_PHASE_SENT,
+PREF_STRIDE_USEFUL,
+PREF_STRIDEPC_USEFUL,
+PREF_STREAM_USEFUL,
+PREF_GHB_USEFUL,
+PREF_2DC_USEFUL,
+PREF_PHASE_USEFUL,
+PREF_STRIDE_LATE,
+PREF_STRIDEPC_LATE,
+PREF_STREAM_LATE,
+PREF_GHB_LATE,
+PREF_2DC_LATE,
+PREF_PHASE_LATE,
+PREF_STRIDE_ACCURACY,
+PREF_STRIDEPC_ACCURACY,
+PREF_STREAM_ACCURACY,
+PREF_GHB_ACCURACY,
+PREF_2DC_ACCURACY,
+PREF_PHASE_ACCURACY,
+PREF_STRIDE_COVERAGE,
+PREF_STRIDEPC_COVERAGE,
+PREF_STREAM_COVERAGE,
+PREF_GHB_COVERAGE,
+PREF_2DC_COVERAGE,
+PREF_PHASE_COVERAGE,
+PREF_STRIDE_TIMELINESS,
+PREF_STRIDEPC_TIMELINESS,
+PREF_STREAM_TIMELINESS,
+PREF_GHB_TIMELINESS,
+PREF_2DC_TIMELINESS,
+PREF_PHASE_TIMELINESS,
 DCACHE_PREF_HIT,
 IFETCH_WB_FIRST_SCHEDULE,
 PREFETCH_LAST_SCHEDULE,
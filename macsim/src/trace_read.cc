@@ -255,7 +255,7 @@ bool trace_read_c::read_trace(int core_id, void *trace_info, int sim_thread_id,
       // trace reading error
       else {
         if (bytes_read == 0) {
-          if (!core->m_thread_finished[sim_thread_id]) { 
+          if (!core->m_thread_state->m_thread_finished[core->get_thread_slot(sim_thread_id)]) { 
             thread_trace_info->m_trace_ended = true;
 
             DEBUG("trace ended core_id:%d thread_id:%d\n", core_id, sim_thread_id);
@@ -817,15 +817,17 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   trace_uop_s *trace_uop;
   int num_uop  = 0;
   core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_state_c* thread_state = core->m_thread_state;
+  int slot = core->get_thread_slot(sim_thread_id);
   inst_info_s *info;
 
   // fetch ended : no uop to fetch
-  if (core->m_fetch_ended[sim_thread_id]) 
+  if (thread_state->m_fetch_ended[slot]) 
     return false;
 
   trace_info_cpu_s trace_info;
   bool read_success = true;
-  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+  thread_s* thread_trace_info = thread_state->m_trace_info[slot];
 
   if (thread_trace_info->m_thread_init) {
     thread_trace_info->m_thread_init = false;
@@ -838,15 +840,15 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   if (thread_trace_info->m_bom) {
     bool inst_read; // indicate new instruction has been read from a trace file
     
-    if (core->m_inst_fetched[sim_thread_id] < *KNOB(KNOB_MAX_INSTS)) {
+    if (thread_state->m_inst_fetched[slot] < CONFIG(m_max_insts)) {
       // read next instruction
       read_success = read_trace(core_id, thread_trace_info->m_next_trace_info, 
           sim_thread_id, &inst_read);
     }
     else {
       inst_read = false;
-      if (!core->get_trace_info(sim_thread_id)->m_trace_ended) { 
-        core->get_trace_info(sim_thread_id)->m_trace_ended = true;
+      if (!thread_trace_info->m_trace_ended) { 
+        thread_trace_info->m_trace_ended = true;
       }
     }
 
@@ -876,12 +878,12 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
     // read a new instruction, so update stats
     if (inst_read) { 
-      ++core->m_inst_fetched[sim_thread_id];
+      ++thread_state->m_inst_fetched[slot];
       DEBUG("core_id:%d thread_id:%d inst_num:%lu\n",
           core_id, sim_thread_id, thread_trace_info->m_temp_inst_count + 1);
 
-      if (core->m_inst_fetched[sim_thread_id] > core->m_max_inst_fetched) 
-        core->m_max_inst_fetched = core->m_inst_fetched[sim_thread_id];
+      if (thread_state->m_inst_fetched[slot] > core->m_max_inst_fetched) 
+        core->m_max_inst_fetched = thread_state->m_inst_fetched[slot];
     }
 
 
@@ -898,7 +900,7 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     thread_trace_info->m_eom             = thread_trace_info->m_trace_uop_array[0]->m_eom;
     thread_trace_info->m_bom             = false;
 
-    uop->m_isitBOM = true;
+    uop->m_warm->m_isitBOM = true;
     POWER_CORE_EVENT(core_id, POWER_INST_DECODER_R);
     POWER_CORE_EVENT(core_id, POWER_OPERAND_DECODER_R);
   } // END EOM
@@ -909,51 +911,51 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     info                     = trace_uop->m_info;
     thread_trace_info->m_eom = trace_uop->m_eom;
     info->m_trace_info.m_bom = 0; // because of repeat instructions ....
-    uop->m_isitBOM           = false;
+    uop->m_warm->m_isitBOM           = false;
     ++thread_trace_info->m_num_sending_uop;
   }
 
 
   // set end of macro flag
   if (thread_trace_info->m_eom) {
-    uop->m_isitEOM           = true; // mark for current uop
+    uop->m_warm->m_isitEOM           = true; // mark for current uop
     thread_trace_info->m_bom = true; // mark for next instruction
   }
   else {
-    uop->m_isitEOM           = false;
+    uop->m_warm->m_isitEOM           = false;
     thread_trace_info->m_bom = false;
   }
 
 
-  if (core->get_trace_info(sim_thread_id)->m_trace_ended && uop->m_isitEOM) {
+  if (thread_trace_info->m_trace_ended && uop->m_warm->m_isitEOM) {
     --core->m_fetching_thread_num;
-    core->m_fetch_ended[sim_thread_id] = true;
-    uop->m_last_uop                    = true;
+    thread_state->m_fetch_ended[slot] = true;
+    uop->m_warm->m_last_uop                   = true;
     DEBUG("core_id:%d thread_id:%d inst_num:%lld uop_num:%lld fetched:%lld last uop\n",
-        core_id, sim_thread_id, uop->m_inst_num, uop->m_uop_num, 
-        core->m_inst_fetched[sim_thread_id]);
+        core_id, sim_thread_id, uop->m_warm->m_inst_num, uop->m_uop_num, 
+        thread_state->m_inst_fetched[slot]);
   }
 
 
   ///
   /// Set up actual uop data structure
   ///
-  uop->m_opcode      = trace_uop->m_opcode;
+  uop->m_warm->m_opcode      = trace_uop->m_opcode;
   uop->m_uop_type    = info->m_table_info->m_op_type;
-  uop->m_cf_type     = info->m_table_info->m_cf_type;
+  uop->m_warm->m_cf_type     = info->m_table_info->m_cf_type;
   uop->m_mem_type    = info->m_table_info->m_mem_type;
   ASSERT(uop->m_mem_type >= 0 && uop->m_mem_type < NUM_MEM_TYPES);
-  uop->m_bar_type    = trace_uop->m_bar_type;
-  uop->m_npc         = trace_uop->m_npc;
-  uop->m_active_mask = trace_uop->m_active_mask;
-
-  if (uop->m_cf_type) { 
-    uop->m_taken_mask      = trace_uop->m_taken_mask;
-    uop->m_reconverge_addr = trace_uop->m_reconverge_addr;
-    uop->m_target_addr     = trace_uop->m_target;
+  uop->m_warm->m_bar_type    = trace_uop->m_bar_type;
+  uop->m_cold->m_npc         = trace_uop->m_npc;
+  uop->m_cold->m_active_mask = trace_uop->m_active_mask;
+
+  if (uop->m_warm->m_cf_type) { 
+    uop->m_cold->m_taken_mask      = trace_uop->m_taken_mask;
+    uop->m_cold->m_reconverge_addr = trace_uop->m_reconverge_addr;
+    uop->m_cold->m_target_addr     = trace_uop->m_target;
   }
 
-  if (uop->m_opcode == GPU_EN) {
+  if (uop->m_warm->m_opcode == GPU_EN) {
     m_simBase->m_gpu_paused = false;	
   }
 
@@ -966,41 +968,41 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     // using extra bits to differentiate address space of each application
     uop->m_vaddr = trace_uop->m_va + m_simBase->m_memory->base_addr(core_id,
         (unsigned long)UINT_MAX * 
-        (core->get_trace_info(sim_thread_id)->m_process->m_process_id) * 10ul);
+        (thread_trace_info->m_process->m_process_id) * 10ul);
 
     // virtual-to-physical translation 
     // physical page is allocated at this point for the time being
     if (m_enable_physical_mapping)
-      uop->m_vaddr = m_page_mapper->translate(uop->m_vaddr);
+      uop->m_vaddr = m_page_mapper->translate(uop->m_vaddr, core_id);
   }
 
 
-  uop->m_mem_size = trace_uop->m_mem_size;
+  uop->m_warm->m_mem_size = trace_uop->m_mem_size;
   if (uop->m_mem_type != NOT_MEM) {
-    int temp_num_req = (uop->m_mem_size + *KNOB(KNOB_MAX_TRANSACTION_SIZE) - 1) / 
+    int temp_num_req = (uop->m_warm->m_mem_size + *KNOB(KNOB_MAX_TRANSACTION_SIZE) - 1) / 
       *KNOB(KNOB_MAX_TRANSACTION_SIZE);
 
     ASSERTM(temp_num_req > 0, "pc:%llx vaddr:%llx opcode:%d size:%d max:%d num:%d type:%d num:%d\n", 
-        uop->m_pc, uop->m_vaddr, uop->m_opcode, uop->m_mem_size, 
+        uop->m_warm->m_pc, uop->m_vaddr, uop->m_warm->m_opcode, uop->m_warm->m_mem_size, 
         (int)*KNOB(KNOB_MAX_TRANSACTION_SIZE), temp_num_req, uop->m_mem_type, 
         trace_uop->m_info->m_trace_info.m_num_uop);
   }
 
-  uop->m_dir     = trace_uop->m_actual_taken;
-  uop->m_pc      = info->m_addr;
+  uop->m_warm->m_dir     = trace_uop->m_actual_taken;
+  uop->m_warm->m_pc      = info->m_addr;
   uop->m_core_id = core_id;
 
 
   // we found first uop of an instruction, so add instruction count
-  if (uop->m_isitBOM) 
+  if (uop->m_warm->m_isitBOM) 
     ++thread_trace_info->m_temp_inst_count;
 
-  uop->m_inst_num  = thread_trace_info->m_temp_inst_count;
+  uop->m_warm->m_inst_num  = thread_trace_info->m_temp_inst_count;
   uop->m_num_srcs  = trace_uop->m_num_src_regs;
-  uop->m_num_dests = trace_uop->m_num_dest_regs;
+  uop->m_warm->m_num_dests = trace_uop->m_num_dest_regs;
 
-  ASSERTM(uop->m_num_dests < MAX_DST_NUM, "uop->num_dests=%d MAX_DST_NUM=%d\n", 
-      uop->m_num_dests, MAX_DST_NUM);
+  ASSERTM(uop->m_warm->m_num_dests < MAX_DST_NUM, "uop->num_dests=%d MAX_DST_NUM=%d\n", 
+      uop->m_warm->m_num_dests, MAX_DST_NUM);
 
 
   // uop number is specific to the core
@@ -1008,13 +1010,13 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
   DEBUG("uop_num:%lld num_srcs:%d  trace_uop->num_src_regs:%d  num_dsts:%d num_seing_uop:%d "
       "pc:0x%s dir:%d \n",
-      uop->m_uop_num, uop->m_num_srcs, trace_uop->m_num_src_regs, uop->m_num_dests, 
-      thread_trace_info->m_num_sending_uop, hexstr64s(uop->m_pc), uop->m_dir);
+      uop->m_uop_num, uop->m_num_srcs, trace_uop->m_num_src_regs, uop->m_warm->m_num_dests, 
+      thread_trace_info->m_num_sending_uop, hexstr64s(uop->m_warm->m_pc), uop->m_warm->m_dir);
 
   // filling the src_info, dest_info
   if (uop->m_num_srcs < MAX_SRCS) {
     for (int index=0; index < uop->m_num_srcs; ++index) {
-      uop->m_src_info[index] = trace_uop->m_srcs[index].m_id;
+      uop->m_cold->m_src_info[index] = trace_uop->m_srcs[index].m_id;
       //DEBUG("uop_num:%lld src_info[%d]:%d\n", uop->uop_num, index, uop->src_info[index]);
     }
   } 
@@ -1024,17 +1026,17 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
 
 
-  for (int index = 0; index < uop->m_num_dests; ++index) {
-    uop->m_dest_info[index] = trace_uop->m_dests[index].m_id;
+  for (int index = 0; index < uop->m_warm->m_num_dests; ++index) {
+    uop->m_cold->m_dest_info[index] = trace_uop->m_dests[index].m_id;
     ASSERT(trace_uop->m_dests[index].m_reg < NUM_REG_IDS);
   }
 
   uop->m_uop_num          = (thread_trace_info->m_temp_uop_count++);
   uop->m_thread_id        = sim_thread_id;
-  uop->m_block_id         = ((core)->get_trace_info(sim_thread_id))->m_block_id; 
-  uop->m_orig_block_id    = ((core)->get_trace_info(sim_thread_id))->m_orig_block_id;
-  uop->m_unique_thread_id = ((core)->get_trace_info(sim_thread_id))->m_unique_thread_id;
-  uop->m_orig_thread_id   = ((core)->get_trace_info(sim_thread_id))->m_orig_thread_id;
+  uop->m_warm->m_block_id         = thread_trace_info->m_block_id; 
+  uop->m_cold->m_orig_block_id    = thread_trace_info->m_orig_block_id;
+  uop->m_cold->m_unique_thread_id = thread_trace_info->m_unique_thread_id;
+  uop->m_cold->m_orig_thread_id   = thread_trace_info->m_orig_thread_id;
 
   
   ///
@@ -1043,7 +1045,7 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   ///
 
   DEBUG("new uop: uop_num:%lld inst_num:%lld thread_id:%d unique_num:%lld \n",
-      uop->m_uop_num, uop->m_inst_num, uop->m_thread_id, uop->m_unique_num);
+      uop->m_uop_num, uop->m_warm->m_inst_num, uop->m_thread_id, uop->m_unique_num);
 
   return read_success;
 }
@@ -776,15 +776,17 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   trace_uop_s *trace_uop;
   int num_uop  = 0;
   core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_state_c* thread_state = core->m_thread_state;
+  int slot = core->get_thread_slot(sim_thread_id);
   inst_info_s *info;
 
   // fetch ended : no uop to fetch
-  if (core->m_fetch_ended[sim_thread_id]) 
+  if (thread_state->m_fetch_ended[slot]) 
     return false;
 
   trace_info_gpu_s trace_info;
   bool read_success = true;
-  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+  thread_s* thread_trace_info = thread_state->m_trace_info[slot];
 
   if (thread_trace_info->m_thread_init) {
     thread_trace_info->m_thread_init = false;
@@ -797,15 +799,15 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   if (thread_trace_info->m_bom) {
     bool inst_read; // indicate new instruction has been read from a trace file
     
-    if (core->m_inst_fetched[sim_thread_id] < *KNOB(KNOB_MAX_INSTS)) {
+    if (thread_state->m_inst_fetched[slot] < CONFIG(m_max_insts)) {
       // read next instruction
       read_success = read_trace(core_id, thread_trace_info->m_next_trace_info, 
           sim_thread_id, &inst_read);
     }
     else {
       inst_read = false;
-      if (!core->get_trace_info(sim_thread_id)->m_trace_ended) { 
-        core->get_trace_info(sim_thread_id)->m_trace_ended = true;
+      if (!thread_trace_info->m_trace_ended) { 
+        thread_trace_info->m_trace_ended = true;
       }
     }
 
@@ -834,12 +836,12 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
     // read a new instruction, so update stats
     if (inst_read) { 
-      ++core->m_inst_fetched[sim_thread_id];
+      ++thread_state->m_inst_fetched[slot];
       DEBUG("core_id:%d thread_id:%d inst_num:%lu\n",
           core_id, sim_thread_id, thread_trace_info->m_temp_inst_count + 1);
 
-      if (core->m_inst_fetched[sim_thread_id] > core->m_max_inst_fetched) 
-        core->m_max_inst_fetched = core->m_inst_fetched[sim_thread_id];
+      if (thread_state->m_inst_fetched[slot] > core->m_max_inst_fetched) 
+        core->m_max_inst_fetched = thread_state->m_inst_fetched[slot];
     }
 
 
@@ -873,7 +875,7 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     thread_trace_info->m_eom             = thread_trace_info->m_trace_uop_array[0]->m_eom;
     thread_trace_info->m_bom             = false;
 
-    uop->m_isitBOM = true;
+    uop->m_warm->m_isitBOM = true;
     POWER_CORE_EVENT(core_id, POWER_INST_DECODER_R);
     POWER_CORE_EVENT(core_id, POWER_OPERAND_DECODER_R);
   } // END EOM
@@ -884,46 +886,47 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     info                     = trace_uop->m_info;
     thread_trace_info->m_eom = trace_uop->m_eom;
     info->m_trace_info.m_bom = 0; // because of repeat instructions ....
-    uop->m_isitBOM           = false;
+    uop->m_warm->m_isitBOM           = false;
     ++thread_trace_info->m_num_sending_uop;
   }
 
 
   // set end of macro flag
   if (thread_trace_info->m_eom) {
-    uop->m_isitEOM           = true; // mark for current uop
+    uop->m_warm->m_isitEOM           = true; // mark for current uop
     thread_trace_info->m_bom = true; // mark for next instruction
   }
   else {
-    uop->m_isitEOM           = false;
+    uop->m_warm->m_isitEOM           = false;
     thread_trace_info->m_bom = false;
   }
 
 
-  if (core->get_trace_info(sim_thread_id)->m_trace_ended && uop->m_isitEOM) {
+  if (thread_trace_info->m_trace_ended && uop->m_warm->m_isitEOM) {
     --core->m_fetching_thread_num;
-    core->m_fetch_ended[sim_thread_id] = true;
-    uop->m_last_uop                    = true;
+    thread_state->m_fetch_ended[slot] = true;
+    uop->m_warm->m_last_uop                   = true;
     DEBUG("core_id:%d thread_id:%d inst_num:%lld uop_num:%lld fetched:%lld last uop\n",
-        core_id, sim_thread_id, uop->m_inst_num, uop->m_uop_num, 
-        core->m_inst_fetched[sim_thread_id]);
+        core_id, sim_thread_id, uop->m_warm->m_inst_num, uop->m_uop_num, 
+        thread_state->m_inst_fetched[slot]);
   }
 
 
   /* BAR_FETCH */
   if (trace_uop->m_bar_type == BAR_FETCH) { //only last uop with have BAR_FETCH set
     frontend_c *frontend   = core->get_frontend();
-    frontend_s *fetch_data = core->get_trace_info(sim_thread_id)->m_fetch_data;
+    frontend_s *fetch_data = thread_trace_info->m_fetch_data;
 
     fetch_data->m_fetch_blocked = true;
+    frontend->inc_barrier_blocked_thread_num();
 
     bool new_entry = false;
     sync_thread_s* sync_info = frontend->m_sync_info->hash_table_access_create(
-        core->get_trace_info(sim_thread_id)->m_block_id, &new_entry);
+        thread_trace_info->m_block_id, &new_entry);
 
     // new synchronization information
     if (new_entry) {
-      sync_info->m_block_id = core->get_trace_info(sim_thread_id)->m_block_id;
+      sync_info->m_block_id = thread_trace_info->m_block_id;
       sync_info->m_sync_count = 0;
       sync_info->m_num_threads_in_block = 
         m_simBase->m_block_schedule_info[sync_info->m_block_id]->m_total_thread_num;
@@ -938,22 +941,22 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   ///
   /// Set up actual uop data structure
   ///
-  uop->m_opcode      = trace_uop->m_opcode;
+  uop->m_warm->m_opcode      = trace_uop->m_opcode;
   uop->m_uop_type    = info->m_table_info->m_op_type;
-  uop->m_cf_type     = info->m_table_info->m_cf_type;
+  uop->m_warm->m_cf_type     = info->m_table_info->m_cf_type;
   uop->m_mem_type    = info->m_table_info->m_mem_type;
   ASSERT(uop->m_mem_type >= 0 && uop->m_mem_type < NUM_MEM_TYPES);
-  uop->m_bar_type    = trace_uop->m_bar_type;
-  uop->m_npc         = trace_uop->m_npc;
-  uop->m_active_mask = trace_uop->m_active_mask;
-
-  if (uop->m_cf_type) { 
-    uop->m_taken_mask      = trace_uop->m_taken_mask;
-    uop->m_reconverge_addr = trace_uop->m_reconverge_addr;
-    uop->m_target_addr     = trace_uop->m_target;
+  uop->m_warm->m_bar_type    = trace_uop->m_bar_type;
+  uop->m_cold->m_npc         = trace_uop->m_npc;
+  uop->m_cold->m_active_mask = trace_uop->m_active_mask;
+
+  if (uop->m_warm->m_cf_type) { 
+    uop->m_cold->m_taken_mask      = trace_uop->m_taken_mask;
+    uop->m_cold->m_reconverge_addr = trace_uop->m_reconverge_addr;
+    uop->m_cold->m_target_addr     = trace_uop->m_target;
   }
 
-  if (uop->m_opcode == GPU_EN) {
+  if (uop->m_warm->m_opcode == GPU_EN) {
     m_simBase->m_gpu_paused = false;	
   }
 
@@ -966,27 +969,27 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     // using extra bits to differentiate address space of each application
     uop->m_vaddr = trace_uop->m_va + m_simBase->m_memory->base_addr(core_id,
         (unsigned long)UINT_MAX * 
-        (core->get_trace_info(sim_thread_id)->m_process->m_process_id) * 10ul);
+        (thread_trace_info->m_process->m_process_id) * 10ul);
   }
 
 
-  uop->m_mem_size = trace_uop->m_mem_size;
+  uop->m_warm->m_mem_size = trace_uop->m_mem_size;
 
-  uop->m_dir     = trace_uop->m_actual_taken;
-  uop->m_pc      = info->m_addr;
+  uop->m_warm->m_dir     = trace_uop->m_actual_taken;
+  uop->m_warm->m_pc      = info->m_addr;
   uop->m_core_id = core_id;
 
 
   // we found first uop of an instruction, so add instruction count
-  if (uop->m_isitBOM) 
+  if (uop->m_warm->m_isitBOM) 
     ++thread_trace_info->m_temp_inst_count;
 
-  uop->m_inst_num  = thread_trace_info->m_temp_inst_count;
+  uop->m_warm->m_inst_num  = thread_trace_info->m_temp_inst_count;
   uop->m_num_srcs  = trace_uop->m_num_src_regs;
-  uop->m_num_dests = trace_uop->m_num_dest_regs;
+  uop->m_warm->m_num_dests = trace_uop->m_num_dest_regs;
 
-  ASSERTM(uop->m_num_dests < MAX_DST_NUM, "uop->num_dests=%d MAX_DST_NUM=%d\n", 
-      uop->m_num_dests, MAX_DST_NUM);
+  ASSERTM(uop->m_warm->m_num_dests < MAX_DST_NUM, "uop->num_dests=%d MAX_DST_NUM=%d\n", 
+      uop->m_warm->m_num_dests, MAX_DST_NUM);
 
 
   // uop number is specific to the core
@@ -994,13 +997,13 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
   DEBUG("uop_num:%lld num_srcs:%d  trace_uop->num_src_regs:%d  num_dsts:%d num_seing_uop:%d "
       "pc:0x%s dir:%d \n",
-      uop->m_uop_num, uop->m_num_srcs, trace_uop->m_num_src_regs, uop->m_num_dests, 
-      thread_trace_info->m_num_sending_uop, hexstr64s(uop->m_pc), uop->m_dir);
+      uop->m_uop_num, uop->m_num_srcs, trace_uop->m_num_src_regs, uop->m_warm->m_num_dests, 
+      thread_trace_info->m_num_sending_uop, hexstr64s(uop->m_warm->m_pc), uop->m_warm->m_dir);
 
   // filling the src_info, dest_info
   if (uop->m_num_srcs < MAX_SRCS) {
     for (int index=0; index < uop->m_num_srcs; ++index) {
-      uop->m_src_info[index] = trace_uop->m_srcs[index].m_id;
+      uop->m_cold->m_src_info[index] = trace_uop->m_srcs[index].m_id;
       //DEBUG("uop_num:%lld src_info[%d]:%d\n", uop->uop_num, index, uop->src_info[index]);
     }
   } 
@@ -1008,17 +1011,17 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
     ASSERTM(uop->m_num_srcs < MAX_SRCS, "src_num:%d MAX_SRC:%d", uop->m_num_srcs, MAX_SRCS);
   }
 
-  for (int index = 0; index < uop->m_num_dests; ++index) {
-    uop->m_dest_info[index] = trace_uop->m_dests[index].m_id;
+  for (int index = 0; index < uop->m_warm->m_num_dests; ++index) {
+    uop->m_cold->m_dest_info[index] = trace_uop->m_dests[index].m_id;
     ASSERT(trace_uop->m_dests[index].m_reg < NUM_REG_IDS);
   }
 
   uop->m_uop_num          = (thread_trace_info->m_temp_uop_count++);
   uop->m_thread_id        = sim_thread_id;
-  uop->m_block_id         = ((core)->get_trace_info(sim_thread_id))->m_block_id; 
-  uop->m_orig_block_id    = ((core)->get_trace_info(sim_thread_id))->m_orig_block_id;
-  uop->m_unique_thread_id = ((core)->get_trace_info(sim_thread_id))->m_unique_thread_id;
-  uop->m_orig_thread_id   = ((core)->get_trace_info(sim_thread_id))->m_orig_thread_id;
+  uop->m_warm->m_block_id         = thread_trace_info->m_block_id; 
+  uop->m_cold->m_orig_block_id    = thread_trace_info->m_orig_block_id;
+  uop->m_cold->m_unique_thread_id = thread_trace_info->m_unique_thread_id;
+  uop->m_cold->m_orig_thread_id   = thread_trace_info->m_orig_thread_id;
 
   ///
   /// GPU simulation : coalescing logic
@@ -1044,14 +1047,14 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
       }
     }
 
-    if (*KNOB(KNOB_COMPUTE_CAPABILITY) == 1.3f) {
+    if (CONFIG(m_compute_capability) == 1.3f) {
       if (*KNOB(KNOB_BYTE_LEVEL_ACCESS)) {
         //cache_line_addr = uop->m_vaddr;
         //cache_line_size = *KNOB(KNOB_MAX_TRANSACTION_SIZE);
       }
       ASSERTM(0, "TBD");
     }
-    else if (*KNOB(KNOB_COMPUTE_CAPABILITY) == 2.0f) {
+    else if (CONFIG(m_fermi)) {
       Addr line_addr = 0;
       Addr end_line_addr = 0;
       int line_size;
@@ -1059,33 +1062,33 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
         // shared memory, parameter memory
         case MEM_LD_SM:
         case MEM_ST_SM:
-          if (uop->m_vaddr && uop->m_mem_size) {
+          if (uop->m_vaddr && uop->m_warm->m_mem_size) {
             line_addr = core->get_shared_memory()->base_cache_line(uop->m_vaddr);
-            end_line_addr = core->get_shared_memory()->base_cache_line(uop->m_vaddr + uop->m_mem_size - 1);
+            end_line_addr = core->get_shared_memory()->base_cache_line(uop->m_vaddr + uop->m_warm->m_mem_size - 1);
           }
           line_size = core->get_shared_memory()->cache_line_size();
           break;
           // constant memory
         case MEM_LD_CM:
-          if (uop->m_vaddr && uop->m_mem_size) {
+          if (uop->m_vaddr && uop->m_warm->m_mem_size) {
             line_addr = core->get_const_cache()->base_cache_line(uop->m_vaddr);
-            end_line_addr = core->get_const_cache()->base_cache_line(uop->m_vaddr + uop->m_mem_size - 1);
+            end_line_addr = core->get_const_cache()->base_cache_line(uop->m_vaddr + uop->m_warm->m_mem_size - 1);
           }
           line_size = core->get_const_cache()->cache_line_size();
           break;
           // texture memory
         case MEM_LD_TM:
-          if (uop->m_vaddr && uop->m_mem_size) {
+          if (uop->m_vaddr && uop->m_warm->m_mem_size) {
             line_addr = core->get_texture_cache()->base_cache_line(uop->m_vaddr);
-            end_line_addr = core->get_texture_cache()->base_cache_line(uop->m_vaddr + uop->m_mem_size - 1);
+            end_line_addr = core->get_texture_cache()->base_cache_line(uop->m_vaddr + uop->m_warm->m_mem_size - 1);
           }
           line_size = core->get_texture_cache()->cache_line_size();
           break;
           // global memory
         default:
-          if (uop->m_vaddr && uop->m_mem_size) {
+          if (uop->m_vaddr && uop->m_warm->m_mem_size) {
             line_addr = m_simBase->m_memory->base_addr(core_id, uop->m_vaddr);
-            end_line_addr = m_simBase->m_memory->base_addr(core_id, uop->m_vaddr + uop->m_mem_size - 1);
+            end_line_addr = m_simBase->m_memory->base_addr(core_id, uop->m_vaddr + uop->m_warm->m_mem_size - 1);
           }
           line_size = m_simBase->m_memory->line_size(core_id);
           break;
@@ -1103,10 +1106,10 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
       bool last_inst = false;
       bool inst_read;
       Addr addr;
-      int access_size = uop->m_mem_size;
+      int access_size = uop->m_warm->m_mem_size;
       ASSERTM(access_size, "access size cannot be zero %s tid %d core %d uop num %llu block id %d orig id %d\n",
-              gpu_decoder_c::g_tr_opcode_names[uop->m_opcode], sim_thread_id, core_id, 
-              uop->m_uop_num, uop->m_block_id, uop->m_orig_thread_id);
+              gpu_decoder_c::g_tr_opcode_names[uop->m_warm->m_opcode], sim_thread_id, core_id, 
+              uop->m_uop_num, uop->m_warm->m_block_id, uop->m_cold->m_orig_thread_id);
 
       // even if a warp has fewer than 32 threads or even if fewer than 
       // 32 threads are active, there will be 32 addresses, with bytes
@@ -1136,7 +1139,7 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
             if (read_success) {
               if (inst_read) {
                 trace_info_gpu_s *prev_trace_info = static_cast<trace_info_gpu_s *>(thread_trace_info->m_prev_trace_info);
-                uop->m_npc = prev_trace_info->m_inst_addr;
+                uop->m_cold->m_npc = prev_trace_info->m_inst_addr;
               }
               else {
                 thread_trace_info->m_trace_ended = true;
@@ -1205,17 +1208,17 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
       ASSERTM(seen_block_addr.size() == seen_block_list.size() && seen_block_addr.size(), 
           "should be non-zero and equal");
 
-      uop->m_child_uops = new uop_c * [seen_block_addr.size()];
-      uop->m_num_child_uops = seen_block_addr.size();
-      uop->m_num_child_uops_done = 0;
-      if (uop->m_num_child_uops != 64) {
-        uop->m_pending_child_uops  = N_BIT_MASK(uop->m_num_child_uops);
+      uop->m_warm->m_child_uops = new uop_c * [seen_block_addr.size()];
+      uop->m_warm->m_num_child_uops = seen_block_addr.size();
+      uop->m_warm->m_num_child_uops_done = 0;
+      if (uop->m_warm->m_num_child_uops != 64) {
+        uop->m_warm->m_pending_child_uops  = N_BIT_MASK(uop->m_warm->m_num_child_uops);
       }
       else {
-        uop->m_pending_child_uops  = N_BIT_MASK_64;
+        uop->m_warm->m_pending_child_uops  = N_BIT_MASK_64;
       }
       uop->m_vaddr               = 0;
-      uop->m_mem_size            = 0;
+      uop->m_warm->m_mem_size            = 0;
 
       uop_c *child_mem_uop = NULL;
       int count = 0;
@@ -1229,15 +1232,22 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
         child_mem_uop->allocate();
         ASSERT(child_mem_uop); 
 
+        // copy the parent, but keep the child's own warm and cold records
+        uop_warm_c* child_warm = child_mem_uop->m_warm;
+        uop_cold_c* child_cold = child_mem_uop->m_cold;
         memcpy(child_mem_uop, uop, sizeof(uop_c));
+        child_mem_uop->m_warm = child_warm;
+        child_mem_uop->m_cold = child_cold;
+        *child_warm = *uop->m_warm;
+        *child_cold = *uop->m_cold;
 
-        child_mem_uop->m_parent_uop = uop;
+        child_mem_uop->m_warm->m_parent_uop = uop;
         child_mem_uop->m_vaddr = vaddr;
-        child_mem_uop->m_mem_size = line_size;
+        child_mem_uop->m_warm->m_mem_size = line_size;
         child_mem_uop->m_uop_num    = thread_trace_info->m_temp_uop_count++;
         child_mem_uop->m_unique_num = core->inc_and_get_unique_uop_num();
 
-        uop->m_child_uops[count++] = child_mem_uop;
+        uop->m_warm->m_child_uops[count++] = child_mem_uop;
 
         ++itr;
       }
@@ -1245,7 +1255,7 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   }
 
   DEBUG("new uop: uop_num:%lld inst_num:%lld thread_id:%d unique_num:%lld \n",
-      uop->m_uop_num, uop->m_inst_num, uop->m_thread_id, uop->m_unique_num);
+      uop->m_uop_num, uop->m_warm->m_inst_num, uop->m_thread_id, uop->m_unique_num);
 
   return read_success;
 }
@@ -405,75 +405,92 @@ const char *uop_c::g_uop_type_name[NUM_UOP_TYPES] = {
 uop_c::uop_c(macsim_c* simBase)
 {
   m_simBase = simBase;
+  m_warm    = new uop_warm_c;
+  m_cold    = new uop_cold_c;
   init();
   m_valid = false;
 }
 
 uop_c::uop_c()
 {
+  m_warm = new uop_warm_c;
+  m_cold = new uop_cold_c;
   init();
   m_valid = false;
 }
 
 
+// destructor
+uop_c::~uop_c()
+{
+  delete m_warm;
+  delete m_cold;
+}
+
+
 // initialize an uop
 void uop_c::init()
 {
   for (int ii = 0; ii < MAX_SRCS; ++ii) {
-    m_map_src_info[ii].m_uop = NULL;
+    m_warm->m_map_src_info[ii].m_uop = NULL;
   }
 
   for (int ii = 0; ii < MAX_DESTS; ++ii) {
-    m_dest_info[ii] = 0;
+    m_cold->m_dest_info[ii] = 0;
   }
 
   m_uop_num                           = 0; 
-  m_inst_num                          = 0; 
+  m_warm->m_inst_num                  = 0; 
   m_thread_id                         = -1; 
-  m_unique_thread_id                  = -1; 
-  m_orig_thread_id                    = -1;
-  m_off_path                          = 0; 
-  m_fetched_cycle                     = 0;
-  m_bp_cycle                          = 0;
-  m_alloc_cycle                       = 0;
-  m_sched_cycle                       = 0;
-  m_exec_cycle                        = 0;
+  m_cold->m_unique_thread_id          = -1; 
+  m_cold->m_orig_thread_id            = -1;
+  m_warm->m_off_path                  = 0; 
+  m_cold->m_fetched_cycle             = 0;
+  m_cold->m_bp_cycle                  = 0;
+  m_warm->m_alloc_cycle               = 0;
+  m_warm->m_sched_cycle               = 0;
+  m_warm->m_exec_cycle                = 0;
   m_done_cycle                        = 0;
-  m_mem_start_cycle                   = 0;
-  m_srcs_not_rdy_vector               = 0;
+  m_cold->m_mem_start_cycle           = 0;
+  m_cold->m_srcs_not_rdy_vector       = 0;
   m_last_dep_exec                     = NULL;
   m_srcs_rdy                          = 0;
+  m_wakeup_cycle                      = 0;
+  m_sched_seq                         = 0;
+  m_wakeup_head                       = NULL;
+  m_wakeup_next                       = NULL;
   m_mem_type                          = NOT_MEM; 
   m_bogus                             = false;
-  m_active_mask                       = 0;
-  m_taken_mask                        = 0;
-  m_reconverge_addr                   = 0;
-  m_target_addr                       = 0;
-  m_uop_info.m_misfetch               = false;
-  m_uop_info.m_mispred                = false;
-  m_uop_info.m_originally_mispred     = false;
-  m_uop_info.m_originally_misfetch    = false;
-  m_uop_info.m_btb_miss               = false;
-  m_uop_info.m_btb_miss_resolved      = false; 
-  m_uop_info.m_no_target              = false;
-  m_uop_info.m_ibp_miss               = false;
-  m_uop_info.m_icmiss                 = false;
-  m_uop_info.m_dcmiss                 = false;
-  m_uop_info.m_l2_miss                = false;
-  m_num_child_uops                    = 0;
-  m_num_child_uops_done               = 0;
-  m_child_uops                        = NULL;
-  m_parent_uop                        = NULL;
-  m_pending_child_uops                = 0;
-  m_uncoalesced_flag                  = false;
-  m_last_uop                          = false;
-  m_req_sb                            = false;
-  m_req_lb                            = false;
-  m_req_int_reg                       = false;
-  m_req_fp_reg                        = false;
-  m_dcache_bank_id                    = 128;
-  m_bypass_llc                        = false;
-  m_skip_llc                          = false;
+  m_cold->m_active_mask               = 0;
+  m_cold->m_taken_mask                = 0;
+  m_cold->m_reconverge_addr           = 0;
+  m_cold->m_target_addr               = 0;
+  m_cold->m_uop_info.m_misfetch       = false;
+  m_cold->m_uop_info.m_mispred        = false;
+  m_cold->m_uop_info.m_originally_mispred = false;
+  m_cold->m_uop_info.m_originally_misfetch = false;
+  m_cold->m_uop_info.m_btb_miss       = false;
+  m_cold->m_uop_info.m_btb_miss_resolved = false; 
+  m_cold->m_uop_info.m_no_target      = false;
+  m_cold->m_uop_info.m_ibp_miss       = false;
+  m_cold->m_uop_info.m_icmiss         = false;
+  m_cold->m_uop_info.m_dcmiss         = false;
+  m_cold->m_uop_info.m_l2_miss        = false;
+  m_cold->m_uop_info.m_mem_level      = 0;
+  m_warm->m_num_child_uops            = 0;
+  m_warm->m_num_child_uops_done       = 0;
+  m_warm->m_child_uops                = NULL;
+  m_warm->m_parent_uop                = NULL;
+  m_warm->m_pending_child_uops        = 0;
+  m_cold->m_uncoalesced_flag          = false;
+  m_warm->m_last_uop                  = false;
+  m_warm->m_req_sb                    = false;
+  m_warm->m_req_lb                    = false;
+  m_warm->m_req_int_reg               = false;
+  m_warm->m_req_fp_reg                = false;
+  m_warm->m_dcache_bank_id            = 128;
+  m_warm->m_bypass_llc                = false;
+  m_warm->m_skip_llc                  = false;
 }
 
 
@@ -489,18 +506,18 @@ void uop_c::allocate()
 uop_c* uop_c::free()
 {
   m_uop_num        = 0 ; 
-  m_inst_num       = 0 ; 
+  m_warm->m_inst_num = 0 ; 
   m_valid = false;
   
   if ((m_mem_type == MEM_ST) || (m_mem_type == MEM_ST_LM)) {
     delete_store_hash_entry_wrapper(m_simBase->m_core_pointers[m_core_id]->get_map(), this);
   }
-  m_thread_id        = -1; 
-  m_unique_thread_id = -1; 
-  m_orig_thread_id   = -1;
-  m_dcache_bank_id   = 128;
-  m_bypass_llc       = false;
-  m_skip_llc         = false;
+  m_thread_id      = -1; 
+  m_cold->m_unique_thread_id = -1; 
+  m_cold->m_orig_thread_id = -1;
+  m_warm->m_dcache_bank_id = 128;
+  m_warm->m_bypass_llc = false;
+  m_warm->m_skip_llc = false;
 
   return this;
 }
@@ -503,6 +503,7 @@ class  uop_info_c
     bool  m_icmiss;             /**< instruction cache miss */
     bool  m_dcmiss;             /**< data cache miss */
     bool  m_l2_miss;            /**< l2 miss */
+    int   m_mem_level;          /**< memory level that serviced the load (0: dcache hit) */
     uns32 m_pred_global_hist;   /**< global branch history 32-bit */
     uns64 m_pred_global_hist_64; /**< global branch history 64-bit */
     int32 m_perceptron_output;  /**< perceptron bp output */
@@ -533,6 +534,77 @@ class recovery_info_c
 };
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Rarely accessed uop fields (trace decoding, branch prediction, debug and stats).
+/// Kept out of uop_c so the per-cycle pipeline stages only touch the hot record.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class uop_cold_c
+{
+  public:
+    int               m_unique_thread_id; /**< unique thread id */
+    int               m_orig_thread_id; /**< original thread id */
+    int               m_orig_block_id; /**< original GPU block id */
+    int               m_srcs_not_rdy_vector; /**< src not ready bit vector */
+    Addr              m_npc; /**< next pc */
+    Addr              m_target_addr; /**< branch target address */
+    Addr              m_reconverge_addr; /**< GPU : reconvergence address */
+    uint32_t          m_active_mask; /**< GPU : active mask */
+    uint32_t          m_taken_mask; /**< GPU : taken mask */
+    bool              m_mispredicted; /**< mispredicted branch */
+    bool              m_uncoalesced_flag; /**< uncoalesced flag */
+    Counter           m_fetched_cycle; /**< fetched cycle */
+    Counter           m_bp_cycle; /**< branch predictor access cycle */
+    Counter           m_mem_start_cycle; /**< mem start cycle */
+    Counter           m_src_uop_num; /**< number of source uops */
+    uns16             m_src_info[MAX_SRCS]; /**< src uop info */
+    uns16             m_dest_info[MAX_DESTS]; /**< destination information */
+    uop_info_c        m_uop_info; /**< uop microarchitecture info */
+    recovery_info_c   m_recovery_info; /**< recovery information */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief uop pipeline fields touched once or twice per uop (allocation, execution,
+/// retirement) and the source map, which is read when the uop enters the scheduler.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class uop_warm_c
+{
+  public:
+    Counter           m_inst_num; /**< instruction number */
+    Counter           m_exec_cycle; /**< execution cycle */
+    Counter           m_alloc_cycle; /**< allocated cycle */
+    Counter           m_sched_cycle; /**< scheduled cycle */
+    Addr              m_pc; /**< pc address */
+    mem_req_s *       m_req; /**< pointer to memory request */ 
+    uop_c           **m_child_uops; /**< children uops */
+    uop_c            *m_parent_uop; /**< parent uop */
+    uns64             m_pending_child_uops; /**< pending child uops vector */
+    Cf_Type           m_cf_type; /**< branch type */
+    int               m_mem_size; /**< memory access size */
+    int               m_num_dests; /**< number of dest registers */
+    int               m_rob_entry; /**< rob entry id */
+    int               m_dcache_bank_id; /**< dcache bank id */
+    Bar_Type          m_bar_type; /**< barrier type */
+    uns               m_block_id; /**< GPU data structure */
+    int               m_num_child_uops; /**< number of children uops */
+    int               m_num_child_uops_done; /**< number of done children uops */
+    bool              m_in_iaq; /**< in allocation queue */
+    bool              m_isitBOM; /**< first uop of an instruction */
+    bool              m_isitEOM; /**< last uop of an instruction */
+    bool              m_last_uop; /**< last uop of a thread */
+    bool              m_off_path; /**< uop in wrong-path */
+    uns8              m_dir; /**< branch direction */
+    uint8_t           m_opcode; /**< opcode */
+    bool              m_req_sb; /**< need store buffer */
+    bool              m_req_lb; /**< need load buffer */
+    bool              m_req_int_reg; /**< need integer register */
+    bool              m_req_fp_reg; /**< need fp register */
+    bool              m_bypass_llc; /**< bypass last level cache */
+    bool              m_skip_llc; /**< skip last level cache */
+    src_info_c        m_map_src_info[MAX_UOP_SRC_DEPS]; /**< src map information */
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Micro-Op (uop) class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -549,6 +621,11 @@ class uop_c
      */
     uop_c(macsim_c* simBase);
 
+    /**
+     * Destructor
+     */
+    ~uop_c();
+
     /**
      * Initilization
      */
@@ -571,75 +648,32 @@ class uop_c
     static const char *g_uop_type_name[NUM_UOP_TYPES]; /**< uop type string */
 
 
+    // -------------------------------------
+    // hot : read by schedule / exec / retire every cycle (two cache lines with the pointers)
+    // -------------------------------------
     Counter           m_uop_num; /**< uop number */
     Counter           m_unique_num; /**< uop unique number */
-    Counter           m_inst_num; /**< instruction number */
+    Counter           m_done_cycle; /**< done cycle */
+    Counter           m_wakeup_cycle; /**< cycle all sources are ready (MAX_CTR: pending) */
+    Counter           m_sched_seq; /**< insertion order in the scheduler */
+    Counter *         m_last_dep_exec; /**< last dependent execution cycle */
+    uop_c *           m_wakeup_head; /**< consumers parked on this uop */
+    uop_c *           m_wakeup_next; /**< next consumer parked on the same producer */
+    Addr              m_vaddr; /**< memory address */
     int               m_thread_id; /**< thread id */
-    int               m_unique_thread_id; /**< unique thread id */
-    int               m_orig_thread_id; /**< original thread id */
-    int               m_orig_block_id; /**< original GPU block id */
-    uns               m_block_id; /**< GPU data structure */
     int               m_core_id; /**< core id */
-    Addr              m_pc; /**< pc address */
-    Addr              m_npc; /**< next pc */
-    uint8_t           m_opcode; /**< opcode */
     Uop_Type          m_uop_type; /**< uop type */
-    Cf_Type           m_cf_type; /**< branch type */
     Mem_Type          m_mem_type; /**< memory type */
-    Bar_Type          m_bar_type; /**< barrier type */
-
-    Counter           m_fetched_cycle; /**< fetched cycle */
-    Counter           m_bp_cycle; /**< branch predictor access cycle */
-    Counter           m_alloc_cycle; /**< allocated cycle */
-    Counter           m_sched_cycle; /**< scheduled cycle */
-    Counter           m_exec_cycle; /**< execution cycle */
-    Counter           m_done_cycle; /**< done cycle */
-
+    ALLOCQ_Type       m_allocq_num; /**< alloc queue id */
+    Uop_State         m_state; /**< the state of the op in the datapath */
     int               m_num_srcs; /**< number of src registers */
-    int               m_num_dests; /**< number of dest registers */
-    Addr              m_vaddr; /**< memory address */
-    int               m_mem_size; /**< memory access size */
-    uns8              m_dir; /**< branch direction */
-    uns16             m_src_info[MAX_SRCS]; /**< src uop info */
-    src_info_c        m_map_src_info[MAX_UOP_SRC_DEPS]; /**< src map information */
-    Counter           m_src_uop_num; /**< number of source uops */
-    uns16             m_dest_info[MAX_DESTS]; /**< destination information */
     bool              m_valid; /**< valid uop */
     bool              m_bogus;  /**< mispredicted uops */
-    bool              m_off_path; /**< uop in wrong-path */
-    bool              m_mispredicted; /**< mispredicted branch */
-    Addr              m_target_addr; /**< branch target address */
-    uint32_t          m_active_mask; /**< GPU : active mask */
-    uint32_t          m_taken_mask; /**< GPU : taken mask */
-    Addr              m_reconverge_addr; /**< GPU : reconvergence address */
-    Uop_State         m_state; /**< the state of the op in the datapath */
-    int               m_rob_entry; /**< rob entry id */
-    bool              m_in_scheduler; /**< in scheduler */
-    ALLOCQ_Type       m_allocq_num; /**< alloc queue id */
-    bool              m_in_iaq; /**< in allocation queue */
-    Counter *         m_last_dep_exec; /**< last dependent execution cycle */
     bool              m_srcs_rdy; /**< source ready */
-    uop_info_c        m_uop_info; /**< uop microarchitecture info */
-    bool              m_isitBOM; /**< first uop of an instruction */
-    bool              m_isitEOM; /**< last uop of an instruction */
-    bool              m_last_uop; /**< last uop of a thread */
-    recovery_info_c   m_recovery_info; /**< recovery information */
-    int               m_srcs_not_rdy_vector; /**< src not ready bit vector */
-    int               m_num_child_uops; /**< number of children uops */
-    int               m_num_child_uops_done; /**< number of done children uops */
-    uop_c           **m_child_uops; /**< children uops */
-    uop_c            *m_parent_uop; /**< parent uop */
-    uns64             m_pending_child_uops; /**< pending child uops vector */
-    mem_req_s *       m_req; /**< pointer to memory request */ 
-    bool              m_uncoalesced_flag; /**< uncoalesced flag */
-    Counter           m_mem_start_cycle; /**< mem start cycle */
-    bool              m_req_sb; /**< need store buffer */
-    bool              m_req_lb; /**< need load buffer */
-    bool              m_req_int_reg; /**< need integer register */
-    bool              m_req_fp_reg; /**< need fp register */
-    int               m_dcache_bank_id; /**< dcache bank id */
-    bool              m_bypass_llc; /**< bypass last level cache */
-    bool              m_skip_llc; /**< skip last level cache */
+    bool              m_in_scheduler; /**< in scheduler */
+
+    uop_warm_c *      m_warm; /**< pipeline state touched once or twice, source map */
+    uop_cold_c *      m_cold; /**< trace, branch prediction and stat fields */
 
   private:
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
@@ -46,6 +46,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <time.h>
 #include <string>
 #include <list>
+#include <new>
+#include <vector>
 #include <unordered_map>
 #include <fstream>
 
@@ -107,6 +109,10 @@ using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief pool class
+///
+/// Entries are constructed in contiguous chunks of pool_expand_unit entries, so objects
+/// recycled through the pool stay packed together. Free entries are kept in a LIFO stack;
+/// recently released (cache-warm) entries are handed out first.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 template <class T>
 class pool_c
@@ -117,7 +123,6 @@ class pool_c
      */
     pool_c()
     {
-      m_pool            = new list<T*>;
       m_poolsize        = 0;
       m_poolexpand_unit = 1;
       m_name            = "none";
@@ -130,7 +135,6 @@ class pool_c
      */
     pool_c(int pool_expand_unit, string name)
     {
-      m_pool            = new list<T*>;
       m_poolsize        = 0;
       m_poolexpand_unit = pool_expand_unit;
       m_name            = name;
@@ -141,12 +145,12 @@ class pool_c
      */
     ~pool_c()
     {
-      while (!m_pool->empty()) {
-        T* entry = m_pool->front();
-        m_pool->pop_front();
-        delete entry;
+      for (int ii = 0, size = m_chunk.size(); ii < size; ++ii) {
+        for (int jj = 0; jj < m_poolexpand_unit; ++jj) {
+          m_chunk[ii][jj].~T();
+        }
+        ::operator delete(m_chunk[ii]);
       }
-      delete m_pool;
     }
 
     /**
@@ -154,11 +158,11 @@ class pool_c
      */
     T* acquire_entry(void)
     {
-      if (m_pool->empty()) {
+      if (m_pool.empty()) {
         expand_pool();
       }
-      T* entry = m_pool->front();
-      m_pool->pop_front();
+      T* entry = m_pool.back();
+      m_pool.pop_back();
       return entry;
     }
     
@@ -168,11 +172,11 @@ class pool_c
      */
     T* acquire_entry(macsim_c* m_simBase) 
     {
-      if (m_pool->empty()) {
+      if (m_pool.empty()) {
         expand_pool(m_simBase);
       }
-      T* entry = m_pool->front();
-      m_pool->pop_front();
+      T* entry = m_pool.back();
+      m_pool.pop_back();
       return entry;
     }
 
@@ -181,7 +185,7 @@ class pool_c
      */
     void release_entry(T* entry)
     {
-      m_pool->push_front(entry);
+      m_pool.push_back(entry);
     }
 
     /**
@@ -189,11 +193,11 @@ class pool_c
      */
     void expand_pool(void)
     {
+      T* entries = new_chunk();
       for (int ii = 0; ii < m_poolexpand_unit; ++ii) {
-        T* entries = new T;
-        m_pool->push_back(entries);
+        new (&entries[ii]) T;
       }
-      m_poolsize += m_poolexpand_unit;
+      push_chunk(entries);
     }
 
    /**
@@ -202,11 +206,11 @@ class pool_c
      */
     void expand_pool(macsim_c* m_simBase)
     {
+      T* entries = new_chunk();
       for (int ii = 0; ii < m_poolexpand_unit; ++ii) {
-        T* entries = new T(m_simBase);
-        m_pool->push_back(entries);
+        new (&entries[ii]) T(m_simBase);
       }
-      m_poolsize += m_poolexpand_unit;
+      push_chunk(entries);
     }
 
     /**
@@ -218,10 +222,32 @@ class pool_c
     }
 
   private:
-    list<T*>* m_pool; /**< pool */
-    int       m_poolsize; /**< pool size */
-    int       m_poolexpand_unit; /**< pool expand unit */
-    string    m_name; /**< pool name */
+    /**
+     * Allocate raw storage for pool_expand_unit entries
+     */
+    T* new_chunk(void)
+    {
+      return static_cast<T*>(::operator new(sizeof(T) * m_poolexpand_unit));
+    }
+
+    /**
+     * Add constructed entries to the free stack; the first entry is handed out first
+     */
+    void push_chunk(T* entries)
+    {
+      m_chunk.push_back(entries);
+      for (int ii = m_poolexpand_unit - 1; ii >= 0; --ii) {
+        m_pool.push_back(&entries[ii]);
+      }
+      m_poolsize += m_poolexpand_unit;
+    }
+
+  private:
+    vector<T*> m_pool; /**< free entries */
+    vector<T*> m_chunk; /**< contiguous entry storage */
+    int        m_poolsize; /**< pool size */
+    int        m_poolexpand_unit; /**< pool expand unit */
+    string     m_name; /**< pool name */
 };
 
 